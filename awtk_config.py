@@ -68,6 +68,8 @@ COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_STB_FONT '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DSTBTT_STATIC -DSTB_IMAGE_STATIC -DWITH_STB_IMAGE '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_VGCANVAS -DWITH_UNICODE_BREAK -DWITH_DESKTOP_STYLE '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DSDL2 -DHAS_STD_MALLOC -DWITH_SDL -DWITH_FS_RES -DHAS_STDIO '
+COMMON_CCFLAGS=COMMON_CCFLAGS+' -DHAS_GET_TIME_US64 '
+COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_SIMD '
 
 #only for c compiler flags
 COMMON_CFLAGS=''
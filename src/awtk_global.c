@@ -21,6 +21,7 @@
 
 #include "awtk.h"
 #include "tkc/mem.h"
+#include "tkc/trace.h"
 #include "base/idle.h"
 #include "base/timer.h"
 #include "tkc/time_now.h"
@@ -34,7 +35,9 @@
 #include "base/widget_factory.h"
 #include "base/assets_manager.h"
 #include "base/widget_pool.h"
+#include "base/layer_cache.h"
 #include "base/widget_animator_manager.h"
+#include "ui_loader/window_template_cache.h"
 #include "font_loader/font_loader_bitmap.h"
 #include "base/window_animator_factory.h"
 #include "window_animators/window_animator_builtins.h"
@@ -55,6 +58,7 @@
 #endif /*WITH_SDL*/
 
 #include "font_loader/font_loader_truetype.h"
+#include "image_loader/image_loader_lz4.h"
 
 #ifdef WITH_STB_IMAGE
 #include "image_loader/image_loader_stb.h"
@@ -106,6 +110,8 @@ static ret_t awtk_mem_on_out_of_memory(void* ctx, uint32_t tried_times, uint32_t
     image_manager_unload_unused(image_manager(), 10);
   } else if (tried_times == 2) {
     image_manager_unload_unused(image_manager(), 0);
+    window_manager_free_unused_snapshots(window_manager());
+    layer_cache_clear();
   } else if (tried_times == 3) {
     event_t e = event_init(EVT_LOW_MEMORY, NULL);
     widget_dispatch(window_manager(), &e);
@@ -119,6 +125,7 @@ static ret_t awtk_mem_on_out_of_memory(void* ctx, uint32_t tried_times, uint32_t
 
 ret_t tk_init_internal(void) {
   font_loader_t* font_loader = NULL;
+  image_loader_register(image_loader_lz4());
 #ifdef WITH_STB_IMAGE
   image_loader_register(image_loader_stb());
 #endif /*WITH_STB_IMAGE*/
@@ -187,8 +194,12 @@ ret_t tk_init(wh_t w, wh_t h, app_type_t app_type, const char* app_name, const c
 }
 
 ret_t tk_deinit_internal(void) {
+  window_template_cache_deinit();
+  tk_trace_stop();
+
   widget_destroy(window_manager());
   window_manager_set(NULL);
+  layer_cache_deinit();
 
   clip_board_destroy(clip_board());
   clip_board_set(NULL);
@@ -29,6 +29,62 @@
 
 static ret_t asset_info_unref(asset_info_t* info);
 
+#define ASSETS_MANAGER_MIN_BUCKETS_NR 64
+
+static uint32_t assets_manager_hash(assets_manager_t* am, asset_type_t type, const char* name) {
+  uint32_t h = 2166136261u ^ (uint32_t)type;
+
+  while (*name) {
+    h = (h ^ (uint8_t)(*name++)) * 16777619u;
+  }
+
+  return h & (am->buckets_nr - 1);
+}
+
+/*同类型同名的资源只索引第一个，与线性查找的结果一致*/
+static ret_t assets_manager_index_insert(assets_manager_t* am, const asset_info_t* info) {
+  uint32_t mask = am->buckets_nr - 1;
+  uint32_t i = assets_manager_hash(am, (asset_type_t)(info->type), info->name);
+
+  while (am->buckets[i] != NULL) {
+    const asset_info_t* iter = am->buckets[i];
+    if (iter->type == info->type && strcmp(iter->name, info->name) == 0) {
+      return RET_FOUND;
+    }
+    i = (i + 1) & mask;
+  }
+  am->buckets[i] = info;
+
+  return RET_OK;
+}
+
+static ret_t assets_manager_index_rebuild(assets_manager_t* am) {
+  uint32_t i = 0;
+  uint32_t buckets_nr = ASSETS_MANAGER_MIN_BUCKETS_NR;
+
+  /*负载因子不超过0.5*/
+  while (buckets_nr < am->assets.size * 2) {
+    buckets_nr = buckets_nr << 1;
+  }
+
+  if (buckets_nr != am->buckets_nr) {
+    TKMEM_FREE(am->buckets);
+    am->buckets_nr = 0;
+    am->buckets = TKMEM_ZALLOCN(const asset_info_t*, buckets_nr);
+    return_value_if_fail(am->buckets != NULL, RET_OOM);
+    am->buckets_nr = buckets_nr;
+  } else {
+    memset((void*)(am->buckets), 0x00, buckets_nr * sizeof(const asset_info_t*));
+  }
+
+  for (i = 0; i < am->assets.size; i++) {
+    assets_manager_index_insert(am, (const asset_info_t*)(am->assets.elms[i]));
+  }
+  am->index_dirty = FALSE;
+
+  return RET_OK;
+}
+
 static int asset_cache_cmp_type(const void* a, const void* b) {
   const asset_info_t* aa = (const asset_info_t*)a;
   const asset_info_t* bb = (const asset_info_t*)b;
@@ -228,6 +284,8 @@ static uint16_t subtype_from_extname(const char* extname) {
     subtype = ASSET_TYPE_IMAGE_JPG;
   } else if (tk_str_ieq(extname, ".jpeg")) {
     subtype = ASSET_TYPE_IMAGE_JPG;
+  } else if (tk_str_ieq(extname, ".lz4")) {
+    subtype = ASSET_TYPE_IMAGE_LZ4;
   } else if (tk_str_ieq(extname, "ttf")) {
     subtype = ASSET_TYPE_FONT_TTF;
   } else {
@@ -426,6 +484,10 @@ assets_manager_t* assets_manager_init(assets_manager_t* am, uint32_t init_nr) {
 
   darray_init(&(am->assets), init_nr, (tk_destroy_t)asset_info_unref,
               (tk_compare_t)asset_cache_cmp_type);
+  am->buckets = NULL;
+  am->buckets_nr = 0;
+  am->generation = 0;
+  am->index_dirty = TRUE;
 
   return am;
 }
@@ -463,7 +525,18 @@ ret_t assets_manager_add(assets_manager_t* am, const void* info) {
   return_value_if_fail(am != NULL && info != NULL, RET_BAD_PARAMS);
 
   asset_info_ref((asset_info_t*)r);
-  return darray_push(&(am->assets), (void*)r);
+  if (darray_push(&(am->assets), (void*)r) != RET_OK) {
+    asset_info_unref((asset_info_t*)r);
+    return RET_OOM;
+  }
+
+  if (!am->index_dirty && am->buckets != NULL && am->assets.size * 2 <= am->buckets_nr) {
+    assets_manager_index_insert(am, r);
+  } else {
+    am->index_dirty = TRUE;
+  }
+
+  return RET_OK;
 }
 
 const asset_info_t* assets_manager_find_in_cache(assets_manager_t* am, asset_type_t type,
@@ -473,6 +546,24 @@ const asset_info_t* assets_manager_find_in_cache(assets_manager_t* am, asset_typ
   const asset_info_t** all = NULL;
   return_value_if_fail(am != NULL && name != NULL, NULL);
 
+  if ((am->index_dirty || am->buckets == NULL) && am->assets.size > 0) {
+    assets_manager_index_rebuild(am);
+  }
+
+  if (!am->index_dirty && am->buckets != NULL) {
+    uint32_t mask = am->buckets_nr - 1;
+
+    i = assets_manager_hash(am, type, name);
+    while ((iter = am->buckets[i]) != NULL) {
+      if (type == iter->type && strcmp(name, iter->name) == 0) {
+        return iter;
+      }
+      i = (i + 1) & mask;
+    }
+
+    return NULL;
+  }
+
   all = (const asset_info_t**)(am->assets.elms);
 
   for (i = 0; i < am->assets.size; i++) {
@@ -559,6 +650,9 @@ ret_t assets_manager_clear_cache(assets_manager_t* am, asset_type_t type) {
   info.type = type;
   return_value_if_fail(am != NULL, RET_BAD_PARAMS);
 
+  am->generation++;
+  am->index_dirty = TRUE;
+
   return darray_remove_all(&(am->assets), &info);
 }
 
@@ -575,6 +669,10 @@ ret_t assets_manager_deinit(assets_manager_t* am) {
 
   TKMEM_FREE(am->res_root);
   darray_deinit(&(am->assets));
+  TKMEM_FREE(am->buckets);
+  am->buckets_nr = 0;
+  am->index_dirty = TRUE;
+  am->generation++;
 
   return RET_OK;
 }
@@ -244,6 +244,13 @@ struct _assets_manager_t {
   char* res_root;
   locale_info_t* locale_info;
   system_info_t* system_info;
+
+  /*按(type, name)索引assets的hash表(开放寻址)，清除缓存后重建*/
+  const asset_info_t** buckets;
+  uint32_t buckets_nr;
+  bool_t index_dirty;
+  /*清除缓存时增加，用于判断引用资源数据的句柄是否有效(参考image_handle_t)*/
+  uint32_t generation;
 };
 
 /**
@@ -118,6 +118,12 @@
  * #define WITH_WCSXXX 1
  */
 
+/**
+ * 如果CPU支持SSE2/AVX2/NEON，用SIMD指令加速图片合成和填充，请定义本宏(运行时检测是否支持AVX2)
+ *
+ * #define WITH_SIMD 1
+ */
+
 /**
  * 如果启用STM32 G2D硬件加速，请定义本宏
  *
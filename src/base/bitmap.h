@@ -122,7 +122,13 @@ typedef enum _bitmap_flag_t {
    * @const BITMAP_FLAG_PREMULTI_ALPHA
    * 预乘alpha。
    */
-  BITMAP_FLAG_PREMULTI_ALPHA = 16
+  BITMAP_FLAG_PREMULTI_ALPHA = 16,
+  /**
+   * @const BITMAP_FLAG_SMOOTH
+   * 缩放时使用双线性插值(效果更平滑)，否则使用最近邻插值(速度更快)。
+   * 可以设置在源图片上，也可以由lcd在每次绘制时设置在目标图片上(参考canvas\_set\_image\_smooth)。
+   */
+  BITMAP_FLAG_SMOOTH = 32
 } bitmap_flag_t;
 
 /**
@@ -214,6 +214,12 @@ ret_t canvas_set_global_alpha(canvas_t* c, uint8_t alpha) {
   return RET_OK;
 }
 
+ret_t canvas_set_image_smooth(canvas_t* c, bool_t smooth) {
+  return_value_if_fail(c != NULL, RET_BAD_PARAMS);
+
+  return lcd_set_image_smooth(c->lcd, smooth);
+}
+
 ret_t canvas_set_font(canvas_t* c, const char* name, font_size_t size) {
   return_value_if_fail(c != NULL && c->lcd != NULL, RET_BAD_PARAMS);
 
@@ -282,15 +288,8 @@ float_t canvas_measure_utf8(canvas_t* c, const char* str) {
   return ret;
 }
 
-ret_t canvas_begin_frame(canvas_t* c, rect_t* dirty_rect, lcd_draw_mode_t draw_mode) {
-  ret_t ret = RET_OK;
-  return_value_if_fail(c != NULL, RET_BAD_PARAMS);
-
-  c->ox = 0;
-  c->oy = 0;
-
-  canvas_set_global_alpha(c, 0xff);
-  ret = lcd_begin_frame(c->lcd, dirty_rect, draw_mode);
+static ret_t canvas_set_dirty_clip_rect(canvas_t* c, rect_t* dirty_rect,
+                                        lcd_draw_mode_t draw_mode) {
   if (c->lcd->support_dirty_rect && dirty_rect != NULL) {
     if (draw_mode == LCD_DRAW_NORMAL && c->lcd->type == LCD_VGCANVAS) {
       rect_t r = *dirty_rect;
@@ -309,9 +308,46 @@ ret_t canvas_begin_frame(canvas_t* c, rect_t* dirty_rect, lcd_draw_mode_t draw_m
     canvas_set_clip_rect(c, NULL);
   }
 
+  return RET_OK;
+}
+
+ret_t canvas_begin_frame(canvas_t* c, rect_t* dirty_rect, lcd_draw_mode_t draw_mode) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(c != NULL, RET_BAD_PARAMS);
+
+  c->ox = 0;
+  c->oy = 0;
+
+  canvas_set_global_alpha(c, 0xff);
+  canvas_set_image_smooth(c, FALSE);
+  ret = lcd_begin_frame(c->lcd, dirty_rect, draw_mode);
+  canvas_set_dirty_clip_rect(c, dirty_rect, draw_mode);
+
+  return ret;
+}
+
+ret_t canvas_begin_frame_rects(canvas_t* c, const dirty_rects_t* dirty_rects,
+                               lcd_draw_mode_t draw_mode) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(c != NULL && dirty_rects != NULL, RET_BAD_PARAMS);
+
+  c->ox = 0;
+  c->oy = 0;
+
+  canvas_set_global_alpha(c, 0xff);
+  canvas_set_image_smooth(c, FALSE);
+  ret = lcd_begin_frame_rects(c->lcd, dirty_rects, draw_mode);
+  canvas_set_dirty_clip_rect(c, &(c->lcd->dirty_rect), draw_mode);
+
   return ret;
 }
 
+ret_t canvas_set_dirty_rect(canvas_t* c, rect_t* dirty_rect) {
+  return_value_if_fail(c != NULL && dirty_rect != NULL, RET_BAD_PARAMS);
+
+  return canvas_set_dirty_clip_rect(c, dirty_rect, c->lcd->draw_mode);
+}
+
 static ret_t canvas_draw_hline_impl(canvas_t* c, xy_t x, xy_t y, wh_t w) {
   xy_t x2 = x + w - 1;
 
@@ -482,27 +518,34 @@ ret_t canvas_stroke_rect(canvas_t* c, xy_t x, xy_t y, wh_t w, wh_t h) {
   return canvas_stroke_rect_impl(c, c->ox + x, c->oy + y, w, h);
 }
 
-static ret_t canvas_draw_glyph(canvas_t* c, glyph_t* g, xy_t x, xy_t y) {
-  rect_t src;
-  rect_t dst;
+static bool_t canvas_clip_glyph(canvas_t* c, glyph_t* g, xy_t x, xy_t y,
+                                draw_glyph_info_t* info) {
   xy_t x2 = x + g->w - 1;
   xy_t y2 = y + g->h - 1;
 
   if (x > c->clip_right || x2 < c->clip_left || y > c->clip_bottom || y2 < c->clip_top) {
-    return RET_OK;
+    return FALSE;
   }
 
-  dst.x = tk_max(x, c->clip_left);
-  dst.y = tk_max(y, c->clip_top);
-  dst.w = tk_min(x2, c->clip_right) - dst.x + 1;
-  dst.h = tk_min(y2, c->clip_bottom) - dst.y + 1;
+  info->glyph = *g;
+  info->x = tk_max(x, c->clip_left);
+  info->y = tk_max(y, c->clip_top);
+  info->src.x = info->x - x;
+  info->src.y = info->y - y;
+  info->src.w = tk_min(x2, c->clip_right) - info->x + 1;
+  info->src.h = tk_min(y2, c->clip_bottom) - info->y + 1;
+
+  return TRUE;
+}
+
+static ret_t canvas_draw_glyph(canvas_t* c, glyph_t* g, xy_t x, xy_t y) {
+  draw_glyph_info_t info;
 
-  src.x = dst.x - x;
-  src.y = dst.y - y;
-  src.w = dst.w;
-  src.h = dst.h;
+  if (!canvas_clip_glyph(c, g, x, y, &info)) {
+    return RET_OK;
+  }
 
-  return lcd_draw_glyph(c->lcd, g, &src, dst.x, dst.y);
+  return lcd_draw_glyph(c->lcd, g, &(info.src), info.x, info.y);
 }
 
 static ret_t canvas_draw_char_impl(canvas_t* c, wchar_t chr, xy_t x, xy_t y) {
@@ -525,6 +568,8 @@ ret_t canvas_draw_char(canvas_t* c, wchar_t chr, xy_t x, xy_t y) {
 static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr, xy_t x, xy_t y) {
   glyph_t g;
   uint32_t i = 0;
+  uint32_t run_nr = 0;
+  draw_glyph_info_t run[TK_GLYPH_RUN_NR];
   xy_t left = x;
   uint32_t start_time = time_now_ms();
   font_size_t font_size = c->font_size;
@@ -542,17 +587,41 @@ static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr,
     } else if (chr == '\r') {
       y += font_size;
       x = left;
+    } else if (x - font_size > c->clip_right) {
+      /*本行剩下的字符都在裁剪区外(字模向左偏移不会超过字体大小)，不需要查找字模*/
+      continue;
     } else if (font_get_glyph(c->font, chr, c->font_size, &g) == RET_OK) {
       xy_t xx = x + g.x;
       xy_t yy = y + font_size + g.y;
 
-      canvas_draw_glyph(c, &g, xx, yy);
+      /*
+       * 字模的数据在glyph cache中，最近查找的TK_GLYPH_RUN_NR个不会被淘汰，所以可以攒起来批量绘制。
+       * 被裁剪掉的字模也会更新glyph cache，后面的查找可能淘汰run中的字模，所以先把run画出来。
+       */
+      if (canvas_clip_glyph(c, &g, xx, yy, run + run_nr)) {
+        run_nr++;
+        if (run_nr == TK_GLYPH_RUN_NR) {
+          lcd_draw_glyphs(c->lcd, run, run_nr);
+          run_nr = 0;
+        }
+      } else if (run_nr > 0) {
+        lcd_draw_glyphs(c->lcd, run, run_nr);
+        run_nr = 0;
+      }
       x += g.advance + 1;
     } else {
+      if (run_nr > 0) {
+        lcd_draw_glyphs(c->lcd, run, run_nr);
+        run_nr = 0;
+      }
       x += 4;
     }
   }
 
+  if (run_nr > 0) {
+    lcd_draw_glyphs(c->lcd, run, run_nr);
+  }
+
   y = time_now_ms() - start_time;
 
   return RET_OK;
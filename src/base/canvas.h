@@ -231,6 +231,19 @@ ret_t canvas_set_stroke_color_str(canvas_t* c, const char* color);
  */
 ret_t canvas_set_global_alpha(canvas_t* c, uint8_t alpha);
 
+/**
+ * @method canvas_set_image_smooth
+ * 设置缩放图片时是否使用双线性插值。
+ * 双线性插值的效果更平滑，最近邻插值的速度更快(缺省)。每帧开始时恢复为缺省值。
+ *
+ * @annotation ["scriptable"]
+ * @param {canvas_t*} c canvas对象。
+ * @param {bool_t} smooth 是否使用双线性插值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t canvas_set_image_smooth(canvas_t* c, bool_t smooth);
+
 /**
  * @method canvas_translate
  * 平移原点坐标。
@@ -528,6 +541,9 @@ ret_t canvas_set_fps(canvas_t* c, bool_t show_fps, uint32_t fps);
 ret_t canvas_set_font_manager(canvas_t* c, font_manager_t* font_manager);
 
 ret_t canvas_begin_frame(canvas_t* c, rect_t* dirty_rect, lcd_draw_mode_t draw_mode);
+ret_t canvas_begin_frame_rects(canvas_t* c, const dirty_rects_t* dirty_rects,
+                               lcd_draw_mode_t draw_mode);
+ret_t canvas_set_dirty_rect(canvas_t* c, rect_t* dirty_rect);
 ret_t canvas_end_frame(canvas_t* c);
 ret_t canvas_test_paint(canvas_t* c, bool_t pressed, xy_t x, xy_t y);
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "base/window_manager.h"
 #include "base/dialog_highlighter.h"
 
 dialog_highlighter_t* dialog_highlighter_create(const dialog_highlighter_vtable_t* vt) {
@@ -97,7 +98,7 @@ ret_t dialog_highlighter_destroy(dialog_highlighter_t* h) {
     vg = canvas_get_vgcanvas(h->canvas);
     vgcanvas_destroy_fbo(vg, &(h->fbo));
   } else {
-    bitmap_destroy(&(h->img));
+    window_manager_release_snapshot(window_manager(), &(h->img));
   }
 
   memset(h, 0x00, h->vt->size);
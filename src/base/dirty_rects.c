@@ -0,0 +1,153 @@
+﻿/**
+ * File:   dirty_rects.c
+ * Author: AWTK Develop Team
+ * Brief:  dirty rects
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "base/dirty_rects.h"
+
+static int32_t dirty_rects_area(const rect_t* r) {
+  return (int32_t)(r->w) * (int32_t)(r->h);
+}
+
+static bool_t dirty_rects_is_intersect(const rect_t* r1, const rect_t* r2) {
+  rect_t r = rect_intersect(r1, r2);
+
+  return r.w > 0 && r.h > 0;
+}
+
+/*合并后多绘制的像素数*/
+static int32_t dirty_rects_merge_cost(const rect_t* r1, const rect_t* r2) {
+  rect_t u = *r1;
+  rect_t i = rect_intersect(r1, r2);
+
+  rect_merge(&u, (rect_t*)r2);
+
+  return dirty_rects_area(&u) - dirty_rects_area(r1) - dirty_rects_area(r2) +
+         dirty_rects_area(&i);
+}
+
+static ret_t dirty_rects_remove(dirty_rects_t* dirty_rects, uint32_t index) {
+  dirty_rects->nr--;
+  if (index < dirty_rects->nr) {
+    dirty_rects->rects[index] = dirty_rects->rects[dirty_rects->nr];
+  }
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_init(dirty_rects_t* dirty_rects) {
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  memset(dirty_rects, 0x00, sizeof(dirty_rects_t));
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_reset(dirty_rects_t* dirty_rects) {
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  dirty_rects->nr = 0;
+  dirty_rects->max = rect_init(0, 0, 0, 0);
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r) {
+  uint32_t i = 0;
+  rect_t nr = {0};
+  bool_t merged = FALSE;
+  return_value_if_fail(dirty_rects != NULL && r != NULL, RET_BAD_PARAMS);
+
+  if (r->w <= 0 || r->h <= 0) {
+    return RET_OK;
+  }
+
+  nr = *r;
+  rect_merge(&(dirty_rects->max), &nr);
+
+  /*把相交或者合并代价较小的矩形并入新矩形，直到没有可以合并的为止*/
+  do {
+    merged = FALSE;
+    for (i = 0; i < dirty_rects->nr; i++) {
+      rect_t* iter = dirty_rects->rects + i;
+
+      if (dirty_rects_is_intersect(iter, &nr) ||
+          dirty_rects_merge_cost(iter, &nr) <= TK_DIRTY_RECT_MERGE_COST) {
+        rect_merge(&nr, iter);
+        dirty_rects_remove(dirty_rects, i);
+        merged = TRUE;
+        break;
+      }
+    }
+  } while (merged);
+
+  if (dirty_rects->nr < TK_MAX_DIRTY_RECT_NR) {
+    dirty_rects->rects[dirty_rects->nr++] = nr;
+  } else {
+    /*已满，并入合并代价最小的矩形*/
+    uint32_t best = 0;
+    int32_t best_cost = dirty_rects_merge_cost(dirty_rects->rects, &nr);
+
+    for (i = 1; i < dirty_rects->nr; i++) {
+      int32_t cost = dirty_rects_merge_cost(dirty_rects->rects + i, &nr);
+      if (cost < best_cost) {
+        best = i;
+        best_cost = cost;
+      }
+    }
+
+    rect_merge(&nr, dirty_rects->rects + best);
+    dirty_rects_remove(dirty_rects, best);
+
+    return dirty_rects_add(dirty_rects, &nr);
+  }
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_add_rects(dirty_rects_t* dirty_rects, const dirty_rects_t* other) {
+  uint32_t i = 0;
+  return_value_if_fail(dirty_rects != NULL && other != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < other->nr; i++) {
+    dirty_rects_add(dirty_rects, other->rects + i);
+  }
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_fix(dirty_rects_t* dirty_rects, wh_t max_w, wh_t max_h) {
+  uint32_t i = 0;
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  dirty_rects->max = rect_init(0, 0, 0, 0);
+  while (i < dirty_rects->nr) {
+    rect_t* iter = dirty_rects->rects + i;
+
+    rect_fix(iter, max_w, max_h);
+    if (iter->w > 0 && iter->h > 0) {
+      rect_merge(&(dirty_rects->max), iter);
+      i++;
+    } else {
+      dirty_rects_remove(dirty_rects, i);
+    }
+  }
+
+  return RET_OK;
+}
@@ -0,0 +1,129 @@
+﻿/**
+ * File:   dirty_rects.h
+ * Author: AWTK Develop Team
+ * Brief:  dirty rects
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_DIRTY_RECTS_H
+#define TK_DIRTY_RECTS_H
+
+#include "tkc/rect.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 最多记录的脏矩形个数，超过时按合并代价最小的原则合并。
+ * 定义为1时，退化为单个脏矩形。
+ */
+#ifndef TK_MAX_DIRTY_RECT_NR
+#define TK_MAX_DIRTY_RECT_NR 8
+#endif /*TK_MAX_DIRTY_RECT_NR*/
+
+/**
+ * 合并两个矩形时，如果多绘制的面积(像素数)不超过本值，则直接合并。
+ * 每多一个脏矩形，就需要多遍历一次控件树，小的脏矩形合并起来更划算。
+ */
+#ifndef TK_DIRTY_RECT_MERGE_COST
+#define TK_DIRTY_RECT_MERGE_COST 1024
+#endif /*TK_DIRTY_RECT_MERGE_COST*/
+
+/**
+ * @class dirty_rects_t
+ * 脏矩形列表。
+ *
+ * 记录多个互不相交的脏矩形，每个脏矩形独立绘制和刷新到屏幕。
+ * 个数达到上限后，把新矩形合并到代价(新增面积)最小的矩形中。
+ */
+typedef struct _dirty_rects_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 脏矩形的个数。
+   */
+  uint32_t nr;
+
+  /**
+   * @property {rect_t} max
+   * @annotation ["readable"]
+   * 包含全部脏矩形的最小矩形。
+   */
+  rect_t max;
+
+  /**
+   * @property {rect_t*} rects
+   * @annotation ["readable"]
+   * 脏矩形。
+   */
+  rect_t rects[TK_MAX_DIRTY_RECT_NR];
+} dirty_rects_t;
+
+/**
+ * @method dirty_rects_init
+ * 初始化脏矩形列表。
+ * @param {dirty_rects_t*} dirty_rects 脏矩形列表。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_init(dirty_rects_t* dirty_rects);
+
+/**
+ * @method dirty_rects_reset
+ * 清除全部脏矩形。
+ * @param {dirty_rects_t*} dirty_rects 脏矩形列表。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_reset(dirty_rects_t* dirty_rects);
+
+/**
+ * @method dirty_rects_add
+ * 增加脏矩形。
+ *
+ * > 与已有矩形相交或者合并代价较小时，会与已有矩形合并，保证列表中的矩形互不相交。
+ *
+ * @param {dirty_rects_t*} dirty_rects 脏矩形列表。
+ * @param {const rect_t*} r 脏矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r);
+
+/**
+ * @method dirty_rects_add_rects
+ * 把另外一个脏矩形列表中的矩形全部加入进来。
+ * @param {dirty_rects_t*} dirty_rects 脏矩形列表。
+ * @param {const dirty_rects_t*} other 另外一个脏矩形列表。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_add_rects(dirty_rects_t* dirty_rects, const dirty_rects_t* other);
+
+/**
+ * @method dirty_rects_fix
+ * 把脏矩形限制在指定的范围内，并去掉为空的矩形。
+ * @param {dirty_rects_t*} dirty_rects 脏矩形列表。
+ * @param {wh_t} max_w 最大宽度。
+ * @param {wh_t} max_h 最大高度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_fix(dirty_rects_t* dirty_rects, wh_t max_w, wh_t max_h);
+
+END_C_DECLS
+
+#endif /*TK_DIRTY_RECTS_H*/
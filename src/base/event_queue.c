@@ -20,6 +20,9 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/mutex.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
 #include "base/event_queue.h"
 
 event_queue_t* event_queue_create(uint16_t capacity) {
@@ -90,3 +93,259 @@ ret_t event_queue_destroy(event_queue_t* q) {
 
   return RET_OK;
 }
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EVENT_QUEUE_LOCK_FREE 1
+#define mpsc_load(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define mpsc_store(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define mpsc_cas(p, expected, v) \
+  __atomic_compare_exchange_n(p, expected, v, TRUE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#define mpsc_inc(p) __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#include <windows.h>
+#define EVENT_QUEUE_LOCK_FREE 1
+static uint32_t mpsc_load(uint32_t* p) {
+  uint32_t v = *(volatile uint32_t*)p;
+  MemoryBarrier();
+
+  return v;
+}
+#define mpsc_store(p, v) (MemoryBarrier(), *(volatile uint32_t*)(p) = (v))
+static bool_t mpsc_cas(uint32_t* p, uint32_t* expected, uint32_t v) {
+  uint32_t old = (uint32_t)InterlockedCompareExchange((volatile LONG*)p, (LONG)v, (LONG)*expected);
+
+  if (old == *expected) {
+    return TRUE;
+  }
+  *expected = old;
+
+  return FALSE;
+}
+#define mpsc_inc(p) InterlockedIncrement((volatile LONG*)(p))
+#else
+/*
+ * 不支持原子操作的编译器：生产者和消费者的所有操作都在互斥锁内进行，
+ * 加锁和解锁同时起到内存屏障的作用，下面只是普通的读写。
+ */
+#define mpsc_load(p) (*(p))
+#define mpsc_store(p, v) (*(p) = (v))
+static bool_t mpsc_cas(uint32_t* p, uint32_t* expected, uint32_t v) {
+  if (*p == *expected) {
+    *p = v;
+    return TRUE;
+  }
+  *expected = *p;
+
+  return FALSE;
+}
+#define mpsc_inc(p) ((*(p))++)
+#endif /*__GNUC__*/
+
+#ifdef EVENT_QUEUE_LOCK_FREE
+#define mpsc_lock(q)
+#define mpsc_unlock(q)
+#else
+#define mpsc_lock(q) tk_mutex_lock((tk_mutex_t*)((q)->mutex))
+#define mpsc_unlock(q) tk_mutex_unlock((tk_mutex_t*)((q)->mutex))
+#endif /*EVENT_QUEUE_LOCK_FREE*/
+
+event_queue_drop_type_t event_queue_drop_type_of(uint32_t event_type) {
+  switch (event_type) {
+    case EVT_POINTER_DOWN:
+    case EVT_POINTER_MOVE:
+    case EVT_POINTER_UP:
+      return EVENT_QUEUE_DROP_POINTER;
+    case EVT_KEY_DOWN:
+    case EVT_KEY_UP:
+      return EVENT_QUEUE_DROP_KEY;
+    case REQ_ADD_IDLE:
+      return EVENT_QUEUE_DROP_IDLE;
+    case REQ_ADD_TIMER:
+      return EVENT_QUEUE_DROP_TIMER;
+    default:
+      return EVENT_QUEUE_DROP_OTHER;
+  }
+}
+
+event_queue_mpsc_t* event_queue_mpsc_create(uint32_t capacity) {
+  uint32_t i = 0;
+  uint32_t nr = 2;
+  event_queue_mpsc_t* q = NULL;
+  return_value_if_fail(capacity > 1 && capacity <= 0x10000, NULL);
+
+  while (nr < capacity) {
+    nr = nr << 1;
+  }
+
+  q = TKMEM_ZALLOC(event_queue_mpsc_t);
+  return_value_if_fail(q != NULL, NULL);
+
+  q->cells = TKMEM_ZALLOCN(event_queue_cell_t, nr);
+  if (q->cells == NULL) {
+    TKMEM_FREE(q);
+    return NULL;
+  }
+
+#ifndef EVENT_QUEUE_LOCK_FREE
+  q->mutex = tk_mutex_create();
+  if (q->mutex == NULL) {
+    TKMEM_FREE(q->cells);
+    TKMEM_FREE(q);
+    return NULL;
+  }
+#endif /*EVENT_QUEUE_LOCK_FREE*/
+
+  /*单元i的序号为i表示可写，为i+1表示可读*/
+  for (i = 0; i < nr; i++) {
+    q->cells[i].seq = i;
+  }
+  q->capacity = nr;
+
+  return q;
+}
+
+ret_t event_queue_mpsc_set_wakeup(event_queue_mpsc_t* q, event_queue_wakeup_t wakeup, void* ctx) {
+  return_value_if_fail(q != NULL, RET_BAD_PARAMS);
+
+  q->wakeup = wakeup;
+  q->wakeup_ctx = ctx;
+
+  return RET_OK;
+}
+
+static ret_t event_queue_mpsc_try_send(event_queue_mpsc_t* q, const event_queue_req_t* r) {
+  event_queue_cell_t* cell = NULL;
+  uint32_t mask = q->capacity - 1;
+  uint32_t pos = mpsc_load(&(q->tail));
+
+  for (;;) {
+    int32_t dif = 0;
+
+    cell = q->cells + (pos & mask);
+    dif = (int32_t)(mpsc_load(&(cell->seq)) - pos);
+
+    if (dif == 0) {
+      if (mpsc_cas(&(q->tail), &pos, pos + 1)) {
+        break;
+      }
+    } else if (dif < 0) {
+      return RET_FAIL;
+    } else {
+      pos = mpsc_load(&(q->tail));
+    }
+  }
+
+  memcpy(&(cell->req), r, sizeof(*r));
+  mpsc_store(&(cell->seq), pos + 1);
+
+  return RET_OK;
+}
+
+static ret_t event_queue_mpsc_send_impl(event_queue_mpsc_t* q, const event_queue_req_t* r) {
+  ret_t ret = RET_OK;
+
+  mpsc_lock(q);
+  ret = event_queue_mpsc_try_send(q, r);
+  mpsc_unlock(q);
+
+  if (ret == RET_OK && q->wakeup != NULL) {
+    q->wakeup(q->wakeup_ctx);
+  }
+
+  return ret;
+}
+
+ret_t event_queue_mpsc_send(event_queue_mpsc_t* q, const event_queue_req_t* r) {
+  return event_queue_mpsc_send_timeout(q, r, 0);
+}
+
+ret_t event_queue_mpsc_send_timeout(event_queue_mpsc_t* q, const event_queue_req_t* r,
+                                    uint32_t timeout_ms) {
+  uint32_t start = 0;
+  return_value_if_fail(q != NULL && r != NULL, RET_BAD_PARAMS);
+
+  if (event_queue_mpsc_send_impl(q, r) == RET_OK) {
+    return RET_OK;
+  }
+
+  start = time_now_ms();
+  while ((time_now_ms() - start) < timeout_ms) {
+    if (q->wakeup != NULL) {
+      q->wakeup(q->wakeup_ctx);
+    }
+
+    sleep_ms(1);
+    if (event_queue_mpsc_send_impl(q, r) == RET_OK) {
+      return RET_OK;
+    }
+  }
+
+  mpsc_lock(q);
+  mpsc_inc(q->dropped + event_queue_drop_type_of(r->event.type));
+  mpsc_unlock(q);
+
+  return RET_FAIL;
+}
+
+static ret_t event_queue_mpsc_peek_impl(event_queue_mpsc_t* q, event_queue_req_t* r) {
+  event_queue_cell_t* cell = q->cells + (q->head & (q->capacity - 1));
+
+  if (mpsc_load(&(cell->seq)) != q->head + 1) {
+    return RET_FAIL;
+  }
+
+  memcpy(r, &(cell->req), sizeof(*r));
+
+  return RET_OK;
+}
+
+ret_t event_queue_mpsc_peek(event_queue_mpsc_t* q, event_queue_req_t* r) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(q != NULL && r != NULL, RET_BAD_PARAMS);
+
+  mpsc_lock(q);
+  ret = event_queue_mpsc_peek_impl(q, r);
+  mpsc_unlock(q);
+
+  return ret;
+}
+
+ret_t event_queue_mpsc_recv(event_queue_mpsc_t* q, event_queue_req_t* r) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(q != NULL && r != NULL, RET_BAD_PARAMS);
+
+  mpsc_lock(q);
+  ret = event_queue_mpsc_peek_impl(q, r);
+  if (ret == RET_OK) {
+    event_queue_cell_t* cell = q->cells + (q->head & (q->capacity - 1));
+
+    mpsc_store(&(cell->seq), q->head + q->capacity);
+    q->head++;
+  }
+  mpsc_unlock(q);
+
+  return ret;
+}
+
+uint32_t event_queue_mpsc_get_dropped(event_queue_mpsc_t* q, event_queue_drop_type_t type) {
+  uint32_t dropped = 0;
+  return_value_if_fail(q != NULL && (uint32_t)type < EVENT_QUEUE_DROP_NR, 0);
+
+  mpsc_lock(q);
+  dropped = mpsc_load(q->dropped + type);
+  mpsc_unlock(q);
+
+  return dropped;
+}
+
+ret_t event_queue_mpsc_destroy(event_queue_mpsc_t* q) {
+  return_value_if_fail(q != NULL, RET_BAD_PARAMS);
+
+#ifndef EVENT_QUEUE_LOCK_FREE
+  tk_mutex_destroy((tk_mutex_t*)(q->mutex));
+#endif /*EVENT_QUEUE_LOCK_FREE*/
+  TKMEM_FREE(q->cells);
+  TKMEM_FREE(q);
+
+  return RET_OK;
+}
@@ -63,6 +63,61 @@ ret_t event_queue_send(event_queue_t* q, const event_queue_req_t* r);
 ret_t event_queue_replace_last(event_queue_t* q, const event_queue_req_t* r);
 ret_t event_queue_destroy(event_queue_t* q);
 
+/*
+ * 多生产者单消费者的无锁队列(有界)：
+ * 任意线程都可以调用event_queue_mpsc_send，只有GUI线程调用event_queue_mpsc_recv/peek。
+ * 每个单元有一个序号，生产者用CAS抢占写位置，写完后更新序号，消费者根据序号判断数据是否就绪。
+ * 编译器不支持原子操作时用互斥锁实现。
+ */
+
+/*丢弃的事件按类型分别计数*/
+typedef enum _event_queue_drop_type_t {
+  EVENT_QUEUE_DROP_POINTER = 0,
+  EVENT_QUEUE_DROP_KEY,
+  EVENT_QUEUE_DROP_IDLE,
+  EVENT_QUEUE_DROP_TIMER,
+  EVENT_QUEUE_DROP_OTHER,
+  EVENT_QUEUE_DROP_NR
+} event_queue_drop_type_t;
+
+/*发送成功后调用，用于唤醒在等待事件的GUI线程*/
+typedef ret_t (*event_queue_wakeup_t)(void* ctx);
+
+typedef struct _event_queue_cell_t {
+  uint32_t seq;
+  event_queue_req_t req;
+} event_queue_cell_t;
+
+typedef struct _event_queue_mpsc_t {
+  uint32_t capacity;
+  /*只有消费者访问*/
+  uint32_t head;
+  /*生产者共享(原子操作)*/
+  uint32_t tail;
+  uint32_t dropped[EVENT_QUEUE_DROP_NR];
+
+  event_queue_wakeup_t wakeup;
+  void* wakeup_ctx;
+
+  void* mutex;
+  event_queue_cell_t* cells;
+} event_queue_mpsc_t;
+
+/*capacity向上取整为2的幂*/
+event_queue_mpsc_t* event_queue_mpsc_create(uint32_t capacity);
+ret_t event_queue_mpsc_set_wakeup(event_queue_mpsc_t* q, event_queue_wakeup_t wakeup, void* ctx);
+/*队列满时返回RET_FAIL并计入丢弃的个数*/
+ret_t event_queue_mpsc_send(event_queue_mpsc_t* q, const event_queue_req_t* r);
+/*队列满时等待消费者取走事件，最多等待timeout_ms毫秒(不要在GUI线程中等待)*/
+ret_t event_queue_mpsc_send_timeout(event_queue_mpsc_t* q, const event_queue_req_t* r,
+                                    uint32_t timeout_ms);
+ret_t event_queue_mpsc_recv(event_queue_mpsc_t* q, event_queue_req_t* r);
+/*获取下一个事件但不从队列中取走*/
+ret_t event_queue_mpsc_peek(event_queue_mpsc_t* q, event_queue_req_t* r);
+uint32_t event_queue_mpsc_get_dropped(event_queue_mpsc_t* q, event_queue_drop_type_t type);
+event_queue_drop_type_t event_queue_drop_type_of(uint32_t event_type);
+ret_t event_queue_mpsc_destroy(event_queue_mpsc_t* q);
+
 END_C_DECLS
 
 #endif /*TK_EVENT_QUEUE_H*/
@@ -20,98 +20,411 @@
  */
 
 #include "tkc/mem.h"
-#include "tkc/time_now.h"
 #include "base/glyph_cache.h"
 
+#define GLYPH_CACHE_ITEM_MEM_SIZE(g) ((uint32_t)((g)->w) * (g)->h + sizeof(glyph_t))
+
+static uint32_t glyph_cache_hash(glyph_cache_t* cache, wchar_t code, font_size_t size) {
+  uint32_t h = ((uint32_t)code * 2654435761u) ^ ((uint32_t)size * 40503u);
+
+  return (h ^ (h >> 16)) & (cache->buckets_nr - 1);
+}
+
 glyph_cache_t* glyph_cache_init(glyph_cache_t* cache, uint32_t capacity,
                                 tk_destroy_t destroy_glyph) {
+  uint32_t buckets_nr = 16;
   return_value_if_fail(cache != NULL && capacity > 10, NULL);
 
+  memset(cache, 0x00, sizeof(glyph_cache_t));
+
+  /*负载因子不超过0.5*/
+  while (buckets_nr < capacity * 2) {
+    buckets_nr = buckets_nr << 1;
+  }
+
   cache->items = TKMEM_ZALLOCN(glyph_cache_item_t, capacity);
   return_value_if_fail(cache->items != NULL, NULL);
 
+  cache->buckets = TKMEM_ZALLOCN(glyph_cache_item_t*, buckets_nr);
+  if (cache->buckets == NULL) {
+    TKMEM_FREE(cache->items);
+    return NULL;
+  }
+
   cache->size = 0;
   cache->capacity = capacity;
+  cache->buckets_nr = buckets_nr;
   cache->destroy_glyph = destroy_glyph;
 
   return cache;
 }
 
-static glyph_cache_item_t* glyph_cache_get_empty(glyph_cache_t* cache) {
-  uint32_t i = 0;
-  uint32_t nr = 0;
-  uint32_t oldest = 0;
-  glyph_cache_item_t* item = NULL;
-  uint32_t oldest_time = 0xffffffff;
+ret_t glyph_cache_set_max_mem_size(glyph_cache_t* cache, uint32_t max_mem_size) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
-  return_value_if_fail(cache != NULL && cache->items != NULL, NULL);
+  cache->max_mem_size = max_mem_size;
+
+  return RET_OK;
+}
+
+ret_t glyph_cache_enable_atlas(glyph_cache_t* cache, uint32_t page_size, uint32_t pages_nr) {
+  return_value_if_fail(cache != NULL && cache->pages == NULL, RET_BAD_PARAMS);
+  return_value_if_fail(page_size > 0 && pages_nr > 0 && pages_nr < 0xffff, RET_BAD_PARAMS);
+
+  cache->pages = TKMEM_ZALLOCN(glyph_cache_page_t, pages_nr);
+  return_value_if_fail(cache->pages != NULL, RET_OOM);
+
+  cache->page_size = page_size;
+  cache->pages_nr = pages_nr;
+
+  return RET_OK;
+}
+
+/*和当前glyph一起批量绘制的前TK_GLYPH_RUN_NR-1个glyph，不能因为内存的原因被淘汰*/
+static bool_t glyph_cache_is_recent(glyph_cache_t* cache, uint32_t access) {
+  return access > 0 && (cache->clock - access) < (TK_GLYPH_RUN_NR - 1);
+}
+
+static ret_t glyph_cache_touch(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  item->access = ++cache->clock;
+
+  if (item->page > 0) {
+    cache->pages[item->page - 1].last_access = item->access;
+  }
+
+  return RET_OK;
+}
+
+static int32_t glyph_cache_find_slot(glyph_cache_t* cache, wchar_t code, font_size_t size) {
+  uint32_t mask = cache->buckets_nr - 1;
+  uint32_t i = glyph_cache_hash(cache, code, size);
+
+  while (cache->buckets[i] != NULL) {
+    glyph_cache_item_t* item = cache->buckets[i];
+    if (item->code == code && item->size == size) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return -1;
+}
+
+static ret_t glyph_cache_hash_insert(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  uint32_t mask = cache->buckets_nr - 1;
+  uint32_t i = glyph_cache_hash(cache, item->code, item->size);
 
-  if ((cache->size + 1) < cache->capacity) {
-    oldest = cache->size++;
-    return cache->items + oldest;
+  while (cache->buckets[i] != NULL) {
+    i = (i + 1) & mask;
   }
+  cache->buckets[i] = item;
+
+  return RET_OK;
+}
+
+/*线性探测的删除：把后面同一簇中的项往前移，不需要墓碑标记*/
+static ret_t glyph_cache_hash_remove(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  uint32_t j = 0;
+  uint32_t mask = cache->buckets_nr - 1;
+  int32_t i = glyph_cache_find_slot(cache, item->code, item->size);
+  return_value_if_fail(i >= 0, RET_NOT_FOUND);
 
-  for (i = 0, nr = cache->size; i < nr; i++) {
-    glyph_cache_item_t* item = cache->items + i;
-    if (item->last_access_time < oldest_time) {
-      oldest_time = item->last_access_time;
-      oldest = i;
+  cache->buckets[i] = NULL;
+  for (j = (i + 1) & mask; cache->buckets[j] != NULL; j = (j + 1) & mask) {
+    glyph_cache_item_t* iter = cache->buckets[j];
+    uint32_t k = glyph_cache_hash(cache, iter->code, iter->size);
+
+    if ((j > (uint32_t)i && (k <= (uint32_t)i || k > j)) ||
+        (j < (uint32_t)i && (k <= (uint32_t)i && k > j))) {
+      cache->buckets[i] = iter;
+      cache->buckets[j] = NULL;
+      i = j;
     }
   }
 
-  item = cache->items + oldest;
-  if (cache->destroy_glyph) {
+  return RET_OK;
+}
+
+static ret_t glyph_cache_lru_remove(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  if (item->prev != NULL) {
+    item->prev->next = item->next;
+  } else {
+    cache->head = item->next;
+  }
+
+  if (item->next != NULL) {
+    item->next->prev = item->prev;
+  } else {
+    cache->tail = item->prev;
+  }
+
+  item->prev = NULL;
+  item->next = NULL;
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_lru_push_front(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  item->prev = NULL;
+  item->next = cache->head;
+
+  if (cache->head != NULL) {
+    cache->head->prev = item;
+  } else {
+    cache->tail = item;
+  }
+  cache->head = item;
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_put_free(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  memset(item, 0x00, sizeof(glyph_cache_item_t));
+
+  item->next = cache->free_items;
+  cache->free_items = item;
+
+  return RET_OK;
+}
+
+static ret_t glyph_cache_evict(glyph_cache_t* cache, glyph_cache_item_t* item) {
+  glyph_cache_hash_remove(cache, item);
+  glyph_cache_lru_remove(cache, item);
+
+  if (item->page > 0) {
+    glyph_cache_page_t* page = cache->pages + item->page - 1;
+
+    page->glyphs_nr--;
+    if (page->glyphs_nr == 0) {
+      page->used = 0;
+    }
+  } else if (cache->destroy_glyph != NULL) {
     cache->destroy_glyph(item->g);
-    memset(item, 0x00, sizeof(glyph_cache_item_t));
+  }
+
+  cache->mem_size -= item->mem_size;
+  cache->evictions++;
+
+  return glyph_cache_put_free(cache, item);
+}
+
+static glyph_cache_item_t* glyph_cache_get_empty(glyph_cache_t* cache, uint32_t mem_size) {
+  glyph_cache_item_t* item = NULL;
+  return_value_if_fail(cache != NULL && cache->items != NULL, NULL);
+
+  /*个数已满，淘汰最久没有使用的*/
+  if (cache->free_items == NULL && cache->size >= cache->capacity) {
+    glyph_cache_evict(cache, cache->tail);
+  }
+
+  /*内存超过上限，淘汰最久没有使用的(不在atlas中的)glyph*/
+  if (cache->max_mem_size > 0) {
+    glyph_cache_item_t* iter = cache->tail;
+
+    while (iter != NULL && (cache->mem_size + mem_size) > cache->max_mem_size &&
+           !glyph_cache_is_recent(cache, iter->access)) {
+      glyph_cache_item_t* prev = iter->prev;
+
+      if (iter->page == 0) {
+        glyph_cache_evict(cache, iter);
+      }
+      iter = prev;
+    }
+  }
+
+  if (cache->free_items != NULL) {
+    item = cache->free_items;
+    cache->free_items = item->next;
+    item->next = NULL;
+  } else {
+    item = cache->items + cache->size++;
   }
 
   return item;
 }
 
+static ret_t glyph_cache_remove_key(glyph_cache_t* cache, wchar_t code, font_size_t size) {
+  int32_t slot = glyph_cache_find_slot(cache, code, size);
+
+  if (slot >= 0) {
+    glyph_cache_evict(cache, cache->buckets[slot]);
+    cache->evictions--;
+  }
+
+  return RET_OK;
+}
+
 ret_t glyph_cache_add(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
-  glyph_cache_item_t* item = glyph_cache_get_empty(cache);
-  return_value_if_fail(cache != NULL && g != NULL && item != NULL, RET_BAD_PARAMS);
+  uint32_t mem_size = 0;
+  glyph_cache_item_t* item = NULL;
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
+
+  glyph_cache_remove_key(cache, code, size);
+
+  mem_size = GLYPH_CACHE_ITEM_MEM_SIZE(g);
+  item = glyph_cache_get_empty(cache, mem_size);
+  return_value_if_fail(item != NULL, RET_OOM);
 
   item->g = g;
   item->size = size;
   item->code = code;
-  item->last_access_time = time_now_ms();
+  item->mem_size = mem_size;
+  cache->mem_size += mem_size;
+
+  glyph_cache_touch(cache, item);
+  glyph_cache_hash_insert(cache, item);
+  glyph_cache_lru_push_front(cache, item);
 
   return RET_OK;
 }
 
-ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
+static ret_t glyph_cache_recycle_page(glyph_cache_t* cache, uint32_t index) {
+  glyph_cache_item_t* iter = cache->tail;
+
+  while (iter != NULL && cache->pages[index].glyphs_nr > 0) {
+    glyph_cache_item_t* prev = iter->prev;
+
+    if (iter->page == index + 1) {
+      glyph_cache_evict(cache, iter);
+    }
+    iter = prev;
+  }
+
+  return RET_OK;
+}
+
+static uint8_t* glyph_cache_page_alloc(glyph_cache_t* cache, uint32_t size, uint16_t* page) {
   uint32_t i = 0;
-  uint32_t nr = 0;
+  int32_t empty = -1;
+  int32_t oldest = -1;
+  uint8_t* data = NULL;
+  glyph_cache_page_t* iter = NULL;
 
-  return_value_if_fail(cache != NULL && g != NULL, RET_BAD_PARAMS);
-  for (i = 0, nr = cache->size; i < nr; i++) {
-    glyph_cache_item_t* item = cache->items + i;
-    if (item->code == code && item->size == size) {
-      *g = *(item->g);
-      item->last_access_time = time_now_ms();
+  for (i = 0; i < cache->pages_nr; i++) {
+    iter = cache->pages + i;
 
-      return RET_OK;
+    if (iter->data == NULL) {
+      if (empty < 0) {
+        empty = i;
+      }
+    } else if ((cache->page_size - iter->used) >= size) {
+      break;
+    } else if (!glyph_cache_is_recent(cache, iter->last_access)) {
+      if (oldest < 0 || iter->last_access < cache->pages[oldest].last_access) {
+        oldest = i;
+      }
     }
   }
 
-  return RET_NOT_FOUND;
+  if (i < cache->pages_nr) {
+    iter = cache->pages + i;
+  } else if (empty >= 0 && (cache->max_mem_size == 0 ||
+                            (cache->mem_size + cache->page_size) <= cache->max_mem_size)) {
+    iter = cache->pages + empty;
+    iter->data = (uint8_t*)TKMEM_ALLOC(cache->page_size);
+    return_value_if_fail(iter->data != NULL, NULL);
+
+    iter->used = 0;
+    cache->mem_size += cache->page_size;
+  } else if (oldest >= 0) {
+    iter = cache->pages + oldest;
+    glyph_cache_recycle_page(cache, oldest);
+    iter->used = 0;
+  } else {
+    return NULL;
+  }
+
+  data = iter->data + iter->used;
+  iter->used += size;
+  iter->glyphs_nr++;
+  *page = (uint16_t)(iter - cache->pages) + 1;
+
+  return data;
+}
+
+glyph_t* glyph_cache_alloc(glyph_cache_t* cache, wchar_t code, font_size_t size, const glyph_t* g) {
+  uint8_t* data = NULL;
+  uint16_t page = 0;
+  uint32_t data_size = 0;
+  glyph_cache_item_t* item = NULL;
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, NULL);
+
+  data_size = (uint32_t)(g->w) * g->h;
+  if (cache->pages == NULL || data_size == 0 || data_size > cache->page_size) {
+    return NULL;
+  }
+
+  glyph_cache_remove_key(cache, code, size);
+  item = glyph_cache_get_empty(cache, 0);
+  return_value_if_fail(item != NULL, NULL);
+
+  data = glyph_cache_page_alloc(cache, data_size, &page);
+  if (data == NULL) {
+    glyph_cache_put_free(cache, item);
+    return NULL;
+  }
+
+  item->glyph = *g;
+  item->glyph.data = data;
+  item->g = &(item->glyph);
+  item->page = page;
+  item->size = size;
+  item->code = code;
+
+  glyph_cache_touch(cache, item);
+  glyph_cache_hash_insert(cache, item);
+  glyph_cache_lru_push_front(cache, item);
+
+  return item->g;
+}
+
+ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
+  int32_t slot = 0;
+  glyph_cache_item_t* item = NULL;
+  return_value_if_fail(cache != NULL && cache->buckets != NULL && g != NULL, RET_BAD_PARAMS);
+
+  slot = glyph_cache_find_slot(cache, code, size);
+  if (slot < 0) {
+    cache->misses++;
+    return RET_NOT_FOUND;
+  }
+
+  item = cache->buckets[slot];
+  if (cache->head != item) {
+    glyph_cache_lru_remove(cache, item);
+    glyph_cache_lru_push_front(cache, item);
+  }
+
+  glyph_cache_touch(cache, item);
+  *g = *(item->g);
+  cache->hits++;
+
+  return RET_OK;
 }
 
 ret_t glyph_cache_deinit(glyph_cache_t* cache) {
   uint32_t i = 0;
-  uint32_t nr = 0;
+  glyph_cache_item_t* iter = NULL;
 
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
   if (cache->destroy_glyph != NULL) {
-    for (i = 0, nr = cache->size; i < nr; i++) {
-      glyph_cache_item_t* item = cache->items + i;
-      cache->destroy_glyph(item->g);
+    for (iter = cache->head; iter != NULL; iter = iter->next) {
+      if (iter->page == 0) {
+        cache->destroy_glyph(iter->g);
+      }
+    }
+  }
+
+  if (cache->pages != NULL) {
+    for (i = 0; i < cache->pages_nr; i++) {
+      TKMEM_FREE(cache->pages[i].data);
     }
+    TKMEM_FREE(cache->pages);
   }
 
   TKMEM_FREE(cache->items);
+  TKMEM_FREE(cache->buckets);
   memset(cache, 0x00, sizeof(glyph_cache_t));
 
   return RET_OK;
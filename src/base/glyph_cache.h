@@ -27,21 +27,98 @@
 BEGIN_C_DECLS
 
 typedef struct _glyph_cache_item_t {
-  uint32_t last_access_time;
   font_size_t size;
   wchar_t code;
   glyph_t* g;
+  uint32_t mem_size;
+  uint32_t access;
+
+  /*字模数据在atlas中时，g指向glyph，page为页号+1*/
+  glyph_t glyph;
+  uint16_t page;
+
+  /*LRU链表(空闲时用next链接空闲项)*/
+  struct _glyph_cache_item_t* prev;
+  struct _glyph_cache_item_t* next;
 } glyph_cache_item_t;
 
+typedef struct _glyph_cache_page_t {
+  uint8_t* data;
+  uint32_t used;
+  uint32_t glyphs_nr;
+  uint32_t last_access;
+} glyph_cache_page_t;
+
+/**
+ * @class glyph_cache_t
+ * glyph缓存。
+ *
+ * 用(code, font_size)作为key的开放寻址hash表查找，用LRU链表淘汰，查找和淘汰都是O(1)。
+ * 除了限制缓存的个数外，还可以限制缓存占用的内存(字节数)。
+ *
+ * 启用atlas后，字模数据依次存放在若干个大的内存页中，避免为每个字符分配小块内存。
+ * 内存页用完时，回收最久没有使用的内存页。
+ *
+ * > 最近访问的TK\_GLYPH\_RUN\_NR个glyph不会因为内存的原因被淘汰，以便批量绘制文本。
+ */
 typedef struct _glyph_cache_t {
   uint32_t size;
   uint32_t capacity;
   glyph_cache_item_t* items;
   tk_destroy_t destroy_glyph;
+
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 当前缓存的glyph占用的内存(字节数)。
+   */
+  uint32_t mem_size;
+
+  /**
+   * @property {uint32_t} max_mem_size
+   * @annotation ["readable"]
+   * 缓存最多占用的内存(字节数)，为0表示不限制。
+   */
+  uint32_t max_mem_size;
+
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 命中的次数。
+   */
+  uint32_t hits;
+
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 未命中的次数。
+   */
+  uint32_t misses;
+
+  /**
+   * @property {uint32_t} evictions
+   * @annotation ["readable"]
+   * 被淘汰的glyph的个数。
+   */
+  uint32_t evictions;
+
+  /*private*/
+  uint32_t clock;
+  uint32_t page_size;
+  uint32_t pages_nr;
+  glyph_cache_page_t* pages;
+  uint32_t buckets_nr;
+  glyph_cache_item_t** buckets;
+  glyph_cache_item_t* head;
+  glyph_cache_item_t* tail;
+  glyph_cache_item_t* free_items;
 } glyph_cache_t;
 
 glyph_cache_t* glyph_cache_init(glyph_cache_t* cache, uint32_t capacity,
                                 tk_destroy_t destroy_glyph);
+ret_t glyph_cache_set_max_mem_size(glyph_cache_t* cache, uint32_t max_mem_size);
+ret_t glyph_cache_enable_atlas(glyph_cache_t* cache, uint32_t page_size, uint32_t pages_nr);
+glyph_t* glyph_cache_alloc(glyph_cache_t* cache, wchar_t code, font_size_t size, const glyph_t* g);
 ret_t glyph_cache_add(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g);
 ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g);
 ret_t glyph_cache_deinit(glyph_cache_t* cache);
@@ -31,6 +31,13 @@ typedef struct _bitmap_cache_t {
   uint32_t access_count;
   uint32_t created_time;
   uint32_t last_access_time;
+
+  image_manager_t* imm;
+  /*解码后的数据占用的内存，直接引用资源数据的为0*/
+  uint32_t mem_size;
+  /*最后访问时的帧序号和时钟*/
+  uint32_t frame;
+  uint32_t clock;
 } bitmap_cache_t;
 
 static int bitmap_cache_cmp_time(bitmap_cache_t* a, bitmap_cache_t* b) {
@@ -45,9 +52,127 @@ static int bitmap_cache_cmp_data(bitmap_cache_t* a, bitmap_cache_t* b) {
   return (char*)(a->image.data) - (char*)(b->image.data);
 }
 
+#define IMAGE_MANAGER_MIN_BUCKETS_NR 32
+
+static uint32_t image_manager_hash(image_manager_t* imm, const char* name) {
+  uint32_t h = 2166136261u;
+
+  while (*name) {
+    h = (h ^ (uint8_t)(*name++)) * 16777619u;
+  }
+
+  return h & (imm->buckets_nr - 1);
+}
+
+/*同名的图片只索引第一个，与线性查找的结果一致*/
+static ret_t image_manager_index_insert(image_manager_t* imm, bitmap_cache_t* cache) {
+  uint32_t mask = imm->buckets_nr - 1;
+  uint32_t i = image_manager_hash(imm, cache->name);
+  bitmap_cache_t** buckets = (bitmap_cache_t**)(imm->buckets);
+
+  while (buckets[i] != NULL) {
+    if (strcmp(buckets[i]->name, cache->name) == 0) {
+      return RET_FOUND;
+    }
+    i = (i + 1) & mask;
+  }
+  buckets[i] = cache;
+
+  return RET_OK;
+}
+
+static ret_t image_manager_index_rebuild(image_manager_t* imm) {
+  uint32_t i = 0;
+  uint32_t buckets_nr = IMAGE_MANAGER_MIN_BUCKETS_NR;
+
+  /*负载因子不超过0.5*/
+  while (buckets_nr < imm->images.size * 2) {
+    buckets_nr = buckets_nr << 1;
+  }
+
+  if (buckets_nr != imm->buckets_nr) {
+    TKMEM_FREE(imm->buckets);
+    imm->buckets_nr = 0;
+    imm->buckets = (void**)TKMEM_ZALLOCN(bitmap_cache_t*, buckets_nr);
+    return_value_if_fail(imm->buckets != NULL, RET_OOM);
+    imm->buckets_nr = buckets_nr;
+  } else {
+    memset(imm->buckets, 0x00, buckets_nr * sizeof(bitmap_cache_t*));
+  }
+
+  for (i = 0; i < imm->images.size; i++) {
+    image_manager_index_insert(imm, (bitmap_cache_t*)(imm->images.elms[i]));
+  }
+  imm->index_dirty = FALSE;
+
+  return RET_OK;
+}
+
+static bitmap_cache_t* image_manager_find(image_manager_t* imm, const char* name) {
+  uint32_t i = 0;
+  uint32_t mask = 0;
+  bitmap_cache_t** buckets = NULL;
+
+  if (imm->index_dirty || imm->buckets == NULL) {
+    if (image_manager_index_rebuild(imm) != RET_OK) {
+      bitmap_cache_t info;
+
+      memset(&info, 0x00, sizeof(info));
+      info.name = (char*)name;
+      imm->images.compare = (tk_compare_t)bitmap_cache_cmp_name;
+
+      return (bitmap_cache_t*)darray_find(&(imm->images), &info);
+    }
+  }
+
+  mask = imm->buckets_nr - 1;
+  i = image_manager_hash(imm, name);
+  buckets = (bitmap_cache_t**)(imm->buckets);
+  while (buckets[i] != NULL) {
+    if (strcmp(buckets[i]->name, name) == 0) {
+      return buckets[i];
+    }
+    i = (i + 1) & mask;
+  }
+
+  return NULL;
+}
+
+/*删除了图片，索引和已有的image_handle_t都失效*/
+static ret_t image_manager_invalidate(image_manager_t* imm) {
+  imm->generation++;
+  imm->index_dirty = TRUE;
+
+  return RET_OK;
+}
+
+static uint32_t image_manager_get_generation(image_manager_t* imm) {
+  uint32_t generation = imm->generation;
+
+  if (imm->assets_manager != NULL) {
+    generation += imm->assets_manager->generation;
+  }
+
+  return generation;
+}
+
+static ret_t image_manager_touch(image_manager_t* imm, bitmap_cache_t* cache) {
+  cache->access_count++;
+  cache->frame = imm->frame;
+  cache->clock = ++imm->clock;
+  cache->last_access_time = time_now_s();
+
+  return RET_OK;
+}
+
 static ret_t bitmap_cache_destroy(bitmap_cache_t* cache) {
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
+  if (cache->imm != NULL) {
+    cache->imm->stats.nr--;
+    cache->imm->stats.mem_size -= cache->mem_size;
+  }
+
   bitmap_destroy(&(cache->image));
   TKMEM_FREE(cache->name);
   TKMEM_FREE(cache);
@@ -78,10 +203,57 @@ image_manager_t* image_manager_init(image_manager_t* imm) {
 
   darray_init(&(imm->images), 0, (tk_destroy_t)bitmap_cache_destroy, NULL);
   imm->assets_manager = assets_manager();
+  imm->buckets = NULL;
+  imm->buckets_nr = 0;
+  imm->generation = 1;
+  imm->index_dirty = TRUE;
+  imm->frame = 0;
+  imm->clock = 0;
+  imm->max_mem_size = TK_IMAGE_MANAGER_MEM_SIZE;
+  memset(&(imm->stats), 0x00, sizeof(imm->stats));
 
   return imm;
 }
 
+/*当前帧用到的图片不能淘汰，没有调用image_manager_begin_frame时只保护最后加载的图片*/
+static bool_t image_manager_is_in_use(image_manager_t* imm, bitmap_cache_t* cache) {
+  if (imm->frame != 0) {
+    return cache->frame == imm->frame;
+  }
+
+  return cache->clock == imm->clock;
+}
+
+static ret_t image_manager_shrink(image_manager_t* imm) {
+  while (imm->max_mem_size > 0 && imm->stats.mem_size > imm->max_mem_size) {
+    uint32_t i = 0;
+    int32_t victim = -1;
+    uint32_t min_age = 0;
+
+    for (i = 0; i < imm->images.size; i++) {
+      bitmap_cache_t* iter = (bitmap_cache_t*)(imm->images.elms[i]);
+
+      if (iter->mem_size > 0 && !image_manager_is_in_use(imm, iter)) {
+        uint32_t age = imm->clock - iter->clock;
+        if (victim < 0 || age > min_age) {
+          victim = i;
+          min_age = age;
+        }
+      }
+    }
+
+    if (victim < 0) {
+      break;
+    }
+
+    image_manager_invalidate(imm);
+    darray_remove_index(&(imm->images), victim);
+    imm->stats.evictions++;
+  }
+
+  return RET_OK;
+}
+
 ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t* image) {
   bitmap_cache_t* cache = NULL;
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
@@ -96,32 +268,53 @@ ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t*
   cache->name = tk_strdup(name);
   cache->image.name = cache->name;
   cache->last_access_time = cache->created_time;
+  cache->frame = imm->frame;
+  cache->clock = ++imm->clock;
+  if (image->should_free_data) {
+    cache->mem_size = bitmap_get_line_length(&(cache->image)) * image->h;
+  }
+
+  if (darray_push(&(imm->images), cache) != RET_OK) {
+    TKMEM_FREE(cache->name);
+    TKMEM_FREE(cache);
+    return RET_OOM;
+  }
+
+  cache->imm = imm;
+  imm->stats.nr++;
+  imm->stats.mem_size += cache->mem_size;
+
+  if (!imm->index_dirty && imm->buckets != NULL && imm->images.size * 2 <= imm->buckets_nr) {
+    image_manager_index_insert(imm, cache);
+  } else {
+    imm->index_dirty = TRUE;
+  }
+
+  return image_manager_shrink(imm);
+}
+
+static ret_t image_manager_copy_bitmap(image_manager_t* imm, bitmap_cache_t* cache,
+                                       bitmap_t* image) {
+  *image = cache->image;
+  image->destroy = NULL;
+  image->image_manager = imm;
+  image->specific_destroy = NULL;
+  image->should_free_data = FALSE;
 
-  return darray_push(&(imm->images), cache);
+  return RET_OK;
 }
 
 ret_t image_manager_lookup(image_manager_t* imm, const char* name, bitmap_t* image) {
-  bitmap_cache_t info;
   bitmap_cache_t* iter = NULL;
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
 
-  memset(&info, 0x00, sizeof(info));
-
-  info.name = (char*)name;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_name;
-  iter = darray_find(&(imm->images), &info);
+  iter = image_manager_find(imm, name);
 
   if (iter != NULL) {
-    *image = iter->image;
-    image->destroy = NULL;
-    image->image_manager = imm;
-    image->specific_destroy = NULL;
-    image->should_free_data = FALSE;
-
-    iter->access_count++;
-    iter->last_access_time = time_now_s();
+    imm->stats.hits++;
+    image_manager_touch(imm, iter);
 
-    return RET_OK;
+    return image_manager_copy_bitmap(imm, iter, image);
   }
 
   return RET_NOT_FOUND;
@@ -145,6 +338,7 @@ ret_t image_manager_update_specific(image_manager_t* imm, bitmap_t* image) {
     iter->image.specific = image->specific;
     iter->image.specific_ctx = image->specific_ctx;
     iter->image.specific_destroy = image->specific_destroy;
+    imm->generation++;
 
     return RET_OK;
   }
@@ -183,13 +377,23 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
 #endif
     return RET_OK;
   } else if (res->subtype != ASSET_TYPE_IMAGE_BSVG) {
+    bitmap_cache_t* iter = NULL;
+    uint32_t start = time_now_ms();
     ret_t ret = image_loader_load_image(res, image);
+
+    imm->stats.misses++;
+    imm->stats.decode_time += time_now_ms() - start;
     if (ret == RET_OK) {
       image_manager_add(imm, name, image);
       assets_manager_unref(imm->assets_manager, res);
     }
 
-    return image_manager_lookup(imm, name, image);
+    iter = image_manager_find(imm, name);
+    if (iter == NULL) {
+      return RET_NOT_FOUND;
+    }
+
+    return image_manager_copy_bitmap(imm, iter, image);
   } else {
     return RET_NOT_FOUND;
   }
@@ -246,21 +450,72 @@ ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t*
   }
 }
 
+static bool_t image_manager_is_plain_name(const char* name) {
+  return strlen(name) <= TK_NAME_LEN && strstr(name, TK_LOCALE_MAGIC) == NULL &&
+         strchr(name, '$') == NULL && strchr(name, ',') == NULL;
+}
+
+ret_t image_manager_get_bitmap_with_handle(image_manager_t* imm, const char* name,
+                                           image_handle_t* handle, bitmap_t* image) {
+  ret_t ret = RET_OK;
+  uint32_t generation = 0;
+  return_value_if_fail(imm != NULL && name != NULL && handle != NULL && image != NULL,
+                       RET_BAD_PARAMS);
+
+  generation = image_manager_get_generation(imm);
+  if (handle->imm == imm && handle->generation == generation && tk_str_eq(handle->name, name)) {
+    bitmap_cache_t* cache = (bitmap_cache_t*)(handle->cache);
+    if (cache != NULL) {
+      imm->stats.hits++;
+      image_manager_touch(imm, cache);
+    }
+    *image = handle->bitmap;
+
+    return RET_OK;
+  }
+
+  handle->generation = 0;
+  ret = image_manager_get_bitmap(imm, name, image);
+  if (ret == RET_OK && image_manager_is_plain_name(name)) {
+    handle->imm = imm;
+    handle->bitmap = *image;
+    handle->cache = image_manager_find(imm, name);
+    handle->generation = image_manager_get_generation(imm);
+    tk_strncpy(handle->name, name, TK_NAME_LEN);
+  }
+
+  return ret;
+}
+
 ret_t image_manager_set_assets_manager(image_manager_t* imm, assets_manager_t* am) {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
   imm->assets_manager = am;
+  image_manager_invalidate(imm);
 
   return RET_OK;
 }
 
+/*只有真的删除了图片时才让已有的image_handle_t失效*/
+static ret_t image_manager_remove_all(image_manager_t* imm, tk_compare_t cmp, void* ctx) {
+  ret_t ret = RET_OK;
+  uint32_t size = imm->images.size;
+
+  imm->images.compare = cmp;
+  ret = darray_remove_all(&(imm->images), ctx);
+  if (imm->images.size != size) {
+    image_manager_invalidate(imm);
+  }
+
+  return ret;
+}
+
 ret_t image_manager_unload_unused(image_manager_t* imm, uint32_t time_delta_s) {
   bitmap_cache_t b;
   b.last_access_time = time_now_s() - time_delta_s;
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_time;
-  return darray_remove_all(&(imm->images), &b);
+  return image_manager_remove_all(imm, (tk_compare_t)bitmap_cache_cmp_time, &b);
 }
 
 ret_t image_manager_unload_bitmap(image_manager_t* imm, bitmap_t* image) {
@@ -268,15 +523,44 @@ ret_t image_manager_unload_bitmap(image_manager_t* imm, bitmap_t* image) {
   return_value_if_fail(imm != NULL && image != NULL, RET_BAD_PARAMS);
 
   b.image.data = image->data;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_data;
 
-  return darray_remove_all(&(imm->images), &b);
+  return image_manager_remove_all(imm, (tk_compare_t)bitmap_cache_cmp_data, &b);
+}
+
+ret_t image_manager_set_max_mem_size(image_manager_t* imm, uint32_t max_mem_size) {
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->max_mem_size = max_mem_size;
+
+  return image_manager_shrink(imm);
+}
+
+ret_t image_manager_begin_frame(image_manager_t* imm) {
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->frame++;
+  if (imm->frame == 0) {
+    imm->frame = 1;
+  }
+
+  return RET_OK;
+}
+
+ret_t image_manager_get_stats(image_manager_t* imm, image_manager_stats_t* stats) {
+  return_value_if_fail(imm != NULL && stats != NULL, RET_BAD_PARAMS);
+
+  *stats = imm->stats;
+
+  return RET_OK;
 }
 
 ret_t image_manager_deinit(image_manager_t* imm) {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
   darray_deinit(&(imm->images));
+  image_manager_invalidate(imm);
+  TKMEM_FREE(imm->buckets);
+  imm->buckets_nr = 0;
 
   return RET_OK;
 }
@@ -39,6 +39,49 @@ typedef struct _bitmap_header_t {
   uint8_t data[4];
 } bitmap_header_t;
 
+/**
+ * @class image_manager_stats_t
+ * 图片缓存的统计信息。
+ */
+typedef struct _image_manager_stats_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 缓存的图片个数。
+   */
+  uint32_t nr;
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 解码后的图片占用的内存(字节数)。
+   */
+  uint32_t mem_size;
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 在缓存中找到的次数。
+   */
+  uint32_t hits;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 没有在缓存中找到，需要解码的次数。
+   */
+  uint32_t misses;
+  /**
+   * @property {uint32_t} evictions
+   * @annotation ["readable"]
+   * 因为超过内存上限而淘汰的图片个数。
+   */
+  uint32_t evictions;
+  /**
+   * @property {uint32_t} decode_time
+   * @annotation ["readable"]
+   * 解码图片花费的总时间(毫秒)。
+   */
+  uint32_t decode_time;
+} image_manager_stats_t;
+
 /**
  * @class image_manager_t
  * @annotation ["scriptable"]
@@ -58,8 +101,43 @@ struct _image_manager_t {
    * 资源管理器。
    */
   assets_manager_t* assets_manager;
+
+  /*private*/
+  /*按名称索引images的hash表(开放寻址)，删除图片后重建*/
+  void** buckets;
+  uint32_t buckets_nr;
+  bool_t index_dirty;
+  /*卸载图片或更新specific时增加，用于判断image_handle_t是否有效*/
+  uint32_t generation;
+
+  /*解码后的图片最多占用的内存，为0表示不限制*/
+  uint32_t max_mem_size;
+  /*当前帧的序号，当前帧用到的图片不会被淘汰*/
+  uint32_t frame;
+  /*每次访问图片时增加，用于LRU淘汰*/
+  uint32_t clock;
+  image_manager_stats_t stats;
 };
 
+/**
+ * @class image_handle_t
+ * 控件保存的图片句柄。
+ *
+ * 控件每次绘制时都要获取图片，把上次获取的结果保存在句柄中，图片没有被卸载且名称不变时直接使用，
+ * 不需要查找缓存。句柄不需要释放，初始化为0即可。
+ *
+ * > 包含本地化和表达式的图片名不会保存在句柄中。
+ */
+typedef struct _image_handle_t {
+  bitmap_t bitmap;
+
+  /*private*/
+  void* cache;
+  uint32_t generation;
+  image_manager_t* imm;
+  char name[TK_NAME_LEN + 1];
+} image_handle_t;
+
 /**
  * @method image_manager
  * 获取缺省的图片管理器。
@@ -111,6 +189,21 @@ image_manager_t* image_manager_init(image_manager_t* imm);
  */
 ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t* image);
 
+/**
+ * @method image_manager_get_bitmap_with_handle
+ * 获取指定的图片。
+ * 句柄有效时直接返回句柄中的图片，否则调用image\_manager\_get\_bitmap并更新句柄。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {char*} name 图片名称。
+ * @param {image_handle_t*} handle 图片句柄。
+ * @param {bitmap_t*} image 用于返回图片。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_get_bitmap_with_handle(image_manager_t* imm, const char* name,
+                                           image_handle_t* handle, bitmap_t* image);
+
 /**
  * @method image_manager_unload_unused
  * 从图片管理器中卸载指定时间内没有使用的图片。
@@ -160,6 +253,40 @@ ret_t image_manager_update_specific(image_manager_t* imm, bitmap_t* image);
  */
 ret_t image_manager_set_assets_manager(image_manager_t* imm, assets_manager_t* assets_manager);
 
+/**
+ * @method image_manager_set_max_mem_size
+ * 设置解码后的图片最多占用的内存。
+ * 超过上限时，在加载新图片时淘汰最久没有使用的图片(当前帧用到的图片除外)。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {uint32_t} max_mem_size 最多占用的内存(字节数)，为0表示不限制。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_set_max_mem_size(image_manager_t* imm, uint32_t max_mem_size);
+
+/**
+ * @method image_manager_begin_frame
+ * 开始绘制新的一帧(由窗口管理器调用)。
+ * 当前帧用到的图片不会被淘汰。没有调用本函数时，只保护刚加载的图片。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_begin_frame(image_manager_t* imm);
+
+/**
+ * @method image_manager_get_stats
+ * 获取图片缓存的统计信息(可用于诊断界面)。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {image_manager_stats_t*} stats 返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_get_stats(image_manager_t* imm, image_manager_stats_t* stats);
+
 /**
  * @method image_manager_deinit
  * 析构图片管理器。
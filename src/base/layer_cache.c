@@ -0,0 +1,337 @@
+/**
+ * File:   layer_cache.c
+ * Author: AWTK Develop Team
+ * Brief:  retained layer cache of widget subtrees.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/darray.h"
+#include "base/layer_cache.h"
+
+typedef struct _layer_t {
+  widget_t* widget;
+  bitmap_t img;
+  bool_t valid;
+  uint32_t mem_size;
+  uint32_t last_used;
+} layer_t;
+
+static darray_t* s_layers = NULL;
+static uint32_t s_mem_size = 0;
+static uint32_t s_max_mem_size = TK_LAYER_CACHE_MEM_SIZE;
+static uint32_t s_stamp = 0;
+static uint32_t s_hits = 0;
+
+static ret_t layer_unload(layer_t* layer) {
+  if (layer->img.data != NULL) {
+    bitmap_destroy(&(layer->img));
+    memset(&(layer->img), 0x00, sizeof(bitmap_t));
+  }
+
+  s_mem_size -= layer->mem_size;
+  layer->mem_size = 0;
+  layer->valid = FALSE;
+
+  return RET_OK;
+}
+
+static ret_t layer_destroy(layer_t* layer) {
+  layer_unload(layer);
+  TKMEM_FREE(layer);
+
+  return RET_OK;
+}
+
+static int layer_compare_widget(const void* a, const void* b) {
+  const layer_t* layer = (const layer_t*)a;
+
+  return layer->widget == (const widget_t*)b ? 0 : 1;
+}
+
+static layer_t* layer_find(widget_t* widget) {
+  if (s_layers == NULL || widget == NULL) {
+    return NULL;
+  }
+
+  return (layer_t*)darray_find(s_layers, widget);
+}
+
+static ret_t layer_cache_shrink(uint32_t need_size, layer_t* keep) {
+  while (s_max_mem_size > 0 && s_mem_size + need_size > s_max_mem_size) {
+    uint32_t i = 0;
+    layer_t* lru = NULL;
+
+    for (i = 0; i < s_layers->size; i++) {
+      layer_t* iter = (layer_t*)(s_layers->elms[i]);
+      if (iter != keep && iter->img.data != NULL) {
+        if (lru == NULL || iter->last_used < lru->last_used) {
+          lru = iter;
+        }
+      }
+    }
+
+    if (lru == NULL) {
+      break;
+    }
+
+    layer_unload(lru);
+  }
+
+  return RET_OK;
+}
+
+static ret_t layer_cache_get_rect(widget_t* widget, rect_t* r) {
+  r->x = widget->x;
+  r->y = widget->y;
+  r->w = widget->w;
+  r->h = widget->h;
+
+  if (widget->astyle != NULL) {
+    r->x += style_get_int_by_id(widget->astyle, STYLE_PROP_X_OFFSET, 0);
+    r->y += style_get_int_by_id(widget->astyle, STYLE_PROP_Y_OFFSET, 0);
+  }
+
+  return RET_OK;
+}
+
+/*只有在本次绘制的区域内，framebuffer中的内容才是刚刚绘制的*/
+static bool_t layer_cache_is_painted(canvas_t* c, rect_t* r) {
+  uint32_t i = 0;
+  lcd_t* lcd = c->lcd;
+  xy_t right = r->x + r->w - 1;
+  xy_t bottom = r->y + r->h - 1;
+  const dirty_rects_t* dr = &(lcd->dirty_rects);
+
+  if (r->x < c->clip_left || r->y < c->clip_top || right > c->clip_right ||
+      bottom > c->clip_bottom) {
+    return FALSE;
+  }
+
+  if (dr->nr == 0) {
+    return TRUE;
+  }
+
+  for (i = 0; i < dr->nr; i++) {
+    const rect_t* iter = dr->rects + i;
+    if (r->x >= iter->x && r->y >= iter->y && right < (iter->x + iter->w) &&
+        bottom < (iter->y + iter->h)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/*
+ * 缓存是从framebuffer中读取的，只有控件完全覆盖所在的区域时，才不会把下面的内容也保存进去：
+ * 背景色不透明、没有圆角，控件和父控件都没有设置透明度。
+ */
+static bool_t layer_cache_is_opaque(widget_t* widget, canvas_t* c) {
+  color_t trans = color_init(0, 0, 0, 0);
+  style_t* style = widget->astyle;
+
+  if (style == NULL || widget->opacity < TK_OPACITY_ALPHA || c->global_alpha < TK_OPACITY_ALPHA) {
+    return FALSE;
+  }
+
+  if (style_get_color_by_id(style, STYLE_PROP_BG_COLOR, trans).rgba.a != 0xff) {
+    return FALSE;
+  }
+
+  return style_get_int_by_id(style, STYLE_PROP_ROUND_RADIUS, 0) == 0;
+}
+
+ret_t layer_cache_draw(widget_t* widget, canvas_t* c) {
+  rect_t s;
+  rect_t d;
+  uint8_t save_alpha = 0;
+  layer_t* layer = layer_find(widget);
+  return_value_if_fail(widget != NULL && c != NULL, RET_BAD_PARAMS);
+
+  if (layer == NULL || !layer->valid) {
+    return RET_NOT_FOUND;
+  }
+
+  layer_cache_get_rect(widget, &d);
+  if (layer->img.w != d.w || layer->img.h != d.h) {
+    layer->valid = FALSE;
+    return RET_NOT_FOUND;
+  }
+
+  /*只缓存不透明的控件，缓存中的内容就是控件绘制的结果，直接拷贝*/
+  s = rect_init(0, 0, d.w, d.h);
+  save_alpha = c->global_alpha;
+  canvas_set_global_alpha(c, 0xff);
+  canvas_draw_image(c, &(layer->img), &s, &d);
+  canvas_set_global_alpha(c, save_alpha);
+
+  layer->last_used = ++s_stamp;
+  s_hits++;
+
+  return RET_OK;
+}
+
+ret_t layer_cache_capture(widget_t* widget, canvas_t* c) {
+  rect_t r;
+  uint32_t size = 0;
+  layer_t* layer = NULL;
+  bitmap_format_t format = BITMAP_FMT_NONE;
+  return_value_if_fail(widget != NULL && c != NULL && c->lcd != NULL, RET_BAD_PARAMS);
+
+  if (c->lcd->read_rect == NULL || c->lcd->draw_mode != LCD_DRAW_NORMAL) {
+    return RET_NOT_IMPL;
+  }
+
+  if (!layer_cache_is_opaque(widget, c)) {
+    layer = layer_find(widget);
+    if (layer != NULL) {
+      layer_unload(layer);
+    }
+
+    return RET_NOT_IMPL;
+  }
+
+  layer_cache_get_rect(widget, &r);
+  r.x += c->ox;
+  r.y += c->oy;
+  if (r.w <= 0 || r.h <= 0 || !layer_cache_is_painted(c, &r)) {
+    return RET_FAIL;
+  }
+
+  format = lcd_get_desired_bitmap_format(c->lcd);
+  size = r.w * r.h * bitmap_get_bpp_of_format(format);
+  if (s_max_mem_size > 0 && size > s_max_mem_size) {
+    return RET_FAIL;
+  }
+
+  if (s_layers == NULL) {
+    s_layers = darray_create(4, (tk_destroy_t)layer_destroy, layer_compare_widget);
+    return_value_if_fail(s_layers != NULL, RET_OOM);
+  }
+
+  layer = layer_find(widget);
+  if (layer == NULL) {
+    layer = TKMEM_ZALLOC(layer_t);
+    return_value_if_fail(layer != NULL, RET_OOM);
+
+    layer->widget = widget;
+    if (darray_push(s_layers, layer) != RET_OK) {
+      TKMEM_FREE(layer);
+      return RET_OOM;
+    }
+  }
+
+  /*大小和格式不变时重用原来的缓冲区*/
+  if (layer->img.data != NULL &&
+      (layer->img.w != r.w || layer->img.h != r.h || layer->img.format != format)) {
+    layer_unload(layer);
+  }
+
+  if (layer->img.data == NULL) {
+    layer_cache_shrink(size, layer);
+  } else {
+    s_mem_size -= layer->mem_size;
+  }
+
+  layer->valid = FALSE;
+  layer->mem_size = 0;
+  if (lcd_read_rect(c->lcd, &r, &(layer->img)) != RET_OK) {
+    layer_unload(layer);
+    return RET_FAIL;
+  }
+
+  layer->valid = TRUE;
+  layer->mem_size = layer->img.line_length * layer->img.h;
+  layer->last_used = ++s_stamp;
+  s_mem_size += layer->mem_size;
+
+  return RET_OK;
+}
+
+ret_t layer_cache_invalidate(widget_t* widget) {
+  layer_t* layer = layer_find(widget);
+
+  if (layer != NULL) {
+    layer->valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t layer_cache_remove(widget_t* widget) {
+  layer_t* layer = layer_find(widget);
+
+  if (layer != NULL) {
+    darray_remove(s_layers, widget);
+  }
+
+  return RET_OK;
+}
+
+bool_t layer_cache_is_valid(widget_t* widget) {
+  layer_t* layer = layer_find(widget);
+
+  return layer != NULL && layer->valid;
+}
+
+uint32_t layer_cache_count(void) {
+  return s_layers != NULL ? s_layers->size : 0;
+}
+
+uint32_t layer_cache_get_hits(void) {
+  return s_hits;
+}
+
+ret_t layer_cache_set_max_mem_size(uint32_t max_mem_size) {
+  s_max_mem_size = max_mem_size;
+
+  if (s_layers != NULL) {
+    layer_cache_shrink(0, NULL);
+  }
+
+  return RET_OK;
+}
+
+uint32_t layer_cache_get_mem_size(void) {
+  return s_mem_size;
+}
+
+ret_t layer_cache_clear(void) {
+  uint32_t i = 0;
+
+  if (s_layers != NULL) {
+    for (i = 0; i < s_layers->size; i++) {
+      layer_unload((layer_t*)(s_layers->elms[i]));
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t layer_cache_deinit(void) {
+  if (s_layers != NULL) {
+    darray_destroy(s_layers);
+    s_layers = NULL;
+  }
+
+  s_mem_size = 0;
+  s_max_mem_size = TK_LAYER_CACHE_MEM_SIZE;
+  s_hits = 0;
+
+  return RET_OK;
+}
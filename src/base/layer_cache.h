@@ -0,0 +1,165 @@
+﻿/**
+ * File:   layer_cache.h
+ * Author: AWTK Develop Team
+ * Brief:  retained layer cache of widget subtrees.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_LAYER_CACHE_H
+#define TK_LAYER_CACHE_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class layer_cache_t
+ * @annotation ["fake"]
+ *
+ * 控件层缓存。
+ *
+ * 对于内容很少变化但绘制比较费时的控件(如复杂的背景、图表和静态的子控件树)，
+ * 可以设置cache\_layer属性，第一次完整绘制后，把控件所在区域的framebuffer内容保存到一张位图中(LCD格式)，
+ * 以后绘制时直接贴图，不再绘制控件及其子控件。
+ *
+ * 控件自身或任何子孙控件调用widget\_invalidate后，缓存自动失效，下次绘制时重新生成。
+ *
+ * 需要注意的是：
+ *
+ * * 只有framebuffer模式的LCD(支持lcd\_read\_rect)才支持。
+ * * 缓存是从framebuffer中读取的，所以只缓存完全不透明的控件：背景色(bg\_color)不透明、没有圆角(round\_radius)，
+ *   控件和父控件都没有设置透明度(opacity)。不满足条件的控件照常绘制，不缓存。
+ * * 超出控件范围的内容(如阴影)不会被缓存。
+ * * 缓存占用的内存超过上限时按LRU淘汰，超过上限的层不缓存。
+ *
+ * ```xml
+ * <view x="0" y="0" w="100%" h="100" cache_layer="true" style:normal:bg_color="#f0f0f0">
+ * ```
+ */
+
+/**
+ * @method layer_cache_draw
+ * 如果控件的缓存有效，用缓存绘制控件。
+ * @annotation ["static", "private"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {canvas_t*} c 画布对象。
+ *
+ * @return {ret_t} 返回RET_OK表示已经用缓存绘制，否则需要正常绘制。
+ */
+ret_t layer_cache_draw(widget_t* widget, canvas_t* c);
+
+/**
+ * @method layer_cache_capture
+ * 控件正常绘制完成后，保存控件所在区域的内容。
+ * 控件不是完全不透明，或者没有完整的在本次绘制的区域内时，不保存。
+ * @annotation ["static", "private"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {canvas_t*} c 画布对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_capture(widget_t* widget, canvas_t* c);
+
+/**
+ * @method layer_cache_invalidate
+ * 使控件的缓存失效(保留缓冲区，下次重用)。
+ * @annotation ["static", "private"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_invalidate(widget_t* widget);
+
+/**
+ * @method layer_cache_remove
+ * 删除控件的缓存并释放缓冲区。
+ * @annotation ["static", "private"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_remove(widget_t* widget);
+
+/**
+ * @method layer_cache_is_valid
+ * 检查控件的缓存是否有效。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {bool_t} 返回TRUE表示有效，否则表示无效。
+ */
+bool_t layer_cache_is_valid(widget_t* widget);
+
+/**
+ * @method layer_cache_count
+ * 获取缓存的个数(包括已经失效的)。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回缓存的个数。
+ */
+uint32_t layer_cache_count(void);
+
+/**
+ * @method layer_cache_get_hits
+ * 获取用缓存绘制的次数(用于性能分析)。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回用缓存绘制的次数。
+ */
+uint32_t layer_cache_get_hits(void);
+
+/**
+ * @method layer_cache_set_max_mem_size
+ * 设置缓存最多占用的内存，为0表示不限制。
+ * 缺省为TK\_LAYER\_CACHE\_MEM\_SIZE。
+ * @annotation ["static"]
+ * @param {uint32_t} max_mem_size 内存上限(字节数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_set_max_mem_size(uint32_t max_mem_size);
+
+/**
+ * @method layer_cache_get_mem_size
+ * 获取缓存占用的内存。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回内存大小(字节数)。
+ */
+uint32_t layer_cache_get_mem_size(void);
+
+/**
+ * @method layer_cache_clear
+ * 释放全部缓冲区(控件的cache\_layer属性不变，下次绘制时重新生成)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_clear(void);
+
+/**
+ * @method layer_cache_deinit
+ * 释放全部缓存。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t layer_cache_deinit(void);
+
+END_C_DECLS
+
+#endif /*TK_LAYER_CACHE_H*/
@@ -25,6 +25,8 @@
 #include "base/self_layouter_factory.h"
 #include "base/children_layouter_factory.h"
 
+static layout_stats_t s_layout_stats;
+
 ret_t widget_layout(widget_t* widget) {
   widget_layout_self(widget);
   widget_layout_children(widget);
@@ -39,6 +41,7 @@ ret_t widget_layout_self(widget_t* widget) {
   return_value_if_fail(widget != NULL && widget->parent != NULL, RET_BAD_PARAMS);
 
   parent = widget->parent;
+  s_layout_stats.self_layout_nr++;
   if (widget_get_prop(parent, WIDGET_PROP_LAYOUT_W, &v) == RET_OK) {
     r.w = value_int(&v);
   } else {
@@ -59,7 +62,8 @@ ret_t widget_layout_children_default(widget_t* widget) {
     return children_layouter_layout(widget->children_layout, widget);
   } else {
     WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
-    widget_layout(iter);
+    widget_layout_self(iter);
+    widget_layout_children_if_needed(iter);
     WIDGET_FOR_EACH_CHILD_END()
 
     return RET_OK;
@@ -69,7 +73,9 @@ ret_t widget_layout_children_default(widget_t* widget) {
 ret_t widget_layout_children(widget_t* widget) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
+  s_layout_stats.children_layout_nr++;
   widget->need_relayout_children = FALSE;
+  widget->need_relayout_descendants = FALSE;
   if (widget->vt->on_layout_children != NULL) {
     return widget->vt->on_layout_children(widget);
   } else {
@@ -77,11 +83,54 @@ ret_t widget_layout_children(widget_t* widget) {
   }
 }
 
+ret_t widget_layout_children_if_needed(widget_t* widget) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->need_relayout_children) {
+    if (widget->vt->on_layout_children == NULL &&
+        (widget->children == NULL || widget->children->size == 0)) {
+      widget->need_relayout_children = FALSE;
+      widget->need_relayout_descendants = FALSE;
+
+      return RET_OK;
+    }
+
+    return widget_layout_children(widget);
+  }
+
+  if (widget->need_relayout_descendants) {
+    widget->need_relayout_descendants = FALSE;
+
+    WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+    widget_layout_children_if_needed(iter);
+    WIDGET_FOR_EACH_CHILD_END()
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_layout_get_stats(layout_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_layout_stats;
+
+  return RET_OK;
+}
+
+ret_t widget_layout_reset_stats(void) {
+  memset(&s_layout_stats, 0x00, sizeof(s_layout_stats));
+
+  return RET_OK;
+}
+
 ret_t widget_set_self_layout(widget_t* widget, const char* params) {
   return_value_if_fail(widget != NULL && params != NULL, RET_BAD_PARAMS);
   self_layouter_destroy(widget->self_layout);
 
   widget->self_layout = self_layouter_create(params);
+  if (widget->parent != NULL && !widget_is_window_manager(widget->parent)) {
+    widget_set_need_relayout_children(widget->parent);
+  }
 
   return RET_OK;
 }
@@ -91,6 +140,7 @@ ret_t widget_set_children_layout(widget_t* widget, const char* params) {
   children_layouter_destroy(widget->children_layout);
 
   widget->children_layout = children_layouter_create(params);
+  widget_set_need_relayout_children(widget);
 
   return RET_OK;
 }
@@ -114,7 +164,8 @@ ret_t widget_layout_floating_children(widget_t* widget) {
     for (i = 0; i < n; i++) {
       widget_t* iter = children[i];
       if (iter->floating) {
-        widget_layout(iter);
+        widget_layout_self(iter);
+        widget_layout_children_if_needed(iter);
       }
     }
   }
@@ -27,10 +27,59 @@
 
 BEGIN_C_DECLS
 
+/**
+ * @class layout_stats_t
+ * layout的统计信息。
+ */
+typedef struct _layout_stats_t {
+  /**
+   * @property {uint32_t} children_layout_nr
+   * @annotation ["readable"]
+   * layout子控件的次数(widget\_layout\_children)。
+   */
+  uint32_t children_layout_nr;
+  /**
+   * @property {uint32_t} self_layout_nr
+   * @annotation ["readable"]
+   * 按self\_layout计算控件自身位置和大小的次数(widget\_layout\_self)。
+   */
+  uint32_t self_layout_nr;
+} layout_stats_t;
+
 ret_t widget_layout_self(widget_t* widget);
 ret_t widget_layout_children(widget_t* widget);
 ret_t widget_layout_children_default(widget_t* widget);
 
+/**
+ * @method widget_layout_children_if_needed
+ * 只layout需要重新layout的部分。
+ *
+ * 控件的need\_relayout\_children为TRUE时layout它的子控件，否则只检查子孙控件中需要重新layout的部分
+ * (need\_relayout\_descendants)。子控件的大小没有变化时，不会layout它的子控件。
+ *
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layout_children_if_needed(widget_t* widget);
+
+/**
+ * @method widget_layout_get_stats
+ * 获取layout的统计信息。
+ * @param {layout_stats_t*} stats 返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layout_get_stats(layout_stats_t* stats);
+
+/**
+ * @method widget_layout_reset_stats
+ * 清除layout的统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layout_reset_stats(void);
+
 ret_t widget_layout_floating_children(widget_t* widget);
 ret_t widget_get_children_for_layout(widget_t* widget, darray_t* result, bool_t keep_disable,
                                      bool_t keep_invisible);
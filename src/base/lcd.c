@@ -19,6 +19,7 @@
  *
  */
 
+#include "tkc/trace.h"
 #include "base/lcd.h"
 #include "base/system_info.h"
 
@@ -36,9 +37,30 @@ ret_t lcd_begin_frame(lcd_t* lcd, rect_t* dirty_rect, lcd_draw_mode_t draw_mode)
     rect_fix(&(lcd->dirty_rect), lcd->w, lcd->h);
   }
 
+  dirty_rects_reset(&(lcd->dirty_rects));
+  dirty_rects_add(&(lcd->dirty_rects), &(lcd->dirty_rect));
+
   return lcd->begin_frame(lcd, dirty_rect);
 }
 
+ret_t lcd_begin_frame_rects(lcd_t* lcd, const dirty_rects_t* dirty_rects,
+                            lcd_draw_mode_t draw_mode) {
+  rect_t r;
+  return_value_if_fail(lcd != NULL && lcd->begin_frame != NULL, RET_BAD_PARAMS);
+
+  if (dirty_rects == NULL) {
+    return lcd_begin_frame(lcd, NULL, draw_mode);
+  }
+
+  lcd->draw_mode = draw_mode;
+  lcd->dirty_rects = *dirty_rects;
+  dirty_rects_fix(&(lcd->dirty_rects), lcd->w, lcd->h);
+  lcd->dirty_rect = lcd->dirty_rects.max;
+  r = lcd->dirty_rect;
+
+  return lcd->begin_frame(lcd, &r);
+}
+
 ret_t lcd_set_clip_rect(lcd_t* lcd, rect_t* rect) {
   return_value_if_fail(lcd != NULL && lcd->set_clip_rect != NULL, RET_BAD_PARAMS);
 
@@ -62,6 +84,14 @@ ret_t lcd_set_global_alpha(lcd_t* lcd, uint8_t alpha) {
   return RET_OK;
 }
 
+ret_t lcd_set_image_smooth(lcd_t* lcd, bool_t smooth) {
+  return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
+
+  lcd->image_smooth = smooth;
+
+  return RET_OK;
+}
+
 ret_t lcd_set_text_color(lcd_t* lcd, color_t color) {
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
@@ -197,6 +227,22 @@ ret_t lcd_draw_glyph(lcd_t* lcd, glyph_t* glyph, rect_t* src, xy_t x, xy_t y) {
   return lcd->draw_glyph(lcd, glyph, src, x, y);
 }
 
+ret_t lcd_draw_glyphs(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr) {
+  uint32_t i = 0;
+  return_value_if_fail(lcd != NULL && lcd->draw_glyph != NULL && glyphs != NULL, RET_BAD_PARAMS);
+
+  if (lcd->draw_glyphs != NULL) {
+    return lcd->draw_glyphs(lcd, glyphs, nr);
+  }
+
+  for (i = 0; i < nr; i++) {
+    draw_glyph_info_t* iter = glyphs + i;
+    lcd->draw_glyph(lcd, &(iter->glyph), &(iter->src), iter->x, iter->y);
+  }
+
+  return RET_OK;
+}
+
 float_t lcd_measure_text(lcd_t* lcd, const wchar_t* str, uint32_t nr) {
   return_value_if_fail(nr < 10240, 0.0f);
   return_value_if_fail(lcd != NULL && lcd->measure_text != NULL && str != NULL, 0.0f);
@@ -212,31 +258,41 @@ ret_t lcd_draw_text(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy_t x, xy_t y)
 }
 
 ret_t lcd_end_frame(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL && lcd->end_frame != NULL, RET_BAD_PARAMS);
 
-  return_value_if_fail(lcd->end_frame(lcd) == RET_OK, RET_FAIL);
+  tk_trace_begin("lcd", "end_frame");
+  ret = lcd->end_frame(lcd);
+  tk_trace_end();
+  return_value_if_fail(ret == RET_OK, RET_FAIL);
 
   return RET_OK;
 }
 
 ret_t lcd_swap(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
   if (lcd->swap != NULL) {
-    return lcd->swap(lcd);
+    tk_trace_begin("lcd", "swap");
+    ret = lcd->swap(lcd);
+    tk_trace_end();
   }
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t lcd_flush(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
   if (lcd->flush != NULL) {
-    return lcd->flush(lcd);
+    tk_trace_begin("lcd", "flush");
+    ret = lcd->flush(lcd);
+    tk_trace_end();
   }
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t lcd_sync(lcd_t* lcd) {
@@ -277,6 +333,16 @@ ret_t lcd_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate) {
   return lcd->take_snapshot(lcd, img, auto_rotate);
 }
 
+ret_t lcd_read_rect(lcd_t* lcd, rect_t* r, bitmap_t* img) {
+  return_value_if_fail(lcd != NULL && r != NULL && img != NULL, RET_BAD_PARAMS);
+
+  if (lcd->read_rect == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return lcd->read_rect(lcd, r, img);
+}
+
 bitmap_format_t lcd_get_desired_bitmap_format(lcd_t* lcd) {
   return_value_if_fail(lcd != NULL && lcd->get_desired_bitmap_format != NULL, BITMAP_FMT_BGR565);
 
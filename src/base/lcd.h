@@ -27,6 +27,7 @@
 #include "tkc/matrix.h"
 #include "base/bitmap.h"
 #include "base/vgcanvas.h"
+#include "base/dirty_rects.h"
 
 BEGIN_C_DECLS
 
@@ -38,6 +39,13 @@ typedef struct _draw_image_info_t {
   matrix_t matrix;
 } draw_image_info_t;
 
+typedef struct _draw_glyph_info_t {
+  glyph_t glyph;
+  rect_t src;
+  xy_t x;
+  xy_t y;
+} draw_glyph_info_t;
+
 struct _lcd_t;
 typedef struct _lcd_t lcd_t;
 
@@ -62,6 +70,7 @@ typedef ret_t (*lcd_fill_rect_t)(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
 typedef ret_t (*lcd_stroke_rect_t)(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
 
 typedef ret_t (*lcd_draw_glyph_t)(lcd_t* lcd, glyph_t* glyph, rect_t* src, xy_t x, xy_t y);
+typedef ret_t (*lcd_draw_glyphs_t)(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr);
 typedef float_t (*lcd_measure_text_t)(lcd_t* lcd, const wchar_t* str, uint32_t nr);
 typedef ret_t (*lcd_draw_text_t)(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy_t x, xy_t y);
 
@@ -69,6 +78,7 @@ typedef ret_t (*lcd_draw_image_t)(lcd_t* lcd, bitmap_t* img, rect_t* src, rect_t
 typedef ret_t (*lcd_draw_image_matrix_t)(lcd_t* lcd, draw_image_info_t* info);
 typedef vgcanvas_t* (*lcd_get_vgcanvas_t)(lcd_t* lcd);
 typedef ret_t (*lcd_take_snapshot_t)(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate);
+typedef ret_t (*lcd_read_rect_t)(lcd_t* lcd, rect_t* r, bitmap_t* img);
 typedef bitmap_format_t (*lcd_get_desired_bitmap_format_t)(lcd_t* lcd);
 
 typedef wh_t (*lcd_get_width_t)(lcd_t* lcd);
@@ -163,6 +173,7 @@ struct _lcd_t {
   lcd_draw_image_t draw_image;
   lcd_draw_image_matrix_t draw_image_matrix;
   lcd_draw_glyph_t draw_glyph;
+  lcd_draw_glyphs_t draw_glyphs; /*可选*/
   lcd_draw_text_t draw_text;
   lcd_measure_text_t measure_text;
   lcd_draw_points_t draw_points;
@@ -175,6 +186,7 @@ struct _lcd_t {
   lcd_end_frame_t end_frame;
   lcd_get_vgcanvas_t get_vgcanvas;
   lcd_take_snapshot_t take_snapshot;
+  lcd_read_rect_t read_rect; /*可选*/
   lcd_get_desired_bitmap_format_t get_desired_bitmap_format;
   lcd_resize_t resize;
   lcd_destroy_t destroy;
@@ -197,6 +209,12 @@ struct _lcd_t {
    * 全局alpha
    */
   uint8_t global_alpha;
+  /**
+   * @property {bool_t} image_smooth
+   * @annotation ["readable"]
+   * 缩放图片时是否使用双线性插值。
+   */
+  bool_t image_smooth;
   /**
    * @property {color_t} text_color
    * @annotation ["readable"]
@@ -258,6 +276,7 @@ struct _lcd_t {
 
   rect_t fps_rect;
   rect_t dirty_rect;
+  dirty_rects_t dirty_rects;
 
   void* impl_data;
 };
@@ -273,6 +292,21 @@ struct _lcd_t {
  */
 ret_t lcd_begin_frame(lcd_t* lcd, rect_t* dirty_rect, lcd_draw_mode_t draw_mode);
 
+/**
+ * @method lcd_begin_frame_rects
+ * 准备绘制多个脏矩形。
+ *
+ * > dirty_rect为全部脏矩形的外接矩形，flush时只刷新各个脏矩形。
+ *
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {const dirty_rects_t*} dirty_rects 需要绘制的区域。
+ * @param {lcd_draw_mode_t} draw_mode 动画模式，如果可能，直接画到显存而不是离线的framebuffer。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_begin_frame_rects(lcd_t* lcd, const dirty_rects_t* dirty_rects,
+                            lcd_draw_mode_t draw_mode);
+
 /**
  * @method lcd_set_clip_rect
  * 设置裁剪区域。
@@ -316,6 +350,16 @@ ret_t lcd_resize(lcd_t* lcd, wh_t w, wh_t h, uint32_t line_length);
  */
 ret_t lcd_set_global_alpha(lcd_t* lcd, uint8_t alpha);
 
+/**
+ * @method lcd_set_image_smooth
+ * 设置缩放图片时是否使用双线性插值(不支持的lcd忽略此设置)。
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {bool_t} smooth 是否使用双线性插值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_set_image_smooth(lcd_t* lcd, bool_t smooth);
+
 /**
  * @method lcd_set_text_color
  * 设置文本颜色。
@@ -451,6 +495,17 @@ ret_t lcd_stroke_rect(lcd_t* lcd, xy_t x, xy_t y, wh_t w, wh_t h);
  */
 ret_t lcd_draw_glyph(lcd_t* lcd, glyph_t* glyph, rect_t* src, xy_t x, xy_t y);
 
+/**
+ * @method lcd_draw_glyphs
+ * 批量绘制字符(颜色和透明度相同)。没有实现draw_glyphs时，逐个调用draw_glyph。
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {draw_glyph_info_t*} glyphs 字模和绘制的位置。
+ * @param {uint32_t} nr 字符的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_draw_glyphs(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr);
+
 /**
  * @method lcd_measure_text
  * 测量字符串占用的宽度。
@@ -509,6 +564,9 @@ vgcanvas_t* lcd_get_vgcanvas(lcd_t* lcd);
 /**
  * @method lcd_take_snapshot
  * 拍摄快照，一般用于窗口动画，只有framebuffer模式，才支持。
+ *
+ * > img的data不为空且大小和格式与快照一致时，直接使用img的缓冲区，否则重新分配(忽略原来的缓冲区)。
+ *
  * @param {lcd_t*} lcd lcd对象。
  * @param {bitmap_t*} img 返回快照图片。
  * @param {bool_t} auto_rotate 是否根据LCD实际方向自动旋转。
@@ -517,6 +575,20 @@ vgcanvas_t* lcd_get_vgcanvas(lcd_t* lcd);
  */
 ret_t lcd_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate);
 
+/**
+ * @method lcd_read_rect
+ * 读取framebuffer中指定区域的内容，一般用于缓存控件的绘制结果，只有framebuffer模式，才支持。
+ *
+ * > img的data不为空且大小和格式与区域一致时，直接使用img的缓冲区，否则重新分配(忽略原来的缓冲区)。
+ *
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {rect_t*} r 区域(屏幕坐标，必须在屏幕范围内)。
+ * @param {bitmap_t*} img 返回读取的图片。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，不支持时返回RET_NOT_IMPL。
+ */
+ret_t lcd_read_rect(lcd_t* lcd, rect_t* r, bitmap_t* img);
+
 /**
  * @method lcd_get_desired_bitmap_format
  * 获取期望的位图格式。绘制期望的位图格式可以提高绘制性能。
@@ -42,7 +42,7 @@ static ret_t lcd_profile_begin_frame(lcd_t* lcd, rect_t* dirty_rect) {
   profile->stroke_pixels = 0;
 
   profile->begin_frame_time = time_now_ms();
-  ret = lcd_begin_frame(profile->impl, dirty_rect, lcd->draw_mode);
+  ret = lcd_begin_frame_rects(profile->impl, &(lcd->dirty_rects), lcd->draw_mode);
 
   return ret;
 }
@@ -203,6 +203,22 @@ static ret_t lcd_profile_draw_glyph(lcd_t* lcd, glyph_t* glyph, rect_t* src, xy_
   return ret;
 }
 
+static ret_t lcd_profile_draw_glyphs(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr) {
+  ret_t ret = RET_OK;
+
+  uint32_t cost = 0;
+  uint32_t start = time_now_ms();
+  lcd_profile_t* profile = LCD_PROFILE(lcd);
+  ret = lcd_draw_glyphs(profile->impl, glyphs, nr);
+  cost = time_now_ms() - start;
+
+  profile->draw_text_times++;
+  profile->draw_text_cost += cost;
+  profile->draw_text_chars += nr;
+
+  return ret;
+}
+
 static float_t lcd_profile_measure_text(lcd_t* lcd, const wchar_t* str, uint32_t nr) {
   lcd_profile_t* profile = LCD_PROFILE(lcd);
 
@@ -231,6 +247,8 @@ static ret_t lcd_profile_draw_image(lcd_t* lcd, bitmap_t* img, rect_t* src, rect
   uint32_t cost = 0;
   uint32_t start = time_now_ms();
   lcd_profile_t* profile = LCD_PROFILE(lcd);
+
+  profile->impl->image_smooth = lcd->image_smooth;
   ret = lcd_draw_image(profile->impl, img, src, dst);
   cost = time_now_ms() - start;
 
@@ -274,6 +292,12 @@ static ret_t lcd_profile_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_ro
   return ret;
 }
 
+static ret_t lcd_profile_read_rect(lcd_t* lcd, rect_t* r, bitmap_t* img) {
+  lcd_profile_t* profile = LCD_PROFILE(lcd);
+
+  return lcd_read_rect(profile->impl, r, img);
+}
+
 static bitmap_format_t lcd_profile_get_desired_bitmap_format(lcd_t* lcd) {
   lcd_profile_t* profile = LCD_PROFILE(lcd);
 
@@ -412,6 +436,10 @@ lcd_t* lcd_profile_create(lcd_t* impl) {
     lcd->draw_glyph = lcd_profile_draw_glyph;
   }
 
+  if (impl->draw_glyphs != NULL) {
+    lcd->draw_glyphs = lcd_profile_draw_glyphs;
+  }
+
   if (impl->measure_text != NULL) {
     lcd->measure_text = lcd_profile_measure_text;
   }
@@ -436,6 +464,10 @@ lcd_t* lcd_profile_create(lcd_t* impl) {
     lcd->take_snapshot = lcd_profile_take_snapshot;
   }
 
+  if (impl->read_rect != NULL) {
+    lcd->read_rect = lcd_profile_read_rect;
+  }
+
   if (impl->get_desired_bitmap_format != NULL) {
     lcd->get_desired_bitmap_format = lcd_profile_get_desired_bitmap_format;
   }
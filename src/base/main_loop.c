@@ -81,32 +81,155 @@ ret_t main_loop_queue_event(main_loop_t* l, const event_queue_req_t* e) {
 #include "base/timer.h"
 #include "base/window_manager.h"
 
-#define TK_MAX_SLEEP_TIME (1000 / TK_MAX_FPS)
+static uint32_t main_loop_get_frame_interval(main_loop_t* l) {
+  return l->frame_interval > 0 ? l->frame_interval : (1000 / TK_MAX_FPS);
+}
 
-ret_t main_loop_sleep_default(main_loop_t* l) {
-  uint32_t sleep_time = 0;
-  uint32_t now = time_now_ms();
-  uint32_t gap = now - l->last_loop_time;
-  int32_t least_sleep_time = gap > TK_MAX_SLEEP_TIME ? 0 : (TK_MAX_SLEEP_TIME - gap);
-  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+static uint32_t main_loop_get_idle_sleep_time(main_loop_t* l) {
+  if (l->idle_sleep_time > 0) {
+    return l->idle_sleep_time;
+  }
+
+  /*能被输入事件和main_loop_wakeup唤醒时，一直睡眠到下一个定时器*/
+  return l->wait != NULL ? 0xffffffff : TK_MAX_IDLE_SLEEP_TIME;
+}
+
+ret_t main_loop_set_fps(main_loop_t* l, uint32_t fps) {
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  l->frame_interval = fps > 0 ? tk_max(1000 / fps, 1) : 0;
+
+  return RET_OK;
+}
+
+ret_t main_loop_set_idle_sleep_time(main_loop_t* l, uint32_t sleep_time) {
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  l->idle_sleep_time = sleep_time;
+
+  return RET_OK;
+}
+
+ret_t main_loop_set_vsync(main_loop_t* l, bool_t vsync) {
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  l->vsync = vsync;
+  l->last_vsync_count = l->vsync_count;
+
+  return RET_OK;
+}
+
+ret_t main_loop_notify_vsync(main_loop_t* l) {
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  l->vsync_count++;
+
+  return main_loop_wakeup(l);
+}
+
+bool_t main_loop_need_paint(main_loop_t* l) {
+  window_manager_t* wm = NULL;
+  return_value_if_fail(l != NULL && l->wm != NULL, FALSE);
+
+  wm = WINDOW_MANAGER(l->wm);
+
+  return wm->animating || wm->dirty_rects.nr > 0 || l->wm->need_relayout_children ||
+         l->wm->need_relayout_descendants;
+}
 
-  if (!wm->animating) {
-    int32_t next_timer = timer_next_time() - time_now_ms();
+ret_t main_loop_begin_frame(main_loop_t* l, uint32_t now) {
+  uint32_t interval = 0;
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  interval = main_loop_get_frame_interval(l);
+  l->frame_deadline = now + interval;
+
+  /*按固定的节拍前进，落后超过一帧(比如刚从睡眠中醒来)时重新对齐到当前时间*/
+  if ((int32_t)(now - l->next_frame_time) >= 0) {
+    l->next_frame_time += interval;
+    if ((int32_t)(now - l->next_frame_time) >= 0) {
+      l->next_frame_time = now + interval;
+    }
+  }
+
+  return RET_OK;
+}
+
+bool_t main_loop_should_dispatch_idle(main_loop_t* l, uint32_t now) {
+  int32_t left = 0;
+  uint32_t paint_cost = 0;
+  return_value_if_fail(l != NULL && l->wm != NULL, TRUE);
+
+  if (!main_loop_need_paint(l) || l->idle_postponed >= TK_MAX_IDLE_POSTPONE) {
+    l->idle_postponed = 0;
+    return TRUE;
+  }
+
+  left = (int32_t)(l->frame_deadline - now);
+  paint_cost = WINDOW_MANAGER(l->wm)->last_paint_cost;
+  if (left > (int32_t)paint_cost) {
+    l->idle_postponed = 0;
+    return TRUE;
+  }
+
+  l->idle_postponed++;
+
+  return FALSE;
+}
 
-    if (next_timer < 0) {
-      next_timer = 0;
+uint32_t main_loop_calc_sleep_time(main_loop_t* l, uint32_t now) {
+  int32_t sleep_time = 0;
+  return_value_if_fail(l != NULL && l->wm != NULL, 0);
+
+  if (main_loop_need_paint(l) || idle_count() > 0) {
+    sleep_time = (int32_t)(l->next_frame_time - now);
+    sleep_time = tk_min(sleep_time, (int32_t)main_loop_get_frame_interval(l));
+  } else {
+    sleep_time = (int32_t)(timer_next_time() - now);
+    if (sleep_time > 0) {
+      sleep_time = tk_min((uint32_t)sleep_time, main_loop_get_idle_sleep_time(l));
     }
+  }
+
+  return sleep_time > 0 ? sleep_time : 0;
+}
+
+static ret_t main_loop_wait(main_loop_t* l, uint32_t timeout_ms) {
+  if (l->wait != NULL) {
+    return l->wait(l, timeout_ms);
+  }
+
+  sleep_ms(timeout_ms);
+
+  return RET_OK;
+}
 
-    sleep_time = tk_min(next_timer, TK_MAX_SLEEP_TIME);
-#ifdef WITH_SDL
-  } else if (gap <= 8) {
-    sleep_time = 8;
-#endif /*WITH_SDL*/
+static ret_t main_loop_wait_vsync(main_loop_t* l) {
+  uint32_t elapsed = 0;
+  uint32_t start = time_now_ms();
+  uint32_t timeout = 2 * main_loop_get_frame_interval(l);
+
+  /*
+   * 驱动没有通知时最多等待两帧，避免界面停止刷新。
+   * main_loop_notify_vsync会唤醒睡眠，不能唤醒时每毫秒检查一次。
+   */
+  while (l->vsync_count == l->last_vsync_count && (elapsed = time_now_ms() - start) < timeout) {
+    main_loop_wait(l, l->wait != NULL ? timeout - elapsed : 1);
   }
+  l->last_vsync_count = l->vsync_count;
+
+  return RET_OK;
+}
+
+ret_t main_loop_sleep_default(main_loop_t* l) {
+  uint32_t sleep_time = main_loop_calc_sleep_time(l, time_now_ms());
 
-  sleep_time = tk_min(least_sleep_time, sleep_time);
   if (sleep_time > 0) {
-    sleep_ms(sleep_time);
+    main_loop_wait(l, sleep_time);
+  }
+
+  if (l->vsync && main_loop_need_paint(l)) {
+    main_loop_wait_vsync(l);
   }
   l->last_loop_time = time_now_ms();
 
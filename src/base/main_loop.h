@@ -36,6 +36,7 @@ typedef ret_t (*main_loop_queue_event_t)(main_loop_t* l, const event_queue_req_t
 typedef ret_t (*main_loop_wakeup_t)(main_loop_t* l);
 typedef ret_t (*main_loop_step_t)(main_loop_t* l);
 typedef ret_t (*main_loop_sleep_t)(main_loop_t* l);
+typedef ret_t (*main_loop_wait_t)(main_loop_t* l, uint32_t timeout_ms);
 typedef ret_t (*main_loop_destroy_t)(main_loop_t* l);
 
 struct _main_loop_t {
@@ -44,12 +45,27 @@ struct _main_loop_t {
   main_loop_step_t step;
   main_loop_sleep_t sleep;
   main_loop_wakeup_t wakeup;
+  /*可选：最多睡眠timeout_ms毫秒，有输入事件或者调用main_loop_wakeup时提前返回。为NULL时用sleep_ms*/
+  main_loop_wait_t wait;
   main_loop_queue_event_t queue_event;
   main_loop_destroy_t destroy;
 
   bool_t running;
   bool_t app_quited;
   uint32_t last_loop_time;
+
+  /*帧调度：目标帧间隔(毫秒，为0时按TK_MAX_FPS)，下一帧开始的时间和当前帧的截止时间*/
+  uint32_t frame_interval;
+  uint32_t next_frame_time;
+  uint32_t frame_deadline;
+  /*没有需要绘制的内容时最多睡眠的时间(毫秒)。为0时：有wait的一直睡眠到下一个定时器，否则按TK_MAX_IDLE_SLEEP_TIME*/
+  uint32_t idle_sleep_time;
+  uint32_t idle_postponed;
+  /*是否按LCD的垂直同步(或刷新完成)信号绘制，信号由main_loop_notify_vsync通知*/
+  bool_t vsync;
+  volatile uint32_t vsync_count;
+  uint32_t last_vsync_count;
+
   widget_t* wm;
   canvas_t canvas;
   lcd_t* lcd;
@@ -69,6 +85,87 @@ ret_t main_loop_destroy(main_loop_t* l);
 ret_t main_loop_step(main_loop_t* l);
 ret_t main_loop_sleep(main_loop_t* l);
 
+/**
+ * @method main_loop_set_fps
+ * 设置目标帧率。需要绘制时主循环按固定的帧间隔运行，而不是每次循环后固定睡眠一段时间。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {uint32_t} fps 帧率，为0时使用TK\_MAX\_FPS。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t main_loop_set_fps(main_loop_t* l, uint32_t fps);
+
+/**
+ * @method main_loop_set_idle_sleep_time
+ * 设置没有需要绘制的内容时最多睡眠的时间。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {uint32_t} sleep_time 睡眠时间(毫秒)。为0时，主循环能被唤醒(有wait)则一直睡眠到下一个定时器，否则使用TK\_MAX\_IDLE\_SLEEP\_TIME。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t main_loop_set_idle_sleep_time(main_loop_t* l, uint32_t sleep_time);
+
+/**
+ * @method main_loop_set_vsync
+ * 设置是否等待LCD的垂直同步(或刷新完成)信号后再绘制下一帧。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {bool_t} vsync 是否等待垂直同步。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t main_loop_set_vsync(main_loop_t* l, bool_t vsync);
+
+/**
+ * @method main_loop_notify_vsync
+ * LCD驱动在垂直同步(或刷新完成)时调用本函数(可以在中断中调用)。
+ * @param {main_loop_t*} l 主循环对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t main_loop_notify_vsync(main_loop_t* l);
+
+/**
+ * @method main_loop_need_paint
+ * 检查是否有需要绘制(或layout)的内容。
+ * @param {main_loop_t*} l 主循环对象。
+ *
+ * @return {bool_t} 返回TRUE表示需要绘制。
+ */
+bool_t main_loop_need_paint(main_loop_t* l);
+
+/**
+ * @method main_loop_begin_frame
+ * 开始一帧(在step开始时调用)，计算当前帧的截止时间和下一帧开始的时间。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {uint32_t} now 当前时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t main_loop_begin_frame(main_loop_t* l, uint32_t now);
+
+/**
+ * @method main_loop_should_dispatch_idle
+ * 检查当前帧是否还有时间分发idle。需要绘制且剩余时间不够绘制时推迟idle，
+ * 但最多连续推迟TK\_MAX\_IDLE\_POSTPONE次。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {uint32_t} now 当前时间(毫秒)。
+ *
+ * @return {bool_t} 返回TRUE表示分发idle。
+ */
+bool_t main_loop_should_dispatch_idle(main_loop_t* l, uint32_t now);
+
+/**
+ * @method main_loop_calc_sleep_time
+ * 计算下一次循环之前需要睡眠的时间。
+ *
+ * 需要绘制时睡眠到下一帧开始，否则睡眠到下一个定时器到期(不超过idle\_sleep\_time)。
+ * @param {main_loop_t*} l 主循环对象。
+ * @param {uint32_t} now 当前时间(毫秒)。
+ *
+ * @return {uint32_t} 返回睡眠时间(毫秒)。
+ */
+uint32_t main_loop_calc_sleep_time(main_loop_t* l, uint32_t now);
+
 END_C_DECLS
 
 #endif /*TK_MAIN_LOOP_H*/
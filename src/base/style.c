@@ -19,8 +19,112 @@
  *
  */
 
+#include "tkc/utils.h"
 #include "base/style.h"
 
+static const char* s_style_prop_names[STYLE_PROP_NR] = {
+    STYLE_ID_BG_COLOR,
+    STYLE_ID_FG_COLOR,
+    STYLE_ID_MASK_COLOR,
+    STYLE_ID_FONT_NAME,
+    STYLE_ID_FONT_SIZE,
+    STYLE_ID_FONT_STYLE,
+    STYLE_ID_TEXT_COLOR,
+    STYLE_ID_TIPS_TEXT_COLOR,
+    STYLE_ID_TEXT_ALIGN_H,
+    STYLE_ID_TEXT_ALIGN_V,
+    STYLE_ID_BORDER_COLOR,
+    STYLE_ID_BORDER_WIDTH,
+    STYLE_ID_BORDER,
+    STYLE_ID_BG_IMAGE,
+    STYLE_ID_BG_IMAGE_DRAW_TYPE,
+    STYLE_ID_BG_IMAGE_SMOOTH,
+    STYLE_ID_ICON,
+    STYLE_ID_FG_IMAGE,
+    STYLE_ID_FG_IMAGE_DRAW_TYPE,
+    STYLE_ID_FG_IMAGE_SMOOTH,
+    STYLE_ID_SPACER,
+    STYLE_ID_MARGIN,
+    STYLE_ID_MARGIN_LEFT,
+    STYLE_ID_MARGIN_RIGHT,
+    STYLE_ID_MARGIN_TOP,
+    STYLE_ID_MARGIN_BOTTOM,
+    STYLE_ID_ICON_AT,
+    STYLE_ID_ACTIVE_ICON,
+    STYLE_ID_X_OFFSET,
+    STYLE_ID_Y_OFFSET,
+    STYLE_ID_SELECTED_BG_COLOR,
+    STYLE_ID_SELECTED_FG_COLOR,
+    STYLE_ID_SELECTED_TEXT_COLOR,
+    STYLE_ID_ROUND_RADIUS,
+};
+
+/*按名称排序的ID，用于二分查找*/
+static const uint8_t s_style_prop_sorted[STYLE_PROP_NR] = {
+    STYLE_PROP_ACTIVE_ICON,
+    STYLE_PROP_BG_COLOR,
+    STYLE_PROP_BG_IMAGE,
+    STYLE_PROP_BG_IMAGE_DRAW_TYPE,
+    STYLE_PROP_BG_IMAGE_SMOOTH,
+    STYLE_PROP_BORDER,
+    STYLE_PROP_BORDER_COLOR,
+    STYLE_PROP_BORDER_WIDTH,
+    STYLE_PROP_FG_COLOR,
+    STYLE_PROP_FG_IMAGE,
+    STYLE_PROP_FG_IMAGE_DRAW_TYPE,
+    STYLE_PROP_FG_IMAGE_SMOOTH,
+    STYLE_PROP_FONT_NAME,
+    STYLE_PROP_FONT_SIZE,
+    STYLE_PROP_FONT_STYLE,
+    STYLE_PROP_ICON,
+    STYLE_PROP_ICON_AT,
+    STYLE_PROP_MARGIN,
+    STYLE_PROP_MARGIN_BOTTOM,
+    STYLE_PROP_MARGIN_LEFT,
+    STYLE_PROP_MARGIN_RIGHT,
+    STYLE_PROP_MARGIN_TOP,
+    STYLE_PROP_MASK_COLOR,
+    STYLE_PROP_ROUND_RADIUS,
+    STYLE_PROP_SELECTED_BG_COLOR,
+    STYLE_PROP_SELECTED_FG_COLOR,
+    STYLE_PROP_SELECTED_TEXT_COLOR,
+    STYLE_PROP_SPACER,
+    STYLE_PROP_TEXT_ALIGN_H,
+    STYLE_PROP_TEXT_ALIGN_V,
+    STYLE_PROP_TEXT_COLOR,
+    STYLE_PROP_TIPS_TEXT_COLOR,
+    STYLE_PROP_X_OFFSET,
+    STYLE_PROP_Y_OFFSET,
+};
+
+style_prop_id_t style_prop_id(const char* name) {
+  int32_t low = 0;
+  int32_t high = STYLE_PROP_NR - 1;
+  return_value_if_fail(name != NULL, STYLE_PROP_NR);
+
+  while (low <= high) {
+    int32_t mid = (low + high) >> 1;
+    style_prop_id_t id = (style_prop_id_t)s_style_prop_sorted[mid];
+    int32_t ret = strcmp(s_style_prop_names[id], name);
+
+    if (ret == 0) {
+      return id;
+    } else if (ret < 0) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return STYLE_PROP_NR;
+}
+
+const char* style_prop_name(style_prop_id_t id) {
+  return_value_if_fail((uint32_t)id < STYLE_PROP_NR, NULL);
+
+  return s_style_prop_names[id];
+}
+
 ret_t style_notify_widget_state_changed(style_t* s, widget_t* widget) {
   return_value_if_fail(s != NULL && s->vt != NULL && s->vt->notify_widget_state_changed != NULL,
                        RET_BAD_PARAMS);
@@ -54,6 +158,37 @@ const char* style_get_str(style_t* s, const char* name, const char* defval) {
   return s->vt->get_str(s, name, defval);
 }
 
+int32_t style_get_int_by_id(style_t* s, style_prop_id_t id, int32_t defval) {
+  return_value_if_fail(s != NULL && s->vt != NULL && (uint32_t)id < STYLE_PROP_NR, defval);
+
+  if (s->vt->get_int_by_id != NULL) {
+    return s->vt->get_int_by_id(s, id, defval);
+  }
+
+  return style_get_int(s, s_style_prop_names[id], defval);
+}
+
+color_t style_get_color_by_id(style_t* s, style_prop_id_t id, color_t defval) {
+  return_value_if_fail(s != NULL && s->vt != NULL && (uint32_t)id < STYLE_PROP_NR, defval);
+
+  if (s->vt->get_int_by_id != NULL) {
+    defval.color = s->vt->get_int_by_id(s, id, defval.color);
+    return defval;
+  }
+
+  return style_get_color(s, s_style_prop_names[id], defval);
+}
+
+const char* style_get_str_by_id(style_t* s, style_prop_id_t id, const char* defval) {
+  return_value_if_fail(s != NULL && s->vt != NULL && (uint32_t)id < STYLE_PROP_NR, defval);
+
+  if (s->vt->get_str_by_id != NULL) {
+    return s->vt->get_str_by_id(s, id, defval);
+  }
+
+  return style_get_str(s, s_style_prop_names[id], defval);
+}
+
 ret_t style_destroy(style_t* s) {
   if (s != NULL && s->vt != NULL && s->vt->destroy != NULL) {
     return s->vt->destroy(s);
@@ -122,6 +122,12 @@ BEGIN_C_DECLS
  */
 #define STYLE_ID_BG_IMAGE_DRAW_TYPE "bg_image_draw_type"
 
+/**
+ * @const STYLE_ID_BG_IMAGE_SMOOTH
+ * 图片缩放时是否使用双线性插值(效果更平滑，缺省使用最近邻插值)。
+ */
+#define STYLE_ID_BG_IMAGE_SMOOTH "bg_image_smooth"
+
 /**
  * @const STYLE_ID_ICON
  * 图标的名称。
@@ -140,6 +146,12 @@ BEGIN_C_DECLS
  */
 #define STYLE_ID_FG_IMAGE_DRAW_TYPE "fg_image_draw_type"
 
+/**
+ * @const STYLE_ID_FG_IMAGE_SMOOTH
+ * 图片缩放时是否使用双线性插值(效果更平滑，缺省使用最近邻插值)。
+ */
+#define STYLE_ID_FG_IMAGE_SMOOTH "fg_image_smooth"
+
 /**
  * @const STYLE_ID_SPACER
  * 间距。
@@ -224,6 +236,200 @@ BEGIN_C_DECLS
  */
 #define STYLE_ID_ROUND_RADIUS "round_radius"
 
+/**
+ * @enum style_prop_id_t
+ * @prefix STYLE_PROP_
+ * 常用样式属性的整数ID(与STYLE\_ID\_xxx一一对应)。
+ *
+ * theme\_gen把ID写入主题数据，控件状态变化时按ID建立索引，绘制时按ID获取属性不需要比较字符串。
+ *
+ * > 新的ID只能追加在后面，不能改变已有的值(已经生成的主题数据中保存了ID)。
+ */
+typedef enum _style_prop_id_t {
+  /**
+   * @const STYLE_PROP_BG_COLOR
+   * STYLE\_ID\_BG\_COLOR的ID。
+   */
+  STYLE_PROP_BG_COLOR = 0,
+  /**
+   * @const STYLE_PROP_FG_COLOR
+   * STYLE\_ID\_FG\_COLOR的ID。
+   */
+  STYLE_PROP_FG_COLOR,
+  /**
+   * @const STYLE_PROP_MASK_COLOR
+   * STYLE\_ID\_MASK\_COLOR的ID。
+   */
+  STYLE_PROP_MASK_COLOR,
+  /**
+   * @const STYLE_PROP_FONT_NAME
+   * STYLE\_ID\_FONT\_NAME的ID。
+   */
+  STYLE_PROP_FONT_NAME,
+  /**
+   * @const STYLE_PROP_FONT_SIZE
+   * STYLE\_ID\_FONT\_SIZE的ID。
+   */
+  STYLE_PROP_FONT_SIZE,
+  /**
+   * @const STYLE_PROP_FONT_STYLE
+   * STYLE\_ID\_FONT\_STYLE的ID。
+   */
+  STYLE_PROP_FONT_STYLE,
+  /**
+   * @const STYLE_PROP_TEXT_COLOR
+   * STYLE\_ID\_TEXT\_COLOR的ID。
+   */
+  STYLE_PROP_TEXT_COLOR,
+  /**
+   * @const STYLE_PROP_TIPS_TEXT_COLOR
+   * STYLE\_ID\_TIPS\_TEXT\_COLOR的ID。
+   */
+  STYLE_PROP_TIPS_TEXT_COLOR,
+  /**
+   * @const STYLE_PROP_TEXT_ALIGN_H
+   * STYLE\_ID\_TEXT\_ALIGN\_H的ID。
+   */
+  STYLE_PROP_TEXT_ALIGN_H,
+  /**
+   * @const STYLE_PROP_TEXT_ALIGN_V
+   * STYLE\_ID\_TEXT\_ALIGN\_V的ID。
+   */
+  STYLE_PROP_TEXT_ALIGN_V,
+  /**
+   * @const STYLE_PROP_BORDER_COLOR
+   * STYLE\_ID\_BORDER\_COLOR的ID。
+   */
+  STYLE_PROP_BORDER_COLOR,
+  /**
+   * @const STYLE_PROP_BORDER_WIDTH
+   * STYLE\_ID\_BORDER\_WIDTH的ID。
+   */
+  STYLE_PROP_BORDER_WIDTH,
+  /**
+   * @const STYLE_PROP_BORDER
+   * STYLE\_ID\_BORDER的ID。
+   */
+  STYLE_PROP_BORDER,
+  /**
+   * @const STYLE_PROP_BG_IMAGE
+   * STYLE\_ID\_BG\_IMAGE的ID。
+   */
+  STYLE_PROP_BG_IMAGE,
+  /**
+   * @const STYLE_PROP_BG_IMAGE_DRAW_TYPE
+   * STYLE\_ID\_BG\_IMAGE\_DRAW\_TYPE的ID。
+   */
+  STYLE_PROP_BG_IMAGE_DRAW_TYPE,
+  /**
+   * @const STYLE_PROP_BG_IMAGE_SMOOTH
+   * STYLE\_ID\_BG\_IMAGE\_SMOOTH的ID。
+   */
+  STYLE_PROP_BG_IMAGE_SMOOTH,
+  /**
+   * @const STYLE_PROP_ICON
+   * STYLE\_ID\_ICON的ID。
+   */
+  STYLE_PROP_ICON,
+  /**
+   * @const STYLE_PROP_FG_IMAGE
+   * STYLE\_ID\_FG\_IMAGE的ID。
+   */
+  STYLE_PROP_FG_IMAGE,
+  /**
+   * @const STYLE_PROP_FG_IMAGE_DRAW_TYPE
+   * STYLE\_ID\_FG\_IMAGE\_DRAW\_TYPE的ID。
+   */
+  STYLE_PROP_FG_IMAGE_DRAW_TYPE,
+  /**
+   * @const STYLE_PROP_FG_IMAGE_SMOOTH
+   * STYLE\_ID\_FG\_IMAGE\_SMOOTH的ID。
+   */
+  STYLE_PROP_FG_IMAGE_SMOOTH,
+  /**
+   * @const STYLE_PROP_SPACER
+   * STYLE\_ID\_SPACER的ID。
+   */
+  STYLE_PROP_SPACER,
+  /**
+   * @const STYLE_PROP_MARGIN
+   * STYLE\_ID\_MARGIN的ID。
+   */
+  STYLE_PROP_MARGIN,
+  /**
+   * @const STYLE_PROP_MARGIN_LEFT
+   * STYLE\_ID\_MARGIN\_LEFT的ID。
+   */
+  STYLE_PROP_MARGIN_LEFT,
+  /**
+   * @const STYLE_PROP_MARGIN_RIGHT
+   * STYLE\_ID\_MARGIN\_RIGHT的ID。
+   */
+  STYLE_PROP_MARGIN_RIGHT,
+  /**
+   * @const STYLE_PROP_MARGIN_TOP
+   * STYLE\_ID\_MARGIN\_TOP的ID。
+   */
+  STYLE_PROP_MARGIN_TOP,
+  /**
+   * @const STYLE_PROP_MARGIN_BOTTOM
+   * STYLE\_ID\_MARGIN\_BOTTOM的ID。
+   */
+  STYLE_PROP_MARGIN_BOTTOM,
+  /**
+   * @const STYLE_PROP_ICON_AT
+   * STYLE\_ID\_ICON\_AT的ID。
+   */
+  STYLE_PROP_ICON_AT,
+  /**
+   * @const STYLE_PROP_ACTIVE_ICON
+   * STYLE\_ID\_ACTIVE\_ICON的ID。
+   */
+  STYLE_PROP_ACTIVE_ICON,
+  /**
+   * @const STYLE_PROP_X_OFFSET
+   * STYLE\_ID\_X\_OFFSET的ID。
+   */
+  STYLE_PROP_X_OFFSET,
+  /**
+   * @const STYLE_PROP_Y_OFFSET
+   * STYLE\_ID\_Y\_OFFSET的ID。
+   */
+  STYLE_PROP_Y_OFFSET,
+  /**
+   * @const STYLE_PROP_SELECTED_BG_COLOR
+   * STYLE\_ID\_SELECTED\_BG\_COLOR的ID。
+   */
+  STYLE_PROP_SELECTED_BG_COLOR,
+  /**
+   * @const STYLE_PROP_SELECTED_FG_COLOR
+   * STYLE\_ID\_SELECTED\_FG\_COLOR的ID。
+   */
+  STYLE_PROP_SELECTED_FG_COLOR,
+  /**
+   * @const STYLE_PROP_SELECTED_TEXT_COLOR
+   * STYLE\_ID\_SELECTED\_TEXT\_COLOR的ID。
+   */
+  STYLE_PROP_SELECTED_TEXT_COLOR,
+  /**
+   * @const STYLE_PROP_ROUND_RADIUS
+   * STYLE\_ID\_ROUND\_RADIUS的ID。
+   */
+  STYLE_PROP_ROUND_RADIUS,
+  /**
+   * @const STYLE_PROP_NR
+   * 属性ID的个数(也用于表示无效的ID)。
+   */
+  STYLE_PROP_NR
+} style_prop_id_t;
+
+/**
+ * @const STYLE_PROP_ID_UNKNOWN
+ * 主题数据中自定义属性(不是常用属性)的ID。
+ * 固定为0xff，不会与以后追加的ID冲突，建立索引时跳过。
+ */
+#define STYLE_PROP_ID_UNKNOWN 0xff
+
 struct _style_t;
 typedef struct _style_t style_t;
 
@@ -231,6 +437,8 @@ typedef bool_t (*style_is_valid_t)(style_t* s);
 typedef int32_t (*style_get_int_t)(style_t* s, const char* name, int32_t defval);
 typedef color_t (*style_get_color_t)(style_t* s, const char* name, color_t defval);
 typedef const char* (*style_get_str_t)(style_t* s, const char* name, const char* defval);
+typedef int32_t (*style_get_int_by_id_t)(style_t* s, style_prop_id_t id, int32_t defval);
+typedef const char* (*style_get_str_by_id_t)(style_t* s, style_prop_id_t id, const char* defval);
 
 typedef ret_t (*style_set_t)(style_t* s, const char* state, const char* name, const value_t* value);
 
@@ -244,6 +452,9 @@ typedef struct _style_vtable_t {
   style_get_int_t get_int;
   style_get_str_t get_str;
   style_get_color_t get_color;
+  /*可选，没有实现时按名称获取*/
+  style_get_int_by_id_t get_int_by_id;
+  style_get_str_by_id_t get_str_by_id;
   style_notify_widget_state_changed_t notify_widget_state_changed;
 
   style_set_t set;
@@ -327,6 +538,57 @@ color_t style_get_color(style_t* s, const char* name, color_t defval);
  */
 const char* style_get_str(style_t* s, const char* name, const char* defval);
 
+/**
+ * @method style_get_int_by_id
+ * 获取指定ID的整数格式的值(绘制时使用，比按名称获取快)。
+ * @param {style_t*} s style对象。
+ * @param {style_prop_id_t} id 属性ID。
+ * @param {int32_t} defval 缺省值。
+ *
+ * @return {int32_t} 返回整数格式的值。
+ */
+int32_t style_get_int_by_id(style_t* s, style_prop_id_t id, int32_t defval);
+
+/**
+ * @method style_get_color_by_id
+ * 获取指定ID的颜色值(绘制时使用，比按名称获取快)。
+ * @param {style_t*} s style对象。
+ * @param {style_prop_id_t} id 属性ID。
+ * @param {color_t} defval 缺省值。
+ *
+ * @return {color_t} 返回颜色值。
+ */
+color_t style_get_color_by_id(style_t* s, style_prop_id_t id, color_t defval);
+
+/**
+ * @method style_get_str_by_id
+ * 获取指定ID的字符串格式的值(绘制时使用，比按名称获取快)。
+ * @param {style_t*} s style对象。
+ * @param {style_prop_id_t} id 属性ID。
+ * @param {const char*} defval 缺省值。
+ *
+ * @return {const char*} 返回字符串格式的值。
+ */
+const char* style_get_str_by_id(style_t* s, style_prop_id_t id, const char* defval);
+
+/**
+ * @method style_prop_id
+ * 获取属性名对应的ID。
+ * @param {const char*} name 属性名。
+ *
+ * @return {style_prop_id_t} 返回属性ID，不是常用的属性时返回STYLE\_PROP\_NR。
+ */
+style_prop_id_t style_prop_id(const char* name);
+
+/**
+ * @method style_prop_name
+ * 获取属性ID对应的属性名。
+ * @param {style_prop_id_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，ID无效时返回NULL。
+ */
+const char* style_prop_name(style_prop_id_t id);
+
 /**
  * @method style_set
  * 设置指定状态的指定属性的值(仅仅对mutable的style有效)。
@@ -47,7 +47,7 @@ static bool_t is_valid_style_name(const char* str) {
   return str != NULL && *str;
 }
 
-static const void* widget_get_const_style_data(widget_t* widget) {
+static const void* widget_get_const_style_data(widget_t* widget, theme_t** found) {
   const void* data = NULL;
   theme_t* win_theme = NULL;
   theme_t* default_theme = NULL;
@@ -56,26 +56,44 @@ static const void* widget_get_const_style_data(widget_t* widget) {
   const char* state = widget_get_prop_str(widget, WIDGET_PROP_STATE_FOR_STYLE, widget->state);
 
   if (tk_str_eq(type, WIDGET_TYPE_WINDOW_MANAGER)) {
-    return theme_find_style(theme(), type, style_name, state);
+    *found = theme();
+    return theme_find_style(*found, type, style_name, state);
   }
 
   return_value_if_fail(widget_get_window_theme(widget, &win_theme, &default_theme) == RET_OK, NULL);
 
   if (win_theme != NULL) {
+    *found = win_theme;
     data = theme_find_style(win_theme, type, style_name, state);
   }
 
   if (data == NULL) {
+    *found = default_theme;
     data = theme_find_style(default_theme, type, style_name, state);
   }
 
   return data;
 }
 
+static bool_t theme_has_style_ids(theme_t* t) {
+  const theme_header_t* header = NULL;
+
+  if (t == NULL || t->data == NULL) {
+    return FALSE;
+  }
+
+  header = (const theme_header_t*)(t->data);
+
+  return header->version >= 1;
+}
+
 static ret_t style_const_notify_widget_state_changed(style_t* s, widget_t* widget) {
+  theme_t* found = NULL;
   style_const_t* style = (style_const_t*)s;
 
-  style->data = widget_get_const_style_data(widget);
+  style->data = widget_get_const_style_data(widget, &found);
+  style->indexed = style_data_build_index(style->data, theme_has_style_ids(found), style->index,
+                                          STYLE_PROP_NR) == RET_OK;
 
   return RET_OK;
 }
@@ -86,20 +104,62 @@ bool_t style_const_is_valid(style_t* s) {
   return style->data != NULL;
 }
 
+static int32_t style_const_get_int_by_id(style_t* s, style_prop_id_t id, int32_t defval) {
+  uint8_t index = 0;
+  style_const_t* style = (style_const_t*)s;
+
+  if (!style->indexed) {
+    return style_data_get_int(style->data, style_prop_name(id), defval);
+  }
+
+  index = style->index[id];
+  if (index == 0 || (index & STYLE_DATA_INDEX_STR)) {
+    return defval;
+  }
+
+  return style_data_get_int_at(style->data, index - 1, defval);
+}
+
+static const char* style_const_get_str_by_id(style_t* s, style_prop_id_t id, const char* defval) {
+  uint8_t index = 0;
+  style_const_t* style = (style_const_t*)s;
+
+  if (!style->indexed) {
+    return style_data_get_str(style->data, style_prop_name(id), defval);
+  }
+
+  index = style->index[id];
+  if (!(index & STYLE_DATA_INDEX_STR)) {
+    return defval;
+  }
+
+  return style_data_get_str_at(style->data, (index & ~STYLE_DATA_INDEX_STR) - 1, defval);
+}
+
 int32_t style_const_get_int(style_t* s, const char* name, int32_t defval) {
   style_const_t* style = (style_const_t*)s;
+  style_prop_id_t id = style->indexed ? style_prop_id(name) : STYLE_PROP_NR;
+
+  if (id < STYLE_PROP_NR) {
+    return style_const_get_int_by_id(s, id, defval);
+  }
 
   return style_data_get_int(style->data, name, defval);
 }
 
 color_t style_const_get_color(style_t* s, const char* name, color_t defval) {
-  style_const_t* style = (style_const_t*)s;
+  defval.color = style_const_get_int(s, name, defval.color);
 
-  return style_data_get_color(style->data, name, defval);
+  return defval;
 }
 
 const char* style_const_get_str(style_t* s, const char* name, const char* defval) {
   style_const_t* style = (style_const_t*)s;
+  style_prop_id_t id = style->indexed ? style_prop_id(name) : STYLE_PROP_NR;
+
+  if (id < STYLE_PROP_NR) {
+    return style_const_get_str_by_id(s, id, defval);
+  }
 
   return style_data_get_str(style->data, name, defval);
 }
@@ -119,6 +179,8 @@ static const style_vtable_t style_const_vt = {
     .get_int = style_const_get_int,
     .get_str = style_const_get_str,
     .get_color = style_const_get_color,
+    .get_int_by_id = style_const_get_int_by_id,
+    .get_str_by_id = style_const_get_str_by_id,
     .destroy = style_const_destroy};
 
 style_t* style_const_create(widget_t* widget) {
@@ -34,10 +34,16 @@ BEGIN_C_DECLS
  *
  * tools/theme_gen用于把XML的主题数据转换成常量数据。
  *
+ * 控件状态变化时建立属性ID到值的索引，按ID获取属性时不需要比较字符串。
+ *
  */
 typedef struct _style_const_t {
   style_t style;
   const uint8_t* data;
+
+  /*private*/
+  bool_t indexed;
+  uint8_t index[STYLE_PROP_NR];
 } style_const_t;
 
 /**
@@ -99,7 +99,7 @@ static ret_t text_edit_notify(text_edit_t* text_edit);
 static int32_t text_edit_calc_x(text_edit_t* text_edit, row_info_t* iter);
 
 static align_h_t widget_get_text_align_h(widget_t* widget) {
-  return (align_h_t)style_get_int(widget->astyle, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_LEFT);
+  return (align_h_t)style_get_int_by_id(widget->astyle, STYLE_PROP_TEXT_ALIGN_H, ALIGN_H_LEFT);
 }
 
 static ret_t widget_get_text_layout_info(widget_t* widget, text_layout_info_t* info) {
@@ -419,7 +419,7 @@ static ret_t text_edit_paint_caret(text_edit_t* text_edit, canvas_t* c) {
   style_t* style = widget->astyle;
   color_t black = color_init(0, 0, 0, 0xff);
   text_layout_info_t* layout_info = &(impl->layout_info);
-  color_t caret_color = style_get_color(style, STYLE_ID_TEXT_COLOR, black);
+  color_t caret_color = style_get_color_by_id(style, STYLE_PROP_TEXT_COLOR, black);
   uint32_t x = layout_info->margin_l + impl->caret.x - layout_info->ox;
   uint32_t y = layout_info->margin_t + impl->caret.y - layout_info->oy;
 
@@ -516,15 +516,16 @@ static ret_t text_edit_paint_line(text_edit_t* text_edit, canvas_t* c, row_info_
       uint32_t ry = y - layout_info->oy;
 
       if (offset >= select_start && offset < select_end) {
-        color_t select_bg_color = style_get_color(style, STYLE_ID_SELECTED_BG_COLOR, white);
-        color_t select_text_color = style_get_color(style, STYLE_ID_SELECTED_TEXT_COLOR, black);
+        color_t select_bg_color = style_get_color_by_id(style, STYLE_PROP_SELECTED_BG_COLOR, white);
+        color_t select_text_color =
+            style_get_color_by_id(style, STYLE_PROP_SELECTED_TEXT_COLOR, black);
 
         canvas_set_fill_color(c, select_bg_color);
         canvas_fill_rect(c, rx, ry, char_w + CHAR_SPACING, c->font_size);
 
         canvas_set_text_color(c, select_text_color);
       } else {
-        color_t text_color = style_get_color(style, STYLE_ID_TEXT_COLOR, black);
+        color_t text_color = style_get_color_by_id(style, STYLE_PROP_TEXT_COLOR, black);
         canvas_set_text_color(c, text_color);
       }
 
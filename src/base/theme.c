@@ -22,6 +22,7 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "base/theme.h"
+#include "base/style.h"
 #include "tkc/buffer.h"
 
 color_t style_data_get_color(const uint8_t* s, const char* name, color_t defval) {
@@ -81,17 +82,158 @@ const char* style_data_get_str(const uint8_t* s, const char* name, const char* d
   return defval;
 }
 
+uint32_t style_data_get_int_at(const uint8_t* s, uint32_t index, uint32_t defval) {
+  uint32_t nr = 0;
+  const uint8_t* p = s;
+  const style_int_data_t* iter = NULL;
+
+  if (s == NULL) {
+    return defval;
+  }
+
+  load_uint32(p, nr);
+  return_value_if_fail(index < nr, defval);
+  iter = (const style_int_data_t*)p + index;
+
+  return iter->value;
+}
+
+const char* style_data_get_str_at(const uint8_t* s, uint32_t index, const char* defval) {
+  uint32_t nr = 0;
+  const uint8_t* p = s;
+  const style_str_data_t* iter = NULL;
+
+  if (s == NULL) {
+    return defval;
+  }
+
+  /*skip int values*/
+  load_uint32(p, nr);
+  p += nr * sizeof(style_int_data_t);
+
+  load_uint32(p, nr);
+  return_value_if_fail(index < nr, defval);
+  iter = (const style_str_data_t*)p + index;
+
+  return iter->value;
+}
+
+/*
+ * 建立属性ID到值的索引：index[id]为0表示没有该属性，否则低7位为值的序号加1，
+ * 有STYLE_DATA_INDEX_STR标志的是字符串值。主题数据中有属性ID时不需要比较字符串。
+ */
+ret_t style_data_build_index(const uint8_t* s, bool_t with_ids, uint8_t* index, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t int_nr = 0;
+  uint32_t str_nr = 0;
+  const uint8_t* p = s;
+  const uint8_t* ids = NULL;
+  const style_int_data_t* ints = NULL;
+  const style_str_data_t* strs = NULL;
+  return_value_if_fail(index != NULL, RET_BAD_PARAMS);
+
+  memset(index, 0x00, nr);
+  if (s == NULL) {
+    return RET_OK;
+  }
+
+  load_uint32(p, int_nr);
+  ints = (const style_int_data_t*)p;
+  p += int_nr * sizeof(style_int_data_t);
+
+  load_uint32(p, str_nr);
+  strs = (const style_str_data_t*)p;
+  p += str_nr * sizeof(style_str_data_t);
+
+  if (int_nr >= STYLE_DATA_INDEX_STR || str_nr >= STYLE_DATA_INDEX_STR) {
+    return RET_FAIL;
+  }
+
+  ids = with_ids ? p : NULL;
+  for (i = 0; i < int_nr; i++) {
+    uint32_t id = ids != NULL ? ids[i] : style_prop_id(ints[i].name);
+
+    if (id == STYLE_PROP_ID_UNKNOWN) {
+      continue;
+    }
+
+    if (id < nr && index[id] == 0) {
+      index[id] = i + 1;
+    }
+  }
+
+  for (i = 0; i < str_nr; i++) {
+    uint32_t id = ids != NULL ? ids[int_nr + i] : style_prop_id(strs[i].name);
+
+    if (id == STYLE_PROP_ID_UNKNOWN) {
+      continue;
+    }
+
+    if (id < nr && index[id] == 0) {
+      index[id] = STYLE_DATA_INDEX_STR | (i + 1);
+    }
+  }
+
+  return RET_OK;
+}
+
+int theme_item_cmp(const theme_item_t* item, const char* widget_type, const char* name,
+                   const char* widget_state) {
+  int ret = strcmp(item->widget_type, widget_type);
+
+  if (ret == 0) {
+    ret = strcmp(item->name, name);
+    if (ret == 0) {
+      ret = strcmp(item->state, widget_state);
+    }
+  }
+
+  return ret;
+}
+
+static const uint8_t* theme_find_style_sorted(theme_t* t, const char* widget_type,
+                                              const char* name, const char* widget_state) {
+  int32_t low = 0;
+  int32_t found = -1;
+  const theme_header_t* header = (const theme_header_t*)(t->data);
+  const theme_item_t* items = (const theme_item_t*)(t->data + sizeof(theme_header_t));
+  int32_t high = (int32_t)(header->nr) - 1;
+
+  /*相同的项可能有多个，和线性查找一样返回第一个*/
+  while (low <= high) {
+    int32_t mid = low + ((high - low) >> 1);
+    int ret = theme_item_cmp(items + mid, widget_type, name, widget_state);
+
+    if (ret < 0) {
+      low = mid + 1;
+    } else {
+      if (ret == 0) {
+        found = mid;
+      }
+      high = mid - 1;
+    }
+  }
+
+  return found >= 0 ? t->data + items[found].offset : NULL;
+}
+
 const uint8_t* theme_find_style(theme_t* t, const char* widget_type, const char* name,
                                 const char* widget_state) {
   uint32_t i = 0;
   const theme_item_t* iter = NULL;
-  const theme_header_t* header = (const theme_header_t*)(t->data);
+  const theme_header_t* header = NULL;
   return_value_if_fail(t != NULL && t->data != NULL, NULL);
 
   if (name == NULL) {
     name = TK_DEFAULT_STYLE;
   }
 
+  header = (const theme_header_t*)(t->data);
+  if (header->version >= THEME_VERSION_SORTED) {
+    return_value_if_fail(widget_type != NULL && widget_state != NULL, NULL);
+    return theme_find_style_sorted(t, widget_type, name, widget_state);
+  }
+
   iter = (const theme_item_t*)(t->data + sizeof(theme_header_t));
   for (i = 0; i < header->nr; i++) {
     if (tk_str_eq(widget_type, iter->widget_type)) {
@@ -112,11 +112,29 @@ ret_t theme_destroy(theme_t* theme);
 uint32_t style_data_get_int(const uint8_t* s, const char* name, uint32_t defval);
 color_t style_data_get_color(const uint8_t* s, const char* name, color_t defval);
 const char* style_data_get_str(const uint8_t* s, const char* name, const char* defval);
+uint32_t style_data_get_int_at(const uint8_t* s, uint32_t index, uint32_t defval);
+const char* style_data_get_str_at(const uint8_t* s, uint32_t index, const char* defval);
+ret_t style_data_build_index(const uint8_t* s, bool_t with_ids, uint8_t* index, uint32_t nr);
 
 /*public for tools only*/
 #define THEME_MAGIC 0xFAFBFCFD
 #define TK_DEFAULT_STYLE "default"
 
+/*
+ * 主题数据的版本：
+ * 0 每个样式只有整数值和字符串值。
+ * 1 每个样式的值后面保存了各个值的属性ID(uint8_t，参考style_prop_id_t，按4字节对齐)，
+ *   自定义属性的ID为STYLE_PROP_ID_UNKNOWN。
+ * 2 theme_item_t按widget_type、name和state排序(strcmp，相同的保持原来的顺序)，可以二分查找。
+ */
+#define THEME_VERSION 2
+
+/*theme_item_t已经排序的版本*/
+#define THEME_VERSION_SORTED 2
+
+/*索引中字符串值的标志，没有此标志的是整数值*/
+#define STYLE_DATA_INDEX_STR 0x80
+
 typedef struct _theme_header_t {
   uint32_t magic;
   uint32_t version;
@@ -130,6 +148,10 @@ typedef struct _theme_item_t {
   char widget_type[TK_NAME_LEN + 1];
 } theme_item_t;
 
+/*theme_item_t的排序规则(THEME_VERSION_SORTED)*/
+int theme_item_cmp(const theme_item_t* item, const char* widget_type, const char* name,
+                   const char* widget_state);
+
 typedef struct _style_int_data_t {
   char name[TK_NAME_LEN + 1];
   uint32_t value;
@@ -50,13 +50,7 @@ ret_t timer_dispatch(void) {
 }
 
 ret_t timer_modify(uint32_t timer_id, uint32_t duration) {
-  timer_info_t* info = (timer_info_t*)timer_manager_find(timer_manager(), timer_id);
-  return_value_if_fail(info != NULL, RET_NOT_FOUND);
-
-  info->duration = duration;
-  info->start = timer_now();
-
-  return RET_OK;
+  return timer_manager_modify(timer_manager(), timer_id, duration);
 }
 
 uint32_t timer_count(void) {
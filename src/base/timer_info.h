@@ -117,6 +117,9 @@ struct _timer_info_t {
   /*private*/
   uint32_t last_dispatch_time;
   timer_manager_t* timer_manager;
+  uint32_t deadline;
+  uint32_t heap_index;
+  bool_t busy;
 };
 
 /**
@@ -16,12 +16,22 @@
  * History:
  * ================================================================
  * 2018-02-22 Li XianJing <xianjimli@hotmail.com> created
+ * 2026-10-16 Li XianJing <xianjimli@hotmail.com> use binary heap and hash index instead of slist
  *
  */
 
 #include "tkc/mem.h"
 #include "base/timer_manager.h"
 
+/*
+ * 定时器按到期时间放在二叉堆中(堆顶是最先到期的定时器)，
+ * 同时用开放寻址的hash表按ID索引。
+ * 添加/删除/重置都是O(log n)，查找和获取下一次到期时间都是O(1)。
+ */
+
+#define TIMER_MANAGER_INIT_CAPACITY 16
+#define TIMER_INVALID_INDEX 0xffffffff
+
 static timer_manager_t* s_timer_manager;
 
 timer_manager_t* timer_manager(void) {
@@ -50,7 +60,11 @@ timer_manager_t* timer_manager_init(timer_manager_t* timer_manager, timer_get_ti
   timer_manager->next_timer_id = TK_INVALID_ID + 1;
   timer_manager->last_dispatch_time = get_time();
   timer_manager->get_time = get_time;
-  slist_init(&(timer_manager->timers), (tk_destroy_t)object_unref, timer_info_compare);
+  timer_manager->size = 0;
+  timer_manager->capacity = 0;
+  timer_manager->heap = NULL;
+  timer_manager->buckets_nr = 0;
+  timer_manager->buckets = NULL;
 
   return timer_manager;
 }
@@ -58,7 +72,16 @@ timer_manager_t* timer_manager_init(timer_manager_t* timer_manager, timer_get_ti
 ret_t timer_manager_deinit(timer_manager_t* timer_manager) {
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  slist_deinit(&(timer_manager->timers));
+  while (timer_manager->size > 0) {
+    timer_info_t* timer = timer_manager->heap[timer_manager->size - 1];
+
+    timer_manager_remove(timer_manager, timer->id);
+  }
+
+  TKMEM_FREE(timer_manager->heap);
+  TKMEM_FREE(timer_manager->buckets);
+  timer_manager->capacity = 0;
+  timer_manager->buckets_nr = 0;
 
   return RET_OK;
 }
@@ -72,10 +95,180 @@ ret_t timer_manager_destroy(timer_manager_t* timer_manager) {
   return RET_OK;
 }
 
+static uint32_t timer_manager_hash(timer_manager_t* timer_manager, uint32_t id) {
+  uint32_t h = id * 2654435761u;
+
+  return (h ^ (h >> 16)) & (timer_manager->buckets_nr - 1);
+}
+
+static int32_t timer_manager_find_slot(timer_manager_t* timer_manager, uint32_t id) {
+  uint32_t i = 0;
+  uint32_t mask = timer_manager->buckets_nr - 1;
+
+  if (timer_manager->buckets_nr == 0) {
+    return -1;
+  }
+
+  i = timer_manager_hash(timer_manager, id);
+  while (timer_manager->buckets[i] != NULL) {
+    if (timer_manager->buckets[i]->id == id) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return -1;
+}
+
+static ret_t timer_manager_hash_insert(timer_manager_t* timer_manager, timer_info_t* timer) {
+  uint32_t mask = timer_manager->buckets_nr - 1;
+  uint32_t i = timer_manager_hash(timer_manager, timer->id);
+
+  while (timer_manager->buckets[i] != NULL) {
+    i = (i + 1) & mask;
+  }
+  timer_manager->buckets[i] = timer;
+
+  return RET_OK;
+}
+
+/*线性探测的删除：把后面同一簇中的项往前移，不需要墓碑标记*/
+static ret_t timer_manager_hash_remove(timer_manager_t* timer_manager, timer_info_t* timer) {
+  uint32_t j = 0;
+  uint32_t mask = timer_manager->buckets_nr - 1;
+  int32_t i = timer_manager_find_slot(timer_manager, timer->id);
+  return_value_if_fail(i >= 0, RET_NOT_FOUND);
+
+  timer_manager->buckets[i] = NULL;
+  for (j = (i + 1) & mask; timer_manager->buckets[j] != NULL; j = (j + 1) & mask) {
+    timer_info_t* iter = timer_manager->buckets[j];
+    uint32_t k = timer_manager_hash(timer_manager, iter->id);
+
+    if ((j > (uint32_t)i && (k <= (uint32_t)i || k > j)) ||
+        (j < (uint32_t)i && (k <= (uint32_t)i && k > j))) {
+      timer_manager->buckets[i] = iter;
+      timer_manager->buckets[j] = NULL;
+      i = j;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t timer_manager_extend(timer_manager_t* timer_manager) {
+  uint32_t i = 0;
+  uint32_t capacity = 0;
+  uint32_t buckets_nr = 0;
+  timer_info_t** heap = NULL;
+  timer_info_t** buckets = NULL;
+
+  if (timer_manager->size < timer_manager->capacity) {
+    return RET_OK;
+  }
+
+  capacity = tk_max(timer_manager->capacity * 2, TIMER_MANAGER_INIT_CAPACITY);
+  heap = TKMEM_REALLOCT(timer_info_t*, timer_manager->heap, capacity);
+  return_value_if_fail(heap != NULL, RET_OOM);
+  timer_manager->heap = heap;
+
+  /*负载因子不超过0.5*/
+  buckets_nr = capacity * 2;
+  buckets = TKMEM_ZALLOCN(timer_info_t*, buckets_nr);
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  TKMEM_FREE(timer_manager->buckets);
+  timer_manager->buckets = buckets;
+  timer_manager->buckets_nr = buckets_nr;
+  timer_manager->capacity = capacity;
+
+  for (i = 0; i < timer_manager->size; i++) {
+    timer_manager_hash_insert(timer_manager, heap[i]);
+  }
+
+  return RET_OK;
+}
+
+static inline bool_t timer_info_before(timer_info_t* a, timer_info_t* b) {
+  int32_t diff = (int32_t)(a->deadline - b->deadline);
+
+  /*同时到期的定时器，按添加的先后顺序执行*/
+  return diff < 0 || (diff == 0 && a->id < b->id);
+}
+
+static inline void timer_manager_heap_set(timer_manager_t* timer_manager, uint32_t index,
+                                          timer_info_t* timer) {
+  timer_manager->heap[index] = timer;
+  timer->heap_index = index;
+}
+
+static void timer_manager_sift_up(timer_manager_t* timer_manager, uint32_t index) {
+  timer_info_t** heap = timer_manager->heap;
+  timer_info_t* timer = heap[index];
+
+  while (index > 0) {
+    uint32_t parent = (index - 1) >> 1;
+    if (!timer_info_before(timer, heap[parent])) {
+      break;
+    }
+
+    timer_manager_heap_set(timer_manager, index, heap[parent]);
+    index = parent;
+  }
+
+  timer_manager_heap_set(timer_manager, index, timer);
+}
+
+static void timer_manager_sift_down(timer_manager_t* timer_manager, uint32_t index) {
+  uint32_t size = timer_manager->size;
+  timer_info_t** heap = timer_manager->heap;
+  timer_info_t* timer = heap[index];
+
+  while (TRUE) {
+    uint32_t child = index * 2 + 1;
+    if (child >= size) {
+      break;
+    }
+
+    if (child + 1 < size && timer_info_before(heap[child + 1], heap[child])) {
+      child++;
+    }
+
+    if (!timer_info_before(heap[child], timer)) {
+      break;
+    }
+
+    timer_manager_heap_set(timer_manager, index, heap[child]);
+    index = child;
+  }
+
+  timer_manager_heap_set(timer_manager, index, timer);
+}
+
+/*定时器的到期时间变化后，调整它在堆中的位置*/
+static ret_t timer_manager_reschedule(timer_manager_t* timer_manager, timer_info_t* timer,
+                                      uint32_t deadline) {
+  uint32_t index = timer->heap_index;
+  return_value_if_fail(index < timer_manager->size, RET_BAD_PARAMS);
+
+  timer->deadline = deadline;
+  timer_manager_sift_up(timer_manager, index);
+  if (timer->heap_index == index) {
+    timer_manager_sift_down(timer_manager, index);
+  }
+
+  return RET_OK;
+}
+
 ret_t timer_manager_append(timer_manager_t* timer_manager, timer_info_t* timer) {
   return_value_if_fail(timer_manager != NULL && timer != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(timer_manager_extend(timer_manager) == RET_OK, RET_OOM);
 
-  return slist_append(&(timer_manager->timers), timer);
+  timer->deadline = timer->start + timer->duration;
+  timer_manager_heap_set(timer_manager, timer_manager->size++, timer);
+  timer_manager_sift_up(timer_manager, timer->heap_index);
+  timer_manager_hash_insert(timer_manager, timer);
+
+  return RET_OK;
 }
 
 uint32_t timer_manager_add(timer_manager_t* timer_manager, timer_func_t on_timer, void* ctx,
@@ -91,11 +284,33 @@ uint32_t timer_manager_add(timer_manager_t* timer_manager, timer_func_t on_timer
 }
 
 ret_t timer_manager_remove(timer_manager_t* timer_manager, uint32_t timer_id) {
-  timer_info_t timer;
+  uint32_t index = 0;
+  timer_info_t* timer = NULL;
+  timer_info_t* last = NULL;
   return_value_if_fail(timer_id != TK_INVALID_ID, RET_BAD_PARAMS);
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  timer = (timer_info_t*)timer_manager_find(timer_manager, timer_id);
+  if (timer == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  index = timer->heap_index;
+  timer_manager_hash_remove(timer_manager, timer);
+  timer->heap_index = TIMER_INVALID_INDEX;
+
+  last = timer_manager->heap[--timer_manager->size];
+  if (last != timer) {
+    timer_manager_heap_set(timer_manager, index, last);
+    timer_manager_sift_up(timer_manager, index);
+    if (last->heap_index == index) {
+      timer_manager_sift_down(timer_manager, index);
+    }
+  }
+
+  object_unref((object_t*)timer);
+
+  return RET_OK;
 }
 
 ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id) {
@@ -103,28 +318,40 @@ ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id) {
   return_value_if_fail(info != NULL, RET_NOT_FOUND);
   info->start = timer_manager->get_time();
 
-  return RET_OK;
+  return timer_manager_reschedule(timer_manager, info, info->start + info->duration);
+}
+
+ret_t timer_manager_modify(timer_manager_t* timer_manager, uint32_t timer_id, uint32_t duration) {
+  timer_info_t* info = (timer_info_t*)timer_manager_find(timer_manager, timer_id);
+  return_value_if_fail(info != NULL, RET_NOT_FOUND);
+
+  info->duration = duration;
+  info->start = timer_manager->get_time();
+
+  return timer_manager_reschedule(timer_manager, info, info->start + info->duration);
 }
 
 const timer_info_t* timer_manager_find(timer_manager_t* timer_manager, uint32_t timer_id) {
-  timer_info_t timer;
+  int32_t slot = 0;
   return_value_if_fail(timer_id != TK_INVALID_ID, NULL);
   return_value_if_fail(timer_manager != NULL, NULL);
 
-  return slist_find(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  slot = timer_manager_find_slot(timer_manager, timer_id);
+
+  return slot >= 0 ? timer_manager->buckets[slot] : NULL;
 }
 
 static ret_t timer_manager_update_time(timer_manager_t* timer_manager, uint32_t now,
                                        int32_t delta_time) {
-  slist_node_t* iter = timer_manager->timers.first;
+  uint32_t i = 0;
 
-  while (iter != NULL) {
-    timer_info_t* timer = (timer_info_t*)(iter->data);
+  /*所有定时器平移相同的时间，堆中的相对顺序不变*/
+  for (i = 0; i < timer_manager->size; i++) {
+    timer_info_t* timer = timer_manager->heap[i];
 
     timer->start += delta_time;
+    timer->deadline += delta_time;
     timer->user_changed_time = TRUE;
-
-    iter = iter->next;
   }
 
   return RET_OK;
@@ -132,32 +359,52 @@ static ret_t timer_manager_update_time(timer_manager_t* timer_manager, uint32_t
 
 static ret_t timer_manager_dispatch_one(timer_manager_t* timer_manager, uint32_t now,
                                         int32_t delta_time) {
-  slist_node_t* iter = timer_manager->timers.first;
+  ret_t ret = RET_OK;
+  timer_info_t* timer = NULL;
 
-  while (iter != NULL && TIMER_INFO(iter->data)->now == now) {
-    iter = iter->next;
-  }
+  while (timer_manager->size > 0) {
+    timer = timer_manager->heap[0];
 
-  if (iter != NULL) {
-    timer_info_t* timer = (timer_info_t*)object_ref((object_t*)(iter->data));
-    return_value_if_fail(timer != NULL, RET_BAD_PARAMS);
+    if ((int32_t)(now - timer->deadline) < 0) {
+      return RET_DONE;
+    }
 
-    timer->now = now;
-    if ((timer->start + timer->duration) <= now) {
-      if (timer->on_timer(timer) != RET_REPEAT) {
-        timer_manager_remove(timer_manager, timer->id);
-      } else {
-        timer->start = now;
-      }
-      timer->user_changed_time = FALSE;
+    if (timer->now != now && !timer->busy) {
+      break;
     }
 
-    object_unref((object_t*)timer);
+    /*
+     * 本轮已经执行过(比如间隔为0的定时器)，或者正在执行(在回调函数中运行了子main loop)，
+     * 推迟到下一轮，保证每轮最多执行一次，也不会递归执行自己。
+     */
+    timer_manager_reschedule(timer_manager, timer, now + 1);
+  }
 
-    return RET_OK;
+  if (timer_manager->size == 0) {
+    return RET_DONE;
   }
 
-  return RET_DONE;
+  timer = (timer_info_t*)object_ref((object_t*)timer);
+  return_value_if_fail(timer != NULL, RET_BAD_PARAMS);
+
+  timer->now = now;
+  timer->busy = TRUE;
+  ret = timer->on_timer(timer);
+  timer->busy = FALSE;
+
+  if (ret != RET_REPEAT) {
+    timer_manager_remove(timer_manager, timer->id);
+  } else {
+    timer->start = now;
+    if (timer->heap_index != TIMER_INVALID_INDEX) {
+      timer_manager_reschedule(timer_manager, timer, timer->start + timer->duration);
+    }
+  }
+  timer->user_changed_time = FALSE;
+
+  object_unref((object_t*)timer);
+
+  return RET_OK;
 }
 
 ret_t timer_manager_dispatch(timer_manager_t* timer_manager) {
@@ -172,7 +419,7 @@ ret_t timer_manager_dispatch(timer_manager_t* timer_manager) {
     log_debug("User change time: %u => %u\n", timer_manager->last_dispatch_time, now);
   }
 
-  if (timer_manager->timers.first == NULL) {
+  if (timer_manager->size == 0) {
     timer_manager->last_dispatch_time = now;
     return RET_OK;
   }
@@ -190,21 +437,19 @@ ret_t timer_manager_dispatch(timer_manager_t* timer_manager) {
 uint32_t timer_manager_count(timer_manager_t* timer_manager) {
   return_value_if_fail(timer_manager != NULL, 0);
 
-  return slist_size(&(timer_manager->timers));
+  return timer_manager->size;
 }
 
 uint32_t timer_manager_next_time(timer_manager_t* timer_manager) {
-  slist_node_t* iter = NULL;
-  uint32_t t = timer_manager->get_time() + 0xffff;
-  return_value_if_fail(timer_manager != NULL, t);
-
-  iter = timer_manager->timers.first;
-  while (iter != NULL) {
-    timer_info_t* timer = TIMER_INFO(iter->data);
-    if ((timer->start + timer->duration) < t) {
-      t = timer->start + timer->duration;
+  uint32_t t = 0;
+  return_value_if_fail(timer_manager != NULL, 0);
+
+  t = timer_manager->get_time() + 0xffff;
+  if (timer_manager->size > 0) {
+    uint32_t deadline = timer_manager->heap[0]->deadline;
+    if ((int32_t)(t - deadline) > 0) {
+      t = deadline;
     }
-    iter = iter->next;
   }
 
   return t;
@@ -22,7 +22,6 @@
 #ifndef TK_TIMER_MANAGER_H
 #define TK_TIMER_MANAGER_H
 
-#include "tkc/slist.h"
 #include "base/timer_info.h"
 
 BEGIN_C_DECLS
@@ -32,7 +31,14 @@ struct _timer_manager_t {
   uint32_t last_dispatch_time;
   timer_get_time_t get_time;
 
-  slist_t timers;
+  /*按到期时间排序的二叉堆*/
+  uint32_t size;
+  uint32_t capacity;
+  timer_info_t** heap;
+
+  /*按ID索引定时器的hash表*/
+  uint32_t buckets_nr;
+  timer_info_t** buckets;
 };
 
 timer_manager_t* timer_manager(void);
@@ -49,6 +55,7 @@ ret_t timer_manager_set_on_destroy(timer_manager_t* timer_manager, uint32_t time
                                    tk_destroy_t on_destroy, void* on_destroy_ctx);
 ret_t timer_manager_remove(timer_manager_t* timer_manager, uint32_t timer_id);
 ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id);
+ret_t timer_manager_modify(timer_manager_t* timer_manager, uint32_t timer_id, uint32_t duration);
 const timer_info_t* timer_manager_find(timer_manager_t* timer_manager, uint32_t timer_id);
 ret_t timer_manager_dispatch(timer_manager_t* timer_manager);
 uint32_t timer_manager_count(timer_manager_t* timer_manager);
@@ -223,6 +223,19 @@ typedef enum _app_type_t {
 #define TK_MAX_FPS 100
 #endif /*TK_MAX_FPS*/
 
+/*
+ * 没有需要绘制的内容时，主循环最多睡眠的时间(毫秒，下一个定时器到期时会提前醒来)。
+ * 输入设备需要轮询的平台不宜太大，输入事件由中断或其它线程投递的平台可以设置得更大。
+ */
+#ifndef TK_MAX_IDLE_SLEEP_TIME
+#define TK_MAX_IDLE_SLEEP_TIME (1000 / TK_MAX_FPS)
+#endif /*TK_MAX_IDLE_SLEEP_TIME*/
+
+/*当前帧时间不够时，idle最多连续推迟的次数*/
+#ifndef TK_MAX_IDLE_POSTPONE
+#define TK_MAX_IDLE_POSTPONE 4
+#endif /*TK_MAX_IDLE_POSTPONE*/
+
 #define TK_OPACITY_ALPHA 0xfa
 #define TK_TRANSPARENT_ALPHA 0x02
 
@@ -311,4 +324,69 @@ typedef struct _system_info_t system_info_t;
 
 #endif /*TK_GLYPH_CACHE_NR*/
 
+/*主循环事件队列的容量(向上取整为2的幂)*/
+#ifndef TK_EVENT_QUEUE_SIZE
+#define TK_EVENT_QUEUE_SIZE 32
+#endif /*TK_EVENT_QUEUE_SIZE*/
+
+/*主循环是否合并连续的指针移动事件(只分发最后一个)*/
+#ifndef TK_COALESCE_POINTER_MOVE
+#define TK_COALESCE_POINTER_MOVE 1
+#endif /*TK_COALESCE_POINTER_MOVE*/
+
+/*被合并的指针移动事件最多保留的个数(供velocity计算速度)*/
+#ifndef TK_POINTER_HISTORY_SIZE
+#define TK_POINTER_HISTORY_SIZE 16
+#endif /*TK_POINTER_HISTORY_SIZE*/
+
+/*解码后的图片最多占用的内存(字节数)，为0表示不限制*/
+#ifndef TK_IMAGE_MANAGER_MEM_SIZE
+#define TK_IMAGE_MANAGER_MEM_SIZE 0
+#endif /*TK_IMAGE_MANAGER_MEM_SIZE*/
+
+/*窗口模板缓存最多占用的内存(估计的字节数)，为0表示不限制*/
+#ifndef TK_WINDOW_TEMPLATE_CACHE_MEM_SIZE
+#define TK_WINDOW_TEMPLATE_CACHE_MEM_SIZE (64 * 1024)
+#endif /*TK_WINDOW_TEMPLATE_CACHE_MEM_SIZE*/
+
+/*
+ * 窗口管理器保留的快照缓冲区个数(窗口动画的前后两个窗口，以及对话框高亮的背景)。
+ * 缓冲区第一次使用时分配，之后一直重用，不够时临时分配。为0表示不保留。
+ */
+#ifndef TK_SNAPSHOT_POOL_SIZE
+#define TK_SNAPSHOT_POOL_SIZE 3
+#endif /*TK_SNAPSHOT_POOL_SIZE*/
+
+/*控件层缓存(cache_layer属性)最多占用的内存(字节数)，为0表示不限制*/
+#ifndef TK_LAYER_CACHE_MEM_SIZE
+#ifdef WITH_SDL
+#define TK_LAYER_CACHE_MEM_SIZE (4 * 1024 * 1024)
+#else
+#define TK_LAYER_CACHE_MEM_SIZE (512 * 1024)
+#endif /*WITH_SDL*/
+#endif /*TK_LAYER_CACHE_MEM_SIZE*/
+
+/*glyph缓存最多占用的内存(字节数)，为0表示只限制个数*/
+#ifndef TK_GLYPH_CACHE_MEM_SIZE
+#ifdef WITH_SDL
+#define TK_GLYPH_CACHE_MEM_SIZE (4 * 1024 * 1024)
+#else
+#define TK_GLYPH_CACHE_MEM_SIZE (128 * 1024)
+#endif /*WITH_SDL*/
+#endif /*TK_GLYPH_CACHE_MEM_SIZE*/
+
+/*glyph atlas每页的大小(字节数)*/
+#ifndef TK_GLYPH_ATLAS_PAGE_SIZE
+#ifdef WITH_SDL
+#define TK_GLYPH_ATLAS_PAGE_SIZE (64 * 1024)
+#else
+#define TK_GLYPH_ATLAS_PAGE_SIZE (16 * 1024)
+#endif /*WITH_SDL*/
+#endif /*TK_GLYPH_ATLAS_PAGE_SIZE*/
+
+/*批量绘制文本时，每批最多的glyph个数*/
+#ifndef TK_GLYPH_RUN_NR
+#define TK_GLYPH_RUN_NR 8
+#endif /*TK_GLYPH_RUN_NR*/
+
 #endif /*TK_TYPES_DEF_H*/
@@ -19,6 +19,8 @@
  *
  */
 
+#include "tkc/utils.h"
+#include "tkc/color.h"
 #include "base/ui_builder.h"
 
 ret_t ui_builder_on_widget_start(ui_builder_t* b, const widget_desc_t* desc) {
@@ -34,6 +36,46 @@ ret_t ui_builder_on_widget_prop(ui_builder_t* b, const char* name, const char* v
   return b->on_widget_prop(b, name, value);
 }
 
+ret_t ui_builder_on_widget_prop_value(ui_builder_t* b, uint32_t id, const char* name,
+                                      const value_t* v) {
+  char str[TK_NUM_MAX_LEN + 1];
+  const char* value = str;
+  return_value_if_fail(b != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  if (b->on_widget_prop_value != NULL) {
+    return b->on_widget_prop_value(b, id, name, v);
+  }
+
+  memset(str, 0x00, sizeof(str));
+  switch (v->type) {
+    case VALUE_TYPE_STRING: {
+      value = value_str(v);
+      break;
+    }
+    case VALUE_TYPE_BOOL: {
+      value = value_bool(v) ? "true" : "false";
+      break;
+    }
+    case VALUE_TYPE_UINT32: {
+      color_t c;
+      c.color = value_uint32(v);
+      color_hex_str(c, str);
+      break;
+    }
+    case VALUE_TYPE_FLOAT:
+    case VALUE_TYPE_FLOAT32: {
+      tk_snprintf(str, sizeof(str) - 1, "%g", value_float(v));
+      break;
+    }
+    default: {
+      tk_snprintf(str, sizeof(str) - 1, "%d", value_int(v));
+      break;
+    }
+  }
+
+  return ui_builder_on_widget_prop(b, name, value);
+}
+
 ret_t ui_builder_on_widget_prop_end(ui_builder_t* b) {
   return_value_if_fail(b != NULL && b->on_widget_prop_end != NULL, RET_BAD_PARAMS);
 
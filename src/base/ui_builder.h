@@ -38,6 +38,8 @@ typedef struct _widget_desc_t {
 typedef ret_t (*ui_builder_on_start_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_widget_start_t)(ui_builder_t* b, const widget_desc_t* desc);
 typedef ret_t (*ui_builder_on_widget_prop_t)(ui_builder_t* b, const char* name, const char* value);
+typedef ret_t (*ui_builder_on_widget_prop_value_t)(ui_builder_t* b, uint32_t id, const char* name,
+                                                  const value_t* v);
 typedef ret_t (*ui_builder_on_widget_prop_end_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_widget_end_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_end_t)(ui_builder_t* b);
@@ -67,6 +69,7 @@ struct _ui_builder_t {
   ui_builder_on_start_t on_start;
   ui_builder_on_widget_start_t on_widget_start;
   ui_builder_on_widget_prop_t on_widget_prop;
+  ui_builder_on_widget_prop_value_t on_widget_prop_value;
   ui_builder_on_widget_prop_end_t on_widget_prop_end;
   ui_builder_on_widget_end_t on_widget_end;
   ui_builder_on_end_t on_end;
@@ -100,6 +103,23 @@ ret_t ui_builder_on_widget_start(ui_builder_t* builder, const widget_desc_t* des
  */
 ret_t ui_builder_on_widget_prop(ui_builder_t* builder, const char* name, const char* value);
 
+/**
+ * @method ui_builder_on_widget_prop_value
+ * ui\_loader在解析到widget的属性(V2格式，值已预先解析)时，调用本函数进一步处理。
+ *
+ * builder没有实现on\_widget\_prop\_value时，把值转换成字符串后交给on\_widget\_prop处理。
+ *
+ * @param {ui_builder_t*} builder builder对象。
+ * @param {uint32_t} id 预定义的属性ID(参考ui\_prop\_id\_t)，0表示不是预定义的属性。
+ * @param {const char*} name 属性名。
+ * @param {const value_t*} v 属性值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t ui_builder_on_widget_prop_value(ui_builder_t* builder, uint32_t id, const char* name,
+                                      const value_t* v);
+
 /**
  * @method ui_builder_on_widget_prop
  * ui\_loader在解析到widget全部属性结束时，调用本函数进一步处理。
@@ -145,6 +165,7 @@ ret_t ui_builder_on_start(ui_builder_t* builder);
 ret_t ui_builder_on_end(ui_builder_t* builder);
 
 #define UI_DATA_MAGIC 0x11221212
+#define UI_DATA_MAGIC_V2 0x11221213
 
 END_C_DECLS
 
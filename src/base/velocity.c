@@ -21,6 +21,37 @@
 
 #include "base/velocity.h"
 
+typedef struct _pointer_sample_t {
+  uint32_t time;
+  xy_t x;
+  xy_t y;
+} pointer_sample_t;
+
+static uint32_t s_history_nr = 0;
+static pointer_sample_t s_history[TK_POINTER_HISTORY_SIZE];
+
+ret_t velocity_history_reset(void) {
+  s_history_nr = 0;
+
+  return RET_OK;
+}
+
+ret_t velocity_history_add(uint32_t time, xy_t x, xy_t y) {
+  pointer_sample_t* s = NULL;
+
+  if (s_history_nr >= TK_POINTER_HISTORY_SIZE) {
+    memmove(s_history, s_history + 1, sizeof(pointer_sample_t) * (TK_POINTER_HISTORY_SIZE - 1));
+    s_history_nr = TK_POINTER_HISTORY_SIZE - 1;
+  }
+
+  s = s_history + s_history_nr++;
+  s->time = time;
+  s->x = x;
+  s->y = y;
+
+  return RET_OK;
+}
+
 velocity_t* velocity_reset(velocity_t* v) {
   return_value_if_fail(v != NULL, NULL);
   memset(v, 0x00, sizeof(velocity_t));
@@ -79,6 +110,15 @@ ret_t velocity_update(velocity_t* v, uint32_t time, xy_t x, xy_t y) {
   return_value_if_fail(v != NULL, RET_BAD_PARAMS);
 
   if (v->time) {
+    uint32_t i = 0;
+
+    for (i = 0; i < s_history_nr; i++) {
+      const pointer_sample_t* s = s_history + i;
+      if (s->time > v->time && s->time < time) {
+        velocity_do_update(v, s->time, s->x, s->y);
+      }
+    }
+
     return velocity_do_update(v, time, x, y);
   } else {
     return velocity_init(v, time, x, y);
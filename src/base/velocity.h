@@ -46,6 +46,30 @@ velocity_t* velocity_reset(velocity_t* v);
 
 ret_t velocity_update(velocity_t* v, uint32_t time, xy_t x, xy_t y);
 
+/**
+ * @method velocity_history_reset
+ * 清除被合并的指针移动事件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t velocity_history_reset(void);
+
+/**
+ * @method velocity_history_add
+ * 记录一个被合并(没有分发)的指针移动事件。
+ *
+ * 主循环合并连续的EVT\_POINTER\_MOVE时，把丢掉的事件记录下来，velocity\_update会先用
+ * 时间在上次更新和本次更新之间的记录更新速度，这样合并事件不会影响速度的计算。
+ * 超过TK\_POINTER\_HISTORY\_SIZE时丢掉最早的记录。
+ *
+ * @param {uint32_t} time 时间。
+ * @param {xy_t} x x坐标。
+ * @param {xy_t} y y坐标。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t velocity_history_add(uint32_t time, xy_t x, xy_t y);
+
 END_C_DECLS
 
 #endif /*TK_VELOCITY_H*/
@@ -22,6 +22,7 @@
 #include "tkc/mem.h"
 #include "tkc/utf8.h"
 #include "tkc/utils.h"
+#include "tkc/trace.h"
 #include "tkc/color_parser.h"
 
 #include "base/keys.h"
@@ -30,6 +31,7 @@
 #include "base/idle.h"
 #include "base/widget.h"
 #include "base/layout.h"
+#include "base/layer_cache.h"
 #include "base/main_loop.h"
 #include "base/widget_pool.h"
 #include "base/system_info.h"
@@ -110,19 +112,26 @@ ret_t widget_resize(widget_t* widget, wh_t w, wh_t h) {
 }
 
 ret_t widget_move_resize(widget_t* widget, xy_t x, xy_t y, wh_t w, wh_t h) {
+  bool_t resized = FALSE;
   event_t e = event_init(EVT_WILL_MOVE_RESIZE, widget);
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
   if (widget->x != x || widget->y != y || widget->w != w || widget->h != h) {
     widget_dispatch(widget, &e);
 
+    resized = widget->w != w || widget->h != h;
+
     widget_invalidate_force(widget, NULL);
     widget->x = x;
     widget->y = y;
     widget->w = w;
     widget->h = h;
     widget_invalidate_force(widget, NULL);
-    widget_set_need_relayout_children(widget);
+
+    /*子控件的位置是相对于父控件的，只移动时不需要重新layout子控件*/
+    if (resized) {
+      widget_set_need_relayout_children(widget);
+    }
 
     e.type = EVT_MOVE_RESIZE;
     widget_dispatch(widget, &e);
@@ -412,6 +421,20 @@ ret_t widget_set_floating(widget_t* widget, bool_t floating) {
   return RET_OK;
 }
 
+ret_t widget_set_cache_layer(widget_t* widget, bool_t cache_layer) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->cache_layer != cache_layer) {
+    widget->cache_layer = cache_layer;
+    if (!cache_layer) {
+      layer_cache_remove(widget);
+    }
+    widget_invalidate(widget, NULL);
+  }
+
+  return RET_OK;
+}
+
 ret_t widget_set_focused(widget_t* widget, bool_t focused) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -880,13 +903,13 @@ ret_t widget_draw_icon_text(widget_t* widget, canvas_t* c, const char* icon, wst
   int32_t align_v = ALIGN_V_MIDDLE;
   return_value_if_fail(widget->astyle != NULL, RET_BAD_PARAMS);
 
-  spacer = style_get_int(style, STYLE_ID_SPACER, 2);
-  margin = style_get_int(style, STYLE_ID_MARGIN, 0);
-  margin_top = style_get_int(style, STYLE_ID_MARGIN_TOP, margin);
-  margin_left = style_get_int(style, STYLE_ID_MARGIN_LEFT, margin);
-  margin_right = style_get_int(style, STYLE_ID_MARGIN_RIGHT, margin);
-  margin_bottom = style_get_int(style, STYLE_ID_MARGIN_BOTTOM, margin);
-  icon_at = style_get_int(style, STYLE_ID_ICON_AT, ICON_AT_AUTO);
+  spacer = style_get_int_by_id(style, STYLE_PROP_SPACER, 2);
+  margin = style_get_int_by_id(style, STYLE_PROP_MARGIN, 0);
+  margin_top = style_get_int_by_id(style, STYLE_PROP_MARGIN_TOP, margin);
+  margin_left = style_get_int_by_id(style, STYLE_PROP_MARGIN_LEFT, margin);
+  margin_right = style_get_int_by_id(style, STYLE_PROP_MARGIN_RIGHT, margin);
+  margin_bottom = style_get_int_by_id(style, STYLE_PROP_MARGIN_BOTTOM, margin);
+  icon_at = style_get_int_by_id(style, STYLE_PROP_ICON_AT, ICON_AT_AUTO);
 
   w = widget->w - margin_left - margin_right;
   h = widget->h - margin_top - margin_bottom;
@@ -897,18 +920,18 @@ ret_t widget_draw_icon_text(widget_t* widget, canvas_t* c, const char* icon, wst
   }
 
   if (icon == NULL) {
-    icon = style_get_str(style, STYLE_ID_ICON, NULL);
+    icon = style_get_str_by_id(style, STYLE_PROP_ICON, NULL);
   }
 
   widget_prepare_text_style(widget, c);
 
   font_size = c->font_size;
   if (icon_at == ICON_AT_RIGHT || icon_at == ICON_AT_LEFT) {
-    align_v = style_get_int(style, STYLE_ID_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
-    align_h = style_get_int(style, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_LEFT);
+    align_v = style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
+    align_h = style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_H, ALIGN_H_LEFT);
   } else {
-    align_v = style_get_int(style, STYLE_ID_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
-    align_h = style_get_int(style, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_CENTER);
+    align_v = style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
+    align_h = style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_H, ALIGN_H_CENTER);
   }
   canvas_set_text_align(c, (align_h_t)align_h, (align_v_t)align_v);
 
@@ -941,13 +964,15 @@ ret_t widget_fill_rect(widget_t* widget, canvas_t* c, rect_t* r, bool_t bg,
   bitmap_t img;
   style_t* style = widget->astyle;
   color_t trans = color_init(0, 0, 0, 0);
-  uint32_t radius = style_get_int(style, STYLE_ID_ROUND_RADIUS, 0);
-  const char* color_key = bg ? STYLE_ID_BG_COLOR : STYLE_ID_FG_COLOR;
-  const char* image_key = bg ? STYLE_ID_BG_IMAGE : STYLE_ID_FG_IMAGE;
-  const char* draw_type_key = bg ? STYLE_ID_BG_IMAGE_DRAW_TYPE : STYLE_ID_FG_IMAGE_DRAW_TYPE;
+  uint32_t radius = style_get_int_by_id(style, STYLE_PROP_ROUND_RADIUS, 0);
+  style_prop_id_t color_key = bg ? STYLE_PROP_BG_COLOR : STYLE_PROP_FG_COLOR;
+  style_prop_id_t image_key = bg ? STYLE_PROP_BG_IMAGE : STYLE_PROP_FG_IMAGE;
+  style_prop_id_t draw_type_key =
+      bg ? STYLE_PROP_BG_IMAGE_DRAW_TYPE : STYLE_PROP_FG_IMAGE_DRAW_TYPE;
+  style_prop_id_t smooth_key = bg ? STYLE_PROP_BG_IMAGE_SMOOTH : STYLE_PROP_FG_IMAGE_SMOOTH;
 
-  color_t color = style_get_color(style, color_key, trans);
-  const char* image_name = style_get_str(style, image_key, NULL);
+  color_t color = style_get_color_by_id(style, color_key, trans);
+  const char* image_name = style_get_str_by_id(style, image_key, NULL);
 
   if (color.rgba.a && r->w > 0 && r->h > 0) {
     canvas_set_fill_color(c, color);
@@ -971,8 +996,16 @@ ret_t widget_fill_rect(widget_t* widget, canvas_t* c, rect_t* r, bool_t bg,
 
   if (image_name != NULL && r->w > 0 && r->h > 0) {
     if (widget_load_image(widget, image_name, &img) == RET_OK) {
-      draw_type = (image_draw_type_t)style_get_int(style, draw_type_key, draw_type);
-      canvas_draw_image_ex(c, &img, draw_type, r);
+      bool_t smooth = style_get_int_by_id(style, smooth_key, FALSE) != 0;
+
+      draw_type = (image_draw_type_t)style_get_int_by_id(style, draw_type_key, draw_type);
+      if (smooth) {
+        canvas_set_image_smooth(c, TRUE);
+        canvas_draw_image_ex(c, &img, draw_type, r);
+        canvas_set_image_smooth(c, FALSE);
+      } else {
+        canvas_draw_image_ex(c, &img, draw_type, r);
+      }
     }
   }
 
@@ -982,10 +1015,10 @@ ret_t widget_fill_rect(widget_t* widget, canvas_t* c, rect_t* r, bool_t bg,
 ret_t widget_stroke_border_rect(widget_t* widget, canvas_t* c, rect_t* r) {
   style_t* style = widget->astyle;
   color_t trans = color_init(0, 0, 0, 0);
-  color_t bd = style_get_color(style, STYLE_ID_BORDER_COLOR, trans);
-  uint32_t radius = style_get_int(style, STYLE_ID_ROUND_RADIUS, 0);
-  int32_t border = style_get_int(style, STYLE_ID_BORDER, BORDER_ALL);
-  uint32_t border_width = style_get_int(style, STYLE_ID_BORDER_WIDTH, 1);
+  color_t bd = style_get_color_by_id(style, STYLE_PROP_BORDER_COLOR, trans);
+  uint32_t radius = style_get_int_by_id(style, STYLE_PROP_ROUND_RADIUS, 0);
+  int32_t border = style_get_int_by_id(style, STYLE_PROP_BORDER, BORDER_ALL);
+  uint32_t border_width = style_get_int_by_id(style, STYLE_PROP_BORDER_WIDTH, 1);
 
   if (bd.rgba.a) {
     wh_t w = r->w;
@@ -1072,8 +1105,8 @@ static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
   }
 
   if (widget->astyle != NULL) {
-    ox += style_get_int(widget->astyle, STYLE_ID_X_OFFSET, 0);
-    oy += style_get_int(widget->astyle, STYLE_ID_Y_OFFSET, 0);
+    ox += style_get_int_by_id(widget->astyle, STYLE_PROP_X_OFFSET, 0);
+    oy += style_get_int_by_id(widget->astyle, STYLE_PROP_Y_OFFSET, 0);
   }
 
   canvas_translate(c, ox, oy);
@@ -1106,9 +1139,18 @@ ret_t widget_paint(widget_t* widget, canvas_t* c) {
     widget_layout_children(widget);
   }
 
+  tk_trace_begin("widget", widget->vt->type);
   canvas_save(c);
-  widget_paint_impl(widget, c);
+  if (widget->cache_layer && layer_cache_draw(widget, c) == RET_OK) {
+    widget_on_paint_done(widget, c);
+  } else {
+    widget_paint_impl(widget, c);
+    if (widget->cache_layer) {
+      layer_cache_capture(widget, c);
+    }
+  }
   canvas_restore(c);
+  tk_trace_end();
 
   widget->dirty = FALSE;
 
@@ -1132,8 +1174,10 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
     widget->y = (wh_t)value_int(v);
   } else if (tk_str_eq(name, WIDGET_PROP_W)) {
     widget->w = (wh_t)value_int(v);
+    widget_set_need_relayout_children(widget);
   } else if (tk_str_eq(name, WIDGET_PROP_H)) {
     widget->h = (wh_t)value_int(v);
+    widget_set_need_relayout_children(widget);
   } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
     widget->opacity = (uint8_t)value_int(v);
   } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
@@ -1142,6 +1186,8 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
     widget->sensitive = value_bool(v);
   } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
     widget->floating = value_bool(v);
+  } else if (tk_str_eq(name, WIDGET_PROP_CACHE_LAYER)) {
+    widget_set_cache_layer(widget, value_bool(v));
   } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
     widget->focusable = value_bool(v);
   } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
@@ -1218,6 +1264,8 @@ ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
     value_set_bool(v, widget->sensitive);
   } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
     value_set_bool(v, widget->floating);
+  } else if (tk_str_eq(name, WIDGET_PROP_CACHE_LAYER)) {
+    value_set_bool(v, widget->cache_layer);
   } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
     value_set_bool(v, widget_is_focusable(widget));
   } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
@@ -2031,6 +2079,10 @@ static ret_t widget_destroy_sync(widget_t* widget) {
     widget->custom_props = NULL;
   }
 
+  if (widget->cache_layer) {
+    layer_cache_remove(widget);
+  }
+
   wstr_reset(&(widget->text));
   style_destroy(widget->astyle);
   widget->astyle = NULL;
@@ -2099,6 +2151,10 @@ static ret_t widget_set_dirty(widget_t* widget) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
   widget->dirty = TRUE;
+  if (widget->cache_layer) {
+    layer_cache_invalidate(widget);
+  }
+
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
   widget_set_dirty(iter);
   WIDGET_FOR_EACH_CHILD_END();
@@ -2106,6 +2162,20 @@ static ret_t widget_set_dirty(widget_t* widget) {
   return RET_OK;
 }
 
+/*子孙控件的内容改变后，祖先控件缓存的绘制结果也随之失效*/
+static ret_t widget_invalidate_layers(widget_t* widget) {
+  widget_t* iter = widget;
+
+  while (iter != NULL) {
+    if (iter->cache_layer) {
+      layer_cache_invalidate(iter);
+    }
+    iter = iter->parent;
+  }
+
+  return RET_OK;
+}
+
 ret_t widget_invalidate(widget_t* widget, rect_t* r) {
   rect_t rself;
   if (r == NULL) {
@@ -2115,6 +2185,10 @@ ret_t widget_invalidate(widget_t* widget, rect_t* r) {
 
   return_value_if_fail(widget != NULL && r != NULL, RET_BAD_PARAMS);
 
+  if (layer_cache_count() > 0) {
+    widget_invalidate_layers(widget);
+  }
+
   if (widget->dirty) {
     return RET_OK;
   }
@@ -2228,6 +2302,8 @@ ret_t widget_get_prop_default_value(widget_t* widget, const char* name, value_t*
     value_set_bool(v, TRUE);
   } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
     value_set_bool(v, FALSE);
+  } else if (tk_str_eq(name, WIDGET_PROP_CACHE_LAYER)) {
+    value_set_bool(v, FALSE);
   } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
     value_set_bool(v, FALSE);
   } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
@@ -2341,11 +2417,13 @@ int32_t widget_index_of(widget_t* widget) {
 ret_t widget_prepare_text_style(widget_t* widget, canvas_t* c) {
   style_t* style = widget->astyle;
   color_t trans = color_init(0, 0, 0, 0);
-  color_t tc = style_get_color(style, STYLE_ID_TEXT_COLOR, trans);
-  const char* font_name = style_get_str(style, STYLE_ID_FONT_NAME, NULL);
-  uint16_t font_size = style_get_int(style, STYLE_ID_FONT_SIZE, TK_DEFAULT_FONT_SIZE);
-  align_h_t align_h = (align_h_t)style_get_int(style, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_CENTER);
-  align_v_t align_v = (align_v_t)style_get_int(style, STYLE_ID_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
+  color_t tc = style_get_color_by_id(style, STYLE_PROP_TEXT_COLOR, trans);
+  const char* font_name = style_get_str_by_id(style, STYLE_PROP_FONT_NAME, NULL);
+  uint16_t font_size = style_get_int_by_id(style, STYLE_PROP_FONT_SIZE, TK_DEFAULT_FONT_SIZE);
+  align_h_t align_h =
+      (align_h_t)style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_H, ALIGN_H_CENTER);
+  align_v_t align_v =
+      (align_v_t)style_get_int_by_id(style, STYLE_PROP_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
 
   canvas_set_text_color(c, tc);
   canvas_set_font(c, font_name, font_size);
@@ -2362,6 +2440,7 @@ static const char* s_widget_persistent_props[] = {WIDGET_PROP_NAME,
                                                   WIDGET_PROP_ENABLE,
                                                   WIDGET_PROP_VISIBLE,
                                                   WIDGET_PROP_FLOATING,
+                                                  WIDGET_PROP_CACHE_LAYER,
                                                   WIDGET_PROP_CHILDREN_LAYOUT,
                                                   WIDGET_PROP_SELF_LAYOUT,
                                                   WIDGET_PROP_OPACITY,
@@ -2553,6 +2632,17 @@ ret_t widget_load_image(widget_t* widget, const char* name, bitmap_t* bitmap) {
   return image_manager_get_bitmap(imm, name, bitmap);
 }
 
+ret_t widget_load_image_with_handle(widget_t* widget, const char* name, image_handle_t* handle,
+                                    bitmap_t* bitmap) {
+  image_manager_t* imm = widget_get_image_manager(widget);
+
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget != NULL && name != NULL && handle != NULL && bitmap != NULL,
+                       RET_BAD_PARAMS);
+
+  return image_manager_get_bitmap_with_handle(imm, name, handle, bitmap);
+}
+
 ret_t widget_unload_image(widget_t* widget, bitmap_t* bitmap) {
   image_manager_t* imm = widget_get_image_manager(widget);
 
@@ -2853,9 +2943,18 @@ bool_t widget_is_window_manager(widget_t* widget) {
 }
 
 ret_t widget_set_need_relayout_children(widget_t* widget) {
+  widget_t* iter = NULL;
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
   widget->need_relayout_children = TRUE;
 
+  /*
+   * 一直标识到根控件：布局器跳过的子树(如不可见的控件，或者自定义的on_layout_children只调用
+   * move_resize)会残留标识，所以祖先控件已经标识过，并不意味着它的祖先控件也标识过了。
+   */
+  for (iter = widget->parent; iter != NULL; iter = iter->parent) {
+    iter->need_relayout_descendants = TRUE;
+  }
+
   return RET_OK;
 }
 
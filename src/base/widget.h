@@ -330,12 +330,25 @@ struct _widget_t {
    * 标识控件是否启用浮动布局，不受父控件的children_layout的控制。
    */
   uint8_t floating : 1;
+  /**
+   * @property {bool_t} cache_layer
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 标识是否缓存控件(包括子控件)的绘制结果，适用于内容很少变化但绘制比较费时的控件。
+   * 只对背景色不透明的控件有效(参考layer\_cache\_t)。
+   */
+  uint8_t cache_layer : 1;
   /**
    * @property {bool_t} need_relayout_children
    * @annotation ["readable"]
    * 标识控件是否需要重新layout子控件。
    */
   uint8_t need_relayout_children : 1;
+  /**
+   * @property {bool_t} need_relayout_descendants
+   * @annotation ["readable"]
+   * 标识控件的子孙控件中有需要重新layout子控件的(由widget\_set\_need\_relayout\_children向上传播)。
+   */
+  uint8_t need_relayout_descendants : 1;
   /**
    * @property {uint16_t} can_not_destroy
    * @annotation ["readable"]
@@ -931,6 +944,18 @@ ret_t widget_set_enable(widget_t* widget, bool_t enable);
  */
 ret_t widget_set_floating(widget_t* widget, bool_t floating);
 
+/**
+ * @method widget_set_cache_layer
+ * 设置是否缓存控件的绘制结果。
+ * 控件或子孙控件调用widget\_invalidate时，缓存自动失效。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {bool_t} cache_layer 是否缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_cache_layer(widget_t* widget, bool_t cache_layer);
+
 /**
  * @method widget_set_focused
  * 设置控件的是否聚焦。
@@ -1495,6 +1520,21 @@ uint32_t widget_add_idle(widget_t* widget, idle_func_t on_idle);
  */
 ret_t widget_load_image(widget_t* widget, const char* name, bitmap_t* bitmap);
 
+/**
+ * @method widget_load_image_with_handle
+ * 加载图片，并把结果保存在句柄中。
+ * 句柄有效时(图片没有被卸载且名称不变)直接返回句柄中的图片，用于控件每次绘制都要加载的图片。
+ *
+ * @param {widget_t*} widget 控件对象。
+ * @param {const char*}  name 图片名(不带扩展名)。
+ * @param {image_handle_t*} handle 图片句柄(一般是控件的成员，初始化为0)。
+ * @param {bitmap_t*} bitmap 返回图片对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_load_image_with_handle(widget_t* widget, const char* name, image_handle_t* handle,
+                                    bitmap_t* bitmap);
+
 /**
  * @method widget_unload_image
  * 卸载图片。
@@ -197,6 +197,12 @@ BEGIN_C_DECLS
  */
 #define WIDGET_PROP_FLOATING "floating"
 
+/**
+ * @const WIDGET_PROP_CACHE_LAYER
+ * 是否缓存控件的绘制结果。
+ */
+#define WIDGET_PROP_CACHE_LAYER "cache_layer"
+
 /**
  * @const WIDGET_PROP_MARGIN
  * 边距。
@@ -30,10 +30,10 @@ ret_t widget_invalidate_default(widget_t* widget, rect_t* r) {
   r->x += widget->x;
   r->y += widget->y;
   if (widget->astyle != NULL) {
-    int32_t ox = tk_abs(style_get_int(widget->astyle, STYLE_ID_X_OFFSET, 0));
-    int32_t oy = tk_abs(style_get_int(widget->astyle, STYLE_ID_Y_OFFSET, 0));
-    int32_t br = tk_abs(style_get_int(widget->astyle, STYLE_ID_ROUND_RADIUS, 0));
-    int32_t bw = tk_abs(style_get_int(widget->astyle, STYLE_ID_BORDER_WIDTH, 1)) >> 1;
+    int32_t ox = tk_abs(style_get_int_by_id(widget->astyle, STYLE_PROP_X_OFFSET, 0));
+    int32_t oy = tk_abs(style_get_int_by_id(widget->astyle, STYLE_PROP_Y_OFFSET, 0));
+    int32_t br = tk_abs(style_get_int_by_id(widget->astyle, STYLE_PROP_ROUND_RADIUS, 0));
+    int32_t bw = tk_abs(style_get_int_by_id(widget->astyle, STYLE_PROP_BORDER_WIDTH, 1)) >> 1;
 
     if (br > 0) {
       ox++;
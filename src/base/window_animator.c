@@ -42,9 +42,9 @@ static ret_t window_animator_open_destroy(window_animator_t* wa) {
   vgcanvas_destroy_fbo(vg, &(wa->curr_fbo));
 #else
   if (wa->dialog_highlighter == NULL) {
-    bitmap_destroy(&(wa->prev_img));
+    window_manager_release_snapshot(window_manager(), &(wa->prev_img));
   }
-  bitmap_destroy(&(wa->curr_img));
+  window_manager_release_snapshot(window_manager(), &(wa->curr_img));
 #endif /*WITH_NANOVG_GPU*/
 
   memset(wa, 0x00, sizeof(window_animator_t));
@@ -23,6 +23,7 @@
 #include "tkc/mem.h"
 #include "base/idle.h"
 #include "tkc/utils.h"
+#include "tkc/trace.h"
 #include "base/timer.h"
 #include "base/layout.h"
 #include "tkc/time_now.h"
@@ -146,6 +147,94 @@ static widget_t* window_manager_find_prev_window(widget_t* widget) {
   return NULL;
 }
 
+#if TK_SNAPSHOT_POOL_SIZE > 0
+static uint32_t window_manager_snapshot_size(bitmap_t* img) {
+  return img->data != NULL ? bitmap_get_line_length(img) * img->h : 0;
+}
+
+static ret_t window_manager_take_snapshot(window_manager_t* wm, lcd_t* lcd, bitmap_t* img,
+                                          bool_t auto_rotate) {
+  uint32_t i = 0;
+  bitmap_t* slot = NULL;
+
+  for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+    if (!wm->snapshots[i].used) {
+      slot = &(wm->snapshots[i].img);
+      break;
+    }
+  }
+
+  if (slot == NULL) {
+    memset(img, 0x00, sizeof(bitmap_t));
+    return lcd_take_snapshot(lcd, img, auto_rotate);
+  }
+
+  /*把保留的缓冲区交给lcd，大小和格式一致时直接重用，否则lcd重新分配*/
+  *img = *slot;
+  img->should_free_data = FALSE;
+  return_value_if_fail(lcd_take_snapshot(lcd, img, auto_rotate) == RET_OK, RET_FAIL);
+
+  if (img->data != slot->data) {
+    bitmap_destroy(slot);
+    *slot = *img;
+    img->should_free_data = FALSE;
+  }
+  wm->snapshots[i].used = TRUE;
+
+  return RET_OK;
+}
+
+ret_t window_manager_release_snapshot(widget_t* widget, bitmap_t* img) {
+  uint32_t i = 0;
+  window_manager_t* wm = WINDOW_MANAGER(widget);
+  return_value_if_fail(img != NULL, RET_BAD_PARAMS);
+
+  if (wm != NULL && img->data != NULL) {
+    for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+      if (wm->snapshots[i].used && wm->snapshots[i].img.data == img->data) {
+        wm->snapshots[i].used = FALSE;
+        memset(img, 0x00, sizeof(bitmap_t));
+
+        return RET_OK;
+      }
+    }
+  }
+
+  return bitmap_destroy(img);
+}
+
+uint32_t window_manager_free_unused_snapshots(widget_t* widget) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  window_manager_t* wm = WINDOW_MANAGER(widget);
+  return_value_if_fail(wm != NULL, 0);
+
+  for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+    bitmap_t* slot = &(wm->snapshots[i].img);
+    if (!wm->snapshots[i].used && slot->data != NULL) {
+      size += window_manager_snapshot_size(slot);
+      bitmap_destroy(slot);
+      memset(slot, 0x00, sizeof(bitmap_t));
+    }
+  }
+
+  return size;
+}
+#else
+static ret_t window_manager_take_snapshot(window_manager_t* wm, lcd_t* lcd, bitmap_t* img,
+                                          bool_t auto_rotate) {
+  return lcd_take_snapshot(lcd, img, auto_rotate);
+}
+
+ret_t window_manager_release_snapshot(widget_t* widget, bitmap_t* img) {
+  return bitmap_destroy(img);
+}
+
+uint32_t window_manager_free_unused_snapshots(widget_t* widget) {
+  return 0;
+}
+#endif /*TK_SNAPSHOT_POOL_SIZE > 0*/
+
 ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitmap_t* img,
                                       framebuffer_object_t* fbo, bool_t auto_rotate) {
   canvas_t* c = NULL;
@@ -178,7 +267,7 @@ ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitm
   ENSURE(widget_on_paint_background(widget, c) == RET_OK);
   ENSURE(widget_paint(curr_win, c) == RET_OK);
   ENSURE(canvas_end_frame(c) == RET_OK);
-  ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
+  ENSURE(window_manager_take_snapshot(wm, c->lcd, img, auto_rotate) == RET_OK);
 #endif
 
   return RET_OK;
@@ -232,7 +321,7 @@ ret_t window_manager_snap_prev_window(widget_t* widget, widget_t* prev_win, bitm
     dialog_highlighter_prepare(dialog_highlighter, c);
   }
   ENSURE(canvas_end_frame(c) == RET_OK);
-  ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
+  ENSURE(window_manager_take_snapshot(wm, c->lcd, img, auto_rotate) == RET_OK);
 #endif /*WITH_NANOVG_GPU*/
 
   if (dialog_highlighter != NULL) {
@@ -525,14 +614,13 @@ widget_t* window_manager_find_target(widget_t* widget, xy_t x, xy_t y) {
   return NULL;
 }
 
-static rect_t window_manager_calc_dirty_rect(window_manager_t* wm) {
-  rect_t r = wm->dirty_rect;
+static ret_t window_manager_calc_dirty_rects(window_manager_t* wm, dirty_rects_t* dr) {
   widget_t* widget = WIDGET(wm);
-  rect_t* ldr = &(wm->last_dirty_rect);
 
-  rect_merge(&r, ldr);
+  *dr = wm->dirty_rects;
+  dirty_rects_add_rects(dr, &(wm->last_dirty_rects));
 
-  return rect_fix(&r, widget->w, widget->h);
+  return dirty_rects_fix(dr, widget->w, widget->h);
 }
 
 static ret_t window_manager_paint_cursor(widget_t* widget, canvas_t* c) {
@@ -573,9 +661,29 @@ static ret_t window_manager_update_cursor(widget_t* widget, int32_t x, int32_t y
   return RET_OK;
 }
 
+static ret_t window_manager_paint_dirty_rects(widget_t* widget, canvas_t* c, dirty_rects_t* dr) {
+  uint32_t i = 0;
+
+  if (!(c->lcd->support_dirty_rect)) {
+    ENSURE(widget_paint(widget, c) == RET_OK);
+    window_manager_paint_cursor(widget, c);
+
+    return RET_OK;
+  }
+
+  /*每个脏矩形单独绘制，控件树中只有与之相交的控件才会被绘制*/
+  for (i = 0; i < dr->nr; i++) {
+    canvas_set_dirty_rect(c, dr->rects + i);
+    ENSURE(widget_paint(widget, c) == RET_OK);
+    window_manager_paint_cursor(widget, c);
+  }
+  canvas_set_dirty_rect(c, &(dr->max));
+
+  return RET_OK;
+}
+
 static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
   window_manager_t* wm = WINDOW_MANAGER(widget);
-  rect_t* dr = &(wm->dirty_rect);
 
   window_manager_inc_fps(widget);
 
@@ -584,25 +692,26 @@ static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
     window_manager_invalidate(widget, &fps_rect);
   }
 
-  if (dr->w && dr->h) {
+  if (wm->dirty_rects.nr > 0) {
+    dirty_rects_t dr;
     uint32_t start_time = time_now_ms();
-    rect_t r = window_manager_calc_dirty_rect(wm);
 
-    if (r.w > 0 && r.h > 0) {
-      ENSURE(canvas_begin_frame(c, &r, LCD_DRAW_NORMAL) == RET_OK);
-      ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
-      window_manager_paint_cursor(widget, c);
+    window_manager_calc_dirty_rects(wm, &dr);
+    if (dr.nr > 0) {
+      ENSURE(canvas_begin_frame_rects(c, &dr, LCD_DRAW_NORMAL) == RET_OK);
+      window_manager_paint_dirty_rects(widget, c, &dr);
       ENSURE(canvas_end_frame(c) == RET_OK);
       wm->last_paint_cost = time_now_ms() - start_time;
-      wm->last_dirty_rect = wm->dirty_rect;
+      wm->last_dirty_rects = wm->dirty_rects;
       /*
-        log_debug("%s x=%d y=%d w=%d h=%d cost=%d\n", __FUNCTION__, (int)(r.x), (int)(r.y),
-                (int)(r.w), (int)(r.h), (int)wm->last_paint_cost);
+        log_debug("%s nr=%d x=%d y=%d w=%d h=%d cost=%d\n", __FUNCTION__, (int)(dr.nr),
+                (int)(dr.max.x), (int)(dr.max.y), (int)(dr.max.w), (int)(dr.max.h),
+                (int)wm->last_paint_cost);
       */
     }
   }
 
-  wm->dirty_rect = rect_init(widget->w, widget->h, 0, 0);
+  dirty_rects_reset(&(wm->dirty_rects));
 
   return RET_OK;
 }
@@ -694,12 +803,23 @@ ret_t window_manager_paint(widget_t* widget, canvas_t* c) {
   wm->canvas = c;
   canvas_set_global_alpha(c, 0xff);
   window_manager_update_fps(widget);
+  if (widget_get_image_manager(widget) != NULL) {
+    image_manager_begin_frame(widget_get_image_manager(widget));
+  }
+  tk_mem_profile_begin_frame();
+
+  /*绘制前统一layout需要重新layout的控件，layout产生的脏矩形在本帧一起绘制*/
+  tk_trace_begin("phase", "layout");
+  widget_layout_children_if_needed(widget);
+  tk_trace_end();
 
+  tk_trace_begin("phase", "paint");
   if (wm->animator != NULL) {
     ret = window_manager_paint_animation(widget, c);
   } else {
     ret = window_manager_paint_normal(widget, c);
   }
+  tk_trace_end();
 
   return ret;
 }
@@ -725,11 +845,8 @@ widget_t* window_manager_create(void) {
 
 static ret_t window_manager_invalidate(widget_t* widget, rect_t* r) {
   window_manager_t* wm = WINDOW_MANAGER(widget);
-  rect_t* dr = &(wm->dirty_rect);
-
-  rect_merge(dr, r);
 
-  return RET_OK;
+  return dirty_rects_add(&(wm->dirty_rects), r);
 }
 
 widget_t* window_manager_get_top_main_window(widget_t* widget) {
@@ -842,6 +959,14 @@ static ret_t window_manager_on_destroy(widget_t* widget) {
   window_manager_t* wm = WINDOW_MANAGER(widget);
 
   TKMEM_FREE(wm->cursor);
+#if TK_SNAPSHOT_POOL_SIZE > 0
+  {
+    uint32_t i = 0;
+    for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+      bitmap_destroy(&(wm->snapshots[i].img));
+    }
+  }
+#endif /*TK_SNAPSHOT_POOL_SIZE > 0*/
 
   return RET_OK;
 }
@@ -938,14 +1063,14 @@ ret_t window_manager_layout_children(widget_t* widget) {
 }
 
 ret_t window_manager_resize(widget_t* widget, wh_t w, wh_t h) {
+  rect_t r;
   window_manager_t* wm = WINDOW_MANAGER(widget);
   return_value_if_fail(wm != NULL, RET_BAD_PARAMS);
 
-  wm->dirty_rect.x = 0;
-  wm->dirty_rect.y = 0;
-  wm->dirty_rect.w = w;
-  wm->dirty_rect.h = h;
-  wm->last_dirty_rect = wm->dirty_rect;
+  r = rect_init(0, 0, w, h);
+  dirty_rects_reset(&(wm->dirty_rects));
+  dirty_rects_add(&(wm->dirty_rects), &r);
+  wm->last_dirty_rects = wm->dirty_rects;
   widget_move_resize(widget, 0, 0, w, h);
 
   return window_manager_layout_children(widget);
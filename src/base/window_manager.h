@@ -47,8 +47,8 @@ typedef struct _window_manager_t {
   bool_t show_fps;
 
   /*private*/
-  rect_t dirty_rect;
-  rect_t last_dirty_rect;
+  dirty_rects_t dirty_rects;
+  dirty_rects_t last_dirty_rects;
 
   bool_t animating;
   bool_t ignore_user_input;
@@ -73,6 +73,14 @@ typedef struct _window_manager_t {
 
   dialog_highlighter_t* dialog_highlighter;
   widget_t* prev_win;
+
+#if TK_SNAPSHOT_POOL_SIZE > 0
+  /*快照缓冲区，used为TRUE表示正在被窗口动画或对话框高亮使用*/
+  struct {
+    bitmap_t img;
+    bool_t used;
+  } snapshots[TK_SNAPSHOT_POOL_SIZE];
+#endif /*TK_SNAPSHOT_POOL_SIZE > 0*/
 } window_manager_t;
 
 /**
@@ -291,6 +299,27 @@ ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitm
 ret_t window_manager_snap_prev_window(widget_t* widget, widget_t* prev_win, bitmap_t* img,
                                       framebuffer_object_t* fbo, bool_t auto_rotate);
 
+/**
+ * @method window_manager_release_snapshot
+ * 释放window\_manager\_snap\_xxx\_window返回的快照。
+ *
+ * 快照的缓冲区来自窗口管理器保留的缓冲区时，把缓冲区还给窗口管理器，否则销毁快照。
+ * @param {widget_t*} widget 窗口管理器对象(可以为NULL)。
+ * @param {bitmap_t*} img 快照。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_manager_release_snapshot(widget_t* widget, bitmap_t* img);
+
+/**
+ * @method window_manager_free_unused_snapshots
+ * 释放没有在使用的快照缓冲区(比如内存不足时)。
+ * @param {widget_t*} widget 窗口管理器对象。
+ *
+ * @return {uint32_t} 返回释放的字节数。
+ */
+uint32_t window_manager_free_unused_snapshots(widget_t* widget);
+
 END_C_DECLS
 
 #endif /*TK_WINDOW_MANAGER_H*/
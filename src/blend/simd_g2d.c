@@ -0,0 +1,973 @@
+/**
+ * File:   simd_g2d.c
+ * Author: AWTK Develop Team
+ * Brief:  simd implemented image operations
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "blend/simd_g2d.h"
+
+/*
+ * 所有的函数都必须和标量代码(blend_image.inc/fill_image.inc/pixel.h)的结果完全一致：
+ *
+ * blend: a = alpha == 0xff ? sa : (sa * alpha) >> 8
+ *        a > 0xf8: d = s
+ *        a > 8   : d = (d * (0xff - a) + s * a) >> 8
+ *        其它    : d不变
+ *
+ * fill:  d = ((d * a) >> 8) + c (565格式为((d8 * a + (c << 8)) >> (8 + 丢弃的位数))
+ */
+
+#ifdef WITH_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_HAS_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_HAS_AVX2 1
+#define SIMD_AVX2_FUNC __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif /*__GNUC__*/
+#endif /*__SSE2__*/
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_HAS_NEON 1
+#include <arm_neon.h>
+#endif /*__ARM_NEON*/
+#endif /*WITH_SIMD*/
+
+/*src中红色和蓝色的位置与dst不同时，需要交换*/
+#define SIMD_SWAP_RB(dst_format, src_format) ((dst_format) != (src_format))
+
+#ifdef SIMD_HAS_SSE2
+static inline __m128i sse2_select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i sse2_swap_rb(__m128i x) {
+  __m128i ag = _mm_and_si128(x, _mm_set1_epi32(0xff00ff00));
+  __m128i rb = _mm_and_si128(x, _mm_set1_epi32(0x00ff00ff));
+
+  return _mm_or_si128(ag, _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+}
+
+static inline __m128i sse2_blend_channels(__m128i d, __m128i s, __m128i a) {
+  __m128i ma = _mm_sub_epi16(_mm_set1_epi16(0xff), a);
+
+  return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(d, ma), _mm_mullo_epi16(s, a)), 8);
+}
+
+static inline uint32_t sse2_blend_row_8888(uint8_t* dst, const uint8_t* src, uint32_t nr,
+                                           uint8_t alpha, bool_t swap) {
+  uint32_t i = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i ff = _mm_set1_epi32(0xff000000);
+  __m128i a8 = _mm_set1_epi32(8);
+  __m128i af8 = _mm_set1_epi32(0xf8);
+  __m128i ga = _mm_set1_epi32(alpha);
+
+  for (i = 0; i + 4 <= nr; i += 4) {
+    __m128i* d = (__m128i*)(dst + i * 4);
+    __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    __m128i a = _mm_srli_epi32(s, 24);
+    __m128i opaque;
+    __m128i visible;
+
+    if (alpha != 0xff) {
+      a = _mm_srli_epi32(_mm_mullo_epi16(a, ga), 8);
+    }
+
+    if (swap) {
+      s = sse2_swap_rb(s);
+    }
+    s = _mm_or_si128(s, ff);
+
+    opaque = _mm_cmpgt_epi32(a, af8);
+    visible = _mm_cmpgt_epi32(a, a8);
+
+    if (_mm_movemask_epi8(opaque) == 0xffff) {
+      _mm_storeu_si128(d, s);
+    } else if (_mm_movemask_epi8(visible) != 0) {
+      __m128i dv = _mm_loadu_si128(d);
+      __m128i a16 = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+      __m128i lo = sse2_blend_channels(_mm_unpacklo_epi8(dv, zero), _mm_unpacklo_epi8(s, zero),
+                                       _mm_unpacklo_epi32(a16, a16));
+      __m128i hi = sse2_blend_channels(_mm_unpackhi_epi8(dv, zero), _mm_unpackhi_epi8(s, zero),
+                                       _mm_unpackhi_epi32(a16, a16));
+      __m128i r = _mm_or_si128(_mm_packus_epi16(lo, hi), ff);
+
+      r = sse2_select(opaque, s, r);
+      r = sse2_select(visible, r, dv);
+      _mm_storeu_si128(d, r);
+    }
+  }
+
+  return i;
+}
+
+static inline __m128i sse2_pack_565(__m128i hi, __m128i mid, __m128i lo) {
+  __m128i h = _mm_slli_epi16(_mm_srli_epi16(hi, 3), 11);
+  __m128i m = _mm_slli_epi16(_mm_srli_epi16(mid, 2), 5);
+
+  return _mm_or_si128(_mm_or_si128(h, m), _mm_srli_epi16(lo, 3));
+}
+
+static inline __m128i sse2_channel_16(__m128i s0, __m128i s1, int shift) {
+  __m128i mask = _mm_set1_epi32(0xff);
+
+  return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(s0, shift), mask),
+                         _mm_and_si128(_mm_srli_epi32(s1, shift), mask));
+}
+
+static inline uint32_t sse2_blend_row_565(uint8_t* dst, const uint8_t* src, uint32_t nr,
+                                          uint8_t alpha, int hi_shift, int lo_shift) {
+  uint32_t i = 0;
+  __m128i a8 = _mm_set1_epi16(8);
+  __m128i af8 = _mm_set1_epi16(0xf8);
+  __m128i ga = _mm_set1_epi16(alpha);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    __m128i* d = (__m128i*)(dst + i * 2);
+    __m128i s0 = _mm_loadu_si128((const __m128i*)(src + i * 4));
+    __m128i s1 = _mm_loadu_si128((const __m128i*)(src + i * 4 + 16));
+    __m128i a = _mm_packs_epi32(_mm_srli_epi32(s0, 24), _mm_srli_epi32(s1, 24));
+    __m128i sh = sse2_channel_16(s0, s1, hi_shift);
+    __m128i sm = sse2_channel_16(s0, s1, 8);
+    __m128i sl = sse2_channel_16(s0, s1, lo_shift);
+    __m128i opaque;
+    __m128i visible;
+
+    if (alpha != 0xff) {
+      a = _mm_srli_epi16(_mm_mullo_epi16(a, ga), 8);
+    }
+
+    opaque = _mm_cmpgt_epi16(a, af8);
+    visible = _mm_cmpgt_epi16(a, a8);
+
+    if (_mm_movemask_epi8(opaque) == 0xffff) {
+      _mm_storeu_si128(d, sse2_pack_565(sh, sm, sl));
+    } else if (_mm_movemask_epi8(visible) != 0) {
+      __m128i v = _mm_loadu_si128(d);
+      __m128i dh = _mm_srli_epi16(_mm_and_si128(v, _mm_set1_epi16(0xf800)), 8);
+      __m128i dm = _mm_srli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x07e0)), 3);
+      __m128i dl = _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x1f)), 3);
+      __m128i r = sse2_pack_565(sse2_blend_channels(dh, sh, a), sse2_blend_channels(dm, sm, a),
+                                sse2_blend_channels(dl, sl, a));
+
+      r = sse2_select(opaque, sse2_pack_565(sh, sm, sl), r);
+      r = sse2_select(visible, r, v);
+      _mm_storeu_si128(d, r);
+    }
+  }
+
+  return i;
+}
+
+static inline uint32_t sse2_fill_row_8888(uint8_t* dst, uint32_t nr, uint32_t c, uint8_t a) {
+  uint32_t i = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i mask = _mm_set1_epi16(0xff);
+  __m128i av = _mm_set1_epi16(a);
+  __m128i cv = _mm_unpacklo_epi8(_mm_set1_epi32(c), zero);
+  __m128i keep = _mm_set1_epi32(0xff000000);
+
+  for (i = 0; i + 4 <= nr; i += 4) {
+    __m128i* d = (__m128i*)(dst + i * 4);
+    __m128i dv = _mm_loadu_si128(d);
+    __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dv, zero), av), 8);
+    __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dv, zero), av), 8);
+
+    lo = _mm_and_si128(_mm_add_epi16(lo, cv), mask);
+    hi = _mm_and_si128(_mm_add_epi16(hi, cv), mask);
+    _mm_storeu_si128(d, sse2_select(keep, dv, _mm_packus_epi16(lo, hi)));
+  }
+
+  return i;
+}
+
+static inline uint32_t sse2_fill_row_565(uint8_t* dst, uint32_t nr, uint8_t hi, uint8_t mid,
+                                         uint8_t lo, uint8_t a) {
+  uint32_t i = 0;
+  __m128i av = _mm_set1_epi16(a);
+  __m128i hv = _mm_set1_epi16(hi);
+  __m128i mv = _mm_set1_epi16(mid);
+  __m128i lv = _mm_set1_epi16(lo);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    __m128i* d = (__m128i*)(dst + i * 2);
+    __m128i v = _mm_loadu_si128(d);
+    __m128i dh = _mm_srli_epi16(_mm_and_si128(v, _mm_set1_epi16(0xf800)), 8);
+    __m128i dm = _mm_srli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x07e0)), 3);
+    __m128i dl = _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x1f)), 3);
+
+    /*(d8 * a + (c << 8)) >> n == (((d8 * a) >> 8) + c) >> (n - 8)，避免16位溢出*/
+    dh = _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dh, av), 8), hv), 3);
+    dm = _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dm, av), 8), mv), 2);
+    dl = _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dl, av), 8), lv), 3);
+
+    v = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(dh, 11), _mm_slli_epi16(dm, 5)), dl);
+    _mm_storeu_si128(d, v);
+  }
+
+  return i;
+}
+
+static uint32_t sse2_clear_row16(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  __m128i v = _mm_set1_epi16((short)pixel);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    _mm_storeu_si128((__m128i*)(dst + i * 2), v);
+  }
+
+  return i;
+}
+
+static uint32_t sse2_clear_row32(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  __m128i v = _mm_set1_epi32(pixel);
+
+  for (i = 0; i + 4 <= nr; i += 4) {
+    _mm_storeu_si128((__m128i*)(dst + i * 4), v);
+  }
+
+  return i;
+}
+
+static uint32_t sse2_copy(uint8_t* dst, const uint8_t* src, uint32_t size) {
+  uint32_t i = 0;
+
+  for (i = 0; i + 64 <= size; i += 64) {
+    __m128i v0 = _mm_loadu_si128((const __m128i*)(src + i));
+    __m128i v1 = _mm_loadu_si128((const __m128i*)(src + i + 16));
+    __m128i v2 = _mm_loadu_si128((const __m128i*)(src + i + 32));
+    __m128i v3 = _mm_loadu_si128((const __m128i*)(src + i + 48));
+
+    _mm_storeu_si128((__m128i*)(dst + i), v0);
+    _mm_storeu_si128((__m128i*)(dst + i + 16), v1);
+    _mm_storeu_si128((__m128i*)(dst + i + 32), v2);
+    _mm_storeu_si128((__m128i*)(dst + i + 48), v3);
+  }
+
+  for (; i + 16 <= size; i += 16) {
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_loadu_si128((const __m128i*)(src + i)));
+  }
+
+  return i;
+}
+
+#define SSE2_BLEND_8888(dst, src)                                                             \
+  static uint32_t sse2_blend_##dst##_##src(uint8_t* d, const uint8_t* s, uint32_t nr,        \
+                                           uint8_t alpha) {                                 \
+    return sse2_blend_row_8888(d, s, nr, alpha,                                             \
+                               SIMD_SWAP_RB(BITMAP_FMT_##dst, BITMAP_FMT_##src));           \
+  }
+
+SSE2_BLEND_8888(BGRA8888, RGBA8888)
+SSE2_BLEND_8888(BGRA8888, BGRA8888)
+SSE2_BLEND_8888(RGBA8888, RGBA8888)
+SSE2_BLEND_8888(RGBA8888, BGRA8888)
+
+static uint32_t sse2_blend_BGR565_RGBA8888(uint8_t* d, const uint8_t* s, uint32_t nr,
+                                           uint8_t alpha) {
+  return sse2_blend_row_565(d, s, nr, alpha, 0, 16);
+}
+
+static uint32_t sse2_blend_BGR565_BGRA8888(uint8_t* d, const uint8_t* s, uint32_t nr,
+                                           uint8_t alpha) {
+  return sse2_blend_row_565(d, s, nr, alpha, 16, 0);
+}
+
+static uint32_t sse2_fill_BGRA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return sse2_fill_row_8888(d, nr, c.b | (c.g << 8) | (c.r << 16), c.a);
+}
+
+static uint32_t sse2_fill_RGBA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return sse2_fill_row_8888(d, nr, c.r | (c.g << 8) | (c.b << 16), c.a);
+}
+
+static uint32_t sse2_fill_BGR565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return sse2_fill_row_565(d, nr, c.r, c.g, c.b, c.a);
+}
+
+static uint32_t sse2_fill_RGB565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return sse2_fill_row_565(d, nr, c.b, c.g, c.r, c.a);
+}
+#endif /*SIMD_HAS_SSE2*/
+
+#ifdef SIMD_HAS_AVX2
+static inline SIMD_AVX2_FUNC __m256i avx2_select(__m256i mask, __m256i a, __m256i b) {
+  return _mm256_blendv_epi8(b, a, mask);
+}
+
+static inline SIMD_AVX2_FUNC __m256i avx2_swap_rb(__m256i x) {
+  __m256i ag = _mm256_and_si256(x, _mm256_set1_epi32(0xff00ff00));
+  __m256i rb = _mm256_and_si256(x, _mm256_set1_epi32(0x00ff00ff));
+
+  return _mm256_or_si256(ag,
+                         _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16)));
+}
+
+static inline SIMD_AVX2_FUNC __m256i avx2_blend_channels(__m256i d, __m256i s, __m256i a) {
+  __m256i ma = _mm256_sub_epi16(_mm256_set1_epi16(0xff), a);
+
+  return _mm256_srli_epi16(
+      _mm256_add_epi16(_mm256_mullo_epi16(d, ma), _mm256_mullo_epi16(s, a)), 8);
+}
+
+static inline SIMD_AVX2_FUNC uint32_t avx2_blend_row_8888(uint8_t* dst, const uint8_t* src,
+                                                          uint32_t nr, uint8_t alpha,
+                                                          bool_t swap) {
+  uint32_t i = 0;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i ff = _mm256_set1_epi32(0xff000000);
+  __m256i a8 = _mm256_set1_epi32(8);
+  __m256i af8 = _mm256_set1_epi32(0xf8);
+  __m256i ga = _mm256_set1_epi32(alpha);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    __m256i* d = (__m256i*)(dst + i * 4);
+    __m256i s = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+    __m256i a = _mm256_srli_epi32(s, 24);
+    __m256i opaque;
+    __m256i visible;
+
+    if (alpha != 0xff) {
+      a = _mm256_srli_epi32(_mm256_mullo_epi16(a, ga), 8);
+    }
+
+    if (swap) {
+      s = avx2_swap_rb(s);
+    }
+    s = _mm256_or_si256(s, ff);
+
+    opaque = _mm256_cmpgt_epi32(a, af8);
+    visible = _mm256_cmpgt_epi32(a, a8);
+
+    if (_mm256_movemask_epi8(opaque) == -1) {
+      _mm256_storeu_si256(d, s);
+    } else if (_mm256_movemask_epi8(visible) != 0) {
+      __m256i dv = _mm256_loadu_si256(d);
+      __m256i a16 = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+      __m256i lo =
+          avx2_blend_channels(_mm256_unpacklo_epi8(dv, zero), _mm256_unpacklo_epi8(s, zero),
+                              _mm256_unpacklo_epi32(a16, a16));
+      __m256i hi =
+          avx2_blend_channels(_mm256_unpackhi_epi8(dv, zero), _mm256_unpackhi_epi8(s, zero),
+                              _mm256_unpackhi_epi32(a16, a16));
+      __m256i r = _mm256_or_si256(_mm256_packus_epi16(lo, hi), ff);
+
+      r = avx2_select(opaque, s, r);
+      r = avx2_select(visible, r, dv);
+      _mm256_storeu_si256(d, r);
+    }
+  }
+
+  return i;
+}
+
+static inline SIMD_AVX2_FUNC __m256i avx2_pack_565(__m256i hi, __m256i mid, __m256i lo) {
+  __m256i h = _mm256_slli_epi16(_mm256_srli_epi16(hi, 3), 11);
+  __m256i m = _mm256_slli_epi16(_mm256_srli_epi16(mid, 2), 5);
+
+  return _mm256_or_si256(_mm256_or_si256(h, m), _mm256_srli_epi16(lo, 3));
+}
+
+/*packs按128位分别处理，需要重新排列成0-15的顺序*/
+static inline SIMD_AVX2_FUNC __m256i avx2_channel_16(__m256i s0, __m256i s1, int shift) {
+  __m256i mask = _mm256_set1_epi32(0xff);
+  __m256i v = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(s0, shift), mask),
+                                 _mm256_and_si256(_mm256_srli_epi32(s1, shift), mask));
+
+  return _mm256_permute4x64_epi64(v, 0xd8);
+}
+
+static inline SIMD_AVX2_FUNC uint32_t avx2_blend_row_565(uint8_t* dst, const uint8_t* src,
+                                                         uint32_t nr, uint8_t alpha,
+                                                         int hi_shift, int lo_shift) {
+  uint32_t i = 0;
+  __m256i a8 = _mm256_set1_epi16(8);
+  __m256i af8 = _mm256_set1_epi16(0xf8);
+  __m256i ga = _mm256_set1_epi16(alpha);
+
+  for (i = 0; i + 16 <= nr; i += 16) {
+    __m256i* d = (__m256i*)(dst + i * 2);
+    __m256i s0 = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+    __m256i s1 = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+    __m256i a = avx2_channel_16(s0, s1, 24);
+    __m256i sh = avx2_channel_16(s0, s1, hi_shift);
+    __m256i sm = avx2_channel_16(s0, s1, 8);
+    __m256i sl = avx2_channel_16(s0, s1, lo_shift);
+    __m256i opaque;
+    __m256i visible;
+
+    if (alpha != 0xff) {
+      a = _mm256_srli_epi16(_mm256_mullo_epi16(a, ga), 8);
+    }
+
+    opaque = _mm256_cmpgt_epi16(a, af8);
+    visible = _mm256_cmpgt_epi16(a, a8);
+
+    if (_mm256_movemask_epi8(opaque) == -1) {
+      _mm256_storeu_si256(d, avx2_pack_565(sh, sm, sl));
+    } else if (_mm256_movemask_epi8(visible) != 0) {
+      __m256i v = _mm256_loadu_si256(d);
+      __m256i dh = _mm256_srli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0xf800)), 8);
+      __m256i dm = _mm256_srli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x07e0)), 3);
+      __m256i dl = _mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x1f)), 3);
+      __m256i r = avx2_pack_565(avx2_blend_channels(dh, sh, a), avx2_blend_channels(dm, sm, a),
+                                avx2_blend_channels(dl, sl, a));
+
+      r = avx2_select(opaque, avx2_pack_565(sh, sm, sl), r);
+      r = avx2_select(visible, r, v);
+      _mm256_storeu_si256(d, r);
+    }
+  }
+
+  return i;
+}
+
+static inline SIMD_AVX2_FUNC uint32_t avx2_fill_row_8888(uint8_t* dst, uint32_t nr, uint32_t c,
+                                                         uint8_t a) {
+  uint32_t i = 0;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i mask = _mm256_set1_epi16(0xff);
+  __m256i av = _mm256_set1_epi16(a);
+  __m256i cv = _mm256_unpacklo_epi8(_mm256_set1_epi32(c), zero);
+  __m256i keep = _mm256_set1_epi32(0xff000000);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    __m256i* d = (__m256i*)(dst + i * 4);
+    __m256i dv = _mm256_loadu_si256(d);
+    __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(dv, zero), av), 8);
+    __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(dv, zero), av), 8);
+
+    lo = _mm256_and_si256(_mm256_add_epi16(lo, cv), mask);
+    hi = _mm256_and_si256(_mm256_add_epi16(hi, cv), mask);
+    _mm256_storeu_si256(d, avx2_select(keep, dv, _mm256_packus_epi16(lo, hi)));
+  }
+
+  return i;
+}
+
+static inline SIMD_AVX2_FUNC uint32_t avx2_fill_row_565(uint8_t* dst, uint32_t nr, uint8_t hi,
+                                                        uint8_t mid, uint8_t lo, uint8_t a) {
+  uint32_t i = 0;
+  __m256i av = _mm256_set1_epi16(a);
+  __m256i hv = _mm256_set1_epi16(hi);
+  __m256i mv = _mm256_set1_epi16(mid);
+  __m256i lv = _mm256_set1_epi16(lo);
+
+  for (i = 0; i + 16 <= nr; i += 16) {
+    __m256i* d = (__m256i*)(dst + i * 2);
+    __m256i v = _mm256_loadu_si256(d);
+    __m256i dh = _mm256_srli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0xf800)), 8);
+    __m256i dm = _mm256_srli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x07e0)), 3);
+    __m256i dl = _mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x1f)), 3);
+
+    dh = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(dh, av), 8), hv), 3);
+    dm = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(dm, av), 8), mv), 2);
+    dl = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(dl, av), 8), lv), 3);
+
+    v = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(dh, 11), _mm256_slli_epi16(dm, 5)),
+                        dl);
+    _mm256_storeu_si256(d, v);
+  }
+
+  return i;
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_clear_row16(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  __m256i v = _mm256_set1_epi16((short)pixel);
+
+  for (i = 0; i + 16 <= nr; i += 16) {
+    _mm256_storeu_si256((__m256i*)(dst + i * 2), v);
+  }
+
+  return i;
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_clear_row32(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  __m256i v = _mm256_set1_epi32(pixel);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    _mm256_storeu_si256((__m256i*)(dst + i * 4), v);
+  }
+
+  return i;
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_copy(uint8_t* dst, const uint8_t* src, uint32_t size) {
+  uint32_t i = 0;
+
+  for (i = 0; i + 64 <= size; i += 64) {
+    __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + i));
+    __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+
+    _mm256_storeu_si256((__m256i*)(dst + i), v0);
+    _mm256_storeu_si256((__m256i*)(dst + i + 32), v1);
+  }
+
+  for (; i + 32 <= size; i += 32) {
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_loadu_si256((const __m256i*)(src + i)));
+  }
+
+  return i;
+}
+
+#define AVX2_BLEND_8888(dst, src)                                                        \
+  static SIMD_AVX2_FUNC uint32_t avx2_blend_##dst##_##src(uint8_t* d, const uint8_t* s, \
+                                                          uint32_t nr, uint8_t alpha) { \
+    return avx2_blend_row_8888(d, s, nr, alpha,                                        \
+                               SIMD_SWAP_RB(BITMAP_FMT_##dst, BITMAP_FMT_##src));      \
+  }
+
+AVX2_BLEND_8888(BGRA8888, RGBA8888)
+AVX2_BLEND_8888(BGRA8888, BGRA8888)
+AVX2_BLEND_8888(RGBA8888, RGBA8888)
+AVX2_BLEND_8888(RGBA8888, BGRA8888)
+
+static SIMD_AVX2_FUNC uint32_t avx2_blend_BGR565_RGBA8888(uint8_t* d, const uint8_t* s,
+                                                          uint32_t nr, uint8_t alpha) {
+  return avx2_blend_row_565(d, s, nr, alpha, 0, 16);
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_blend_BGR565_BGRA8888(uint8_t* d, const uint8_t* s,
+                                                          uint32_t nr, uint8_t alpha) {
+  return avx2_blend_row_565(d, s, nr, alpha, 16, 0);
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_fill_BGRA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return avx2_fill_row_8888(d, nr, c.b | (c.g << 8) | (c.r << 16), c.a);
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_fill_RGBA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return avx2_fill_row_8888(d, nr, c.r | (c.g << 8) | (c.b << 16), c.a);
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_fill_BGR565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return avx2_fill_row_565(d, nr, c.r, c.g, c.b, c.a);
+}
+
+static SIMD_AVX2_FUNC uint32_t avx2_fill_RGB565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return avx2_fill_row_565(d, nr, c.b, c.g, c.r, c.a);
+}
+
+static bool_t avx2_supported(void) {
+  __builtin_cpu_init();
+
+  return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+}
+#endif /*SIMD_HAS_AVX2*/
+
+#ifdef SIMD_HAS_NEON
+static inline uint8x8_t neon_blend_channel(uint8x8_t d, uint8x8_t s, uint8x8_t a,
+                                           uint8x8_t opaque, uint8x8_t visible) {
+  uint8x8_t r = vshrn_n_u16(vmlal_u8(vmull_u8(d, vmvn_u8(a)), s, a), 8);
+
+  return vbsl_u8(visible, vbsl_u8(opaque, s, r), d);
+}
+
+static inline uint32_t neon_blend_row_8888(uint8_t* dst, const uint8_t* src, uint32_t nr,
+                                           uint8_t alpha, bool_t swap) {
+  uint32_t i = 0;
+  uint8x8_t a8 = vdup_n_u8(8);
+  uint8x8_t af8 = vdup_n_u8(0xf8);
+  uint8x8_t ga = vdup_n_u8(alpha);
+  uint8x8_t ff = vdup_n_u8(0xff);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    uint8x8x4_t s = vld4_u8(src + i * 4);
+    uint8x8x4_t d = vld4_u8(dst + i * 4);
+    uint8x8_t a = s.val[3];
+    uint8x8_t opaque;
+    uint8x8_t visible;
+    uint8x8_t sr = swap ? s.val[2] : s.val[0];
+    uint8x8_t sb = swap ? s.val[0] : s.val[2];
+
+    if (alpha != 0xff) {
+      a = vshrn_n_u16(vmull_u8(a, ga), 8);
+    }
+
+    opaque = vcgt_u8(a, af8);
+    visible = vcgt_u8(a, a8);
+
+    d.val[0] = neon_blend_channel(d.val[0], sr, a, opaque, visible);
+    d.val[1] = neon_blend_channel(d.val[1], s.val[1], a, opaque, visible);
+    d.val[2] = neon_blend_channel(d.val[2], sb, a, opaque, visible);
+    d.val[3] = vbsl_u8(visible, ff, d.val[3]);
+    vst4_u8(dst + i * 4, d);
+  }
+
+  return i;
+}
+
+static inline uint16x8_t neon_pack_565(uint8x8_t hi, uint8x8_t mid, uint8x8_t lo) {
+  uint16x8_t h = vshlq_n_u16(vmovl_u8(vshr_n_u8(hi, 3)), 11);
+  uint16x8_t m = vshlq_n_u16(vmovl_u8(vshr_n_u8(mid, 2)), 5);
+
+  return vorrq_u16(vorrq_u16(h, m), vmovl_u8(vshr_n_u8(lo, 3)));
+}
+
+static inline uint32_t neon_blend_row_565(uint8_t* dst, const uint8_t* src, uint32_t nr,
+                                          uint8_t alpha, bool_t swap) {
+  uint32_t i = 0;
+  uint8x8_t a8 = vdup_n_u8(8);
+  uint8x8_t af8 = vdup_n_u8(0xf8);
+  uint8x8_t ga = vdup_n_u8(alpha);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    uint16_t* d = (uint16_t*)(dst + i * 2);
+    uint8x8x4_t s = vld4_u8(src + i * 4);
+    uint16x8_t v = vld1q_u16(d);
+    uint8x8_t a = s.val[3];
+    uint8x8_t sh = swap ? s.val[2] : s.val[0];
+    uint8x8_t sl = swap ? s.val[0] : s.val[2];
+    uint8x8_t dh = vmovn_u16(vshrq_n_u16(vandq_u16(v, vdupq_n_u16(0xf800)), 8));
+    uint8x8_t dm = vmovn_u16(vshrq_n_u16(vandq_u16(v, vdupq_n_u16(0x07e0)), 3));
+    uint8x8_t dl = vmovn_u16(vshlq_n_u16(vandq_u16(v, vdupq_n_u16(0x1f)), 3));
+    uint8x8_t opaque;
+    uint8x8_t visible;
+
+    if (alpha != 0xff) {
+      a = vshrn_n_u16(vmull_u8(a, ga), 8);
+    }
+
+    opaque = vcgt_u8(a, af8);
+    visible = vcgt_u8(a, a8);
+
+    dh = neon_blend_channel(dh, sh, a, opaque, visible);
+    dm = neon_blend_channel(dm, s.val[1], a, opaque, visible);
+    dl = neon_blend_channel(dl, sl, a, opaque, visible);
+    vst1q_u16(d, neon_pack_565(dh, dm, dl));
+  }
+
+  return i;
+}
+
+static inline uint32_t neon_fill_row_8888(uint8_t* dst, uint32_t nr, uint8_t c0, uint8_t c1,
+                                          uint8_t c2, uint8_t a) {
+  uint32_t i = 0;
+  uint8x8_t av = vdup_n_u8(a);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    uint8x8x4_t d = vld4_u8(dst + i * 4);
+
+    d.val[0] = vadd_u8(vshrn_n_u16(vmull_u8(d.val[0], av), 8), vdup_n_u8(c0));
+    d.val[1] = vadd_u8(vshrn_n_u16(vmull_u8(d.val[1], av), 8), vdup_n_u8(c1));
+    d.val[2] = vadd_u8(vshrn_n_u16(vmull_u8(d.val[2], av), 8), vdup_n_u8(c2));
+    vst4_u8(dst + i * 4, d);
+  }
+
+  return i;
+}
+
+static inline uint32_t neon_fill_row_565(uint8_t* dst, uint32_t nr, uint8_t hi, uint8_t mid,
+                                         uint8_t lo, uint8_t a) {
+  uint32_t i = 0;
+  uint16x8_t av = vdupq_n_u16(a);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    uint16_t* d = (uint16_t*)(dst + i * 2);
+    uint16x8_t v = vld1q_u16(d);
+    uint16x8_t dh = vshrq_n_u16(vandq_u16(v, vdupq_n_u16(0xf800)), 8);
+    uint16x8_t dm = vshrq_n_u16(vandq_u16(v, vdupq_n_u16(0x07e0)), 3);
+    uint16x8_t dl = vshlq_n_u16(vandq_u16(v, vdupq_n_u16(0x1f)), 3);
+
+    dh = vshrq_n_u16(vaddq_u16(vshrq_n_u16(vmulq_u16(dh, av), 8), vdupq_n_u16(hi)), 3);
+    dm = vshrq_n_u16(vaddq_u16(vshrq_n_u16(vmulq_u16(dm, av), 8), vdupq_n_u16(mid)), 2);
+    dl = vshrq_n_u16(vaddq_u16(vshrq_n_u16(vmulq_u16(dl, av), 8), vdupq_n_u16(lo)), 3);
+
+    v = vorrq_u16(vorrq_u16(vshlq_n_u16(dh, 11), vshlq_n_u16(dm, 5)), dl);
+    vst1q_u16(d, v);
+  }
+
+  return i;
+}
+
+static uint32_t neon_clear_row16(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  uint16x8_t v = vdupq_n_u16((uint16_t)pixel);
+
+  for (i = 0; i + 8 <= nr; i += 8) {
+    vst1q_u16((uint16_t*)(dst + i * 2), v);
+  }
+
+  return i;
+}
+
+static uint32_t neon_clear_row32(uint8_t* dst, uint32_t nr, uint32_t pixel) {
+  uint32_t i = 0;
+  uint32x4_t v = vdupq_n_u32(pixel);
+
+  for (i = 0; i + 4 <= nr; i += 4) {
+    vst1q_u32((uint32_t*)(dst + i * 4), v);
+  }
+
+  return i;
+}
+
+static uint32_t neon_copy(uint8_t* dst, const uint8_t* src, uint32_t size) {
+  uint32_t i = 0;
+
+  for (i = 0; i + 16 <= size; i += 16) {
+    vst1q_u8(dst + i, vld1q_u8(src + i));
+  }
+
+  return i;
+}
+
+#define NEON_BLEND_8888(dst, src)                                                            \
+  static uint32_t neon_blend_##dst##_##src(uint8_t* d, const uint8_t* s, uint32_t nr,       \
+                                           uint8_t alpha) {                                \
+    return neon_blend_row_8888(d, s, nr, alpha,                                            \
+                               SIMD_SWAP_RB(BITMAP_FMT_##dst, BITMAP_FMT_##src));          \
+  }
+
+NEON_BLEND_8888(BGRA8888, RGBA8888)
+NEON_BLEND_8888(BGRA8888, BGRA8888)
+NEON_BLEND_8888(RGBA8888, RGBA8888)
+NEON_BLEND_8888(RGBA8888, BGRA8888)
+
+static uint32_t neon_blend_BGR565_RGBA8888(uint8_t* d, const uint8_t* s, uint32_t nr,
+                                           uint8_t alpha) {
+  return neon_blend_row_565(d, s, nr, alpha, FALSE);
+}
+
+static uint32_t neon_blend_BGR565_BGRA8888(uint8_t* d, const uint8_t* s, uint32_t nr,
+                                           uint8_t alpha) {
+  return neon_blend_row_565(d, s, nr, alpha, TRUE);
+}
+
+static uint32_t neon_fill_BGRA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return neon_fill_row_8888(d, nr, c.b, c.g, c.r, c.a);
+}
+
+static uint32_t neon_fill_RGBA8888(uint8_t* d, uint32_t nr, rgba_t c) {
+  return neon_fill_row_8888(d, nr, c.r, c.g, c.b, c.a);
+}
+
+static uint32_t neon_fill_BGR565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return neon_fill_row_565(d, nr, c.r, c.g, c.b, c.a);
+}
+
+static uint32_t neon_fill_RGB565(uint8_t* d, uint32_t nr, rgba_t c) {
+  return neon_fill_row_565(d, nr, c.b, c.g, c.r, c.a);
+}
+#endif /*SIMD_HAS_NEON*/
+
+static bool_t s_simd_inited = FALSE;
+static simd_type_t s_simd_type = SIMD_NONE;
+
+static bool_t simd_g2d_is_supported(simd_type_t type) {
+  switch (type) {
+    case SIMD_NONE: {
+      return TRUE;
+    }
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2: {
+      return TRUE;
+    }
+#endif /*SIMD_HAS_SSE2*/
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2: {
+      return avx2_supported();
+    }
+#endif /*SIMD_HAS_AVX2*/
+#ifdef SIMD_HAS_NEON
+    case SIMD_NEON: {
+      return TRUE;
+    }
+#endif /*SIMD_HAS_NEON*/
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+simd_type_t simd_g2d_detect(void) {
+  if (simd_g2d_is_supported(SIMD_AVX2)) {
+    return SIMD_AVX2;
+  } else if (simd_g2d_is_supported(SIMD_SSE2)) {
+    return SIMD_SSE2;
+  } else if (simd_g2d_is_supported(SIMD_NEON)) {
+    return SIMD_NEON;
+  }
+
+  return SIMD_NONE;
+}
+
+simd_type_t simd_g2d_get_type(void) {
+  if (!s_simd_inited) {
+    s_simd_type = simd_g2d_detect();
+    s_simd_inited = TRUE;
+  }
+
+  return s_simd_type;
+}
+
+ret_t simd_g2d_set_type(simd_type_t type) {
+  if (!simd_g2d_is_supported(type)) {
+    return RET_NOT_IMPL;
+  }
+
+  s_simd_type = type;
+  s_simd_inited = TRUE;
+
+  return RET_OK;
+}
+
+#define SIMD_BLEND_ROW(prefix, dst, src) \
+  if (dst_format == BITMAP_FMT_##dst && src_format == BITMAP_FMT_##src) { \
+    return prefix##_blend_##dst##_##src;                                  \
+  }
+
+#define SIMD_BLEND_ROWS(prefix)                \
+  SIMD_BLEND_ROW(prefix, BGRA8888, RGBA8888)   \
+  SIMD_BLEND_ROW(prefix, BGRA8888, BGRA8888)   \
+  SIMD_BLEND_ROW(prefix, RGBA8888, RGBA8888)   \
+  SIMD_BLEND_ROW(prefix, RGBA8888, BGRA8888)   \
+  SIMD_BLEND_ROW(prefix, BGR565, RGBA8888)     \
+  SIMD_BLEND_ROW(prefix, BGR565, BGRA8888)
+
+simd_blend_row_t simd_g2d_get_blend_row(bitmap_format_t dst_format, bitmap_format_t src_format) {
+  switch (simd_g2d_get_type()) {
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2: {
+      SIMD_BLEND_ROWS(sse2);
+      break;
+    }
+#endif /*SIMD_HAS_SSE2*/
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2: {
+      SIMD_BLEND_ROWS(avx2);
+      break;
+    }
+#endif /*SIMD_HAS_AVX2*/
+#ifdef SIMD_HAS_NEON
+    case SIMD_NEON: {
+      SIMD_BLEND_ROWS(neon);
+      break;
+    }
+#endif /*SIMD_HAS_NEON*/
+    default:
+      break;
+  }
+
+  (void)dst_format;
+  (void)src_format;
+
+  return NULL;
+}
+
+#define SIMD_FILL_ROW(prefix, dst)     \
+  if (format == BITMAP_FMT_##dst) {    \
+    return prefix##_fill_##dst;        \
+  }
+
+#define SIMD_FILL_ROWS(prefix)        \
+  SIMD_FILL_ROW(prefix, BGRA8888)     \
+  SIMD_FILL_ROW(prefix, RGBA8888)     \
+  SIMD_FILL_ROW(prefix, BGR565)       \
+  SIMD_FILL_ROW(prefix, RGB565)
+
+simd_fill_row_t simd_g2d_get_fill_row(bitmap_format_t format) {
+  switch (simd_g2d_get_type()) {
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2: {
+      SIMD_FILL_ROWS(sse2);
+      break;
+    }
+#endif /*SIMD_HAS_SSE2*/
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2: {
+      SIMD_FILL_ROWS(avx2);
+      break;
+    }
+#endif /*SIMD_HAS_AVX2*/
+#ifdef SIMD_HAS_NEON
+    case SIMD_NEON: {
+      SIMD_FILL_ROWS(neon);
+      break;
+    }
+#endif /*SIMD_HAS_NEON*/
+    default:
+      break;
+  }
+
+  (void)format;
+
+  return NULL;
+}
+
+simd_clear_row_t simd_g2d_get_clear_row(uint32_t bpp) {
+  switch (simd_g2d_get_type()) {
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2: {
+      return bpp == 2 ? sse2_clear_row16 : (bpp == 4 ? sse2_clear_row32 : NULL);
+    }
+#endif /*SIMD_HAS_SSE2*/
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2: {
+      return bpp == 2 ? avx2_clear_row16 : (bpp == 4 ? avx2_clear_row32 : NULL);
+    }
+#endif /*SIMD_HAS_AVX2*/
+#ifdef SIMD_HAS_NEON
+    case SIMD_NEON: {
+      return bpp == 2 ? neon_clear_row16 : (bpp == 4 ? neon_clear_row32 : NULL);
+    }
+#endif /*SIMD_HAS_NEON*/
+    default:
+      break;
+  }
+
+  (void)bpp;
+
+  return NULL;
+}
+
+simd_copy_t simd_g2d_get_copy(void) {
+#ifndef HAS_FAST_MEMCPY
+  switch (simd_g2d_get_type()) {
+#ifdef SIMD_HAS_SSE2
+    case SIMD_SSE2: {
+      return sse2_copy;
+    }
+#endif /*SIMD_HAS_SSE2*/
+#ifdef SIMD_HAS_AVX2
+    case SIMD_AVX2: {
+      return avx2_copy;
+    }
+#endif /*SIMD_HAS_AVX2*/
+#ifdef SIMD_HAS_NEON
+    case SIMD_NEON: {
+      return neon_copy;
+    }
+#endif /*SIMD_HAS_NEON*/
+    default:
+      break;
+  }
+#endif /*HAS_FAST_MEMCPY*/
+
+  return NULL;
+}
@@ -0,0 +1,131 @@
+﻿/**
+ * File:   simd_g2d.h
+ * Author: AWTK Develop Team
+ * Brief:  simd implemented image operations
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SIMD_G2D_H
+#define TK_SIMD_G2D_H
+
+#include "tkc/color.h"
+#include "base/bitmap.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum simd_type_t
+ * @prefix SIMD_
+ * SIMD指令集类型。
+ */
+typedef enum _simd_type_t {
+  /**
+   * @const SIMD_NONE
+   * 不使用SIMD指令(标量代码)。
+   */
+  SIMD_NONE = 0,
+  /**
+   * @const SIMD_SSE2
+   * x86 SSE2。
+   */
+  SIMD_SSE2,
+  /**
+   * @const SIMD_AVX2
+   * x86 AVX2。
+   */
+  SIMD_AVX2,
+  /**
+   * @const SIMD_NEON
+   * ARM NEON。
+   */
+  SIMD_NEON
+} simd_type_t;
+
+/*
+ * 下面的函数只处理一行中前面的若干个像素(向量宽度的整数倍)，返回处理的像素(字节)个数，
+ * 剩下的像素由调用者用标量代码处理，两者的结果完全一致。
+ */
+typedef uint32_t (*simd_blend_row_t)(uint8_t* dst, const uint8_t* src, uint32_t nr,
+                                     uint8_t alpha);
+typedef uint32_t (*simd_fill_row_t)(uint8_t* dst, uint32_t nr, rgba_t rgba);
+typedef uint32_t (*simd_clear_row_t)(uint8_t* dst, uint32_t nr, uint32_t pixel);
+typedef uint32_t (*simd_copy_t)(uint8_t* dst, const uint8_t* src, uint32_t size);
+
+/**
+ * @method simd_g2d_detect
+ * 检测CPU支持的最好的SIMD指令集(受编译选项WITH_SIMD的限制)。
+ *
+ * @return {simd_type_t} 返回SIMD指令集类型。
+ */
+simd_type_t simd_g2d_detect(void);
+
+/**
+ * @method simd_g2d_get_type
+ * 获取当前使用的SIMD指令集。第一次调用时自动检测。
+ *
+ * @return {simd_type_t} 返回SIMD指令集类型。
+ */
+simd_type_t simd_g2d_get_type(void);
+
+/**
+ * @method simd_g2d_set_type
+ * 设置使用的SIMD指令集(主要用于测试和性能对比)。
+ * @param {simd_type_t} type SIMD指令集类型，SIMD_NONE表示只用标量代码。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，CPU或编译选项不支持时返回RET_NOT_IMPL。
+ */
+ret_t simd_g2d_set_type(simd_type_t type);
+
+/**
+ * @method simd_g2d_get_blend_row
+ * 获取把src合成到dst上的函数(alpha的语义与blend\_image\_xxx一致)。
+ * @param {bitmap_format_t} dst_format 目标格式。
+ * @param {bitmap_format_t} src_format 源格式。
+ *
+ * @return {simd_blend_row_t} 不支持时返回NULL。
+ */
+simd_blend_row_t simd_g2d_get_blend_row(bitmap_format_t dst_format, bitmap_format_t src_format);
+
+/**
+ * @method simd_g2d_get_fill_row
+ * 获取半透明填充的函数(rgba为预乘后的颜色，rgba.a为255-a，语义与fill\_image一致)。
+ * @param {bitmap_format_t} format 目标格式。
+ *
+ * @return {simd_fill_row_t} 不支持时返回NULL。
+ */
+simd_fill_row_t simd_g2d_get_fill_row(bitmap_format_t format);
+
+/**
+ * @method simd_g2d_get_clear_row
+ * 获取用指定像素值填充的函数。
+ * @param {uint32_t} bpp 每个像素占用的字节数(只支持2和4)。
+ *
+ * @return {simd_clear_row_t} 不支持时返回NULL。
+ */
+simd_clear_row_t simd_g2d_get_clear_row(uint32_t bpp);
+
+/**
+ * @method simd_g2d_get_copy
+ * 获取拷贝内存的函数(size和返回值的单位为字节)。定义了HAS\_FAST\_MEMCPY时返回NULL。
+ *
+ * @return {simd_copy_t} 不支持时返回NULL。
+ */
+simd_copy_t simd_g2d_get_copy(void);
+
+END_C_DECLS
+
+#endif /*TK_SIMD_G2D_H*/
@@ -22,6 +22,7 @@
 #include "tkc/utils.h"
 #include "base/pixel.h"
 #include "blend/soft_g2d.h"
+#include "blend/simd_g2d.h"
 #include "base/pixel_pack_unpack.h"
 
 #include "blend_image_bgr565_bgr565.h"
@@ -53,12 +54,28 @@
 #include "rotate_image_rgb565.h"
 #include "rotate_image_rgba8888.h"
 
+static ret_t soft_copy_pixels(uint8_t* dst, const uint8_t* src, uint32_t size, uint8_t bpp,
+                              simd_copy_t copy) {
+  if (copy != NULL) {
+    uint32_t n = copy(dst, src, size * bpp);
+
+    if (n < size * bpp) {
+      memcpy(dst + n, src + n, size * bpp - n);
+    }
+  } else {
+    tk_pixel_copy(dst, src, size, bpp);
+  }
+
+  return RET_OK;
+}
+
 ret_t soft_copy_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, xy_t dx, xy_t dy) {
   uint8_t* src_p = NULL;
   uint8_t* dst_p = NULL;
   uint32_t bpp = bitmap_get_bpp(dst);
   uint32_t dst_line_length = bitmap_get_line_length(dst);
   uint32_t src_line_length = bitmap_get_line_length(src);
+  simd_copy_t copy = simd_g2d_get_copy();
   return_value_if_fail(dst != NULL && src != NULL && src_r != NULL, RET_BAD_PARAMS);
   return_value_if_fail(dst->format == src->format, RET_BAD_PARAMS);
 
@@ -67,7 +84,7 @@ ret_t soft_copy_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, xy_t dx, xy_t
   if ((dst->w * bpp == dst_line_length) && (src->w * bpp == src_line_length) && dst->w == src->w &&
       dst->h == src->h && src_r->w == src->w && src_r->x == 0) {
     uint32_t size = (src_r->w * src_r->h);
-    tk_pixel_copy(dst_p, src_p, size, bpp);
+    soft_copy_pixels(dst_p, src_p, size, bpp, copy);
 
     return RET_OK;
   } else {
@@ -75,7 +92,7 @@ ret_t soft_copy_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, xy_t dx, xy_t
     uint32_t size = src_r->w;
 
     for (i = 0; i < src_r->h; i++) {
-      tk_pixel_copy(dst_p, src_p, size, bpp);
+      soft_copy_pixels(dst_p, src_p, size, bpp, copy);
       dst_p += dst_line_length;
       src_p += src_line_length;
     }
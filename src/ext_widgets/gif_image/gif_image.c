@@ -21,6 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "base/idle.h"
 #include "base/timer.h"
 #include "base/widget_vtable.h"
 #include "gif_image/gif_image.h"
@@ -62,12 +63,77 @@ static ret_t gif_image_on_timer(const timer_info_t* info) {
 }
 #endif /*AWTK_WEB*/
 
+#ifndef AWTK_WEB
+static ret_t gif_image_unload_decoder(widget_t* widget) {
+  gif_image_t* image = GIF_IMAGE(widget);
+  return_value_if_fail(image != NULL, RET_BAD_PARAMS);
+
+  if (image->idle_id != TK_INVALID_ID) {
+    idle_remove(image->idle_id);
+    image->idle_id = TK_INVALID_ID;
+  }
+
+  if (image->decoder != NULL) {
+    gif_decoder_destroy(image->decoder);
+    image->decoder = NULL;
+    image->delays = NULL;
+  }
+
+  if (image->asset != NULL) {
+    widget_unload_asset(widget, image->asset);
+    image->asset = NULL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t gif_image_load_decoder(widget_t* widget) {
+  gif_image_t* image = GIF_IMAGE(widget);
+  image_base_t* image_base = IMAGE_BASE(widget);
+  return_value_if_fail(image != NULL && image_base != NULL, RET_BAD_PARAMS);
+
+  if (image->asset != NULL && tk_str_eq(image->asset->name, image_base->image)) {
+    return image->decoder != NULL ? RET_OK : RET_NOT_FOUND;
+  }
+
+  gif_image_unload_decoder(widget);
+  image->asset = widget_load_asset(widget, ASSET_TYPE_IMAGE, image_base->image);
+  return_value_if_fail(image->asset != NULL, RET_NOT_FOUND);
+
+  /*不是原始的GIF数据(如已经解码的图片)时，仍然使用image_manager加载*/
+  if (image->asset->subtype == ASSET_TYPE_IMAGE_GIF) {
+    image->decoder = gif_decoder_create(image->asset->data, image->asset->size);
+  }
+
+  if (image->decoder != NULL) {
+    image->index = 0;
+    image->delays = image->decoder->delays;
+    image->frames_nr = image->decoder->frames_nr;
+  }
+
+  return image->decoder != NULL ? RET_OK : RET_NOT_FOUND;
+}
+
+static ret_t gif_image_on_idle(const idle_info_t* info) {
+  gif_image_t* image = GIF_IMAGE(info->ctx);
+  return_value_if_fail(image != NULL, RET_BAD_PARAMS);
+
+  image->idle_id = TK_INVALID_ID;
+  if (image->decoder != NULL) {
+    gif_decoder_prefetch(image->decoder);
+  }
+
+  return RET_REMOVE;
+}
+#endif /*AWTK_WEB*/
+
 static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
   wh_t y = 0;
   wh_t h = 0;
   rect_t src;
   rect_t dst;
   bitmap_t bitmap;
+  bitmap_t* img = &bitmap;
   vgcanvas_t* vg = NULL;
   gif_image_t* image = GIF_IMAGE(widget);
   image_base_t* image_base = IMAGE_BASE(widget);
@@ -79,38 +145,50 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
     return RET_OK;
   }
 
+#ifdef AWTK_WEB
   return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
                        RET_BAD_PARAMS);
-#ifdef AWTK_WEB
   image->frames_nr = 1;
   bitmap.gif_frame_h = bitmap.h;
 #else
-  return_value_if_fail(bitmap.is_gif, RET_OK);
-  image->delays = bitmap.gif_delays;
-  image->frames_nr = bitmap.gif_frames_nr;
+  if (gif_image_load_decoder(widget) == RET_OK) {
+    if (image->index >= image->frames_nr) {
+      image->index = 0;
+    }
+
+    img = gif_decoder_get_frame(image->decoder, image->index);
+    return_value_if_fail(img != NULL, RET_FAIL);
+    img->gif_frame_h = img->h;
+  } else {
+    return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
+                         RET_BAD_PARAMS);
+    return_value_if_fail(bitmap.is_gif, RET_OK);
+    image->delays = bitmap.gif_delays;
+    image->frames_nr = bitmap.gif_frames_nr;
+  }
 #endif /*AWTK_WEB*/
 
   if (image->index >= image->frames_nr) {
     image->index = 0;
   }
 
-  h = bitmap.gif_frame_h;
-  y = bitmap.gif_frame_h * image->index;
+  h = img->gif_frame_h;
+  y = img == &bitmap ? img->gif_frame_h * image->index : 0;
 
   if (vg != NULL) {
     if (image_need_transform(widget)) {
       vgcanvas_save(vg);
       image_transform(widget, c);
-      vgcanvas_draw_icon(vg, &bitmap, 0, y, bitmap.w, h, 0, 0, widget->w, widget->h);
+      vgcanvas_draw_icon(vg, img, 0, y, img->w, h, 0, 0, widget->w, widget->h);
       vgcanvas_restore(vg);
 
       return RET_OK;
     }
   }
 
-  src = rect_init(0, y, bitmap.w, h);
+  src = rect_init(0, y, img->w, h);
   dst = rect_init(0, 0, widget->w, widget->h);
-  canvas_draw_image_scale_down(c, &bitmap, &src, &dst);
+  canvas_draw_image_scale_down(c, img, &src, &dst);
 
 #ifdef AWTK_WEB
   if (image->timer_id == TK_INVALID_ID) {
@@ -121,6 +199,10 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
     uint32_t delay = image->delays[image->index];
     image->timer_id = timer_add(gif_image_on_timer, image, delay);
   }
+
+  if (image->decoder != NULL && image->idle_id == TK_INVALID_ID && image->frames_nr > 1) {
+    image->idle_id = idle_add(gif_image_on_idle, image);
+  }
 #endif /*AWTK_WEB*/
 
   return RET_OK;
@@ -140,6 +222,10 @@ static ret_t gif_image_on_destroy(widget_t* widget) {
     image->timer_id = TK_INVALID_ID;
   }
 
+#ifndef AWTK_WEB
+  gif_image_unload_decoder(widget);
+#endif /*AWTK_WEB*/
+
   return image_base_on_destroy(widget);
 }
 
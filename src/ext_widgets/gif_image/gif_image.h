@@ -24,6 +24,7 @@
 
 #include "base/widget.h"
 #include "base/image_base.h"
+#include "image_loader/gif_decoder.h"
 
 BEGIN_C_DECLS
 
@@ -36,6 +37,9 @@ BEGIN_C_DECLS
  * > 注意：GIF图片的尺寸大于控件大小时会自动缩小图片，但一般的嵌入式系统的硬件加速都不支持图片缩放，
  * 所以缩放图片会导致性能明显下降。如果性能不满意时，请确认一下GIF图片的尺寸是否小余控件大小。
  *
+ * > GIF图片为原始的GIF数据时，使用gif\_decoder\_t逐帧解码，只保留当前帧和下一帧，
+ * 下一帧在idle中预先解码，内存占用与帧数无关。
+ *
  * gif\_image\_t是[image\_base\_t](image_base_t.md)的子类控件，image\_base\_t的函数均适用于gif\_image\_t控件。
  *
  * 在xml中使用"gif\_image"标签创建GIF图片控件。如：
@@ -83,6 +87,9 @@ typedef struct _gif_image_t {
   uint32_t index;
   uint32_t timer_id;
   uint32_t frames_nr;
+  uint32_t idle_id;
+  gif_decoder_t* decoder;
+  const asset_info_t* asset;
 } gif_image_t;
 
 /**
@@ -57,11 +57,33 @@ static ret_t image_value_draw_images(widget_t* widget, canvas_t* c, bitmap_t* bi
   return RET_OK;
 }
 
+static image_handle_t* image_value_get_handle(image_value_t* image_value, char chr) {
+  uint32_t i = 0;
+  image_value_handle_t* handles = NULL;
+
+  for (i = 0; i < image_value->handles_nr; i++) {
+    if (image_value->handles[i].chr == chr) {
+      return &(image_value->handles[i].handle);
+    }
+  }
+
+  handles = TKMEM_REALLOCT(image_value_handle_t, image_value->handles, i + 1);
+  return_value_if_fail(handles != NULL, NULL);
+
+  memset(handles + i, 0x00, sizeof(image_value_handle_t));
+  handles[i].chr = chr;
+  image_value->handles = handles;
+  image_value->handles_nr = i + 1;
+
+  return &(handles[i].handle);
+}
+
 static ret_t image_value_on_paint_self(widget_t* widget, canvas_t* c) {
   uint32_t i = 0;
   uint32_t nr = 0;
   char sub_name[8];
   const char* format = NULL;
+  image_handle_t* handle = NULL;
   char name[TK_NAME_LEN + 1];
   char str[IMAGE_VALUE_MAX_CHAR_NR + 1];
   bitmap_t bitmap[IMAGE_VALUE_MAX_CHAR_NR];
@@ -94,7 +116,13 @@ static ret_t image_value_on_paint_self(widget_t* widget, canvas_t* c) {
     }
 
     tk_snprintf(name, TK_NAME_LEN, "%s%s", image_value->image, sub_name);
-    return_value_if_fail(widget_load_image(widget, name, bitmap + i) == RET_OK, RET_BAD_PARAMS);
+    handle = image_value_get_handle(image_value, str[i]);
+    if (handle != NULL) {
+      return_value_if_fail(widget_load_image_with_handle(widget, name, handle, bitmap + i) == RET_OK,
+                           RET_BAD_PARAMS);
+    } else {
+      return_value_if_fail(widget_load_image(widget, name, bitmap + i) == RET_OK, RET_BAD_PARAMS);
+    }
   }
 
   return image_value_draw_images(widget, c, bitmap, nr);
@@ -138,6 +166,8 @@ static ret_t image_value_on_destroy(widget_t* widget) {
 
   TKMEM_FREE(image_value->image);
   TKMEM_FREE(image_value->format);
+  TKMEM_FREE(image_value->handles);
+  image_value->handles_nr = 0;
 
   return RET_OK;
 }
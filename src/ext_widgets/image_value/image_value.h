@@ -65,6 +65,13 @@ BEGIN_C_DECLS
  * 可用通过style来设置控件的显示风格，如背景颜色和边框等等，不过一般情况并不需要。
  *
  */
+
+/*一个字符的图片句柄*/
+typedef struct _image_value_handle_t {
+  char chr;
+  image_handle_t handle;
+} image_value_handle_t;
+
 typedef struct _image_value_t {
   widget_t widget;
 
@@ -88,6 +95,11 @@ typedef struct _image_value_t {
    * 值。
    */
   float_t value;
+
+  /*private*/
+  /*按字符缓存图片句柄，第一次绘制某个字符时才分配*/
+  image_value_handle_t* handles;
+  uint32_t handles_nr;
 } image_value_t;
 
 /**
@@ -171,6 +171,79 @@ static ret_t children_layouter_list_view_get_param(children_layouter_t* layouter
   return RET_FAIL;
 }
 
+static ret_t children_layouter_list_view_layout_virtual(children_layouter_list_view_t* l,
+                                                       widget_t* widget, list_view_t* list_view) {
+  int32_t offset = 0;
+  int32_t virtual_h = 0;
+  int32_t max_offset = 0;
+  int32_t item_height = 0;
+  widget_t* scroll_bar = list_view->scroll_bar;
+  widget_t* first = widget_get_child(widget, 0);
+  scroll_view_t* scroll_view = SCROLL_VIEW(widget);
+
+  item_height = list_view->item_height ? list_view->item_height : l->item_height;
+  if (item_height <= 0) {
+    item_height =
+        list_view->default_item_height ? list_view->default_item_height : l->default_item_height;
+  }
+  if (item_height <= 0 && first != NULL) {
+    item_height = first->h;
+  }
+  return_value_if_fail(item_height > 0, RET_BAD_PARAMS);
+
+  /*虚拟高度只与列表项的个数有关，不需要遍历子控件*/
+  virtual_h = l->y_margin * 2 + list_view->item_count * (item_height + l->spacing) - l->spacing;
+  virtual_h = tk_max(virtual_h, widget->h);
+
+  scroll_view->widget.w = list_view->widget.w;
+  if (scroll_bar != NULL && !scroll_bar_is_mobile(scroll_bar) && list_view->auto_hide_scroll_bar) {
+    if (virtual_h <= widget->h) {
+      widget_set_visible_only(scroll_bar, FALSE);
+      widget_set_enable(scroll_bar, FALSE);
+    } else {
+      scroll_view->widget.w = list_view->widget.w - scroll_bar->w;
+      widget_set_visible_only(scroll_bar, TRUE);
+      widget_set_enable(scroll_bar, TRUE);
+    }
+  }
+
+  list_view->item_x = l->x_margin;
+  list_view->item_y = l->y_margin;
+  list_view->item_w = scroll_view->widget.w - 2 * l->x_margin;
+  list_view->item_h = item_height;
+  list_view->item_spacing = l->spacing;
+
+  /*scroll_view布局前已经把偏移清零，从滚动条恢复滚动的位置，只在超出新的范围时才调整*/
+  if (scroll_bar != NULL) {
+    scroll_bar_t* bar = SCROLL_BAR(scroll_bar);
+    float_t percent = bar->virtual_size > 0 ? (float_t)(bar->value) / bar->virtual_size : 0;
+
+    offset = percent * (scroll_view->virtual_h - widget->h);
+  }
+
+  scroll_view_set_virtual_h(widget, virtual_h);
+  max_offset = virtual_h - widget->h;
+  offset = tk_max(0, tk_min(offset, max_offset));
+  scroll_view_set_offset(widget, 0, offset);
+
+  if (scroll_bar != NULL) {
+    float_t percent = max_offset > 0 ? (float_t)offset / max_offset : 0;
+
+    scroll_bar_set_params(scroll_bar, virtual_h, item_height);
+    scroll_bar_set_value_only(scroll_bar, percent * virtual_h);
+  }
+
+  scroll_view_set_xslidable(widget, FALSE);
+  if (scroll_bar_is_mobile(scroll_bar)) {
+    scroll_view_set_yslidable(widget, TRUE);
+    widget_set_visible_only(scroll_bar, FALSE);
+  }
+
+  list_view_reload(WIDGET(list_view));
+
+  return RET_OK;
+}
+
 static ret_t children_layouter_list_view_layout(children_layouter_t* layouter, widget_t* widget) {
   int32_t spacing = 0;
   int32_t x_margin = 0;
@@ -188,6 +261,10 @@ static ret_t children_layouter_list_view_layout(children_layouter_t* layouter, w
   list_view = LIST_VIEW(widget->parent);
   return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
 
+  if (list_view->is_virtual) {
+    return children_layouter_list_view_layout_virtual(l, widget, list_view);
+  }
+
   scroll_bar = list_view->scroll_bar;
   spacing = l->spacing;
   x_margin = l->x_margin;
@@ -22,11 +22,26 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "base/layout.h"
+#include "scroll_view/list_item.h"
 #include "scroll_view/list_view.h"
 #include "scroll_view/scroll_bar.h"
 #include "scroll_view/scroll_view.h"
 
+/*虚拟列表在可见区域上下各预留的列表项个数*/
+#define LIST_VIEW_OVERSCAN 2
+
 static ret_t list_view_on_add_child(widget_t* widget, widget_t* child);
+static int32_t scroll_view_to_scroll_bar(list_view_t* list_view, int32_t v);
+
+static ret_t list_view_on_destroy(widget_t* widget) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(list_view->bound);
+  list_view->bound_capacity = 0;
+
+  return RET_OK;
+}
 
 static ret_t list_view_on_paint_self(widget_t* widget, canvas_t* c) {
   return widget_paint_helper(widget, c, NULL, NULL);
@@ -96,6 +111,7 @@ TK_DECL_VTABLE(list_view) = {.type = WIDGET_TYPE_LIST_VIEW,
                              .get_prop = list_view_get_prop,
                              .on_event = list_view_on_event,
                              .on_add_child = list_view_on_add_child,
+                             .on_destroy = list_view_on_destroy,
                              .on_paint_self = list_view_on_paint_self};
 
 static int32_t scroll_bar_to_scroll_view(list_view_t* list_view, int32_t v) {
@@ -124,6 +140,9 @@ static ret_t list_view_on_scroll_bar_value_changed(void* ctx, event_t* e) {
   scroll_bar = SCROLL_BAR(list_view->scroll_bar);
   offset = scroll_bar_to_scroll_view(list_view, scroll_bar->value);
   scroll_view_set_offset(list_view->scroll_view, 0, offset);
+  if (list_view->is_virtual) {
+    list_view_update_virtual_items(WIDGET(list_view));
+  }
 
   return RET_OK;
 }
@@ -149,6 +168,10 @@ static ret_t list_view_on_scroll_view_scroll(widget_t* widget, int32_t xoffset,
   list_view_t* list_view = LIST_VIEW(widget->parent);
   return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
 
+  if (list_view->is_virtual) {
+    list_view_update_virtual_items(WIDGET(list_view));
+  }
+
   if (list_view->scroll_bar != NULL) {
     int32_t value = scroll_view_to_scroll_bar(list_view, yoffset);
     scroll_bar_set_value_only(list_view->scroll_bar, value);
@@ -243,6 +266,188 @@ ret_t list_view_set_auto_hide_scroll_bar(widget_t* widget, bool_t auto_hide_scro
   return RET_OK;
 }
 
+static ret_t list_view_ensure_bound(list_view_t* list_view, uint32_t nr) {
+  uint32_t i = 0;
+  int32_t* bound = NULL;
+
+  if (nr <= list_view->bound_capacity) {
+    return RET_OK;
+  }
+
+  bound = TKMEM_REALLOCT(int32_t, list_view->bound, nr);
+  return_value_if_fail(bound != NULL, RET_OOM);
+
+  for (i = list_view->bound_capacity; i < nr; i++) {
+    bound[i] = -1;
+  }
+  list_view->bound = bound;
+  list_view->bound_capacity = nr;
+
+  return RET_OK;
+}
+
+static ret_t list_view_unbind_all(list_view_t* list_view) {
+  uint32_t i = 0;
+
+  for (i = 0; i < list_view->bound_capacity; i++) {
+    list_view->bound[i] = -1;
+  }
+
+  return RET_OK;
+}
+
+/*创建足够的列表项：第一个子控件作为模板，其它的从模板克隆*/
+static uint32_t list_view_ensure_items(list_view_t* list_view, uint32_t nr) {
+  widget_t* scroll_view = list_view->scroll_view;
+  uint32_t n = widget_count_children(scroll_view);
+
+  if (n == 0) {
+    return_value_if_fail(list_item_create(scroll_view, 0, 0, 0, 0) != NULL, 0);
+    n = 1;
+  }
+
+  for (; n < nr; n++) {
+    widget_t* item = widget_clone(widget_get_child(scroll_view, 0), scroll_view);
+    break_if_fail(item != NULL);
+  }
+
+  return list_view_ensure_bound(list_view, n) == RET_OK ? n : 0;
+}
+
+ret_t list_view_update_virtual_items(widget_t* widget) {
+  int32_t i = 0;
+  int32_t n = 0;
+  int32_t nr = 0;
+  int32_t step = 0;
+  int32_t first = 0;
+  scroll_view_t* scroll_view = NULL;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->is_virtual, RET_BAD_PARAMS);
+
+  scroll_view = SCROLL_VIEW(list_view->scroll_view);
+  if (scroll_view == NULL || list_view->item_h <= 0) {
+    /*还没有布局*/
+    return RET_OK;
+  }
+
+  step = list_view->item_h + list_view->item_spacing;
+  nr = list_view->scroll_view->h / step + 2 + 2 * LIST_VIEW_OVERSCAN;
+  nr = tk_min(nr, (int32_t)(list_view->item_count));
+  n = list_view_ensure_items(list_view, nr);
+  return_value_if_fail(n > 0, RET_OOM);
+
+  first = (scroll_view->yoffset - list_view->item_y) / step - LIST_VIEW_OVERSCAN;
+  first = tk_max(first, 0);
+
+  /*第row项数据总是由第row%n个列表项显示，滚动一行时只需要重新绑定一个列表项*/
+  for (i = 0; i < n; i++) {
+    int32_t row = first + i;
+    int32_t index = row % n;
+    widget_t* item = widget_get_child(list_view->scroll_view, index);
+
+    if (row < (int32_t)(list_view->item_count)) {
+      int32_t y = list_view->item_y + row * step;
+
+      if (item->x != list_view->item_x || item->y != y || item->w != list_view->item_w ||
+          item->h != list_view->item_h) {
+        widget_move_resize(item, list_view->item_x, y, list_view->item_w, list_view->item_h);
+      }
+
+      if (list_view->bound[index] != row) {
+        list_view->bound[index] = row;
+        widget_set_visible_only(item, TRUE);
+        widget_set_sensitive(item, TRUE);
+        if (list_view->bind_item != NULL) {
+          list_view->bind_item(list_view->bind_item_ctx, item, row);
+        }
+        widget_layout(item);
+      }
+    } else if (list_view->bound[index] != -1 || item->visible) {
+      list_view->bound[index] = -1;
+      widget_set_visible_only(item, FALSE);
+      widget_set_sensitive(item, FALSE);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t list_view_set_virtual(widget_t* widget, uint32_t item_count, list_view_bind_item_t bind_item,
+                            void* ctx) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && bind_item != NULL, RET_BAD_PARAMS);
+
+  list_view->is_virtual = TRUE;
+  list_view->item_count = item_count;
+  list_view->bind_item = bind_item;
+  list_view->bind_item_ctx = ctx;
+  list_view_unbind_all(list_view);
+
+  if (list_view->scroll_view != NULL) {
+    widget_layout(list_view->scroll_view);
+  }
+
+  return RET_OK;
+}
+
+ret_t list_view_set_item_count(widget_t* widget, uint32_t item_count) {
+  int32_t max_offset = 0;
+  int32_t virtual_h = 0;
+  scroll_view_t* scroll_view = NULL;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->is_virtual, RET_BAD_PARAMS);
+
+  list_view->item_count = item_count;
+  scroll_view = SCROLL_VIEW(list_view->scroll_view);
+  if (scroll_view == NULL || list_view->item_h <= 0) {
+    return RET_OK;
+  }
+
+  /*不重新布局，保持滚动的位置*/
+  virtual_h = list_view->item_y * 2 + item_count * (list_view->item_h + list_view->item_spacing);
+  virtual_h = tk_max(virtual_h - list_view->item_spacing, list_view->scroll_view->h);
+  scroll_view_set_virtual_h(list_view->scroll_view, virtual_h);
+
+  max_offset = virtual_h - list_view->scroll_view->h;
+  if (scroll_view->yoffset > max_offset) {
+    scroll_view_set_offset(list_view->scroll_view, 0, max_offset);
+  }
+
+  if (list_view->scroll_bar != NULL) {
+    scroll_bar_set_params(list_view->scroll_bar, virtual_h, list_view->item_h);
+    scroll_bar_set_value_only(list_view->scroll_bar,
+                              scroll_view_to_scroll_bar(list_view, scroll_view->yoffset));
+  }
+
+  return list_view_update_virtual_items(widget);
+}
+
+ret_t list_view_reload(widget_t* widget) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->is_virtual, RET_BAD_PARAMS);
+
+  list_view_unbind_all(list_view);
+  if (list_view->scroll_view != NULL) {
+    widget_invalidate(list_view->scroll_view, NULL);
+  }
+
+  return list_view_update_virtual_items(widget);
+}
+
+int32_t list_view_get_item_index(widget_t* widget, widget_t* item) {
+  int32_t index = 0;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && item != NULL, -1);
+  return_value_if_fail(item->parent == list_view->scroll_view, -1);
+
+  index = widget_index_of(item);
+  if (!list_view->is_virtual) {
+    return index;
+  }
+
+  return index >= 0 && index < (int32_t)(list_view->bound_capacity) ? list_view->bound[index] : -1;
+}
+
 widget_t* list_view_cast(widget_t* widget) {
   return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, list_view), NULL);
 
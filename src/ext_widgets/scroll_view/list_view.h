@@ -77,7 +77,21 @@ BEGIN_C_DECLS
  *
  * 可用通过style来设置控件的显示风格，如背景颜色和边框颜色等(一般情况不需要)。
  *
+ * 列表项很多(比如上万条日志)时，可以使用虚拟列表(参考list\_view\_set\_virtual)：
+ * 只创建可见的列表项(以及上下少量预留的列表项)，滚动时重新绑定数据，不会为每一项创建控件。
+ *
+ * ```c
+ * static ret_t bind_item(void* ctx, widget_t* item, uint32_t index) {
+ *   widget_set_text_utf8(widget_lookup(item, "title", TRUE), log_get(index));
+ *   return RET_OK;
+ * }
+ *
+ * list_view_set_virtual(list_view, log_count(), bind_item, NULL);
+ * ```
+ *
  */
+typedef ret_t (*list_view_bind_item_t)(void* ctx, widget_t* item, uint32_t index);
+
 typedef struct _list_view_t {
   widget_t widget;
   /**
@@ -102,6 +116,21 @@ typedef struct _list_view_t {
   /*private*/
   widget_t* scroll_view;
   widget_t* scroll_bar;
+
+  /*虚拟列表*/
+  bool_t is_virtual;
+  uint32_t item_count;
+  list_view_bind_item_t bind_item;
+  void* bind_item_ctx;
+  /*列表项的位置(由children_layouter_list_view计算)*/
+  int32_t item_x;
+  int32_t item_y;
+  int32_t item_w;
+  int32_t item_h;
+  int32_t item_spacing;
+  /*scroll_view的每个子控件当前绑定的数据序号，-1表示没有绑定*/
+  int32_t* bound;
+  uint32_t bound_capacity;
 } list_view_t;
 
 /**
@@ -151,6 +180,61 @@ ret_t list_view_set_default_item_height(widget_t* widget, int32_t default_item_h
  */
 ret_t list_view_set_auto_hide_scroll_bar(widget_t* widget, bool_t auto_hide_scroll_bar);
 
+/**
+ * @method list_view_set_virtual
+ * 设置为虚拟列表。
+ *
+ * scroll\_view的第一个子控件作为列表项的模板(没有时创建一个list\_item)，需要时用widget\_clone
+ * 创建更多的列表项。列表项的高度为item\_height(为0时使用default\_item\_height或模板的高度)。
+ *
+ * @param {widget_t*} widget 控件对象。
+ * @param {uint32_t} item_count 列表项的个数。
+ * @param {list_view_bind_item_t} bind_item 把第index项数据绑定到列表项控件上的回调函数。
+ * @param {void*} ctx 回调函数的上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_virtual(widget_t* widget, uint32_t item_count, list_view_bind_item_t bind_item,
+                            void* ctx);
+
+/**
+ * @method list_view_set_item_count
+ * 设置虚拟列表中列表项的个数(数据增加或删除时调用)。
+ * @param {widget_t*} widget 控件对象。
+ * @param {uint32_t} item_count 列表项的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_item_count(widget_t* widget, uint32_t item_count);
+
+/**
+ * @method list_view_reload
+ * 重新绑定虚拟列表中可见的列表项(数据内容变化时调用)。
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_reload(widget_t* widget);
+
+/**
+ * @method list_view_get_item_index
+ * 获取列表项控件对应的数据序号(不是虚拟列表时为列表项在scroll\_view中的序号)。
+ * @param {widget_t*} widget 控件对象。
+ * @param {widget_t*} item 列表项控件(scroll\_view的子控件)。
+ *
+ * @return {int32_t} 返回数据序号，没有绑定时返回-1。
+ */
+int32_t list_view_get_item_index(widget_t* widget, widget_t* item);
+
+/**
+ * @method list_view_update_virtual_items
+ * 根据滚动的位置，移动并重新绑定虚拟列表中的列表项(供children\_layouter\_list\_view使用)。
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_update_virtual_items(widget_t* widget);
+
 /**
  * @method list_view_cast
  * 转换为list_view对象(供脚本语言使用)。
@@ -23,6 +23,7 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "svg/bsvg_draw.h"
+#include "base/image_manager.h"
 #include "base/widget_vtable.h"
 #include "svg_image/svg_image.h"
 
@@ -51,16 +52,188 @@ static ret_t svg_image_load_bsvg(widget_t* widget) {
   return RET_OK;
 }
 
+static ret_t svg_image_draw_bsvg(widget_t* widget, vgcanvas_t* vg, bsvg_t* bsvg, color_t bg,
+                                 color_t fg) {
+  image_base_t* image_base = IMAGE_BASE(widget);
+  float_t anchor_x = image_base->anchor_x * widget->w;
+  float_t anchor_y = image_base->anchor_y * widget->h;
+  int32_t x = (widget->w - (int32_t)(bsvg->header->w)) / 2;
+  int32_t y = (widget->h - (int32_t)(bsvg->header->h)) / 2;
+
+  vgcanvas_translate(vg, anchor_x, anchor_y);
+  vgcanvas_rotate(vg, image_base->rotation);
+  vgcanvas_scale(vg, image_base->scale_x, image_base->scale_y);
+  vgcanvas_translate(vg, -anchor_x, -anchor_y);
+  vgcanvas_translate(vg, x, y);
+  vgcanvas_set_fill_color(vg, bg);
+  vgcanvas_set_stroke_color(vg, fg);
+
+  return bsvg_draw(bsvg, vg);
+}
+
+#ifdef WITH_NANOVG_SOFT
+/*变换后的图片完全在控件内时，才能光栅化到控件大小的位图中*/
+static bool_t svg_image_is_inside(widget_t* widget, bsvg_t* bsvg) {
+  uint32_t i = 0;
+  image_base_t* image_base = IMAGE_BASE(widget);
+  float_t anchor_x = image_base->anchor_x * widget->w;
+  float_t anchor_y = image_base->anchor_y * widget->h;
+  float_t x = (widget->w - (int32_t)(bsvg->header->w)) / 2;
+  float_t y = (widget->h - (int32_t)(bsvg->header->h)) / 2;
+  float_t cs = cos(image_base->rotation);
+  float_t sn = sin(image_base->rotation);
+
+  for (i = 0; i < 4; i++) {
+    float_t px = x + ((i & 1) ? bsvg->header->w : 0);
+    float_t py = y + ((i & 2) ? bsvg->header->h : 0);
+    float_t sx = (px - anchor_x) * image_base->scale_x;
+    float_t sy = (py - anchor_y) * image_base->scale_y;
+    float_t rx = anchor_x + sx * cs - sy * sn;
+    float_t ry = anchor_y + sx * sn + sy * cs;
+
+    if (rx < -0.5f || ry < -0.5f || rx > widget->w + 0.5f || ry > widget->h + 0.5f) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static uint32_t svg_image_hash(const char* str) {
+  uint32_t h = 2166136261u;
+
+  while (*str) {
+    h = (h ^ (uint8_t)(*str++)) * 16777619u;
+  }
+
+  return h != 0 ? h : 1;
+}
+
+/*
+ * 软件的vgcanvas不写目标的alpha通道，所以分别画到黑色和白色的背景上，
+ * 再根据两者的差计算出每个像素的alpha和颜色(非预乘)。
+ */
+static ret_t svg_image_rasterize(widget_t* widget, bsvg_t* bsvg, color_t bg, color_t fg,
+                                 bitmap_t* img) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  uint8_t* black = NULL;
+  uint8_t* white = NULL;
+  vgcanvas_t* vg = NULL;
+#ifdef WITH_BITMAP_BGRA
+  bitmap_format_t format = BITMAP_FMT_BGRA8888;
+#else
+  bitmap_format_t format = BITMAP_FMT_RGBA8888;
+#endif /*WITH_BITMAP_BGRA*/
+
+  return_value_if_fail(bitmap_init(img, widget->w, widget->h, format, NULL) == RET_OK, RET_OOM);
+
+  black = (uint8_t*)(img->data);
+  size = img->line_length * img->h;
+  white = (uint8_t*)TKMEM_ALLOC(size);
+  goto_error_if_fail(white != NULL);
+
+  memset(black, 0x00, size);
+  memset(white, 0xff, size);
+  for (i = 3; i < size; i += 4) {
+    black[i] = 0xff;
+  }
+
+  vg = vgcanvas_create(img->w, img->h, img->line_length, format, black);
+  goto_error_if_fail(vg != NULL);
+
+  for (i = 0; i < 2; i++) {
+    vgcanvas_reinit(vg, img->w, img->h, img->line_length, format, i == 0 ? black : white);
+    vgcanvas_begin_frame(vg, NULL);
+    vgcanvas_save(vg);
+    svg_image_draw_bsvg(widget, vg, bsvg, bg, fg);
+    vgcanvas_restore(vg);
+    vgcanvas_end_frame(vg);
+  }
+  vgcanvas_destroy(vg);
+
+  for (i = 0; i < size; i += 4) {
+    uint8_t* b = black + i;
+    uint8_t* w = white + i;
+    int32_t d = ((w[0] - b[0]) + (w[1] - b[1]) + (w[2] - b[2])) / 3;
+    uint8_t a = 0xff - tk_max(0, tk_min(d, 0xff));
+
+    if (a == 0) {
+      b[0] = b[1] = b[2] = 0;
+    } else if (a < 0xff) {
+      b[0] = tk_min(b[0] * 0xff / a, 0xff);
+      b[1] = tk_min(b[1] * 0xff / a, 0xff);
+      b[2] = tk_min(b[2] * 0xff / a, 0xff);
+    }
+    b[3] = a;
+  }
+  TKMEM_FREE(white);
+
+  img->flags = BITMAP_FLAG_NONE;
+
+  return RET_OK;
+error:
+  TKMEM_FREE(white);
+  bitmap_destroy(img);
+
+  return RET_OOM;
+}
+
+/*
+ * 光栅化后的位图以(资源名称,大小,颜色,变换)为key放在控件所在窗口的image_manager中，
+ * 显示同一图片的控件共享，受image_manager的内存上限限制。
+ * 变换参数每次绘制都在变化(如正在播放动画)时不缓存，直接用矢量绘制。
+ */
+static ret_t svg_image_draw_cached(widget_t* widget, canvas_t* c, bsvg_t* bsvg, color_t bg,
+                                   color_t fg) {
+  bitmap_t img;
+  rect_t r;
+  uint32_t key_hash = 0;
+  char key[TK_NAME_LEN + 128];
+  svg_image_t* svg_image = SVG_IMAGE(widget);
+  image_base_t* image_base = IMAGE_BASE(widget);
+  image_manager_t* imm = widget_get_image_manager(widget);
+
+  if (imm == NULL || widget->w <= 0 || widget->h <= 0 || !svg_image_is_inside(widget, bsvg)) {
+    return RET_NOT_IMPL;
+  }
+
+  tk_snprintf(key, sizeof(key) - 1, "svg:%s:%dx%d:%08x:%08x:%d:%d:%d:%d:%d", image_base->image,
+              widget->w, widget->h, bg.color, fg.color, (int32_t)(image_base->scale_x * 1000),
+              (int32_t)(image_base->scale_y * 1000), (int32_t)(image_base->anchor_x * 1000),
+              (int32_t)(image_base->anchor_y * 1000), (int32_t)(image_base->rotation * 1000));
+
+  if (image_manager_lookup(imm, key, &img) != RET_OK) {
+    key_hash = svg_image_hash(key);
+    if (svg_image->cache_key != 0 && svg_image->cache_key != key_hash) {
+      svg_image->cache_key = key_hash;
+      return RET_NOT_IMPL;
+    }
+
+    svg_image->cache_key = key_hash;
+    return_value_if_fail(svg_image_rasterize(widget, bsvg, bg, fg, &img) == RET_OK, RET_OOM);
+    if (image_manager_add(imm, key, &img) != RET_OK) {
+      bitmap_destroy(&img);
+      return RET_OOM;
+    }
+    return_value_if_fail(image_manager_lookup(imm, key, &img) == RET_OK, RET_FAIL);
+  } else {
+    svg_image->cache_key = svg_image_hash(key);
+  }
+
+  r = rect_init(0, 0, img.w, img.h);
+
+  return canvas_draw_image(c, &img, &r, &r);
+}
+#endif /*WITH_NANOVG_SOFT*/
+
 static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
   svg_image_t* svg_image = SVG_IMAGE(widget);
-  vgcanvas_t* vg = lcd_get_vgcanvas(c->lcd);
   image_base_t* image_base = IMAGE_BASE(widget);
   return_value_if_fail(svg_image != NULL && image_base != NULL && widget != NULL, RET_BAD_PARAMS);
 
   if (image_base->image != NULL && svg_image_load_bsvg(widget) == RET_OK) {
     bsvg_t bsvg;
-    int32_t x = 0;
-    int32_t y = 0;
     style_t* style = widget->astyle;
     color_t black = color_init(0, 0, 0, 0xff);
     const asset_info_t* asset = svg_image->bsvg_asset;
@@ -70,19 +243,18 @@ static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
     return_value_if_fail(bsvg_init(&bsvg, (const uint32_t*)asset->data, asset->size) != NULL,
                          RET_BAD_PARAMS);
 
-    x = (widget->w - bsvg.header->w) / 2;
-    y = (widget->h - bsvg.header->h) / 2;
-
-    vgcanvas_save(vg);
-
-    image_transform(widget, c);
-    vgcanvas_translate(vg, x, y);
-    vgcanvas_set_fill_color(vg, bg);
-    vgcanvas_set_stroke_color(vg, fg);
-
-    bsvg_draw(&bsvg, vg);
+#ifdef WITH_NANOVG_SOFT
+    if (svg_image_draw_cached(widget, c, &bsvg, bg, fg) != RET_OK)
+#endif /*WITH_NANOVG_SOFT*/
+    {
+      vgcanvas_t* vg = lcd_get_vgcanvas(c->lcd);
+      return_value_if_fail(vg != NULL, RET_BAD_PARAMS);
 
-    vgcanvas_restore(vg);
+      vgcanvas_save(vg);
+      vgcanvas_translate(vg, c->ox, c->oy);
+      svg_image_draw_bsvg(widget, vg, &bsvg, bg, fg);
+      vgcanvas_restore(vg);
+    }
   }
 
   widget_paint_helper(widget, c, NULL, NULL);
@@ -53,6 +53,9 @@ BEGIN_C_DECLS
  *
  * > 创建之后: 需要用widget\_set\_image设置图片名称。
  *
+ * > 使用软件的vgcanvas(WITH\_NANOVG\_SOFT)时，图片光栅化后缓存在image\_manager中，以后直接贴图。
+ * 缓存以图片名称、控件大小、颜色和变换参数为key，变换参数一直在变化(如动画)时直接用矢量绘制。
+ *
  * > 完整示例请参考：[svg image demo](
  * https://github.com/zlgopen/awtk-c-demos/blob/master/demos/svg_image.c)
  *
@@ -73,6 +76,8 @@ typedef struct _svg_image_t {
 
   /*private*/
   const asset_info_t* bsvg_asset;
+  /*上次绘制时缓存位图的key(hash)，用于判断变换参数是否在变化*/
+  uint32_t cache_key;
 } svg_image_t;
 
 /**
@@ -156,6 +156,7 @@ font_t* font_ft_create(const char* name, const uint8_t* buff, uint32_t size) {
   tk_strncpy(f->base.name, name, TK_NAME_LEN);
 
   glyph_cache_init(&(f->cache), TK_GLYPH_CACHE_NR, destroy_glyph);
+  glyph_cache_set_max_mem_size(&(f->cache), TK_GLYPH_CACHE_MEM_SIZE);
 
   return &(f->base);
 }
@@ -58,6 +58,43 @@ static int32_t font_stb_get_baseline(font_t* f, font_size_t font_size) {
   return scale * font->ascent;
 }
 
+static ret_t font_stb_get_glyph_in_atlas(font_stb_t* font, wchar_t c, font_size_t font_size,
+                                         glyph_t* g) {
+  int x0 = 0;
+  int y0 = 0;
+  int x1 = 0;
+  int y1 = 0;
+  int lsb = 0;
+  int advance = 0;
+  glyph_t* gg = NULL;
+  stbtt_fontinfo* sf = &(font->stb_font);
+  float scale = stbtt_ScaleForPixelHeight(sf, font_size);
+
+  stbtt_GetCodepointBitmapBox(sf, c, scale, scale, &x0, &y0, &x1, &y1);
+  if ((x1 - x0) <= 0 || (x1 - x0) > 0xff || (y1 - y0) <= 0 || (y1 - y0) > 0xff) {
+    return RET_FAIL;
+  }
+
+  stbtt_GetCodepointHMetrics(sf, c, &advance, &lsb);
+  g->x = x0;
+  g->y = y0;
+  g->w = x1 - x0;
+  g->h = y1 - y0;
+  g->data = NULL;
+  g->advance = advance * scale;
+
+  /*直接把字模光栅化到atlas中，避免临时分配内存和拷贝*/
+  gg = glyph_cache_alloc(&(font->cache), c, font_size, g);
+  if (gg == NULL) {
+    return RET_FAIL;
+  }
+
+  stbtt_MakeCodepointBitmap(sf, (uint8_t*)(gg->data), gg->w, gg->h, gg->w, scale, scale, c);
+  *g = *gg;
+
+  return RET_OK;
+}
+
 static ret_t font_stb_get_glyph(font_t* f, wchar_t c, font_size_t font_size, glyph_t* g) {
   int x = 0;
   int y = 0;
@@ -73,6 +110,10 @@ static ret_t font_stb_get_glyph(font_t* f, wchar_t c, font_size_t font_size, gly
     return RET_OK;
   }
 
+  if (font_stb_get_glyph_in_atlas(font, c, font_size, g) == RET_OK) {
+    return RET_OK;
+  }
+
   g->data = stbtt_GetCodepointBitmap(sf, 0, scale, c, &w, &h, &x, &y);
   stbtt_GetCodepointHMetrics(sf, c, &advance, &lsb);
 
@@ -130,6 +171,9 @@ font_t* font_stb_create(const char* name, const uint8_t* buff, uint32_t buff_siz
   tk_strncpy(f->base.name, name, TK_NAME_LEN);
 
   glyph_cache_init(&(f->cache), TK_GLYPH_CACHE_NR, destroy_glyph);
+  glyph_cache_set_max_mem_size(&(f->cache), TK_GLYPH_CACHE_MEM_SIZE);
+  glyph_cache_enable_atlas(&(f->cache), TK_GLYPH_ATLAS_PAGE_SIZE,
+                           tk_max(1, TK_GLYPH_CACHE_MEM_SIZE / TK_GLYPH_ATLAS_PAGE_SIZE));
   stbtt_InitFont(&(f->stb_font), buff, stbtt_GetFontOffsetForIndex(buff, 0));
   stbtt_GetFontVMetrics(&(f->stb_font), &(f->ascent), &(f->descent), &(f->lineGap));
 
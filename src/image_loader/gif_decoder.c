@@ -0,0 +1,541 @@
+﻿/**
+ * File:   gif_decoder.c
+ * Author: AWTK Develop Team
+ * Brief:  streaming gif decoder
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "image_loader/gif_decoder.h"
+
+#define GIF_LZW_MAX_CODES 4096
+#define GIF_LZW_SIZE (GIF_LZW_MAX_CODES * (sizeof(uint16_t) + 2) + 1)
+
+#define GIF_DISPOSAL_BACKGROUND 2
+#define GIF_DISPOSAL_PREVIOUS 3
+
+#ifdef WITH_BITMAP_BGRA
+#define GIF_BITMAP_FORMAT BITMAP_FMT_BGRA8888
+#define GIF_R 2
+#define GIF_B 0
+#else
+#define GIF_BITMAP_FORMAT BITMAP_FMT_RGBA8888
+#define GIF_R 0
+#define GIF_B 2
+#endif /*WITH_BITMAP_BGRA*/
+
+static uint16_t gif_get16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+/*跳过一串数据子块，返回子块之后的偏移，数据不完整时返回0*/
+static uint32_t gif_skip_sub_blocks(const uint8_t* data, uint32_t size, uint32_t offset) {
+  while (offset < size) {
+    uint8_t len = data[offset];
+
+    offset += len + 1;
+    if (len == 0) {
+      return offset;
+    }
+  }
+
+  return 0;
+}
+
+static ret_t gif_decoder_add_frame(gif_decoder_t* decoder, gif_frame_info_t* info, int delay,
+                                   uint32_t* capacity) {
+  if (decoder->frames_nr >= *capacity) {
+    uint32_t n = *capacity > 0 ? *capacity * 2 : 8;
+    gif_frame_info_t* frames = TKMEM_REALLOCT(gif_frame_info_t, decoder->frames, n);
+    int* delays = NULL;
+    return_value_if_fail(frames != NULL, RET_OOM);
+    decoder->frames = frames;
+
+    delays = TKMEM_REALLOCT(int, decoder->delays, n);
+    return_value_if_fail(delays != NULL, RET_OOM);
+    decoder->delays = delays;
+    *capacity = n;
+  }
+
+  decoder->frames[decoder->frames_nr] = *info;
+  decoder->delays[decoder->frames_nr] = delay;
+  decoder->frames_nr++;
+
+  return RET_OK;
+}
+
+static ret_t gif_decoder_parse(gif_decoder_t* decoder) {
+  int delay = 0;
+  uint32_t capacity = 0;
+  gif_frame_info_t info;
+  const uint8_t* data = decoder->data;
+  uint32_t size = decoder->size;
+  uint32_t offset = 13;
+  uint8_t flags = data[10];
+
+  decoder->w = gif_get16(data + 6);
+  decoder->h = gif_get16(data + 8);
+  return_value_if_fail(decoder->w > 0 && decoder->h > 0, RET_BAD_PARAMS);
+
+  if (flags & 0x80) {
+    decoder->palette = data + offset;
+    decoder->palette_nr = 2 << (flags & 0x07);
+    offset += decoder->palette_nr * 3;
+  }
+
+  memset(&info, 0x00, sizeof(info));
+  info.transparent = -1;
+
+  while (offset < size) {
+    uint8_t tag = data[offset++];
+
+    if (tag == 0x21) {
+      return_value_if_fail(offset + 1 < size, RET_BAD_PARAMS);
+      if (data[offset] == 0xF9 && data[offset + 1] == 4 && offset + 6 < size) {
+        const uint8_t* p = data + offset + 2;
+
+        info.disposal = (p[0] >> 2) & 0x07;
+        info.transparent = (p[0] & 0x01) ? p[3] : -1;
+        delay = 10 * gif_get16(p + 1);
+      }
+      offset = gif_skip_sub_blocks(data, size, offset + 1);
+      return_value_if_fail(offset > 0, RET_BAD_PARAMS);
+    } else if (tag == 0x2C) {
+      uint8_t lflags = 0;
+      return_value_if_fail(offset + 10 < size, RET_BAD_PARAMS);
+
+      info.offset = offset;
+      info.x = gif_get16(data + offset);
+      info.y = gif_get16(data + offset + 2);
+      info.w = gif_get16(data + offset + 4);
+      info.h = gif_get16(data + offset + 6);
+      lflags = data[offset + 8];
+      offset += 9;
+
+      if (lflags & 0x80) {
+        offset += (2 << (lflags & 0x07)) * 3;
+      } else if (decoder->palette == NULL) {
+        return RET_BAD_PARAMS;
+      }
+
+      /*跳过LZW的最小码长和数据子块*/
+      offset = gif_skip_sub_blocks(data, size, offset + 1);
+      return_value_if_fail(offset > 0, RET_BAD_PARAMS);
+      return_value_if_fail(gif_decoder_add_frame(decoder, &info, delay, &capacity) == RET_OK,
+                           RET_OOM);
+
+      /*图形控制扩展只作用于紧跟它的一帧*/
+      memset(&info, 0x00, sizeof(info));
+      info.transparent = -1;
+      delay = 0;
+    } else if (tag == 0x3B) {
+      break;
+    } else {
+      /*数据不完整时，使用已经找到的帧*/
+      break;
+    }
+  }
+
+  return decoder->frames_nr > 0 ? RET_OK : RET_BAD_PARAMS;
+}
+
+gif_decoder_t* gif_decoder_create(const uint8_t* data, uint32_t size) {
+  gif_decoder_t* decoder = NULL;
+  return_value_if_fail(data != NULL && size > 13, NULL);
+  return_value_if_fail(memcmp(data, "GIF8", 4) == 0, NULL);
+
+  decoder = TKMEM_ZALLOC(gif_decoder_t);
+  return_value_if_fail(decoder != NULL, NULL);
+
+  decoder->data = data;
+  decoder->size = size;
+  decoder->front_index = -1;
+  decoder->back_index = -1;
+
+  if (gif_decoder_parse(decoder) != RET_OK ||
+      bitmap_init(&(decoder->front), decoder->w, decoder->h, GIF_BITMAP_FORMAT, NULL) != RET_OK) {
+    gif_decoder_destroy(decoder);
+    return NULL;
+  }
+
+  return decoder;
+}
+
+typedef struct _gif_raster_t {
+  bitmap_t* image;
+  const gif_frame_info_t* info;
+  const uint8_t* palette;
+  uint32_t palette_nr;
+
+  uint32_t x;
+  uint32_t y;
+  uint32_t pass;
+  bool_t interlace;
+  uint32_t left;
+} gif_raster_t;
+
+static const uint8_t s_interlace_start[] = {0, 4, 2, 1};
+static const uint8_t s_interlace_step[] = {8, 8, 4, 2};
+
+static void gif_raster_put(gif_raster_t* r, uint8_t index) {
+  const gif_frame_info_t* info = r->info;
+  uint32_t x = info->x + r->x;
+  uint32_t y = info->y + r->y;
+
+  if (index != info->transparent && index < r->palette_nr && x < r->image->w &&
+      y < r->image->h) {
+    const uint8_t* c = r->palette + index * 3;
+    uint8_t* p = (uint8_t*)(r->image->data) + y * r->image->line_length + x * 4;
+
+    p[GIF_R] = c[0];
+    p[1] = c[1];
+    p[GIF_B] = c[2];
+    p[3] = 0xff;
+  }
+
+  r->left--;
+  if (++r->x < info->w) {
+    return;
+  }
+
+  r->x = 0;
+  if (!r->interlace) {
+    r->y++;
+    return;
+  }
+
+  r->y += s_interlace_step[r->pass];
+  while (r->y >= info->h && r->pass < 3) {
+    r->pass++;
+    r->y = s_interlace_start[r->pass];
+  }
+}
+
+typedef struct _gif_bits_t {
+  const uint8_t* data;
+  uint32_t size;
+  uint32_t offset;
+  uint32_t block_left;
+  uint32_t buff;
+  uint32_t nbits;
+} gif_bits_t;
+
+static int32_t gif_bits_read(gif_bits_t* bits, uint32_t code_size) {
+  int32_t code = 0;
+
+  while (bits->nbits < code_size) {
+    if (bits->block_left == 0) {
+      if (bits->offset >= bits->size || bits->data[bits->offset] == 0) {
+        return -1;
+      }
+      bits->block_left = bits->data[bits->offset++];
+    }
+
+    if (bits->offset >= bits->size) {
+      return -1;
+    }
+
+    bits->buff |= (uint32_t)(bits->data[bits->offset++]) << bits->nbits;
+    bits->nbits += 8;
+    bits->block_left--;
+  }
+
+  code = bits->buff & ((1 << code_size) - 1);
+  bits->buff >>= code_size;
+  bits->nbits -= code_size;
+
+  return code;
+}
+
+static ret_t gif_decoder_draw_frame(gif_decoder_t* decoder, uint32_t index, bitmap_t* image) {
+  gif_bits_t bits;
+  gif_raster_t r;
+  uint32_t i = 0;
+  uint32_t sp = 0;
+  int32_t old = -1;
+  uint8_t first = 0;
+  uint32_t clear = 0;
+  uint32_t avail = 0;
+  uint32_t code_size = 0;
+  uint32_t min_code_size = 0;
+  uint16_t* prefix = NULL;
+  uint8_t* suffix = NULL;
+  uint8_t* stack = NULL;
+  const gif_frame_info_t* info = decoder->frames + index;
+  const uint8_t* p = decoder->data + info->offset;
+  uint8_t lflags = p[8];
+  uint32_t offset = info->offset + 9;
+
+  memset(&r, 0x00, sizeof(r));
+  r.info = info;
+  r.image = image;
+  r.left = info->w * info->h;
+  r.interlace = (lflags & 0x40) != 0;
+  r.palette = decoder->palette;
+  r.palette_nr = decoder->palette_nr;
+  if (lflags & 0x80) {
+    r.palette = decoder->data + offset;
+    r.palette_nr = 2 << (lflags & 0x07);
+    offset += r.palette_nr * 3;
+  }
+
+  if (decoder->lzw == NULL) {
+    decoder->lzw = (uint8_t*)TKMEM_ALLOC(GIF_LZW_SIZE);
+    return_value_if_fail(decoder->lzw != NULL, RET_OOM);
+  }
+  prefix = (uint16_t*)(decoder->lzw);
+  suffix = decoder->lzw + GIF_LZW_MAX_CODES * sizeof(uint16_t);
+  stack = suffix + GIF_LZW_MAX_CODES;
+
+  min_code_size = decoder->data[offset++];
+  return_value_if_fail(min_code_size >= 1 && min_code_size <= 11, RET_BAD_PARAMS);
+
+  memset(&bits, 0x00, sizeof(bits));
+  bits.data = decoder->data;
+  bits.size = decoder->size;
+  bits.offset = offset;
+
+  clear = 1 << min_code_size;
+  for (i = 0; i < clear; i++) {
+    prefix[i] = 0;
+    suffix[i] = i;
+  }
+  avail = clear + 2;
+  code_size = min_code_size + 1;
+
+  while (r.left > 0) {
+    int32_t in = 0;
+    int32_t code = gif_bits_read(&bits, code_size);
+
+    if (code < 0 || code == clear + 1) {
+      break;
+    } else if (code == clear) {
+      avail = clear + 2;
+      code_size = min_code_size + 1;
+      old = -1;
+      continue;
+    } else if (old < 0) {
+      if (code > clear) {
+        break;
+      }
+      first = (uint8_t)code;
+      old = code;
+      gif_raster_put(&r, first);
+      continue;
+    }
+
+    in = code;
+    sp = 0;
+    if (code >= avail) {
+      if (code > avail) {
+        break;
+      }
+      stack[sp++] = first;
+      code = old;
+    }
+
+    while (code >= clear) {
+      stack[sp++] = suffix[code];
+      code = prefix[code];
+    }
+    first = suffix[code];
+    stack[sp++] = first;
+
+    if (avail < GIF_LZW_MAX_CODES) {
+      prefix[avail] = old;
+      suffix[avail] = first;
+      avail++;
+      if (avail == (1u << code_size) && code_size < 12) {
+        code_size++;
+      }
+    }
+    old = in;
+
+    while (sp > 0 && r.left > 0) {
+      gif_raster_put(&r, stack[--sp]);
+    }
+  }
+
+  image->flags |= BITMAP_FLAG_CHANGED;
+
+  return RET_OK;
+}
+
+/*帧的区域与图片的交集*/
+static bool_t gif_frame_clip(const gif_frame_info_t* info, bitmap_t* image, uint32_t* w,
+                             uint32_t* h) {
+  *w = info->x < image->w ? tk_min(info->w, image->w - info->x) : 0;
+  *h = info->y < image->h ? tk_min(info->h, image->h - info->y) : 0;
+
+  return *w > 0 && *h > 0;
+}
+
+static ret_t gif_decoder_save_rect(gif_decoder_t* decoder, const gif_frame_info_t* info,
+                                   bitmap_t* image, bool_t restore) {
+  uint32_t y = 0;
+  uint32_t w = 0;
+  uint32_t h = 0;
+
+  if (!gif_frame_clip(info, image, &w, &h)) {
+    return RET_OK;
+  }
+
+  if (!restore && decoder->saved_size < w * h * 4) {
+    TKMEM_FREE(decoder->saved);
+    decoder->saved = (uint8_t*)TKMEM_ALLOC(w * h * 4);
+    decoder->saved_size = decoder->saved != NULL ? w * h * 4 : 0;
+    return_value_if_fail(decoder->saved != NULL, RET_OOM);
+  }
+  return_value_if_fail(decoder->saved != NULL, RET_FAIL);
+
+  for (y = 0; y < h; y++) {
+    uint8_t* p = (uint8_t*)(image->data) + (info->y + y) * image->line_length + info->x * 4;
+    uint8_t* s = decoder->saved + y * w * 4;
+
+    if (restore) {
+      memcpy(p, s, w * 4);
+    } else {
+      memcpy(s, p, w * 4);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t gif_decoder_clear_rect(const gif_frame_info_t* info, bitmap_t* image) {
+  uint32_t y = 0;
+  uint32_t w = 0;
+  uint32_t h = 0;
+
+  if (gif_frame_clip(info, image, &w, &h)) {
+    for (y = 0; y < h; y++) {
+      memset((uint8_t*)(image->data) + (info->y + y) * image->line_length + info->x * 4, 0x00,
+             w * 4);
+    }
+  }
+
+  return RET_OK;
+}
+
+/*image中是第from帧(from为-1表示没有)，在它的基础上解码下一帧*/
+static ret_t gif_decoder_decode_next(gif_decoder_t* decoder, bitmap_t* image, int32_t from) {
+  uint32_t to = from + 1;
+
+  if (from < 0 || to >= decoder->frames_nr) {
+    to = 0;
+    memset((uint8_t*)(image->data), 0x00, image->line_length * image->h);
+  } else {
+    const gif_frame_info_t* prev = decoder->frames + from;
+
+    if (prev->disposal == GIF_DISPOSAL_BACKGROUND) {
+      gif_decoder_clear_rect(prev, image);
+    } else if (prev->disposal == GIF_DISPOSAL_PREVIOUS) {
+      gif_decoder_save_rect(decoder, prev, image, TRUE);
+    }
+  }
+
+  if (decoder->frames[to].disposal == GIF_DISPOSAL_PREVIOUS) {
+    ret_t ret = gif_decoder_save_rect(decoder, decoder->frames + to, image, FALSE);
+    return_value_if_fail(ret == RET_OK, ret);
+  }
+
+  return gif_decoder_draw_frame(decoder, to, image);
+}
+
+static ret_t gif_decoder_swap(gif_decoder_t* decoder) {
+  bitmap_t t = decoder->front;
+
+  decoder->front = decoder->back;
+  decoder->back = t;
+  decoder->front_index = decoder->back_index;
+  decoder->back_index = -1;
+
+  return RET_OK;
+}
+
+bitmap_t* gif_decoder_get_frame(gif_decoder_t* decoder, uint32_t index) {
+  return_value_if_fail(decoder != NULL && index < decoder->frames_nr, NULL);
+
+  if (decoder->front_index == (int32_t)index) {
+    return &(decoder->front);
+  }
+
+  /*back总是最后解码的帧，从它继续解码*/
+  if (decoder->back_index >= 0) {
+    gif_decoder_swap(decoder);
+  }
+
+  if ((int32_t)index < decoder->front_index) {
+    decoder->front_index = -1;
+  }
+
+  while (decoder->front_index != (int32_t)index) {
+    return_value_if_fail(
+        gif_decoder_decode_next(decoder, &(decoder->front), decoder->front_index) == RET_OK, NULL);
+    decoder->front_index++;
+  }
+
+  return &(decoder->front);
+}
+
+ret_t gif_decoder_prefetch(gif_decoder_t* decoder) {
+  int32_t from = 0;
+  bitmap_t* back = NULL;
+  return_value_if_fail(decoder != NULL, RET_BAD_PARAMS);
+
+  if (decoder->back_index >= 0 || decoder->front_index < 0 || decoder->frames_nr < 2) {
+    return RET_OK;
+  }
+
+  back = &(decoder->back);
+  if (back->data == NULL) {
+    ret_t ret = bitmap_init(back, decoder->w, decoder->h, GIF_BITMAP_FORMAT, NULL);
+    return_value_if_fail(ret == RET_OK, ret);
+  }
+
+  from = decoder->front_index;
+  if (from + 1 < (int32_t)(decoder->frames_nr)) {
+    memcpy((uint8_t*)(back->data), decoder->front.data, back->line_length * back->h);
+  } else {
+    from = -1;
+  }
+
+  return_value_if_fail(gif_decoder_decode_next(decoder, back, from) == RET_OK, RET_FAIL);
+  decoder->back_index = from + 1;
+
+  return RET_OK;
+}
+
+ret_t gif_decoder_destroy(gif_decoder_t* decoder) {
+  return_value_if_fail(decoder != NULL, RET_BAD_PARAMS);
+
+  if (decoder->front.data != NULL) {
+    bitmap_destroy(&(decoder->front));
+  }
+
+  if (decoder->back.data != NULL) {
+    bitmap_destroy(&(decoder->back));
+  }
+
+  TKMEM_FREE(decoder->lzw);
+  TKMEM_FREE(decoder->saved);
+  TKMEM_FREE(decoder->frames);
+  TKMEM_FREE(decoder->delays);
+  TKMEM_FREE(decoder);
+
+  return RET_OK;
+}
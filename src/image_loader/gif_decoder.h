@@ -0,0 +1,153 @@
+﻿/**
+ * File:   gif_decoder.h
+ * Author: AWTK Develop Team
+ * Brief:  streaming gif decoder
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_GIF_DECODER_H
+#define TK_GIF_DECODER_H
+
+#include "base/bitmap.h"
+
+BEGIN_C_DECLS
+
+typedef struct _gif_frame_info_t {
+  /*图像描述符(0x2C之后)在数据中的偏移*/
+  uint32_t offset;
+  uint16_t x;
+  uint16_t y;
+  uint16_t w;
+  uint16_t h;
+  uint8_t disposal;
+  int16_t transparent;
+} gif_frame_info_t;
+
+/**
+ * @class gif_decoder_t
+ * 增量的GIF解码器。
+ *
+ * 打开时只扫描一遍数据，记录每一帧的位置、延时和处理方式，压缩的数据仍然保存在资源中。
+ * 需要显示某一帧时才解码，只保留当前帧(以及预先解码的下一帧)，
+ * 内存占用与帧数无关(每帧w*h*4字节，最多两帧)。
+ *
+ * 支持帧的处理方式(disposal)：保留、恢复为透明背景和恢复为上一帧。
+ * 解码后的图片格式为RGBA8888(定义WITH\_BITMAP\_BGRA时为BGRA8888)。
+ *
+ * ```c
+ * gif_decoder_t* decoder = gif_decoder_create(asset->data, asset->size);
+ * bitmap_t* frame = gif_decoder_get_frame(decoder, 0);
+ * ...
+ * gif_decoder_prefetch(decoder);
+ * frame = gif_decoder_get_frame(decoder, 1);
+ * ...
+ * gif_decoder_destroy(decoder);
+ * ```
+ */
+typedef struct _gif_decoder_t {
+  /**
+   * @property {uint32_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  uint32_t w;
+  /**
+   * @property {uint32_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  uint32_t h;
+  /**
+   * @property {uint32_t} frames_nr
+   * @annotation ["readable"]
+   * 帧数。
+   */
+  uint32_t frames_nr;
+  /**
+   * @property {int*} delays
+   * @annotation ["readable"]
+   * 每一帧的延时(毫秒)。
+   */
+  int* delays;
+
+  /*private*/
+  const uint8_t* data;
+  uint32_t size;
+  const uint8_t* palette;
+  uint32_t palette_nr;
+  gif_frame_info_t* frames;
+
+  /*front为最后一次取出的帧，back为预先解码的下一帧*/
+  bitmap_t front;
+  bitmap_t back;
+  int32_t front_index;
+  int32_t back_index;
+
+  /*最后解码的帧的处理方式为恢复为上一帧时，保存该帧区域原来的内容*/
+  uint8_t* saved;
+  uint32_t saved_size;
+
+  /*LZW解码用的表*/
+  uint8_t* lzw;
+} gif_decoder_t;
+
+/**
+ * @method gif_decoder_create
+ * 创建GIF解码器。
+ * @annotation ["constructor"]
+ * @param {const uint8_t*} data GIF数据(解码器销毁之前必须有效)。
+ * @param {uint32_t} size GIF数据的长度。
+ *
+ * @return {gif_decoder_t*} 返回解码器对象，数据无效时返回NULL。
+ */
+gif_decoder_t* gif_decoder_create(const uint8_t* data, uint32_t size);
+
+/**
+ * @method gif_decoder_get_frame
+ * 获取指定的帧。下一帧已经预先解码时直接返回，否则从当前帧继续解码(往回时从第一帧开始解码)。
+ *
+ * > 返回的图片属于解码器，下次调用gif\_decoder\_get\_frame后内容可能改变。
+ *
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ * @param {uint32_t} index 帧的序号。
+ *
+ * @return {bitmap_t*} 返回图片，失败返回NULL。
+ */
+bitmap_t* gif_decoder_get_frame(gif_decoder_t* decoder, uint32_t index);
+
+/**
+ * @method gif_decoder_prefetch
+ * 预先解码下一帧(最后一帧的下一帧为第一帧)，一般在idle中调用，避免显示下一帧时才解码。
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_prefetch(gif_decoder_t* decoder);
+
+/**
+ * @method gif_decoder_destroy
+ * 销毁解码器。
+ * @annotation ["deconstructor"]
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_destroy(gif_decoder_t* decoder);
+
+END_C_DECLS
+
+#endif /*TK_GIF_DECODER_H*/
@@ -0,0 +1,71 @@
+﻿/**
+ * File:   image_loader_lz4.c
+ * Author: AWTK Develop Team
+ * Brief:  lz4 compressed raw image loader
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/lz4.h"
+#include "base/assets_manager.h"
+#include "image_loader/image_loader_lz4.h"
+
+ret_t lz4_load_image(const uint8_t* buff, uint32_t buff_size, bitmap_t* image) {
+  uint32_t size = 0;
+  const bitmap_lz4_header_t* header = (const bitmap_lz4_header_t*)buff;
+  return_value_if_fail(buff != NULL && image != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(buff_size >= sizeof(bitmap_lz4_header_t) - sizeof(header->data),
+                       RET_BAD_PARAMS);
+  return_value_if_fail(header->size <= buff_size - (header->data - buff), RET_BAD_PARAMS);
+  return_value_if_fail(header->w > 0 && header->h > 0, RET_BAD_PARAMS);
+
+  memset(image, 0x00, sizeof(bitmap_t));
+  image->w = header->w;
+  image->h = header->h;
+  image->format = (bitmap_format_t)(header->format);
+  image->flags = header->flags | BITMAP_FLAG_IMMUTABLE;
+  bitmap_set_line_length(image, 0);
+  return_value_if_fail(bitmap_alloc_data(image) == RET_OK, RET_OOM);
+
+  /*行之间没有填充，直接解压到位图的数据中，不需要中间缓冲区*/
+  size = bitmap_get_line_length(image) * image->h;
+  if (lz4_decompress(header->data, header->size, (uint8_t*)(image->data), size) != (int32_t)size) {
+    log_warn("%s: invalid lz4 image data\n", __FUNCTION__);
+    bitmap_destroy(image);
+    memset(image, 0x00, sizeof(bitmap_t));
+
+    return RET_FAIL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_loader_lz4_load(image_loader_t* l, const asset_info_t* asset, bitmap_t* image) {
+  return_value_if_fail(l != NULL && asset != NULL && image != NULL, RET_BAD_PARAMS);
+
+  if (asset->subtype != ASSET_TYPE_IMAGE_LZ4) {
+    return RET_NOT_IMPL;
+  }
+
+  return lz4_load_image(asset->data, asset->size, image);
+}
+
+static const image_loader_t lz4_loader = {.load = image_loader_lz4_load};
+
+image_loader_t* image_loader_lz4() {
+  return (image_loader_t*)&lz4_loader;
+}
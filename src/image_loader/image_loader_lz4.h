@@ -0,0 +1,68 @@
+﻿/**
+ * File:   image_loader_lz4.h
+ * Author: AWTK Develop Team
+ * Brief:  lz4 compressed raw image loader
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_IMAGE_LOADER_LZ4_H
+#define TK_IMAGE_LOADER_LZ4_H
+
+#include "base/image_loader.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 用LZ4压缩的位图数据的头(ASSET\_TYPE\_IMAGE\_LZ4)，后面紧跟压缩后的像素数据。
+ */
+typedef struct _bitmap_lz4_header_t {
+  uint16_t w;
+  uint16_t h;
+  uint16_t flags;  /*bitmap_flag_t*/
+  uint16_t format; /*bitmap_format_t*/
+  uint32_t size;   /*压缩后的数据长度*/
+  uint8_t data[4];
+} bitmap_lz4_header_t;
+
+/**
+ * @class image_loader_lz4_t
+ * @parent image_loader_t
+ * LZ4压缩的位图加载器。
+ *
+ * 用于加载image\_gen生成的LZ4压缩的位图(选项lz4)，直接解压到位图的数据中。
+ * 与不压缩的位图相比占用的flash少很多，与png相比解压快很多。
+ *
+ * @annotation["fake"]
+ *
+ */
+
+/**
+ * @method image_loader_lz4
+ * @annotation ["constructor"]
+ *
+ * 获取LZ4压缩的位图加载器对象。
+ *
+ * @return {image_loader_t*} 返回图片加载器对象。
+ */
+image_loader_t* image_loader_lz4(void);
+
+/*for tool image_gen and tests*/
+ret_t lz4_load_image(const uint8_t* buff, uint32_t buff_size, bitmap_t* image);
+
+END_C_DECLS
+
+#endif /*TK_IMAGE_LOADER_LZ4_H*/
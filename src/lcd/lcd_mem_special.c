@@ -78,6 +78,15 @@ static ret_t lcd_mem_special_draw_glyph(lcd_t* lcd, glyph_t* glyph, rect_t* src,
   return lcd_draw_glyph(mem, glyph, src, x, y);
 }
 
+static ret_t lcd_mem_special_draw_glyphs(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr) {
+  lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
+  lcd_t* mem = (lcd_t*)(special->lcd_mem);
+  mem->text_color = lcd->text_color;
+  mem->fill_color = lcd->fill_color;
+
+  return lcd_draw_glyphs(mem, glyphs, nr);
+}
+
 static ret_t lcd_mem_special_draw_image_matrix(lcd_t* lcd, draw_image_info_t* info) {
   lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
   lcd_t* mem = (lcd_t*)(special->lcd_mem);
@@ -89,6 +98,7 @@ static ret_t lcd_mem_special_draw_image(lcd_t* lcd, bitmap_t* img, rect_t* src,
   lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
   lcd_t* mem = (lcd_t*)(special->lcd_mem);
 
+  mem->image_smooth = lcd->image_smooth;
   return lcd_draw_image(mem, img, src, dst);
 }
 
@@ -130,6 +140,12 @@ static ret_t lcd_mem_special_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t aut
   return lcd_take_snapshot((lcd_t*)(special->lcd_mem), img, auto_rotate);
 }
 
+static ret_t lcd_mem_special_read_rect(lcd_t* lcd, rect_t* r, bitmap_t* img) {
+  lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
+
+  return lcd_read_rect((lcd_t*)(special->lcd_mem), r, img);
+}
+
 static bitmap_format_t lcd_mem_special_get_desired_bitmap_format(lcd_t* lcd) {
   lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
 
@@ -219,11 +235,13 @@ lcd_t* lcd_mem_special_create(wh_t w, wh_t h, bitmap_format_t fmt, lcd_flush_t o
   lcd->draw_image = lcd_mem_special_draw_image;
   lcd->draw_image_matrix = lcd_mem_special_draw_image_matrix;
   lcd->draw_glyph = lcd_mem_special_draw_glyph;
+  lcd->draw_glyphs = lcd_mem_special_draw_glyphs;
   lcd->draw_points = lcd_mem_special_draw_points;
   lcd->get_point_color = lcd_mem_special_get_point_color;
   lcd->end_frame = lcd_mem_special_end_frame;
   lcd->get_vgcanvas = lcd_mem_special_get_vgcanvas;
   lcd->take_snapshot = lcd_mem_special_take_snapshot;
+  lcd->read_rect = lcd_mem_special_read_rect;
   lcd->set_global_alpha = lcd_mem_special_set_global_alpha;
   lcd->get_desired_bitmap_format = lcd_mem_special_get_desired_bitmap_format;
   lcd->resize = lcd_mem_special_resize;
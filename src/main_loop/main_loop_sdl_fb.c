@@ -85,6 +85,8 @@ main_loop_t* main_loop_init(int w, int h) {
 
   loop->base.destroy = main_loop_sdl_fb_destroy;
   loop->dispatch_input = main_loop_sdl2_dispatch;
+  loop->base.wait = main_loop_sdl2_wait;
+  loop->base.wakeup = main_loop_sdl2_wakeup;
 
   main_loop_sdl_fb_create_window(loop);
   SDL_StopTextInput();
@@ -19,28 +19,63 @@
  *
  */
 
+#include "tkc/trace.h"
 #include "tkc/time_now.h"
+#include "base/velocity.h"
 #include "main_loop/main_loop_simple.h"
 
+#ifdef WIN32
+#include <windows.h>
+#define main_loop_thread_self() ((uint64_t)GetCurrentThreadId())
+#elif defined(HAS_PTHREAD)
+#include <pthread.h>
+#define main_loop_thread_self() ((uint64_t)(uintptr_t)pthread_self())
+#else
+#define main_loop_thread_self() ((uint64_t)0)
+#endif /*WIN32*/
+
 static ret_t main_loop_simple_queue_event(main_loop_t* l, const event_queue_req_t* r) {
-  ret_t ret = RET_FAIL;
+  main_loop_simple_t* loop = (main_loop_simple_t*)l;
+  /*GUI线程等待时没有人取走事件，只会白白等到超时*/
+  uint32_t timeout = main_loop_thread_self() == loop->gui_thread ? 0 : loop->send_timeout;
+
+  return event_queue_mpsc_send_timeout(loop->queue, r, timeout);
+}
+
+static ret_t main_loop_simple_wakeup(main_loop_t* l) {
   main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
-  tk_mutex_lock(loop->mutex);
-  ret = event_queue_send(loop->queue, r);
-  tk_mutex_unlock(loop->mutex);
+  return tk_cond_var_awake(loop->cond);
+}
+
+static ret_t main_loop_simple_wait(main_loop_t* l, uint32_t timeout_ms) {
+  main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
-  return ret;
+  return tk_cond_var_wait(loop->cond, timeout_ms);
 }
 
 static ret_t main_loop_simple_recv_event(main_loop_simple_t* loop, event_queue_req_t* r) {
-  ret_t ret = RET_FAIL;
+  return event_queue_mpsc_recv(loop->queue, r);
+}
+
+static ret_t main_loop_simple_on_queue_wakeup(void* ctx) {
+  return main_loop_wakeup((main_loop_t*)ctx);
+}
+
+ret_t main_loop_simple_set_send_timeout(main_loop_simple_t* loop, uint32_t timeout_ms) {
+  return_value_if_fail(loop != NULL, RET_BAD_PARAMS);
+
+  loop->send_timeout = timeout_ms;
+
+  return RET_OK;
+}
 
-  tk_mutex_lock(loop->mutex);
-  ret = event_queue_recv(loop->queue, r);
-  tk_mutex_unlock(loop->mutex);
+ret_t main_loop_simple_set_coalesce_pointer_move(main_loop_simple_t* loop, bool_t coalesce) {
+  return_value_if_fail(loop != NULL, RET_BAD_PARAMS);
 
-  return ret;
+  loop->coalesce_pointer_move = coalesce;
+
+  return RET_OK;
 }
 
 ret_t main_loop_post_pointer_event(main_loop_t* l, bool_t pressed, xy_t x, xy_t y) {
@@ -115,14 +150,39 @@ ret_t main_loop_post_key_event(main_loop_t* l, bool_t pressed, uint8_t key) {
   return RET_OK;
 }
 
+/*
+ * 后面紧跟着的也是移动事件时，当前的移动事件已经过时，只把它记录到velocity的历史中。
+ */
+static ret_t main_loop_coalesce_pointer_move(main_loop_simple_t* loop, event_queue_req_t* r) {
+  event_queue_req_t next;
+
+  while (event_queue_mpsc_peek(loop->queue, &next) == RET_OK) {
+    if (next.event.type != EVT_POINTER_MOVE ||
+        next.pointer_event.pressed != r->pointer_event.pressed) {
+      break;
+    }
+
+    velocity_history_add(r->event.time, r->pointer_event.x, r->pointer_event.y);
+    main_loop_simple_recv_event(loop, r);
+  }
+
+  return RET_OK;
+}
+
 static ret_t main_loop_dispatch_events(main_loop_simple_t* loop) {
   event_queue_req_t r;
   widget_t* widget = loop->base.wm;
 
   while (main_loop_simple_recv_event(loop, &r) == RET_OK) {
     switch (r.event.type) {
-      case EVT_POINTER_DOWN:
       case EVT_POINTER_MOVE:
+        if (loop->coalesce_pointer_move) {
+          velocity_history_reset();
+          main_loop_coalesce_pointer_move(loop, &r);
+        }
+        window_manager_dispatch_input_event(widget, (event_t*)&(r.pointer_event));
+        break;
+      case EVT_POINTER_DOWN:
       case EVT_POINTER_UP:
         window_manager_dispatch_input_event(widget, (event_t*)&(r.pointer_event));
         break;
@@ -156,12 +216,26 @@ static ret_t main_loop_dispatch_input(main_loop_simple_t* loop) {
 static ret_t main_loop_simple_step(main_loop_t* l) {
   main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
+  tk_trace_begin("phase", "frame");
+  main_loop_begin_frame(l, time_now_ms());
+
+  tk_trace_begin("phase", "timer");
   timer_dispatch();
+  tk_trace_end();
+
+  tk_trace_begin("phase", "input");
   main_loop_dispatch_input(loop);
   main_loop_dispatch_events(loop);
-  idle_dispatch();
+  tk_trace_end();
+
+  if (main_loop_should_dispatch_idle(l, time_now_ms())) {
+    tk_trace_begin("phase", "idle");
+    idle_dispatch();
+    tk_trace_end();
+  }
 
   window_manager_paint(loop->base.wm, &(loop->base.canvas));
+  tk_trace_end();
 
   return RET_OK;
 }
@@ -170,6 +244,7 @@ static ret_t main_loop_simple_run(main_loop_t* l) {
   main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
   loop->pressed = FALSE;
+  loop->gui_thread = main_loop_thread_self();
   while (l->running) {
     main_loop_step(l);
     main_loop_sleep(l);
@@ -186,14 +261,20 @@ main_loop_simple_t* main_loop_simple_init(int w, int h) {
 
   loop->w = w;
   loop->h = h;
+  loop->coalesce_pointer_move = TK_COALESCE_POINTER_MOVE;
   loop->base.wm = window_manager();
   return_value_if_fail(loop->base.wm != NULL, NULL);
 
-  loop->queue = event_queue_create(20);
+  loop->queue = event_queue_mpsc_create(TK_EVENT_QUEUE_SIZE);
   return_value_if_fail(loop->queue != NULL, NULL);
+  event_queue_mpsc_set_wakeup(loop->queue, main_loop_simple_on_queue_wakeup, loop);
 
-  loop->mutex = tk_mutex_create();
-  return_value_if_fail(loop->mutex != NULL, NULL);
+  loop->gui_thread = main_loop_thread_self();
+  loop->cond = tk_cond_var_create();
+  if (loop->cond != NULL) {
+    loop->base.wait = main_loop_simple_wait;
+    loop->base.wakeup = main_loop_simple_wakeup;
+  }
 
   loop->base.run = main_loop_simple_run;
   loop->base.step = main_loop_simple_step;
@@ -207,8 +288,10 @@ main_loop_simple_t* main_loop_simple_init(int w, int h) {
 
 ret_t main_loop_simple_reset(main_loop_simple_t* loop) {
   return_value_if_fail(loop != NULL, RET_BAD_PARAMS);
-  event_queue_destroy(loop->queue);
-  tk_mutex_destroy(loop->mutex);
+  event_queue_mpsc_destroy(loop->queue);
+  if (loop->cond != NULL) {
+    tk_cond_var_destroy(loop->cond);
+  }
   lcd_destroy(loop->base.lcd);
 
   canvas_reset(&(loop->base.canvas));
@@ -25,6 +25,7 @@
 #include "base/idle.h"
 #include "base/timer.h"
 #include "tkc/mutex.h"
+#include "tkc/cond_var.h"
 #include "base/main_loop.h"
 #include "base/event_queue.h"
 #include "base/font_manager.h"
@@ -39,7 +40,16 @@ typedef ret_t (*main_loop_dispatch_input_t)(main_loop_simple_t* loop);
 
 struct _main_loop_simple_t {
   main_loop_t base;
-  event_queue_t* queue;
+  /*多生产者单消费者的无锁队列，容量为TK_EVENT_QUEUE_SIZE*/
+  event_queue_mpsc_t* queue;
+  /*队列满时其它线程等待的时间(毫秒)，为0表示不等待直接丢弃*/
+  uint32_t send_timeout;
+  /*是否合并连续的指针移动事件，缺省为TK_COALESCE_POINTER_MOVE*/
+  bool_t coalesce_pointer_move;
+  /*GUI线程睡眠时等待的条件变量，main_loop_wakeup唤醒它*/
+  tk_cond_var_t* cond;
+  /*GUI线程的ID，GUI线程自己发送事件时队列满了不等待*/
+  uint64_t gui_thread;
 
   wh_t w;
   wh_t h;
@@ -48,7 +58,6 @@ struct _main_loop_simple_t {
   xy_t last_x;
   xy_t last_y;
   uint8_t last_key;
-  tk_mutex_t* mutex;
   void* user1;
   void* user2;
   void* user3;
@@ -59,6 +68,8 @@ struct _main_loop_simple_t {
 main_loop_simple_t* main_loop_simple_init(int w, int h);
 
 ret_t main_loop_simple_reset(main_loop_simple_t* loop);
+ret_t main_loop_simple_set_send_timeout(main_loop_simple_t* loop, uint32_t timeout_ms);
+ret_t main_loop_simple_set_coalesce_pointer_move(main_loop_simple_t* loop, bool_t coalesce);
 ret_t main_loop_post_key_event(main_loop_t* l, bool_t pressed, uint8_t key);
 ret_t main_loop_post_pointer_event(main_loop_t* l, bool_t pressed, xy_t x, xy_t y);
 
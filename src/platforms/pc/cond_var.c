@@ -46,14 +46,18 @@ tk_cond_var_t* tk_cond_var_create(void) {
 ret_t tk_cond_var_wait(tk_cond_var_t* cond_var, uint32_t timeout_ms) {
   return_value_if_fail(cond_var != NULL && cond_var->inited, RET_BAD_PARAMS);
 
+  ret_t ret = RET_OK;
   EnterCriticalSection(&(cond_var->mutex));
   while (!cond_var->has_signal) {
-    SleepConditionVariableCS(&(cond_var->cond), &(cond_var->mutex), timeout_ms);
+    if (!SleepConditionVariableCS(&(cond_var->cond), &(cond_var->mutex), timeout_ms)) {
+      break;
+    }
   }
+  ret = cond_var->has_signal ? RET_OK : RET_FAIL;
   cond_var->has_signal = FALSE;
   LeaveCriticalSection(&(cond_var->mutex));
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t tk_cond_var_awake(tk_cond_var_t* cond_var) {
@@ -82,6 +86,7 @@ ret_t tk_cond_var_destroy(tk_cond_var_t* cond_var) {
 #define _POSIX_C_SOURCE 199309L
 #endif /*_POSIX_C_SOURCE*/
 
+#include <errno.h>
 #include <pthread.h>
 #include <sys/time.h>
 
@@ -106,21 +111,27 @@ tk_cond_var_t* tk_cond_var_create(void) {
 ret_t tk_cond_var_wait(tk_cond_var_t* cond_var, uint32_t timeout_ms) {
   return_value_if_fail(cond_var != NULL && cond_var->inited, RET_BAD_PARAMS);
 
-  pthread_mutex_lock(&(cond_var->mutex));
-  while (!cond_var->has_signal) {
-    struct timespec ts;
-    struct timeval now;
+  ret_t ret = RET_OK;
+  struct timespec ts;
+  struct timeval now;
+  uint64_t nsec = 0;
 
-    gettimeofday(&now, NULL);
-    ts.tv_sec = now.tv_sec + timeout_ms / 1000;
-    ts.tv_nsec = now.tv_usec * 1000 + timeout_ms % 1000;
+  gettimeofday(&now, NULL);
+  nsec = (uint64_t)(now.tv_usec) * 1000 + (uint64_t)(timeout_ms % 1000) * 1000000;
+  ts.tv_sec = now.tv_sec + timeout_ms / 1000 + nsec / 1000000000;
+  ts.tv_nsec = nsec % 1000000000;
 
-    pthread_cond_timedwait(&(cond_var->cond), &(cond_var->mutex), &ts);
+  pthread_mutex_lock(&(cond_var->mutex));
+  while (!cond_var->has_signal) {
+    if (pthread_cond_timedwait(&(cond_var->cond), &(cond_var->mutex), &ts) == ETIMEDOUT) {
+      break;
+    }
   }
+  ret = cond_var->has_signal ? RET_OK : RET_FAIL;
   cond_var->has_signal = FALSE;
   pthread_mutex_unlock(&(cond_var->mutex));
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t tk_cond_var_awake(tk_cond_var_t* cond_var) {
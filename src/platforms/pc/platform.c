@@ -88,6 +88,15 @@ uint32_t get_time_ms() {
   return tv.tv_sec * 1000 + tv.tv_usec / 1000;
 }
 
+#ifdef HAS_GET_TIME_US64
+uint64_t get_time_us64() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+
+  return (uint64_t)(tv.tv_sec) * 1000000 + tv.tv_usec;
+}
+#endif /*HAS_GET_TIME_US64*/
+
 void sleep_ms(uint32_t ms) {
 #ifdef WIN32
   Sleep(ms);
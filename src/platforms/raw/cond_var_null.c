@@ -20,11 +20,13 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/platform.h"
 #include "tkc/cond_var.h"
 
 struct _tk_cond_var_t {
   bool_t inited;
-  bool_t has_signal;
+  /*可能在中断中唤醒*/
+  volatile bool_t has_signal;
 };
 
 tk_cond_var_t* tk_cond_var_create(void) {
@@ -37,14 +39,27 @@ tk_cond_var_t* tk_cond_var_create(void) {
 }
 
 ret_t tk_cond_var_wait(tk_cond_var_t* cond_var, uint32_t timeout_ms) {
+  uint32_t start = get_time_ms();
   return_value_if_fail(cond_var != NULL && cond_var->inited, RET_BAD_PARAMS);
 
-  return RET_OK;
+  /*没有线程，只能按毫秒检查是否被唤醒(中断中调用tk_cond_var_awake)*/
+  while (!cond_var->has_signal && (get_time_ms() - start) < timeout_ms) {
+    sleep_ms(1);
+  }
+
+  if (cond_var->has_signal) {
+    cond_var->has_signal = FALSE;
+    return RET_OK;
+  }
+
+  return RET_FAIL;
 }
 
 ret_t tk_cond_var_awake(tk_cond_var_t* cond_var) {
   return_value_if_fail(cond_var != NULL && cond_var->inited, RET_BAD_PARAMS);
 
+  cond_var->has_signal = TRUE;
+
   return RET_OK;
 }
 
@@ -43,11 +43,11 @@ tk_cond_var_t* tk_cond_var_create(void);
 
 /**
  * @method tk_cond_var_wait
- * 等待。
+ * 等待。在等待之前已经被唤醒时立即返回。
  * @param {tk_cond_var_t*}    cond_var cond_var对象。
  * @param {uint32_t*}  timeout_ms 最长等待时间。
  *
- * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ * @return {ret_t} 返回RET_OK表示被唤醒，超时返回RET_FAIL。
  */
 ret_t tk_cond_var_wait(tk_cond_var_t* cond_var, uint32_t timeout_ms);
 
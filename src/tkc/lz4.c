@@ -0,0 +1,201 @@
+﻿/**
+ * File:   lz4.c
+ * Author: AWTK Develop Team
+ * Brief:  lz4 block format compress/decompress
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/lz4.h"
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_MAX_OFFSET 65535
+/*最后一个匹配必须在结尾12字节之前开始，最后5个字节必须是literal(与标准的LZ4兼容)*/
+#define LZ4_MF_LIMIT 12
+#define LZ4_LAST_LITERALS 5
+#define LZ4_HASH_BITS 12
+#define LZ4_HASH_SIZE (1 << LZ4_HASH_BITS)
+
+static uint32_t lz4_read32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)(p[3]) << 24);
+}
+
+static uint32_t lz4_hash(uint32_t v) {
+  return (v * 2654435761U) >> (32 - LZ4_HASH_BITS);
+}
+
+uint32_t lz4_compress_bound(uint32_t size) {
+  return size + size / 255 + 16;
+}
+
+static uint8_t* lz4_write_len(uint8_t* op, uint8_t* oend, uint32_t len) {
+  while (len >= 255) {
+    return_value_if_fail(op < oend, NULL);
+    *op++ = 255;
+    len -= 255;
+  }
+  return_value_if_fail(op < oend, NULL);
+  *op++ = (uint8_t)len;
+
+  return op;
+}
+
+static uint8_t* lz4_write_sequence(uint8_t* op, uint8_t* oend, const uint8_t* literals,
+                                   uint32_t literals_len, uint32_t offset, uint32_t match_len) {
+  uint8_t* token = op;
+  return_value_if_fail(op < oend, NULL);
+
+  op++;
+  *token = (literals_len >= 15 ? 15 : literals_len) << 4;
+  if (literals_len >= 15) {
+    op = lz4_write_len(op, oend, literals_len - 15);
+    return_value_if_fail(op != NULL, NULL);
+  }
+
+  return_value_if_fail(literals_len <= (uint32_t)(oend - op), NULL);
+  memcpy(op, literals, literals_len);
+  op += literals_len;
+
+  if (offset == 0) {
+    return op;
+  }
+
+  return_value_if_fail((oend - op) >= 2, NULL);
+  *op++ = offset & 0xff;
+  *op++ = offset >> 8;
+
+  match_len -= LZ4_MIN_MATCH;
+  *token |= (match_len >= 15 ? 15 : match_len);
+  if (match_len >= 15) {
+    op = lz4_write_len(op, oend, match_len - 15);
+  }
+
+  return op;
+}
+
+int32_t lz4_compress(const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t capacity) {
+  uint32_t* table = NULL;
+  uint8_t* op = dst;
+  uint8_t* oend = dst + capacity;
+  const uint8_t* ip = src;
+  const uint8_t* anchor = src;
+  const uint8_t* iend = src + size;
+  const uint8_t* mflimit = size > LZ4_MF_LIMIT ? iend - LZ4_MF_LIMIT : src;
+  const uint8_t* matchlimit = size > LZ4_LAST_LITERALS ? iend - LZ4_LAST_LITERALS : src;
+  return_value_if_fail(src != NULL && dst != NULL, -1);
+
+  table = TKMEM_ZALLOCN(uint32_t, LZ4_HASH_SIZE);
+  return_value_if_fail(table != NULL, -1);
+
+  while (ip < mflimit) {
+    uint32_t v = lz4_read32(ip);
+    uint32_t h = lz4_hash(v);
+    const uint8_t* ref = src + table[h];
+
+    table[h] = (uint32_t)(ip - src);
+    if (ref < ip && (ip - ref) <= LZ4_MAX_OFFSET && lz4_read32(ref) == v) {
+      uint32_t match_len = LZ4_MIN_MATCH;
+
+      while ((ip + match_len) < matchlimit && ref[match_len] == ip[match_len]) {
+        match_len++;
+      }
+
+      op = lz4_write_sequence(op, oend, anchor, (uint32_t)(ip - anchor), (uint32_t)(ip - ref),
+                              match_len);
+      if (op == NULL) {
+        break;
+      }
+
+      ip += match_len;
+      anchor = ip;
+    } else {
+      ip++;
+    }
+  }
+
+  if (op != NULL) {
+    op = lz4_write_sequence(op, oend, anchor, (uint32_t)(iend - anchor), 0, 0);
+  }
+  TKMEM_FREE(table);
+
+  return op != NULL ? (int32_t)(op - dst) : -1;
+}
+
+int32_t lz4_decompress(const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t capacity) {
+  uint8_t* op = dst;
+  uint8_t* oend = dst + capacity;
+  const uint8_t* ip = src;
+  const uint8_t* iend = src + size;
+  return_value_if_fail(src != NULL && dst != NULL, -1);
+
+  while (ip < iend) {
+    uint32_t len = 0;
+    uint32_t offset = 0;
+    const uint8_t* match = NULL;
+    uint8_t token = *ip++;
+
+    len = token >> 4;
+    if (len == 15) {
+      uint8_t s = 255;
+      while (s == 255) {
+        return_value_if_fail(ip < iend, -1);
+        s = *ip++;
+        len += s;
+      }
+    }
+
+    return_value_if_fail(len <= (uint32_t)(iend - ip) && len <= (uint32_t)(oend - op), -1);
+    memcpy(op, ip, len);
+    op += len;
+    ip += len;
+
+    /*最后一个序列只有literal*/
+    if (ip >= iend) {
+      break;
+    }
+
+    return_value_if_fail((iend - ip) >= 2, -1);
+    offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    return_value_if_fail(offset > 0 && offset <= (uint32_t)(op - dst), -1);
+
+    len = token & 0x0f;
+    if (len == 15) {
+      uint8_t s = 255;
+      while (s == 255) {
+        return_value_if_fail(ip < iend, -1);
+        s = *ip++;
+        len += s;
+      }
+    }
+    len += LZ4_MIN_MATCH;
+    return_value_if_fail(len <= (uint32_t)(oend - op), -1);
+
+    match = op - offset;
+    if (offset >= len) {
+      memcpy(op, match, len);
+      op += len;
+    } else {
+      /*重叠的匹配(如连续相同的像素)只能逐字节拷贝*/
+      while (len-- > 0) {
+        *op++ = *match++;
+      }
+    }
+  }
+
+  return (int32_t)(op - dst);
+}
@@ -0,0 +1,76 @@
+﻿/**
+ * File:   lz4.h
+ * Author: AWTK Develop Team
+ * Brief:  lz4 block format compress/decompress
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_LZ4_H
+#define TK_LZ4_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class lz4_t
+ * @annotation ["fake"]
+ * LZ4块格式(block format)的压缩和解压。
+ *
+ * 解压只需要输入和输出缓冲区，不需要额外的内存，速度远快于png/jpg的解码。
+ * 压缩实现的是简单的贪心匹配，主要给资源生成工具使用。
+ */
+
+/**
+ * @method lz4_compress_bound
+ * 获取压缩后的数据最大可能的长度。
+ * @annotation ["static"]
+ * @param {uint32_t} size 原始数据的长度。
+ *
+ * @return {uint32_t} 返回压缩后的数据最大可能的长度。
+ */
+uint32_t lz4_compress_bound(uint32_t size);
+
+/**
+ * @method lz4_compress
+ * 压缩数据。
+ * @annotation ["static"]
+ * @param {const uint8_t*} src 原始数据。
+ * @param {uint32_t} size 原始数据的长度。
+ * @param {uint8_t*} dst 用于返回压缩后的数据。
+ * @param {uint32_t} capacity dst的长度(不小于lz4\_compress\_bound时保证成功)。
+ *
+ * @return {int32_t} 返回压缩后的数据长度，失败返回-1。
+ */
+int32_t lz4_compress(const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t capacity);
+
+/**
+ * @method lz4_decompress
+ * 解压数据。会检查输入数据的合法性，损坏的数据不会导致越界访问。
+ * @annotation ["static"]
+ * @param {const uint8_t*} src 压缩后的数据。
+ * @param {uint32_t} size 压缩后的数据长度。
+ * @param {uint8_t*} dst 用于返回原始数据。
+ * @param {uint32_t} capacity dst的长度。
+ *
+ * @return {int32_t} 返回原始数据的长度，失败返回-1。
+ */
+int32_t lz4_decompress(const uint8_t* src, uint32_t size, uint8_t* dst, uint32_t capacity);
+
+END_C_DECLS
+
+#endif /*TK_LZ4_H*/
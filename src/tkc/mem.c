@@ -64,160 +64,477 @@ static void tk_free_impl(void* ptr) {
 }
 
 #else /*non std memory manager*/
-typedef struct _free_node_t {
+/*
+ * 内存分为两级管理：
+ * 1.小于等于MEM_SMALL_MAX的内存块按大小分成若干类，从slab页面中分配，每个页面只存放
+ *   一类内存块，分配和释放都只是对页面内的空闲链表进行操作。
+ * 2.大的内存块(包括slab页面本身)使用TLSF(two level segregated fit)算法管理，空闲块按
+ *   大小分到两级的链表中，用位图查找合适的链表，相邻的空闲块通过边界标记合并。
+ * 两者的分配和释放都是O(1)的。
+ *
+ * 内存块前面的4个字节为头部，用于区分两种内存块(MEM_BLOCK_SMALL)。
+ */
+
+#ifndef TK_MEM_SLAB_PAGE_SIZE
+#define TK_MEM_SLAB_PAGE_SIZE 1024
+#endif /*TK_MEM_SLAB_PAGE_SIZE*/
+
+#define R8B(size) (((size + 7) >> 3) << 3)
+
+#define MEM_BLOCK_FREE 1
+#define MEM_BLOCK_SMALL 2
+#define MEM_BLOCK_FLAGS 7
+
+#define MEM_SL_LOG2 4
+#define MEM_SL_NR (1 << MEM_SL_LOG2)
+#define MEM_FL_SHIFT (MEM_SL_LOG2 + 3)
+#define MEM_FL_NR (32 - MEM_FL_SHIFT + 1)
+#define MEM_SMALL_BLOCK (1 << MEM_FL_SHIFT)
+
+#define MEM_SMALL_MAX 256
+#define MEM_SLAB_MIN_SLOTS 4
+
+typedef struct _mem_block_t {
+  /*物理上前一个块的大小，为0表示是第一个块*/
+  uint32_t prev_size;
+  /*块的大小(包括头部)，低3位为标志*/
   uint32_t size;
-  struct _free_node_t* next;
-  struct _free_node_t* prev;
-} free_node_t;
+  /*下面两个字段只在空闲时有效，使用时为用户数据*/
+  struct _mem_block_t* next_free;
+  struct _mem_block_t* prev_free;
+} mem_block_t;
+
+#define MEM_BLOCK_HEADER_SIZE 8
+#define MEM_MIN_BLOCK_SIZE R8B(sizeof(mem_block_t))
+
+typedef struct _slab_page_t {
+  struct _slab_page_t* next;
+  struct _slab_page_t* prev;
+  /*空闲的slot(用户数据地址)链表*/
+  void* free_list;
+  uint16_t class_index;
+  /*已分配出去的slot个数*/
+  uint16_t used;
+  /*已经划分出来的slot个数(slot是按需划分的)*/
+  uint16_t inited;
+  /*总的slot个数*/
+  uint16_t nr;
+} slab_page_t;
+
+#define SLAB_PAGE_HEADER_SIZE R8B(sizeof(slab_page_t))
+
+typedef struct _slab_class_t {
+  /*slot的大小(包括4字节的头部)*/
+  uint32_t slot_size;
+  uint32_t slots_per_page;
+  uint32_t page_nr;
+  uint32_t used;
+  /*还有空闲slot的页面*/
+  slab_page_t* pages;
+} slab_class_t;
+
+static const uint16_t s_slot_sizes[] = {16,  24,  32,  40,  48,  56,  64,  80,
+                                        96,  112, 128, 160, 192, 224, 264};
+#define MEM_CLASS_NR ARRAY_SIZE(s_slot_sizes)
 
 typedef struct _mem_info_t {
   char* buffer;
   uint32_t size;
   uint32_t used_bytes;
   uint32_t used_block_nr;
-  free_node_t* free_list;
-} mem_info_t;
+  uint32_t free_bytes;
+  uint32_t free_block_nr;
+  uint32_t slab_bytes;
 
-#define R8B(size) (((size + 7) >> 3) << 3)
-#define MIN_SIZE R8B(sizeof(free_node_t))
-#define REAL_SIZE(size) R8B((size > sizeof(free_node_t) ? size : MIN_SIZE) + sizeof(uint32_t));
+  uint32_t fl_bitmap;
+  uint32_t sl_bitmap[MEM_FL_NR];
+  mem_block_t* blocks[MEM_FL_NR][MEM_SL_NR];
 
-static mem_info_t s_mem_info;
+  uint8_t class_of[(R8B(MEM_SMALL_MAX + 4) >> 3) + 1];
+  slab_class_t classes[MEM_CLASS_NR];
+} mem_info_t;
 
-static void* tk_alloc_impl(uint32_t s) {
-  free_node_t* iter = NULL;
-  uint32_t size = REAL_SIZE(s);
+static mem_info_t s_mem_info;
 
-  /*查找第一个满足条件的空闲块*/
-  for (iter = s_mem_info.free_list; iter != NULL; iter = iter->next) {
-    if (iter->size > size) {
-      break;
-    }
+static inline int mem_fls(uint32_t word) {
+#if defined(__GNUC__)
+  return word ? 31 - __builtin_clz(word) : -1;
+#else
+  int bit = 31;
+  if (word == 0) {
+    return -1;
   }
 
-  if (iter == NULL) {
-    log_debug("%s: Out of memory(%d):\n", __FUNCTION__, (int)size);
+  while (!(word & (1u << bit))) {
+    bit--;
   }
 
-  return_value_if_fail(iter != NULL, NULL);
+  return bit;
+#endif /*__GNUC__*/
+}
 
-  /*如果找到的空闲块刚好满足需求，就从空闲块链表中移出它*/
-  if (iter->size < (size + MIN_SIZE)) {
-    if (s_mem_info.free_list == iter) {
-      s_mem_info.free_list = iter->next;
-    }
+static inline int mem_ffs(uint32_t word) {
+  return mem_fls(word & (~word + 1));
+}
 
-    if (iter->prev != NULL) {
-      iter->prev->next = iter->next;
-    }
-    if (iter->next != NULL) {
-      iter->next->prev = iter->prev;
-    }
+static inline uint32_t mem_block_size(const mem_block_t* block) {
+  return block->size & ~MEM_BLOCK_FLAGS;
+}
+
+static inline bool_t mem_block_is_free(const mem_block_t* block) {
+  return (block->size & MEM_BLOCK_FREE) != 0;
+}
+
+static inline mem_block_t* mem_block_next(const mem_block_t* block) {
+  return (mem_block_t*)((char*)block + mem_block_size(block));
+}
+
+static inline mem_block_t* mem_block_prev(const mem_block_t* block) {
+  return block->prev_size ? (mem_block_t*)((char*)block - block->prev_size) : NULL;
+}
+
+static inline void* mem_block_to_ptr(const mem_block_t* block) {
+  return (char*)block + MEM_BLOCK_HEADER_SIZE;
+}
+
+static inline mem_block_t* mem_block_from_ptr(const void* ptr) {
+  return (mem_block_t*)((char*)ptr - MEM_BLOCK_HEADER_SIZE);
+}
+
+static void mem_mapping(uint32_t size, int* fl, int* sl) {
+  if (size < MEM_SMALL_BLOCK) {
+    *fl = 0;
+    *sl = size >> 3;
   } else {
-    /*如果找到的空闲块比较大，就把它拆成两个块，把多余的空闲内存放回去*/
-    free_node_t* new_iter = (free_node_t*)((char*)iter + size);
+    int f = mem_fls(size);
+    *sl = (size >> (f - MEM_SL_LOG2)) ^ MEM_SL_NR;
+    *fl = f - MEM_FL_SHIFT + 1;
+  }
+}
+
+static void mem_block_insert(mem_block_t* block) {
+  int fl = 0;
+  int sl = 0;
+  mem_block_t* head = NULL;
 
-    new_iter->size = iter->size - size;
-    new_iter->next = iter->next;
-    new_iter->prev = iter->prev;
+  mem_mapping(mem_block_size(block), &fl, &sl);
+  head = s_mem_info.blocks[fl][sl];
+
+  block->size |= MEM_BLOCK_FREE;
+  block->prev_free = NULL;
+  block->next_free = head;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
 
-    if (iter->prev != NULL) {
-      iter->prev->next = new_iter;
+  s_mem_info.blocks[fl][sl] = block;
+  s_mem_info.fl_bitmap |= (1u << fl);
+  s_mem_info.sl_bitmap[fl] |= (1u << sl);
+  s_mem_info.free_bytes += mem_block_size(block);
+  s_mem_info.free_block_nr++;
+}
+
+static void mem_block_remove(mem_block_t* block) {
+  int fl = 0;
+  int sl = 0;
+
+  mem_mapping(mem_block_size(block), &fl, &sl);
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    s_mem_info.blocks[fl][sl] = block->next_free;
+    if (block->next_free == NULL) {
+      s_mem_info.sl_bitmap[fl] &= ~(1u << sl);
+      if (s_mem_info.sl_bitmap[fl] == 0) {
+        s_mem_info.fl_bitmap &= ~(1u << fl);
+      }
     }
-    if (iter->next != NULL) {
-      iter->next->prev = new_iter;
+  }
+
+  block->size &= ~MEM_BLOCK_FREE;
+  s_mem_info.free_bytes -= mem_block_size(block);
+  s_mem_info.free_block_nr--;
+}
+
+static mem_block_t* mem_block_find(uint32_t size) {
+  int fl = 0;
+  int sl = 0;
+  uint32_t sl_map = 0;
+
+  /*向上取整到下一个链表，保证链表中的任何一个块都足够大*/
+  if (size >= MEM_SMALL_BLOCK) {
+    uint32_t round = (1u << (mem_fls(size) - MEM_SL_LOG2)) - 1;
+    if (size > 0xffffffffu - round) {
+      return NULL;
     }
+    size += round;
+  }
 
-    if (s_mem_info.free_list == iter) {
-      s_mem_info.free_list = new_iter;
+  mem_mapping(size, &fl, &sl);
+  sl_map = s_mem_info.sl_bitmap[fl] & (~0u << sl);
+  if (sl_map == 0) {
+    uint32_t fl_map = fl + 1 < 32 ? s_mem_info.fl_bitmap & (~0u << (fl + 1)) : 0;
+    if (fl_map == 0) {
+      return NULL;
     }
-    iter->size = size;
+
+    fl = mem_ffs(fl_map);
+    sl_map = s_mem_info.sl_bitmap[fl];
   }
-  /*返回可用的内存*/
-  s_mem_info.used_block_nr++;
-  s_mem_info.used_bytes += size;
+  sl = mem_ffs(sl_map);
 
-  return (char*)iter + sizeof(uint32_t);
+  return s_mem_info.blocks[fl][sl];
 }
 
-static void node_merge2(free_node_t* prev, free_node_t* next) {
-  return_if_fail(prev != NULL && next != NULL && prev->next == next);
+static void mem_block_set_size(mem_block_t* block, uint32_t size) {
+  block->size = size | (block->size & MEM_BLOCK_FLAGS);
+  mem_block_next(block)->prev_size = size;
+}
+
+static mem_block_t* mem_block_merge(mem_block_t* block) {
+  mem_block_t* prev = mem_block_prev(block);
+  mem_block_t* next = mem_block_next(block);
 
-  prev->next = next->next;
-  if (next->next != NULL) {
-    next->next->prev = prev;
+  if (mem_block_is_free(next)) {
+    mem_block_remove(next);
+    mem_block_set_size(block, mem_block_size(block) + mem_block_size(next));
   }
-  prev->size += next->size;
 
-  if (s_mem_info.free_list == next) {
-    s_mem_info.free_list = prev;
+  if (prev != NULL && mem_block_is_free(prev)) {
+    mem_block_remove(prev);
+    mem_block_set_size(prev, mem_block_size(prev) + mem_block_size(block));
+    block = prev;
   }
 
-  return;
+  return block;
 }
 
-static void node_merge(free_node_t* iter) {
-  free_node_t* prev = iter->prev;
-  free_node_t* next = iter->next;
+/*
+ * 导出了malloc时，printf的缓冲区也从这里分配，内存不足时打印日志会再次进入内存不足的分支，
+ * 所以正在打印时不再打印，避免无穷递归。
+ */
+static bool_t s_mem_oom_logging = FALSE;
 
-  if (prev != NULL && ((char*)prev + prev->size) == (char*)iter) {
-    node_merge2(prev, iter);
-    node_merge(prev);
-  } else if (next != NULL && ((char*)iter + iter->size) == (char*)next) {
-    node_merge2(iter, next);
-    node_merge(iter);
+static void mem_log_out_of_memory(const char* func, uint32_t size) {
+  if (!s_mem_oom_logging) {
+    s_mem_oom_logging = TRUE;
+    log_debug("%s: Out of memory(%d):\n", func, (int)size);
+    s_mem_oom_logging = FALSE;
   }
-
-  return;
 }
 
-static void tk_free_impl(void* ptr) {
+static void* mem_large_alloc(uint32_t s) {
+  uint32_t rest = 0;
   uint32_t size = 0;
-  free_node_t* iter = NULL;
-  free_node_t* free_iter = NULL;
+  mem_block_t* block = NULL;
 
-  return_if_fail(ptr != NULL);
+  if (s > 0xffffff00u) {
+    return NULL;
+  }
 
-  free_iter = (free_node_t*)((char*)ptr - sizeof(uint32_t));
+  size = R8B(s + MEM_BLOCK_HEADER_SIZE);
+  size = tk_max(size, MEM_MIN_BLOCK_SIZE);
+  block = mem_block_find(size);
+  if (block == NULL) {
+    mem_log_out_of_memory(__FUNCTION__, size);
+    return NULL;
+  }
 
-  size = free_iter->size;
-  free_iter->prev = NULL;
-  free_iter->next = NULL;
+  mem_block_remove(block);
 
-  if (s_mem_info.free_list == NULL) {
-    s_mem_info.free_list = free_iter;
+  /*如果找到的空闲块比较大，就把它拆成两个块，把多余的空闲内存放回去*/
+  rest = mem_block_size(block) - size;
+  if (rest >= MEM_MIN_BLOCK_SIZE) {
+    mem_block_t* next = NULL;
 
-    return;
+    mem_block_set_size(block, size);
+    next = mem_block_next(block);
+    next->size = 0;
+    next->prev_size = size;
+    mem_block_set_size(next, rest);
+    mem_block_insert(next);
   }
-  /*根据内存块地址的大小，把它插入到适当的位置。*/
-  for (iter = s_mem_info.free_list; iter != NULL; iter = iter->next) {
-    if ((char*)iter > (char*)free_iter) {
-      free_iter->next = iter;
-      free_iter->prev = iter->prev;
-      if (iter->prev != NULL) {
-        iter->prev->next = free_iter;
-      }
-      iter->prev = free_iter;
 
-      if (s_mem_info.free_list == iter) {
-        s_mem_info.free_list = free_iter;
-      }
+  return mem_block_to_ptr(block);
+}
 
-      break;
-    }
+static void mem_large_free(void* ptr) {
+  mem_block_t* block = mem_block_from_ptr(ptr);
 
-    if (iter->next == NULL) {
-      iter->next = free_iter;
-      free_iter->prev = iter;
+  return_if_fail(!mem_block_is_free(block));
 
-      break;
+  block = mem_block_merge(block);
+  mem_block_insert(block);
+}
+
+static uint32_t mem_large_usable_size(void* ptr) {
+  return mem_block_size(mem_block_from_ptr(ptr)) - MEM_BLOCK_HEADER_SIZE;
+}
+
+static inline uint32_t* slab_slot_header(void* ptr) {
+  return (uint32_t*)((char*)ptr - sizeof(uint32_t));
+}
+
+static inline slab_page_t* slab_page_of(void* ptr) {
+  uint32_t offset = *slab_slot_header(ptr) & ~MEM_BLOCK_FLAGS;
+
+  return (slab_page_t*)((char*)ptr - offset);
+}
+
+static inline int slab_class_index(uint32_t size) {
+  return s_mem_info.class_of[R8B(size + sizeof(uint32_t)) >> 3];
+}
+
+static void slab_page_unlink(slab_class_t* c, slab_page_t* page) {
+  if (page->next != NULL) {
+    page->next->prev = page->prev;
+  }
+  if (page->prev != NULL) {
+    page->prev->next = page->next;
+  } else {
+    c->pages = page->next;
+  }
+  page->next = NULL;
+  page->prev = NULL;
+}
+
+static void slab_page_link(slab_class_t* c, slab_page_t* page) {
+  page->prev = NULL;
+  page->next = c->pages;
+  if (c->pages != NULL) {
+    c->pages->prev = page;
+  }
+  c->pages = page;
+}
+
+static slab_page_t* slab_page_create(int index) {
+  slab_page_t* page = NULL;
+  slab_class_t* c = s_mem_info.classes + index;
+  uint32_t size = SLAB_PAGE_HEADER_SIZE + sizeof(uint32_t) + c->slot_size * c->slots_per_page;
+
+  /*内存不足时mem_large_alloc已经打印过日志*/
+  page = (slab_page_t*)mem_large_alloc(size);
+  if (page == NULL) {
+    return NULL;
+  }
+
+  memset(page, 0x00, sizeof(slab_page_t));
+  page->class_index = index;
+  page->nr = c->slots_per_page;
+
+  c->page_nr++;
+  s_mem_info.slab_bytes += mem_large_usable_size(page);
+  slab_page_link(c, page);
+
+  return page;
+}
+
+static void slab_page_destroy(slab_page_t* page) {
+  slab_class_t* c = s_mem_info.classes + page->class_index;
+
+  slab_page_unlink(c, page);
+  c->page_nr--;
+  s_mem_info.slab_bytes -= mem_large_usable_size(page);
+  mem_large_free(page);
+}
+
+static void* mem_small_alloc(uint32_t s) {
+  void* ptr = NULL;
+  int index = slab_class_index(s);
+  slab_class_t* c = s_mem_info.classes + index;
+  slab_page_t* page = c->pages;
+
+  if (page == NULL) {
+    page = slab_page_create(index);
+    if (page == NULL) {
+      return NULL;
     }
   }
 
-  /*对相邻居的内存进行合并*/
-  node_merge(free_iter);
+  if (page->free_list != NULL) {
+    ptr = page->free_list;
+    page->free_list = *(void**)ptr;
+  } else {
+    /*slot的头部占4个字节，用户数据按8字节对齐*/
+    char* slot = (char*)page + SLAB_PAGE_HEADER_SIZE + sizeof(uint32_t);
+    ptr = slot + page->inited * c->slot_size + sizeof(uint32_t);
+    *slab_slot_header(ptr) = ((char*)ptr - (char*)page) | MEM_BLOCK_SMALL;
+    page->inited++;
+  }
+
+  page->used++;
+  c->used++;
+  if (page->used == page->nr) {
+    slab_page_unlink(c, page);
+  }
+
+  s_mem_info.used_bytes += c->slot_size;
+  s_mem_info.used_block_nr++;
+
+  return ptr;
+}
+
+static void mem_small_free(void* ptr) {
+  slab_page_t* page = slab_page_of(ptr);
+  slab_class_t* c = s_mem_info.classes + page->class_index;
+
+  if (page->used == page->nr) {
+    slab_page_link(c, page);
+  }
+
+  *(void**)ptr = page->free_list;
+  page->free_list = ptr;
+  page->used--;
+  c->used--;
+
+  s_mem_info.used_bytes -= c->slot_size;
   s_mem_info.used_block_nr--;
-  s_mem_info.used_bytes -= size;
+
+  if (page->used == 0) {
+    slab_page_destroy(page);
+  }
+}
+
+static uint32_t mem_usable_size(void* ptr) {
+  if (*slab_slot_header(ptr) & MEM_BLOCK_SMALL) {
+    slab_page_t* page = slab_page_of(ptr);
+    return s_mem_info.classes[page->class_index].slot_size - sizeof(uint32_t);
+  } else {
+    return mem_large_usable_size(ptr);
+  }
+}
+
+static void* tk_alloc_impl(uint32_t size) {
+  void* ptr = NULL;
+  return_value_if_fail(s_mem_info.buffer != NULL, NULL);
+
+  if (size <= MEM_SMALL_MAX) {
+    return mem_small_alloc(size);
+  }
+
+  ptr = mem_large_alloc(size);
+  if (ptr != NULL) {
+    s_mem_info.used_bytes += mem_block_size(mem_block_from_ptr(ptr));
+    s_mem_info.used_block_nr++;
+  }
+
+  return ptr;
+}
+
+static void tk_free_impl(void* ptr) {
+  return_if_fail(ptr != NULL);
+
+  if (*slab_slot_header(ptr) & MEM_BLOCK_SMALL) {
+    mem_small_free(ptr);
+  } else {
+    s_mem_info.used_bytes -= mem_block_size(mem_block_from_ptr(ptr));
+    s_mem_info.used_block_nr--;
+    mem_large_free(ptr);
+  }
 
   return;
 }
@@ -226,9 +543,14 @@ static void* tk_realloc_impl(void* ptr, uint32_t size) {
   void* new_ptr = NULL;
 
   if (ptr != NULL) {
-    uint32_t old_size = *(uint32_t*)((char*)ptr - sizeof(uint32_t)) - sizeof(uint32_t);
-    if (old_size >= size && old_size <= (size + MIN_SIZE)) {
-      return ptr;
+    uint32_t old_size = mem_usable_size(ptr);
+    if (old_size >= size) {
+      bool_t small = (*slab_slot_header(ptr) & MEM_BLOCK_SMALL) != 0;
+      /*同一类的小内存块，或者大内存块缩小得不多时，直接使用原来的内存块*/
+      if (small ? (size > MEM_SMALL_MAX || slab_class_index(size) == slab_class_index(old_size))
+                : (size > MEM_SMALL_MAX && old_size - size < MEM_SMALL_MAX)) {
+        return ptr;
+      }
     }
 
     new_ptr = tk_alloc_impl(size);
@@ -244,29 +566,82 @@ static void* tk_realloc_impl(void* ptr, uint32_t size) {
 }
 
 ret_t tk_mem_init(void* buffer, uint32_t size) {
-  return_value_if_fail(buffer != NULL && size > MIN_SIZE, RET_BAD_PARAMS);
+  uint32_t i = 0;
+  uint32_t k = 0;
+  char* start = NULL;
+  mem_block_t* block = NULL;
+  mem_block_t* sentinel = NULL;
+  uint32_t offset = (8 - ((uintptr_t)buffer & 7)) & 7;
+
+  return_value_if_fail(buffer != NULL && size > offset + MEM_MIN_BLOCK_SIZE * 2, RET_BAD_PARAMS);
+
+  memset(&s_mem_info, 0x00, sizeof(s_mem_info));
+  start = (char*)buffer + offset;
+  size = ((size - offset) >> 3) << 3;
+
+  for (i = 0; i < MEM_CLASS_NR; i++) {
+    slab_class_t* c = s_mem_info.classes + i;
+    uint32_t n = (TK_MEM_SLAB_PAGE_SIZE - SLAB_PAGE_HEADER_SIZE) / s_slot_sizes[i];
+
+    c->slot_size = s_slot_sizes[i];
+    c->slots_per_page = tk_max(n, MEM_SLAB_MIN_SLOTS);
+    for (; k <= (s_slot_sizes[i] >> 3); k++) {
+      s_mem_info.class_of[k] = i;
+    }
+  }
+
+  /*最后放一个使用中的哨兵块，合并时不会越界*/
+  block = (mem_block_t*)start;
+  block->prev_size = 0;
+  block->size = size - MEM_BLOCK_HEADER_SIZE;
+  sentinel = mem_block_next(block);
+  sentinel->prev_size = mem_block_size(block);
+  sentinel->size = 0;
 
-  memset(buffer, 0x00, size);
   s_mem_info.buffer = (char*)buffer;
   s_mem_info.size = size;
-  s_mem_info.free_list = (free_node_t*)buffer;
-  s_mem_info.free_list->prev = NULL;
-  s_mem_info.free_list->next = NULL;
-  s_mem_info.free_list->size = size;
-  s_mem_info.used_block_nr = 0;
+  mem_block_insert(block);
 
   return RET_OK;
 }
 
 mem_stat_t tk_mem_stat() {
   mem_stat_t st;
+  int fl = mem_fls(s_mem_info.fl_bitmap);
 
-  st.used_bytes = s_mem_info.size;
+  memset(&st, 0x00, sizeof(st));
+  st.used_bytes = s_mem_info.used_bytes;
   st.used_block_nr = s_mem_info.used_block_nr;
+  st.total_bytes = s_mem_info.size;
+  st.free_bytes = s_mem_info.free_bytes;
+  st.free_block_nr = s_mem_info.free_block_nr;
+  st.slab_bytes = s_mem_info.slab_bytes;
+
+  if (fl >= 0) {
+    int sl = mem_fls(s_mem_info.sl_bitmap[fl]);
+    mem_block_t* iter = s_mem_info.blocks[fl][sl];
+
+    /*最大的空闲块一定在最后一个非空的链表中*/
+    for (; iter != NULL; iter = iter->next_free) {
+      st.max_free_block = tk_max(st.max_free_block, mem_block_size(iter));
+    }
+  }
 
   return st;
 }
 
+static void tk_mem_dump_classes(void) {
+  uint32_t i = 0;
+
+  for (i = 0; i < MEM_CLASS_NR; i++) {
+    const slab_class_t* c = s_mem_info.classes + i;
+    if (c->page_nr > 0) {
+      log_debug("  class %3d: %d pages %d/%d slots\n", (int)c->slot_size, (int)c->page_nr,
+                (int)c->used, (int)(c->page_nr * c->slots_per_page));
+    }
+  }
+}
+
 /*export std malloc*/
 void* calloc(size_t count, size_t size) {
   return tk_calloc_impl(count, size);
@@ -296,6 +671,363 @@ static void* tk_calloc_impl(uint32_t nmemb, uint32_t s) {
   return ptr;
 }
 
+/*
+ * 内存分配的性能分析：按分配的位置(函数名和行号)统计。
+ * 用hash表记录每个使用中的内存块属于哪个位置，所以可以随时启动和停止，
+ * 启动之前分配的内存块在释放时被忽略。
+ */
+typedef struct _mem_block_record_t {
+  void* ptr;
+  uint32_t size;
+  uint32_t site;
+} mem_block_record_t;
+
+typedef struct _mem_profile_t {
+  bool_t started;
+
+  mem_site_stat_t* sites;
+  uint32_t sites_nr;
+  uint32_t sites_capacity;
+  /*保存site的序数加1，0表示空*/
+  uint32_t* site_buckets;
+  uint32_t site_buckets_nr;
+
+  mem_block_record_t* blocks;
+  uint32_t blocks_nr;
+  uint32_t blocks_capacity;
+
+  uint32_t frame_alloc_nr;
+  uint32_t last_frame_alloc_nr;
+} mem_profile_t;
+
+static mem_profile_t s_mem_profile;
+
+static uint32_t mem_profile_hash_ptr(const void* ptr) {
+  return (uint32_t)((uintptr_t)ptr >> 3) * 2654435761u;
+}
+
+static uint32_t mem_profile_hash_site(const char* func, uint32_t line) {
+  return (mem_profile_hash_ptr(func) ^ line) * 2654435761u;
+}
+
+static ret_t mem_profile_rehash_sites(uint32_t buckets_nr) {
+  uint32_t i = 0;
+  uint32_t* buckets = (uint32_t*)tk_calloc_impl(buckets_nr, sizeof(uint32_t));
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  for (i = 0; i < s_mem_profile.sites_nr; i++) {
+    const mem_site_stat_t* site = s_mem_profile.sites + i;
+    uint32_t k = mem_profile_hash_site(site->func, site->line) & (buckets_nr - 1);
+
+    while (buckets[k] != 0) {
+      k = (k + 1) & (buckets_nr - 1);
+    }
+    buckets[k] = i + 1;
+  }
+
+  if (s_mem_profile.site_buckets != NULL) {
+    tk_free_impl(s_mem_profile.site_buckets);
+  }
+  s_mem_profile.site_buckets = buckets;
+  s_mem_profile.site_buckets_nr = buckets_nr;
+
+  return RET_OK;
+}
+
+static mem_site_stat_t* mem_profile_get_site(const char* func, uint32_t line) {
+  uint32_t k = 0;
+  uint32_t mask = s_mem_profile.site_buckets_nr - 1;
+  mem_site_stat_t* site = NULL;
+
+  for (k = mem_profile_hash_site(func, line) & mask; s_mem_profile.site_buckets[k] != 0;
+       k = (k + 1) & mask) {
+    site = s_mem_profile.sites + s_mem_profile.site_buckets[k] - 1;
+    if (site->func == func && site->line == line) {
+      return site;
+    }
+  }
+
+  if (s_mem_profile.sites_nr >= s_mem_profile.sites_capacity) {
+    uint32_t capacity = s_mem_profile.sites_capacity * 2;
+    void* sites = tk_realloc_impl(s_mem_profile.sites, capacity * sizeof(mem_site_stat_t));
+    return_value_if_fail(sites != NULL, NULL);
+
+    s_mem_profile.sites = (mem_site_stat_t*)sites;
+    s_mem_profile.sites_capacity = capacity;
+  }
+
+  site = s_mem_profile.sites + s_mem_profile.sites_nr;
+  memset(site, 0x00, sizeof(*site));
+  site->func = func;
+  site->line = line;
+  s_mem_profile.site_buckets[k] = ++s_mem_profile.sites_nr;
+
+  if (s_mem_profile.sites_nr * 2 > s_mem_profile.site_buckets_nr) {
+    mem_profile_rehash_sites(s_mem_profile.site_buckets_nr * 2);
+  }
+
+  return site;
+}
+
+static mem_block_record_t* mem_profile_find_block(const void* ptr) {
+  uint32_t k = 0;
+  uint32_t mask = s_mem_profile.blocks_capacity - 1;
+
+  for (k = mem_profile_hash_ptr(ptr) & mask; s_mem_profile.blocks[k].ptr != NULL;
+       k = (k + 1) & mask) {
+    if (s_mem_profile.blocks[k].ptr == ptr) {
+      return s_mem_profile.blocks + k;
+    }
+  }
+
+  return s_mem_profile.blocks + k;
+}
+
+static ret_t mem_profile_grow_blocks(void) {
+  uint32_t i = 0;
+  mem_block_record_t* old = s_mem_profile.blocks;
+  uint32_t old_capacity = s_mem_profile.blocks_capacity;
+  uint32_t capacity = old_capacity * 2;
+  mem_block_record_t* blocks =
+      (mem_block_record_t*)tk_calloc_impl(capacity, sizeof(mem_block_record_t));
+  return_value_if_fail(blocks != NULL, RET_OOM);
+
+  s_mem_profile.blocks = blocks;
+  s_mem_profile.blocks_capacity = capacity;
+  for (i = 0; i < old_capacity; i++) {
+    if (old[i].ptr != NULL) {
+      *mem_profile_find_block(old[i].ptr) = old[i];
+    }
+  }
+  tk_free_impl(old);
+
+  return RET_OK;
+}
+
+/*线性探测的hash表，删除时把后面的记录往前移，不需要墓碑标记*/
+static void mem_profile_remove_block(mem_block_record_t* r) {
+  uint32_t mask = s_mem_profile.blocks_capacity - 1;
+  uint32_t i = r - s_mem_profile.blocks;
+  uint32_t k = i;
+
+  for (;;) {
+    uint32_t home = 0;
+    k = (k + 1) & mask;
+    if (s_mem_profile.blocks[k].ptr == NULL) {
+      break;
+    }
+
+    home = mem_profile_hash_ptr(s_mem_profile.blocks[k].ptr) & mask;
+    if (((k - home) & mask) >= ((k - i) & mask)) {
+      s_mem_profile.blocks[i] = s_mem_profile.blocks[k];
+      i = k;
+    }
+  }
+
+  s_mem_profile.blocks[i].ptr = NULL;
+  s_mem_profile.blocks_nr--;
+}
+
+static void mem_profile_on_free(void* ptr) {
+  mem_block_record_t* r = mem_profile_find_block(ptr);
+
+  if (r->ptr != NULL) {
+    mem_site_stat_t* site = s_mem_profile.sites + r->site;
+
+    site->live_bytes -= r->size;
+    site->live_nr--;
+    mem_profile_remove_block(r);
+  }
+}
+
+static void mem_profile_on_alloc(void* ptr, uint32_t size, const char* func, uint32_t line) {
+  mem_block_record_t* r = NULL;
+  mem_site_stat_t* site = NULL;
+
+  if ((s_mem_profile.blocks_nr + 1) * 2 > s_mem_profile.blocks_capacity) {
+    if (mem_profile_grow_blocks() != RET_OK) {
+      return;
+    }
+  }
+
+  site = mem_profile_get_site(func, line);
+  if (site == NULL) {
+    return;
+  }
+
+  site->calls++;
+  site->frame_calls++;
+  site->live_nr++;
+  site->live_bytes += size;
+  if (site->live_bytes > site->peak_bytes) {
+    site->peak_bytes = site->live_bytes;
+  }
+  s_mem_profile.frame_alloc_nr++;
+
+  r = mem_profile_find_block(ptr);
+  if (r->ptr == NULL) {
+    s_mem_profile.blocks_nr++;
+  }
+  r->ptr = ptr;
+  r->size = size;
+  r->site = site - s_mem_profile.sites;
+}
+
+ret_t tk_mem_profile_start(void) {
+  if (s_mem_profile.started) {
+    return RET_OK;
+  }
+
+  memset(&s_mem_profile, 0x00, sizeof(s_mem_profile));
+  s_mem_profile.sites_capacity = 32;
+  s_mem_profile.sites =
+      (mem_site_stat_t*)tk_alloc_impl(s_mem_profile.sites_capacity * sizeof(mem_site_stat_t));
+  s_mem_profile.blocks_capacity = 256;
+  s_mem_profile.blocks = (mem_block_record_t*)tk_calloc_impl(s_mem_profile.blocks_capacity,
+                                                             sizeof(mem_block_record_t));
+
+  if (s_mem_profile.sites == NULL || s_mem_profile.blocks == NULL ||
+      mem_profile_rehash_sites(64) != RET_OK) {
+    s_mem_profile.started = TRUE;
+    tk_mem_profile_stop();
+
+    return RET_OOM;
+  }
+
+  s_mem_profile.started = TRUE;
+
+  return RET_OK;
+}
+
+ret_t tk_mem_profile_stop(void) {
+  return_value_if_fail(s_mem_profile.started, RET_BAD_PARAMS);
+
+  if (s_mem_profile.sites != NULL) {
+    tk_free_impl(s_mem_profile.sites);
+  }
+  if (s_mem_profile.site_buckets != NULL) {
+    tk_free_impl(s_mem_profile.site_buckets);
+  }
+  if (s_mem_profile.blocks != NULL) {
+    tk_free_impl(s_mem_profile.blocks);
+  }
+  memset(&s_mem_profile, 0x00, sizeof(s_mem_profile));
+
+  return RET_OK;
+}
+
+ret_t tk_mem_profile_begin_frame(void) {
+  uint32_t i = 0;
+
+  if (!s_mem_profile.started) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < s_mem_profile.sites_nr; i++) {
+    mem_site_stat_t* site = s_mem_profile.sites + i;
+    site->last_frame_calls = site->frame_calls;
+    site->frame_calls = 0;
+  }
+
+  s_mem_profile.last_frame_alloc_nr = s_mem_profile.frame_alloc_nr;
+  s_mem_profile.frame_alloc_nr = 0;
+
+  return RET_OK;
+}
+
+uint32_t tk_mem_profile_get_frame_alloc_nr(void) {
+  return s_mem_profile.last_frame_alloc_nr;
+}
+
+static int mem_site_stat_cmp(const void* a, const void* b) {
+  const mem_site_stat_t* sa = (const mem_site_stat_t*)a;
+  const mem_site_stat_t* sb = (const mem_site_stat_t*)b;
+
+  if (sa->live_bytes != sb->live_bytes) {
+    return sa->live_bytes < sb->live_bytes ? 1 : -1;
+  }
+
+  return (int)sb->calls - (int)sa->calls;
+}
+
+uint32_t tk_mem_profile_get_sites(mem_site_stat_t* sites, uint32_t nr) {
+  mem_site_stat_t* all = NULL;
+  uint32_t size = s_mem_profile.sites_nr * sizeof(mem_site_stat_t);
+  return_value_if_fail(sites != NULL && s_mem_profile.started, 0);
+
+  if (s_mem_profile.sites_nr == 0) {
+    return 0;
+  }
+
+  all = (mem_site_stat_t*)tk_alloc_impl(size);
+  return_value_if_fail(all != NULL, 0);
+
+  memcpy(all, s_mem_profile.sites, size);
+  qsort(all, s_mem_profile.sites_nr, sizeof(mem_site_stat_t), mem_site_stat_cmp);
+  nr = tk_min(nr, s_mem_profile.sites_nr);
+  memcpy(sites, all, nr * sizeof(mem_site_stat_t));
+  tk_free_impl(all);
+
+  return nr;
+}
+
+static void mem_site_stat_log(const mem_site_stat_t* site, int32_t delta) {
+  log_debug("%s:%d: live %d bytes %d blocks (%+d) peak %d calls %d frame %d\n", site->func,
+            (int)site->line, (int)site->live_bytes, (int)site->live_nr, (int)delta,
+            (int)site->peak_bytes, (int)site->calls, (int)site->last_frame_calls);
+}
+
+ret_t tk_mem_profile_dump(uint32_t nr) {
+  uint32_t i = 0;
+  mem_site_stat_t* sites = NULL;
+  return_value_if_fail(s_mem_profile.started, RET_BAD_PARAMS);
+
+  nr = tk_min(nr, s_mem_profile.sites_nr);
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  sites = (mem_site_stat_t*)tk_alloc_impl(nr * sizeof(mem_site_stat_t));
+  return_value_if_fail(sites != NULL, RET_OOM);
+
+  nr = tk_mem_profile_get_sites(sites, nr);
+  log_debug("memory profile: %d sites %d blocks, %d allocations in last frame\n",
+            (int)s_mem_profile.sites_nr, (int)s_mem_profile.blocks_nr,
+            (int)s_mem_profile.last_frame_alloc_nr);
+  for (i = 0; i < nr; i++) {
+    mem_site_stat_log(sites + i, 0);
+  }
+  tk_free_impl(sites);
+
+  return RET_OK;
+}
+
+uint32_t tk_mem_profile_dump_diff(const mem_site_stat_t* sites, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t changed = 0;
+  return_value_if_fail(s_mem_profile.started && (sites != NULL || nr == 0), 0);
+
+  for (i = 0; i < s_mem_profile.sites_nr; i++) {
+    const mem_site_stat_t* site = s_mem_profile.sites + i;
+    uint32_t old_bytes = 0;
+
+    for (k = 0; k < nr; k++) {
+      if (sites[k].func == site->func && sites[k].line == site->line) {
+        old_bytes = sites[k].live_bytes;
+        break;
+      }
+    }
+
+    if (site->live_bytes != old_bytes) {
+      changed++;
+      mem_site_stat_log(site, (int32_t)(site->live_bytes - old_bytes));
+    }
+  }
+
+  return changed;
+}
+
 #define TRY_MAX_TIMES 5
 static void* s_on_out_of_memory_ctx;
 static tk_mem_on_out_of_memory_t s_on_out_of_memory;
@@ -319,9 +1051,6 @@ void* tk_calloc(uint32_t nmemb, uint32_t size, const char* func, uint32_t line)
   void* addr = NULL;
   uint32_t tried_times = 0;
 
-  (void)func;
-  (void)line;
-
   do {
     addr = tk_calloc_impl(nmemb, size);
     if (addr != NULL) {
@@ -331,6 +1060,10 @@ void* tk_calloc(uint32_t nmemb, uint32_t size, const char* func, uint32_t line)
     tk_mem_on_out_of_memory(++tried_times, nmemb * size);
   } while (tried_times < TRY_MAX_TIMES);
 
+  if (addr != NULL && s_mem_profile.started) {
+    mem_profile_on_alloc(addr, nmemb * size, func, line);
+  }
+
   return addr;
 }
 
@@ -338,9 +1071,6 @@ void* tk_realloc(void* ptr, uint32_t size, const char* func, uint32_t line) {
   void* addr = NULL;
   uint32_t tried_times = 0;
 
-  (void)func;
-  (void)line;
-
   do {
     addr = tk_realloc_impl(ptr, size);
     if (addr != NULL) {
@@ -350,6 +1080,13 @@ void* tk_realloc(void* ptr, uint32_t size, const char* func, uint32_t line) {
     tk_mem_on_out_of_memory(++tried_times, size);
   } while (tried_times < TRY_MAX_TIMES);
 
+  if (addr != NULL && s_mem_profile.started) {
+    if (ptr != NULL) {
+      mem_profile_on_free(ptr);
+    }
+    mem_profile_on_alloc(addr, size, func, line);
+  }
+
   return addr;
 }
 
@@ -357,9 +1094,6 @@ void* tk_alloc(uint32_t size, const char* func, uint32_t line) {
   void* addr = NULL;
   uint32_t tried_times = 0;
 
-  (void)func;
-  (void)line;
-
   do {
     addr = tk_alloc_impl(size);
     if (addr != NULL) {
@@ -369,11 +1103,18 @@ void* tk_alloc(uint32_t size, const char* func, uint32_t line) {
     tk_mem_on_out_of_memory(++tried_times, size);
   } while (tried_times < TRY_MAX_TIMES);
 
+  if (addr != NULL && s_mem_profile.started) {
+    mem_profile_on_alloc(addr, size, func, line);
+  }
+
   return addr;
 }
 
 void tk_free(void* ptr) {
   if (ptr != NULL) {
+    if (s_mem_profile.started) {
+      mem_profile_on_free(ptr);
+    }
     tk_free_impl(ptr);
   }
 }
@@ -381,4 +1122,11 @@ void tk_free(void* ptr) {
 void tk_mem_dump(void) {
   mem_stat_t s = tk_mem_stat();
   log_debug("used: %d bytes %d blocks\n", s.used_bytes, s.used_block_nr);
+#ifndef HAS_STD_MALLOC
+  log_debug("free: %d bytes %d blocks max %d(fragmentation %d%%) slab: %d bytes\n",
+            s.free_bytes, s.free_block_nr, s.max_free_block,
+            s.free_bytes ? (int)(100 - (uint64_t)s.max_free_block * 100 / s.free_bytes) : 0,
+            s.slab_bytes);
+  tk_mem_dump_classes();
+#endif /*HAS_STD_MALLOC*/
 }
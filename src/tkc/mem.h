@@ -130,10 +130,134 @@ void tk_free(void* ptr);
 typedef struct _mem_stat_t {
   uint32_t used_bytes;
   uint32_t used_block_nr;
+  /*下面的字段只在使用内置的内存管理器(没有定义HAS_STD_MALLOC)时有效*/
+  uint32_t total_bytes;
+  uint32_t free_bytes;
+  uint32_t free_block_nr;
+  /*最大的空闲块，与free_bytes相差越大，碎片越多*/
+  uint32_t max_free_block;
+  /*小内存块的页面占用的内存*/
+  uint32_t slab_bytes;
 } mem_stat_t;
 
 void tk_mem_dump(void);
 mem_stat_t tk_mem_stat(void);
 
+/**
+ * @class mem_site_stat_t
+ * 一个分配位置(TKMEM\_XXX所在的函数和行号)的内存使用情况。
+ */
+typedef struct _mem_site_stat_t {
+  /**
+   * @property {const char*} func
+   * 函数名。
+   */
+  const char* func;
+  /**
+   * @property {uint32_t} line
+   * 行号。
+   */
+  uint32_t line;
+  /**
+   * @property {uint32_t} live_bytes
+   * 没有释放的字节数。
+   */
+  uint32_t live_bytes;
+  /**
+   * @property {uint32_t} live_nr
+   * 没有释放的内存块数。
+   */
+  uint32_t live_nr;
+  /**
+   * @property {uint32_t} peak_bytes
+   * live\_bytes的最大值。
+   */
+  uint32_t peak_bytes;
+  /**
+   * @property {uint32_t} calls
+   * 分配的次数。
+   */
+  uint32_t calls;
+  /**
+   * @property {uint32_t} frame_calls
+   * 当前帧中分配的次数。
+   */
+  uint32_t frame_calls;
+  /**
+   * @property {uint32_t} last_frame_calls
+   * 上一帧中分配的次数。
+   */
+  uint32_t last_frame_calls;
+} mem_site_stat_t;
+
+/**
+ * @method tk_mem_profile_start
+ * 开始按分配位置统计内存的使用情况。
+ *
+ * > 开始之前分配的内存不参与统计。统计用的内存不经过TKMEM\_XXX，不会被统计进来。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_mem_profile_start(void);
+
+/**
+ * @method tk_mem_profile_stop
+ * 停止统计，并释放统计数据。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_mem_profile_stop(void);
+
+/**
+ * @method tk_mem_profile_begin_frame
+ * 开始新的一帧(由窗口管理器在绘制时调用)，用于统计每一帧中的分配次数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_mem_profile_begin_frame(void);
+
+/**
+ * @method tk_mem_profile_get_frame_alloc_nr
+ * 获取上一帧中分配内存的次数。
+ *
+ * @return {uint32_t} 返回上一帧中分配内存的次数。
+ */
+uint32_t tk_mem_profile_get_frame_alloc_nr(void);
+
+/**
+ * @method tk_mem_profile_get_sites
+ * 获取各个分配位置的统计数据(按没有释放的字节数从大到小排序)。
+ *
+ * 返回的数据可以作为快照，稍后传给tk\_mem\_profile\_dump\_diff进行比较。
+ *
+ * @param {mem_site_stat_t*} sites 用于返回统计数据。
+ * @param {uint32_t} nr sites的个数。
+ *
+ * @return {uint32_t} 返回实际获取的个数。
+ */
+uint32_t tk_mem_profile_get_sites(mem_site_stat_t* sites, uint32_t nr);
+
+/**
+ * @method tk_mem_profile_dump
+ * 输出没有释放的内存最多的若干个分配位置。
+ * @param {uint32_t} nr 输出的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_mem_profile_dump(uint32_t nr);
+
+/**
+ * @method tk_mem_profile_dump_diff
+ * 与快照比较，输出没有释放的字节数发生变化的分配位置。
+ *
+ * 比如在打开窗口之前获取快照，关闭窗口之后比较，可以找出内存泄露的位置。
+ *
+ * @param {const mem_site_stat_t*} sites tk\_mem\_profile\_get\_sites返回的快照。
+ * @param {uint32_t} nr 快照中的个数。
+ *
+ * @return {uint32_t} 返回发生变化的分配位置的个数。
+ */
+uint32_t tk_mem_profile_dump_diff(const mem_site_stat_t* sites, uint32_t nr);
+
 END_C_DECLS
 #endif /*TK_TKMEM_MANAGER_H*/
@@ -27,6 +27,11 @@
 BEGIN_C_DECLS
 
 uint32_t get_time_ms(void);
+
+#ifdef HAS_GET_TIME_US64
+/*可选：平台支持微秒级的时钟时定义HAS_GET_TIME_US64并实现本函数*/
+uint64_t get_time_us64(void);
+#endif /*HAS_GET_TIME_US64*/
 void sleep_ms(uint32_t ms);
 
 ret_t platform_prepare(void);
@@ -26,6 +26,14 @@ uint32_t time_now_ms(void) {
   return get_time_ms();
 }
 
+uint64_t time_now_us(void) {
+#ifdef HAS_GET_TIME_US64
+  return get_time_us64();
+#else
+  return (uint64_t)get_time_ms() * 1000;
+#endif /*HAS_GET_TIME_US64*/
+}
+
 uint32_t time_now_s(void) {
   return get_time_ms() / 1000;
 }
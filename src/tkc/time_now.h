@@ -52,6 +52,15 @@ uint32_t time_now_s(void);
  */
 uint32_t time_now_ms(void);
 
+/**
+ * @method time_now_us
+ * 获取当前时间(微秒)。平台定义了HAS\_GET\_TIME\_US64时使用get\_time\_us64，否则为毫秒级精度。
+ * @annotation ["static"]
+ *
+ * @return {uint64_t} 返回当前时间(微秒)。
+ */
+uint64_t time_now_us(void);
+
 END_C_DECLS
 
 #endif /*TK_TIME_NOW_H*/
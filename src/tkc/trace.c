@@ -0,0 +1,206 @@
+﻿/**
+ * File:   trace.c
+ * Author: AWTK Develop Team
+ * Brief:  ring buffered tracing with chrome trace export.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/trace.h"
+#include "tkc/time_now.h"
+
+typedef struct _trace_scope_t {
+  const char* cat;
+  const char* name;
+  uint64_t start;
+} trace_scope_t;
+
+typedef struct _trace_t {
+  bool_t started;
+  uint64_t start_time;
+
+  /*环形缓冲区，first为最早的事件*/
+  trace_event_t* events;
+  uint32_t capacity;
+  uint32_t first;
+  uint32_t nr;
+
+  /*depth可能超过TK_TRACE_MAX_DEPTH，超过的部分不记录*/
+  uint32_t depth;
+  trace_scope_t scopes[TK_TRACE_MAX_DEPTH];
+} trace_t;
+
+static trace_t s_trace;
+
+ret_t tk_trace_start(uint32_t capacity) {
+  trace_event_t* events = NULL;
+
+  if (capacity == 0) {
+    capacity = TK_TRACE_CAPACITY;
+  }
+
+  tk_trace_stop();
+  events = TKMEM_ZALLOCN(trace_event_t, capacity);
+  return_value_if_fail(events != NULL, RET_OOM);
+
+  s_trace.events = events;
+  s_trace.capacity = capacity;
+  s_trace.start_time = time_now_us();
+  s_trace.started = TRUE;
+
+  return RET_OK;
+}
+
+ret_t tk_trace_stop(void) {
+  TKMEM_FREE(s_trace.events);
+  memset(&s_trace, 0x00, sizeof(s_trace));
+
+  return RET_OK;
+}
+
+bool_t tk_trace_is_started(void) {
+  return s_trace.started;
+}
+
+ret_t tk_trace_begin(const char* cat, const char* name) {
+  trace_scope_t* scope = NULL;
+
+  if (!s_trace.started) {
+    return RET_OK;
+  }
+
+  if (s_trace.depth < TK_TRACE_MAX_DEPTH) {
+    scope = s_trace.scopes + s_trace.depth;
+    scope->cat = cat;
+    scope->name = name;
+    scope->start = time_now_us();
+  }
+  s_trace.depth++;
+
+  return RET_OK;
+}
+
+ret_t tk_trace_end(void) {
+  uint64_t now = 0;
+  trace_event_t* e = NULL;
+  trace_scope_t* scope = NULL;
+
+  if (!s_trace.started || s_trace.depth == 0) {
+    return RET_OK;
+  }
+
+  s_trace.depth--;
+  if (s_trace.depth >= TK_TRACE_MAX_DEPTH) {
+    return RET_OK;
+  }
+
+  now = time_now_us();
+  scope = s_trace.scopes + s_trace.depth;
+
+  if (s_trace.nr < s_trace.capacity) {
+    e = s_trace.events + (s_trace.first + s_trace.nr) % s_trace.capacity;
+    s_trace.nr++;
+  } else {
+    e = s_trace.events + s_trace.first;
+    s_trace.first = (s_trace.first + 1) % s_trace.capacity;
+  }
+
+  e->cat = scope->cat;
+  e->name = scope->name;
+  e->ts = scope->start - s_trace.start_time;
+  e->dur = (uint32_t)(now - scope->start);
+  e->depth = s_trace.depth;
+
+  return RET_OK;
+}
+
+ret_t tk_trace_clear(void) {
+  s_trace.first = 0;
+  s_trace.nr = 0;
+
+  return RET_OK;
+}
+
+uint32_t tk_trace_get_events(trace_event_t* events, uint32_t nr) {
+  uint32_t i = 0;
+  return_value_if_fail(events != NULL, 0);
+
+  nr = tk_min(nr, s_trace.nr);
+  for (i = 0; i < nr; i++) {
+    events[i] = s_trace.events[(s_trace.first + i) % s_trace.capacity];
+  }
+
+  return nr;
+}
+
+static ret_t tk_trace_append_json_str(str_t* str, const char* text) {
+  const char* p = text != NULL ? text : "";
+
+  str_append_char(str, '\"');
+  while (*p) {
+    if (*p == '\"' || *p == '\\') {
+      str_append_char(str, '\\');
+    }
+    str_append_char(str, *p);
+    p++;
+  }
+
+  return str_append_char(str, '\"');
+}
+
+ret_t tk_trace_export(str_t* str) {
+  uint32_t i = 0;
+  char buff[128];
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+
+  str_set(str, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (i = 0; i < s_trace.nr; i++) {
+    const trace_event_t* e = s_trace.events + (s_trace.first + i) % s_trace.capacity;
+
+    str_append(str, i > 0 ? ",\n{\"name\":" : "\n{\"name\":");
+    tk_trace_append_json_str(str, e->name);
+    str_append(str, ",\"cat\":");
+    tk_trace_append_json_str(str, e->cat);
+    tk_snprintf(buff, sizeof(buff), ",\"ph\":\"X\",\"ts\":%.0f,\"dur\":%u,\"pid\":1,\"tid\":1}",
+                (double)(e->ts), e->dur);
+    str_append(str, buff);
+  }
+
+  return str_append(str, "\n]}\n");
+}
+
+ret_t tk_trace_save(const char* filename) {
+  str_t str;
+  ret_t ret = RET_OK;
+  fs_file_t* file = NULL;
+  return_value_if_fail(filename != NULL, RET_BAD_PARAMS);
+
+  file = fs_open_file(os_fs(), filename, "wb+");
+  return_value_if_fail(file != NULL, RET_FAIL);
+
+  str_init(&str, 64 * 1024);
+  tk_trace_export(&str);
+  if (fs_file_write(file, str.str, str.size) != (int32_t)(str.size)) {
+    ret = RET_FAIL;
+  }
+  fs_file_close(file);
+  str_reset(&str);
+
+  return ret;
+}
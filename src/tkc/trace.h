@@ -0,0 +1,159 @@
+﻿/**
+ * File:   trace.h
+ * Author: AWTK Develop Team
+ * Brief:  ring buffered tracing with chrome trace export.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_TRACE_H
+#define TK_TRACE_H
+
+#include "tkc/str.h"
+
+BEGIN_C_DECLS
+
+/**
+ * 缺省的事件缓冲区大小(事件个数)，缓冲区满时覆盖最早的事件。
+ */
+#ifndef TK_TRACE_CAPACITY
+#define TK_TRACE_CAPACITY 8192
+#endif /*TK_TRACE_CAPACITY*/
+
+/**
+ * 作用域最多嵌套的层数，超过的部分不记录。
+ */
+#ifndef TK_TRACE_MAX_DEPTH
+#define TK_TRACE_MAX_DEPTH 32
+#endif /*TK_TRACE_MAX_DEPTH*/
+
+/**
+ * @class trace_event_t
+ * 跟踪事件(一个已经结束的作用域)。
+ */
+typedef struct _trace_event_t {
+  /**
+   * @property {const char*} cat
+   * 分类(如phase/widget/lcd)。
+   */
+  const char* cat;
+  /**
+   * @property {const char*} name
+   * 名称。
+   */
+  const char* name;
+  /**
+   * @property {uint64_t} ts
+   * 开始时间(微秒，相对于tk\_trace\_start的时间)。
+   */
+  uint64_t ts;
+  /**
+   * @property {uint32_t} dur
+   * 持续的时间(微秒)。
+   */
+  uint32_t dur;
+  /**
+   * @property {uint32_t} depth
+   * 嵌套的层数(从0开始)。
+   */
+  uint32_t depth;
+} trace_event_t;
+
+/**
+ * @method tk_trace_start
+ * 开始跟踪。跟踪只在GUI线程中进行，没有开始时tk\_trace\_begin/tk\_trace\_end只检查一个标志。
+ * @param {uint32_t} capacity 缓冲区能保存的事件个数，为0时使用TK\_TRACE\_CAPACITY。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_start(uint32_t capacity);
+
+/**
+ * @method tk_trace_stop
+ * 停止跟踪，并释放缓冲区。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_stop(void);
+
+/**
+ * @method tk_trace_is_started
+ * 检查是否已经开始跟踪。
+ *
+ * @return {bool_t} 返回TRUE表示已经开始。
+ */
+bool_t tk_trace_is_started(void);
+
+/**
+ * @method tk_trace_begin
+ * 进入一个作用域，必须与tk\_trace\_end配对使用。
+ *
+ * > cat和name只保存指针，必须一直有效(如字符串常量、控件的类型名)。
+ *
+ * @param {const char*} cat 分类。
+ * @param {const char*} name 名称。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_begin(const char* cat, const char* name);
+
+/**
+ * @method tk_trace_end
+ * 离开当前的作用域，并记录一个事件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_end(void);
+
+/**
+ * @method tk_trace_clear
+ * 清除已经记录的事件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_clear(void);
+
+/**
+ * @method tk_trace_get_events
+ * 获取已经记录的事件(从早到晚)。
+ * @param {trace_event_t*} events 用于返回事件。
+ * @param {uint32_t} nr events的个数。
+ *
+ * @return {uint32_t} 返回实际获取的个数。
+ */
+uint32_t tk_trace_get_events(trace_event_t* events, uint32_t nr);
+
+/**
+ * @method tk_trace_export
+ * 把已经记录的事件导出为Chrome trace格式的JSON(可以用chrome://tracing或Perfetto打开)。
+ * @param {str_t*} str 用于返回JSON。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_export(str_t* str);
+
+/**
+ * @method tk_trace_save
+ * 把已经记录的事件导出为Chrome trace格式的JSON，并保存到文件。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t tk_trace_save(const char* filename);
+
+END_C_DECLS
+
+#endif /*TK_TRACE_H*/
@@ -22,9 +22,12 @@
 #include "tkc/buffer.h"
 #include "base/enums.h"
 #include "tkc/utf8.h"
+#include "tkc/utils.h"
+#include "tkc/color_parser.h"
 #include "tkc/value.h"
 #include "base/ui_builder.h"
 #include "ui_loader/ui_loader_default.h"
+#include "ui_loader/ui_prop_ids.h"
 #include "ui_loader/ui_binary_writer.h"
 
 static ret_t ui_binary_writer_on_widget_start(ui_builder_t* b, const widget_desc_t* desc) {
@@ -51,6 +54,102 @@ static ret_t ui_binary_writer_on_widget_end(ui_builder_t* b) {
   return wbuffer_write_uint8(writer->wbuffer, 0);
 }
 
+static ret_t ui_binary_writer_write_number(wbuffer_t* wbuffer, const char* value) {
+  char* end = NULL;
+  long i = 0;
+  double d = 0;
+
+  if (*value) {
+    i = strtol(value, &end, 10);
+    if (*end == '\0') {
+      wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_INT32);
+      return wbuffer_write_uint32(wbuffer, (uint32_t)(int32_t)i);
+    }
+
+    d = strtod(value, &end);
+    if (*end == '\0') {
+      /*float_t在部分平台上是long double，固定保存为float32*/
+      float f = (float)d;
+      wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_FLOAT);
+      return wbuffer_write_binary(wbuffer, &f, sizeof(f));
+    }
+  }
+
+  wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_STRING);
+  return wbuffer_write_string(wbuffer, value);
+}
+
+static bool_t ui_binary_writer_is_style_color(const char* name) {
+  const char* p = NULL;
+
+  if (!tk_str_start_with(name, "style:")) {
+    return FALSE;
+  }
+
+  p = strstr(name, "_color");
+
+  return p != NULL && p[6] == '\0';
+}
+
+/*
+ * V2属性格式：
+ * [uint8 0]结束 | [uint8 1][uint8 id][值] | [uint8 2][string name][值]
+ * 值：[uint8 ui_prop_type_t][数据]
+ */
+static ret_t ui_binary_writer_on_widget_prop_v2(ui_builder_t* b, const char* name,
+                                                const char* value) {
+  ui_binary_writer_t* writer = (ui_binary_writer_t*)b;
+  wbuffer_t* wbuffer = writer->wbuffer;
+  ui_prop_id_t id = ui_prop_id_from_name(name);
+
+  if (id != UI_PROP_NONE) {
+    wbuffer_write_uint8(wbuffer, 1);
+    wbuffer_write_uint8(wbuffer, (uint8_t)id);
+
+    switch (ui_prop_id_get_type(id)) {
+      case UI_PROP_TYPE_BOOL: {
+        wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_BOOL);
+        return wbuffer_write_uint8(wbuffer, tk_atob(value) ? 1 : 0);
+      }
+      case UI_PROP_TYPE_NUMBER: {
+        return ui_binary_writer_write_number(wbuffer, value);
+      }
+      default: {
+        wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_STRING);
+        return wbuffer_write_string(wbuffer, value);
+      }
+    }
+  }
+
+  wbuffer_write_uint8(wbuffer, 2);
+  wbuffer_write_string(wbuffer, name);
+  if (ui_binary_writer_is_style_color(name)) {
+    color_t c = color_parse(value);
+
+    wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_COLOR);
+    return wbuffer_write_uint32(wbuffer, c.color);
+  }
+
+  wbuffer_write_uint8(wbuffer, UI_PROP_TYPE_STRING);
+  return wbuffer_write_string(wbuffer, value);
+}
+
+ui_builder_t* ui_binary_writer_init_v2(ui_binary_writer_t* writer, wbuffer_t* wbuffer) {
+  return_value_if_fail(writer != NULL && wbuffer != NULL, NULL);
+
+  memset(writer, 0x00, sizeof(ui_binary_writer_t));
+
+  writer->wbuffer = wbuffer;
+  writer->builder.on_widget_start = ui_binary_writer_on_widget_start;
+  writer->builder.on_widget_prop = ui_binary_writer_on_widget_prop_v2;
+  writer->builder.on_widget_prop_end = ui_binary_writer_on_widget_prop_end;
+  writer->builder.on_widget_end = ui_binary_writer_on_widget_end;
+
+  wbuffer_write_uint32(wbuffer, UI_DATA_MAGIC_V2);
+
+  return &(writer->builder);
+}
+
 ui_builder_t* ui_binary_writer_init(ui_binary_writer_t* writer, wbuffer_t* wbuffer) {
   return_value_if_fail(writer != NULL && wbuffer != NULL, NULL);
 
@@ -52,6 +52,22 @@ typedef struct _ui_binary_writer_t {
  */
 ui_builder_t* ui_binary_writer_init(ui_binary_writer_t* writer, wbuffer_t* wbuffer);
 
+/**
+ * @method ui_binary_writer_init_v2
+ * @annotation ["constructor"]
+ *
+ * 初始化ui\_binary\_writer对象，生成V2格式的UI描述数据。
+ *
+ * V2格式中，常用属性的属性名被替换成预定义的ID(参考ui\_prop\_ids.h)，
+ * 布尔值、数值和样式中的颜色在生成时预先解析，加载时不再需要比较属性名和解析字符串。
+ *
+ * @param {ui_binary_writer_t*} writer writer对象。
+ * @param {wbuffer_t*} wbuffer 保存结果的buffer。
+ *
+ * @return {ui_builder_t*} 返回ui\_builder对象。
+ */
+ui_builder_t* ui_binary_writer_init_v2(ui_binary_writer_t* writer, wbuffer_t* wbuffer);
+
 END_C_DECLS
 
 #endif /*TK_UI_BINARY_WRITER_H*/
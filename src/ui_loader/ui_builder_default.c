@@ -24,6 +24,7 @@
 #include "base/enums.h"
 #include "widgets/dialog.h"
 #include "base/widget_factory.h"
+#include "ui_loader/ui_prop_ids.h"
 #include "ui_loader/ui_builder_default.h"
 #include "ui_loader/ui_loader_default.h"
 
@@ -61,6 +62,80 @@ static ret_t ui_builder_default_on_widget_prop(ui_builder_t* b, const char* name
   return RET_OK;
 }
 
+/*
+ * V2格式的属性已经解析成ID和类型化的值。widget的基本属性直接写入对应的字段，
+ * 再交给vt->set_prop(与widget_set_prop的处理一致)。加载过程中控件还没有显示，
+ * 省去属性变化事件和刷新(加载结束时统一刷新)。其它属性仍然调用widget_set_prop。
+ */
+static ret_t ui_builder_default_on_widget_prop_value(ui_builder_t* b, uint32_t id,
+                                                     const char* name, const value_t* v) {
+  widget_t* widget = b->widget;
+
+  switch (id) {
+    case UI_PROP_NAME: {
+      widget_set_name(widget, value_str(v));
+      break;
+    }
+    case UI_PROP_STYLE: {
+      return widget_use_style(widget, value_str(v));
+    }
+    case UI_PROP_TR_TEXT: {
+      widget_set_tr_text(widget, value_str(v));
+      break;
+    }
+    case UI_PROP_VISIBLE: {
+      widget->visible = value_bool(v);
+      break;
+    }
+    case UI_PROP_SENSITIVE: {
+      widget->sensitive = value_bool(v);
+      break;
+    }
+    case UI_PROP_FLOATING: {
+      widget->floating = value_bool(v);
+      break;
+    }
+    case UI_PROP_FOCUSABLE: {
+      widget->focusable = value_bool(v);
+      break;
+    }
+    case UI_PROP_WITH_FOCUS_STATE: {
+      widget->with_focus_state = value_bool(v);
+      break;
+    }
+    case UI_PROP_ENABLE: {
+      widget->enable = value_bool(v);
+      break;
+    }
+    case UI_PROP_OPACITY: {
+      widget->opacity = (uint8_t)value_int(v);
+      break;
+    }
+    case UI_PROP_ANIMATION: {
+      widget_set_animation(widget, value_str(v));
+      break;
+    }
+    case UI_PROP_SELF_LAYOUT: {
+      widget_set_self_layout(widget, value_str(v));
+      break;
+    }
+    case UI_PROP_CHILDREN_LAYOUT: {
+      widget_set_children_layout(widget, value_str(v));
+      break;
+    }
+    default: {
+      widget_set_prop(widget, name, v);
+      return RET_OK;
+    }
+  }
+
+  if (widget->vt->set_prop != NULL) {
+    widget->vt->set_prop(widget, name, v);
+  }
+
+  return RET_OK;
+}
+
 static ret_t ui_builder_default_on_widget_prop_end(ui_builder_t* b) {
   (void)b;
   return RET_OK;
@@ -98,6 +173,7 @@ ui_builder_t* ui_builder_default(const char* name) {
 
   s_ui_builder.on_widget_start = ui_builder_default_on_widget_start;
   s_ui_builder.on_widget_prop = ui_builder_default_on_widget_prop;
+  s_ui_builder.on_widget_prop_value = ui_builder_default_on_widget_prop_value;
   s_ui_builder.on_widget_prop_end = ui_builder_default_on_widget_prop_end;
   s_ui_builder.on_widget_end = ui_builder_default_on_widget_end;
   s_ui_builder.on_end = ui_builder_default_on_end;
@@ -21,8 +21,93 @@
 
 #include "tkc/mem.h"
 #include "tkc/buffer.h"
+#include "ui_loader/ui_prop_ids.h"
 #include "ui_loader/ui_loader_default.h"
 
+static ret_t ui_loader_load_props(rbuffer_t* rbuffer, ui_builder_t* b) {
+  const char* key = NULL;
+  const char* value = NULL;
+
+  return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+  while (*key) {
+    return_value_if_fail(rbuffer_read_string(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+    ui_builder_on_widget_prop(b, key, value);
+    return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+  }
+
+  return RET_OK;
+}
+
+static ret_t ui_loader_load_prop_value(rbuffer_t* rbuffer, value_t* v) {
+  uint8_t type = 0;
+  return_value_if_fail(rbuffer_read_uint8(rbuffer, &type) == RET_OK, RET_BAD_PARAMS);
+
+  switch (type) {
+    case UI_PROP_TYPE_STRING: {
+      const char* str = NULL;
+      return_value_if_fail(rbuffer_read_string(rbuffer, &str) == RET_OK, RET_BAD_PARAMS);
+      value_set_str(v, str);
+      break;
+    }
+    case UI_PROP_TYPE_BOOL: {
+      uint8_t b = 0;
+      return_value_if_fail(rbuffer_read_uint8(rbuffer, &b) == RET_OK, RET_BAD_PARAMS);
+      value_set_bool(v, b != 0);
+      break;
+    }
+    case UI_PROP_TYPE_INT32: {
+      uint32_t i = 0;
+      return_value_if_fail(rbuffer_read_uint32(rbuffer, &i) == RET_OK, RET_BAD_PARAMS);
+      value_set_int32(v, (int32_t)i);
+      break;
+    }
+    case UI_PROP_TYPE_FLOAT: {
+      float f = 0;
+      return_value_if_fail(rbuffer_read_binary(rbuffer, &f, sizeof(f)) == RET_OK, RET_BAD_PARAMS);
+      value_set_float32(v, f);
+      break;
+    }
+    case UI_PROP_TYPE_COLOR: {
+      uint32_t c = 0;
+      return_value_if_fail(rbuffer_read_uint32(rbuffer, &c) == RET_OK, RET_BAD_PARAMS);
+      value_set_uint32(v, c);
+      break;
+    }
+    default: {
+      log_warn("%s: invalid prop type %d\n", __FUNCTION__, (int)type);
+      return RET_BAD_PARAMS;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t ui_loader_load_props_v2(rbuffer_t* rbuffer, ui_builder_t* b) {
+  value_t v;
+  uint8_t kind = 0;
+
+  return_value_if_fail(rbuffer_read_uint8(rbuffer, &kind) == RET_OK, RET_BAD_PARAMS);
+  while (kind != 0) {
+    uint8_t id = UI_PROP_NONE;
+    const char* name = NULL;
+
+    if (kind == 1) {
+      return_value_if_fail(rbuffer_read_uint8(rbuffer, &id) == RET_OK, RET_BAD_PARAMS);
+      name = ui_prop_id_to_name(id);
+      return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+    } else {
+      return_value_if_fail(kind == 2, RET_BAD_PARAMS);
+      return_value_if_fail(rbuffer_read_string(rbuffer, &name) == RET_OK, RET_BAD_PARAMS);
+    }
+
+    return_value_if_fail(ui_loader_load_prop_value(rbuffer, &v) == RET_OK, RET_BAD_PARAMS);
+    ui_builder_on_widget_prop_value(b, id, name, &v);
+    return_value_if_fail(rbuffer_read_uint8(rbuffer, &kind) == RET_OK, RET_BAD_PARAMS);
+  }
+
+  return RET_OK;
+}
+
 ret_t ui_loader_load_default(ui_loader_t* loader, const uint8_t* data, uint32_t size,
                              ui_builder_t* b) {
   rbuffer_t rbuffer;
@@ -33,21 +118,18 @@ ret_t ui_loader_load_default(ui_loader_t* loader, const uint8_t* data, uint32_t
   return_value_if_fail(loader != NULL && data != NULL && b != NULL, RET_BAD_PARAMS);
   return_value_if_fail(rbuffer_init(&rbuffer, data, size) != NULL, RET_BAD_PARAMS);
   return_value_if_fail(rbuffer_read_uint32(&rbuffer, &magic) == RET_OK, RET_BAD_PARAMS);
-  return_value_if_fail(magic == UI_DATA_MAGIC, RET_BAD_PARAMS);
+  return_value_if_fail(magic == UI_DATA_MAGIC || magic == UI_DATA_MAGIC_V2, RET_BAD_PARAMS);
 
   ui_builder_on_start(b);
   while ((rbuffer.cursor + sizeof(desc)) <= rbuffer.capacity) {
-    const char* key = NULL;
-    const char* value = NULL;
     return_value_if_fail(rbuffer_read_binary(&rbuffer, &desc, sizeof(desc)) == RET_OK,
                          RET_BAD_PARAMS);
     ui_builder_on_widget_start(b, &desc);
 
-    return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
-    while (*key) {
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
-      ui_builder_on_widget_prop(b, key, value);
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+    if (magic == UI_DATA_MAGIC_V2) {
+      return_value_if_fail(ui_loader_load_props_v2(&rbuffer, b) == RET_OK, RET_BAD_PARAMS);
+    } else {
+      return_value_if_fail(ui_loader_load_props(&rbuffer, b) == RET_OK, RET_BAD_PARAMS);
     }
     ui_builder_on_widget_prop_end(b);
 
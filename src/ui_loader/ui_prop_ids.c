@@ -0,0 +1,98 @@
+/**
+ * File:   ui_prop_ids.c
+ * Author: AWTK Develop Team
+ * Brief:  pre-resolved property ids for binary ui data.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "base/widget_consts.h"
+#include "ui_loader/ui_prop_ids.h"
+
+typedef struct _ui_prop_info_t {
+  const char* name;
+  ui_prop_type_t type;
+} ui_prop_info_t;
+
+/*按ui_prop_id_t的顺序排列*/
+static const ui_prop_info_t s_ui_props[UI_PROP_NR] = {
+    {NULL, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_NAME, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_STYLE, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_TEXT, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_TR_TEXT, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_VISIBLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_SENSITIVE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_FLOATING, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_FOCUSABLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_WITH_FOCUS_STATE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_ENABLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_OPACITY, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_ANIMATION, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_SELF_LAYOUT, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_CHILDREN_LAYOUT, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_FOCUS, UI_PROP_TYPE_BOOL},
+    /*value的含义因控件而异(如color_picker为颜色字符串)，保持字符串*/
+    {WIDGET_PROP_VALUE, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_MIN, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_MAX, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_STEP, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_ITEM_HEIGHT, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_DEFAULT_ITEM_HEIGHT, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_AUTO_HIDE_SCROLL_BAR, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_IMAGE, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_DRAW_TYPE, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_READONLY, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_INPUT_TYPE, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_TIPS, UI_PROP_TYPE_STRING},
+    {WIDGET_PROP_REPEAT, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_MARGIN, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_SPACING, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_VIRTUAL_W, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_VIRTUAL_H, UI_PROP_TYPE_NUMBER},
+    {WIDGET_PROP_XSLIDABLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_YSLIDABLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_ANIMATABLE, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_VERTICAL, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_SHOW_TEXT, UI_PROP_TYPE_BOOL},
+    {WIDGET_PROP_AUTO_FIX, UI_PROP_TYPE_BOOL},
+};
+
+ui_prop_id_t ui_prop_id_from_name(const char* name) {
+  uint32_t i = 0;
+  return_value_if_fail(name != NULL, UI_PROP_NONE);
+
+  for (i = UI_PROP_NONE + 1; i < UI_PROP_NR; i++) {
+    if (tk_str_eq(s_ui_props[i].name, name)) {
+      return (ui_prop_id_t)i;
+    }
+  }
+
+  return UI_PROP_NONE;
+}
+
+const char* ui_prop_id_to_name(uint32_t id) {
+  return_value_if_fail(id > UI_PROP_NONE && id < UI_PROP_NR, NULL);
+
+  return s_ui_props[id].name;
+}
+
+ui_prop_type_t ui_prop_id_get_type(uint32_t id) {
+  return_value_if_fail(id > UI_PROP_NONE && id < UI_PROP_NR, UI_PROP_TYPE_STRING);
+
+  return s_ui_props[id].type;
+}
@@ -0,0 +1,125 @@
+﻿/**
+ * File:   ui_prop_ids.h
+ * Author: AWTK Develop Team
+ * Brief:  pre-resolved property ids for binary ui data.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_UI_PROP_IDS_H
+#define TK_UI_PROP_IDS_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/*
+ * 二进制UI描述数据(V2)中预先解析的属性ID。
+ *
+ * 常用属性在生成UI数据时被替换成ID，加载时不用再逐个比较属性名。
+ * ID保存在UI数据中，只能在UI_PROP_NR之前追加，不能调整已有ID的顺序。
+ */
+typedef enum _ui_prop_id_t {
+  UI_PROP_NONE = 0,
+  UI_PROP_NAME,
+  UI_PROP_STYLE,
+  UI_PROP_TEXT,
+  UI_PROP_TR_TEXT,
+  UI_PROP_VISIBLE,
+  UI_PROP_SENSITIVE,
+  UI_PROP_FLOATING,
+  UI_PROP_FOCUSABLE,
+  UI_PROP_WITH_FOCUS_STATE,
+  UI_PROP_ENABLE,
+  UI_PROP_OPACITY,
+  UI_PROP_ANIMATION,
+  UI_PROP_SELF_LAYOUT,
+  UI_PROP_CHILDREN_LAYOUT,
+  UI_PROP_FOCUS,
+  UI_PROP_VALUE,
+  UI_PROP_MIN,
+  UI_PROP_MAX,
+  UI_PROP_STEP,
+  UI_PROP_ITEM_HEIGHT,
+  UI_PROP_DEFAULT_ITEM_HEIGHT,
+  UI_PROP_AUTO_HIDE_SCROLL_BAR,
+  UI_PROP_IMAGE,
+  UI_PROP_DRAW_TYPE,
+  UI_PROP_READONLY,
+  UI_PROP_INPUT_TYPE,
+  UI_PROP_TIPS,
+  UI_PROP_REPEAT,
+  UI_PROP_MARGIN,
+  UI_PROP_SPACING,
+  UI_PROP_VIRTUAL_W,
+  UI_PROP_VIRTUAL_H,
+  UI_PROP_XSLIDABLE,
+  UI_PROP_YSLIDABLE,
+  UI_PROP_ANIMATABLE,
+  UI_PROP_VERTICAL,
+  UI_PROP_SHOW_TEXT,
+  UI_PROP_AUTO_FIX,
+  UI_PROP_NR
+} ui_prop_id_t;
+
+/*
+ * 属性值在二进制UI描述数据(V2)中的类型。
+ */
+typedef enum _ui_prop_type_t {
+  /*字符串*/
+  UI_PROP_TYPE_STRING = 1,
+  /*布尔值(uint8)*/
+  UI_PROP_TYPE_BOOL,
+  /*整数(int32)*/
+  UI_PROP_TYPE_INT32,
+  /*浮点数(float32)*/
+  UI_PROP_TYPE_FLOAT,
+  /*颜色(uint32)*/
+  UI_PROP_TYPE_COLOR,
+  /*数值(只用于属性表，写入时根据值选择INT32或FLOAT)*/
+  UI_PROP_TYPE_NUMBER
+} ui_prop_type_t;
+
+/**
+ * @method ui_prop_id_from_name
+ * 获取属性名对应的ID。
+ * @param {const char*} name 属性名。
+ *
+ * @return {ui_prop_id_t} 返回属性ID，不是预定义的属性时返回UI\_PROP\_NONE。
+ */
+ui_prop_id_t ui_prop_id_from_name(const char* name);
+
+/**
+ * @method ui_prop_id_to_name
+ * 获取属性ID对应的属性名。
+ * @param {uint32_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，无效的ID返回NULL。
+ */
+const char* ui_prop_id_to_name(uint32_t id);
+
+/**
+ * @method ui_prop_id_get_type
+ * 获取属性ID对应的值类型(STRING/BOOL/NUMBER)。
+ * @param {uint32_t} id 属性ID。
+ *
+ * @return {ui_prop_type_t} 返回值类型，无效的ID返回UI\_PROP\_TYPE\_STRING。
+ */
+ui_prop_type_t ui_prop_id_get_type(uint32_t id);
+
+END_C_DECLS
+
+#endif /*TK_UI_PROP_IDS_H*/
@@ -2,6 +2,7 @@
 #include "base/window_manager.h"
 #include "ui_loader/ui_loader_default.h"
 #include "ui_loader/ui_builder_default.h"
+#include "ui_loader/window_template_cache.h"
 
 static ret_t on_window_open(void* ctx, event_t* e) {
   widget_t* to_close = WIDGET(ctx);
@@ -20,7 +21,11 @@ static ret_t on_window_open(void* ctx, event_t* e) {
 }
 
 static widget_t* window_open_with_name(const char* name, widget_t* to_close) {
-  widget_t* win = ui_loader_load_widget(name);
+  widget_t* win = window_template_cache_open(name);
+
+  if (win == NULL) {
+    win = ui_loader_load_widget(name);
+  }
 
   if (win != NULL) {
     widget_on(win, EVT_WINDOW_OPEN, on_window_open, to_close);
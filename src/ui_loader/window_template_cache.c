@@ -0,0 +1,382 @@
+/**
+ * File:   window_template_cache.c
+ * Author: AWTK Develop Team
+ * Brief:  cache of pre-built window templates.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/darray.h"
+#include "base/theme.h"
+#include "widgets/view.h"
+#include "base/locale_info.h"
+#include "base/assets_manager.h"
+#include "base/widget_factory.h"
+#include "ui_loader/ui_loader_default.h"
+#include "ui_loader/ui_builder_default.h"
+#include "ui_loader/window_template_cache.h"
+
+typedef struct _window_template_prop_t {
+  char* name;
+  value_t v;
+} window_template_prop_t;
+
+typedef struct _window_template_t {
+  char* name;
+
+  /*模板根控件(view，不在窗口管理器中)，它的子控件是窗口的子控件的模板*/
+  widget_t* root;
+  widget_desc_t desc;
+  darray_t props;
+
+  /*构建模板时的主题和语言，改变后模板过期*/
+  const uint8_t* theme_data;
+  char language[3];
+  char country[3];
+
+  uint32_t mem_size;
+  uint32_t last_used;
+} window_template_t;
+
+typedef struct _window_template_builder_t {
+  ui_builder_t builder;
+  ui_builder_t base;
+  window_template_t* t;
+} window_template_builder_t;
+
+static darray_t* s_templates = NULL;
+static uint32_t s_mem_size = 0;
+static uint32_t s_max_mem_size = TK_WINDOW_TEMPLATE_CACHE_MEM_SIZE;
+static uint32_t s_stamp = 0;
+
+static ret_t window_template_prop_destroy(window_template_prop_t* prop) {
+  TKMEM_FREE(prop->name);
+  value_reset(&(prop->v));
+  TKMEM_FREE(prop);
+
+  return RET_OK;
+}
+
+static ret_t window_template_unload(window_template_t* t) {
+  if (t->root != NULL) {
+    widget_destroy(t->root);
+    t->root = NULL;
+  }
+
+  darray_clear(&(t->props));
+  s_mem_size -= t->mem_size;
+  t->mem_size = 0;
+
+  return RET_OK;
+}
+
+static ret_t window_template_destroy(window_template_t* t) {
+  window_template_unload(t);
+  darray_deinit(&(t->props));
+  TKMEM_FREE(t->name);
+  TKMEM_FREE(t);
+
+  return RET_OK;
+}
+
+static int window_template_compare_name(const void* a, const void* b) {
+  const window_template_t* t = (const window_template_t*)a;
+
+  return tk_str_cmp(t->name, (const char*)b);
+}
+
+static window_template_t* window_template_find(const char* name) {
+  if (s_templates == NULL || name == NULL) {
+    return NULL;
+  }
+
+  return (window_template_t*)darray_find(s_templates, (void*)name);
+}
+
+static ret_t window_template_record_prop(window_template_t* t, const char* name,
+                                         const value_t* v) {
+  window_template_prop_t* prop = TKMEM_ZALLOC(window_template_prop_t);
+  return_value_if_fail(prop != NULL, RET_OOM);
+
+  prop->name = tk_strdup(name);
+  value_deep_copy(&(prop->v), v);
+
+  return darray_push(&(t->props), prop);
+}
+
+static ret_t window_template_builder_on_widget_start(ui_builder_t* b, const widget_desc_t* desc) {
+  window_template_builder_t* builder = (window_template_builder_t*)b;
+
+  if (b->root == NULL) {
+    const rect_t* r = &(desc->layout);
+    widget_t* root = view_create(NULL, r->x, r->y, r->w, r->h);
+    return_value_if_fail(root != NULL, RET_OOM);
+
+    builder->t->desc = *desc;
+    b->root = root;
+    b->widget = root;
+
+    return RET_OK;
+  }
+
+  return builder->base.on_widget_start(b, desc);
+}
+
+static ret_t window_template_builder_on_widget_prop(ui_builder_t* b, const char* name,
+                                                    const char* value) {
+  window_template_builder_t* builder = (window_template_builder_t*)b;
+
+  if (b->widget == b->root) {
+    value_t v;
+    return window_template_record_prop(builder->t, name, value_set_str(&v, value));
+  }
+
+  return builder->base.on_widget_prop(b, name, value);
+}
+
+static ret_t window_template_builder_on_widget_prop_value(ui_builder_t* b, uint32_t id,
+                                                          const char* name, const value_t* v) {
+  window_template_builder_t* builder = (window_template_builder_t*)b;
+
+  if (b->widget == b->root) {
+    return window_template_record_prop(builder->t, name, v);
+  }
+
+  return builder->base.on_widget_prop_value(b, id, name, v);
+}
+
+static uint32_t window_template_estimate_mem_size(widget_t* widget) {
+  uint32_t size = widget->vt->size + widget->text.capacity * sizeof(wchar_t);
+
+  if (widget->name != NULL) {
+    size += strlen(widget->name) + 1;
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  size += window_template_estimate_mem_size(iter);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return size;
+}
+
+static bool_t window_template_is_stale(window_template_t* t) {
+  locale_info_t* info = locale_info();
+
+  if (theme() != NULL && theme()->data != t->theme_data) {
+    return TRUE;
+  }
+
+  if (info != NULL &&
+      (!tk_str_eq(info->language, t->language) || !tk_str_eq(info->country, t->country))) {
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+static ret_t window_template_load(window_template_t* t) {
+  window_template_builder_t builder;
+  locale_info_t* info = locale_info();
+  const asset_info_t* ui = assets_manager_ref(assets_manager(), ASSET_TYPE_UI, t->name);
+  return_value_if_fail(ui != NULL, RET_NOT_FOUND);
+
+  memset(&builder, 0x00, sizeof(builder));
+  builder.t = t;
+  builder.base = *ui_builder_default(t->name);
+  builder.builder = builder.base;
+  builder.builder.on_widget_start = window_template_builder_on_widget_start;
+  builder.builder.on_widget_prop = window_template_builder_on_widget_prop;
+  builder.builder.on_widget_prop_value = window_template_builder_on_widget_prop_value;
+  builder.builder.on_end = NULL;
+
+  ui_loader_load(default_ui_loader(), ui->data, ui->size, &(builder.builder));
+  assets_manager_unref(assets_manager(), ui);
+
+  t->root = builder.builder.root;
+  return_value_if_fail(t->root != NULL, RET_FAIL);
+
+  t->theme_data = theme() != NULL ? theme()->data : NULL;
+  if (info != NULL) {
+    tk_strncpy(t->language, info->language, sizeof(t->language) - 1);
+    tk_strncpy(t->country, info->country, sizeof(t->country) - 1);
+  }
+
+  t->mem_size = window_template_estimate_mem_size(t->root) +
+                t->props.size * sizeof(window_template_prop_t);
+  s_mem_size += t->mem_size;
+
+  return RET_OK;
+}
+
+static ret_t window_template_shrink(window_template_t* keep) {
+  while (s_max_mem_size > 0 && s_mem_size > s_max_mem_size) {
+    uint32_t i = 0;
+    window_template_t* lru = NULL;
+
+    for (i = 0; i < s_templates->size; i++) {
+      window_template_t* iter = (window_template_t*)(s_templates->elms[i]);
+      if (iter != keep && iter->root != NULL) {
+        if (lru == NULL || iter->last_used < lru->last_used) {
+          lru = iter;
+        }
+      }
+    }
+
+    if (lru == NULL) {
+      break;
+    }
+
+    window_template_unload(lru);
+  }
+
+  return RET_OK;
+}
+
+static widget_t* window_template_instantiate(window_template_t* t) {
+  uint32_t i = 0;
+  widget_t* win = NULL;
+  const rect_t* r = &(t->desc.layout);
+
+  win = widget_factory_create_widget(widget_factory(), t->desc.type, NULL, r->x, r->y, r->w, r->h);
+  return_value_if_fail(win != NULL, NULL);
+
+  for (i = 0; i < t->props.size; i++) {
+    window_template_prop_t* prop = (window_template_prop_t*)(t->props.elms[i]);
+    widget_set_prop(win, prop->name, &(prop->v));
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(t->root, iter, i)
+  widget_clone(iter, win);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  /*与ui_builder_default加载结束时的处理一致*/
+  widget_invalidate_force(win, NULL);
+  if (win->name == NULL) {
+    widget_set_name(win, t->name);
+  }
+
+  if (win->vt->is_window) {
+    event_t e = event_init(EVT_WINDOW_LOAD, win);
+
+    widget_layout(win);
+    widget_dispatch(win, &e);
+  }
+
+  return win;
+}
+
+ret_t window_template_cache_enable(const char* name) {
+  window_template_t* t = NULL;
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  if (window_template_find(name) != NULL) {
+    return RET_OK;
+  }
+
+  if (s_templates == NULL) {
+    s_templates = darray_create(5, (tk_destroy_t)window_template_destroy,
+                                (tk_compare_t)window_template_compare_name);
+    return_value_if_fail(s_templates != NULL, RET_OOM);
+  }
+
+  t = TKMEM_ZALLOC(window_template_t);
+  return_value_if_fail(t != NULL, RET_OOM);
+
+  t->name = tk_strdup(name);
+  darray_init(&(t->props), 5, (tk_destroy_t)window_template_prop_destroy, NULL);
+
+  return darray_push(s_templates, t);
+}
+
+ret_t window_template_cache_disable(const char* name) {
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(s_templates != NULL, RET_NOT_FOUND);
+
+  return darray_remove(s_templates, (void*)name);
+}
+
+bool_t window_template_cache_is_enabled(const char* name) {
+  return window_template_find(name) != NULL;
+}
+
+widget_t* window_template_cache_open(const char* name) {
+  widget_t* win = NULL;
+  window_template_t* t = window_template_find(name);
+
+  if (t == NULL) {
+    return NULL;
+  }
+
+  if (t->root != NULL && window_template_is_stale(t)) {
+    window_template_unload(t);
+  }
+
+  if (t->root == NULL) {
+    return_value_if_fail(window_template_load(t) == RET_OK, NULL);
+  }
+
+  t->last_used = ++s_stamp;
+  win = window_template_instantiate(t);
+
+  if (s_max_mem_size > 0 && t->mem_size > s_max_mem_size) {
+    log_debug("window template %s is too large: %u\n", name, t->mem_size);
+    window_template_unload(t);
+  } else {
+    window_template_shrink(t);
+  }
+
+  return win;
+}
+
+ret_t window_template_cache_set_max_mem_size(uint32_t max_mem_size) {
+  s_max_mem_size = max_mem_size;
+
+  if (s_templates != NULL) {
+    window_template_shrink(NULL);
+  }
+
+  return RET_OK;
+}
+
+uint32_t window_template_cache_get_mem_size(void) {
+  return s_mem_size;
+}
+
+ret_t window_template_cache_clear(void) {
+  uint32_t i = 0;
+
+  if (s_templates != NULL) {
+    for (i = 0; i < s_templates->size; i++) {
+      window_template_unload((window_template_t*)(s_templates->elms[i]));
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t window_template_cache_deinit(void) {
+  if (s_templates != NULL) {
+    darray_destroy(s_templates);
+    s_templates = NULL;
+  }
+
+  s_mem_size = 0;
+  s_max_mem_size = TK_WINDOW_TEMPLATE_CACHE_MEM_SIZE;
+
+  return RET_OK;
+}
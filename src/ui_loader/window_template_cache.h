@@ -0,0 +1,130 @@
+﻿/**
+ * File:   window_template_cache.h
+ * Author: AWTK Develop Team
+ * Brief:  cache of pre-built window templates.
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-17 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_WINDOW_TEMPLATE_CACHE_H
+#define TK_WINDOW_TEMPLATE_CACHE_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class window_template_cache_t
+ * @annotation ["fake"]
+ *
+ * 窗口模板缓存。
+ *
+ * 对于经常打开的窗口(如弹出窗口、对话框和软键盘)，第一次打开时把UI数据构建成模板(不显示的控件树)，
+ * 以后打开时用widget\_clone复制模板，不再读取和解析UI数据。
+ *
+ * 只有启用了缓存的窗口才会使用模板(window\_template\_cache\_enable)。
+ * 控件的状态需要能通过widget\_clone完整复制(参考widget\_vtable\_t的clone\_properties)。
+ *
+ * 模板占用的内存超过上限时按LRU淘汰，主题或语言改变后模板自动重建。
+ *
+ * ```c
+ * window_template_cache_enable("dialog1");
+ * ...
+ * window_open("dialog1");
+ * ```
+ */
+
+/**
+ * @method window_template_cache_enable
+ * 启用指定窗口的模板缓存。
+ * @annotation ["static"]
+ * @param {const char*} name 窗口的名称(UI资源的名称)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_template_cache_enable(const char* name);
+
+/**
+ * @method window_template_cache_disable
+ * 禁用指定窗口的模板缓存，并释放已经构建的模板。
+ * @annotation ["static"]
+ * @param {const char*} name 窗口的名称(UI资源的名称)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_template_cache_disable(const char* name);
+
+/**
+ * @method window_template_cache_is_enabled
+ * 检查指定窗口是否启用了模板缓存。
+ * @annotation ["static"]
+ * @param {const char*} name 窗口的名称(UI资源的名称)。
+ *
+ * @return {bool_t} 返回TRUE表示启用，否则表示没有启用。
+ */
+bool_t window_template_cache_is_enabled(const char* name);
+
+/**
+ * @method window_template_cache_open
+ * 用模板创建并打开窗口。模板不存在或已经过期时先构建模板。
+ * @annotation ["static"]
+ * @param {const char*} name 窗口的名称(UI资源的名称)。
+ *
+ * @return {widget_t*} 返回窗口对象，没有启用缓存或失败时返回NULL。
+ */
+widget_t* window_template_cache_open(const char* name);
+
+/**
+ * @method window_template_cache_set_max_mem_size
+ * 设置模板最多占用的内存(估计值)，为0表示不限制。
+ * 缺省为TK\_WINDOW\_TEMPLATE\_CACHE\_MEM\_SIZE。
+ * @annotation ["static"]
+ * @param {uint32_t} max_mem_size 内存上限(字节数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_template_cache_set_max_mem_size(uint32_t max_mem_size);
+
+/**
+ * @method window_template_cache_get_mem_size
+ * 获取模板占用的内存(估计值)。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回内存大小(字节数)。
+ */
+uint32_t window_template_cache_get_mem_size(void);
+
+/**
+ * @method window_template_cache_clear
+ * 释放全部已经构建的模板(保留启用状态)。UI资源更新后需要调用本函数。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_template_cache_clear(void);
+
+/**
+ * @method window_template_cache_deinit
+ * 释放全部模板和启用状态。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t window_template_cache_deinit(void);
+
+END_C_DECLS
+
+#endif /*TK_WINDOW_TEMPLATE_CACHE_H*/
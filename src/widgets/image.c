@@ -37,7 +37,8 @@ static ret_t image_on_paint_self(widget_t* widget, canvas_t* c) {
     return RET_OK;
   }
 
-  return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
+  return_value_if_fail(widget_load_image_with_handle(widget, image_base->image,
+                                                     &(image_base->handle), &bitmap) == RET_OK,
                        RET_BAD_PARAMS);
 
   if (vg != NULL) {
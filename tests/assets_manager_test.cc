@@ -150,3 +150,38 @@ TEST(AssetsManager, any) {
   ASSERT_EQ(strncmp((const char*)(r->data), "abc\n", 4), 0);
 #endif /*WITH_FS_RES*/
 }
+
+TEST(AssetsManager, many) {
+  uint32_t i = 0;
+  const uint32_t nr = 200;
+  asset_info_t* imgs = (asset_info_t*)calloc(nr, sizeof(asset_info_t));
+  asset_info_t* uis = (asset_info_t*)calloc(nr, sizeof(asset_info_t));
+  asset_info_t dup = {ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_PNG, TRUE, 100, 0, "img10"};
+  assets_manager_t* rm = assets_manager_create(10);
+
+  for (i = 0; i < nr; i++) {
+    imgs[i].type = ASSET_TYPE_IMAGE;
+    imgs[i].is_in_rom = TRUE;
+    snprintf(imgs[i].name, sizeof(imgs[i].name), "img%u", i);
+    ASSERT_EQ(assets_manager_add(rm, imgs + i), RET_OK);
+
+    uis[i].type = ASSET_TYPE_UI;
+    uis[i].is_in_rom = TRUE;
+    snprintf(uis[i].name, sizeof(uis[i].name), "img%u", i);
+    ASSERT_EQ(assets_manager_add(rm, uis + i), RET_OK);
+
+    ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_IMAGE, imgs[i].name), imgs + i);
+  }
+  ASSERT_EQ(assets_manager_add(rm, &dup), RET_OK);
+
+  for (i = 0; i < nr; i++) {
+    ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_IMAGE, imgs[i].name), imgs + i);
+    ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_UI, uis[i].name), uis + i);
+  }
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_IMAGE, "img200") == NULL, true);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_FONT, "img1") == NULL, true);
+
+  assets_manager_destroy(rm);
+  free(imgs);
+  free(uis);
+}
@@ -2,6 +2,7 @@
 #include "tkc/color.h"
 #include "base/bitmap.h"
 #include "blend/image_g2d.h"
+#include "blend/simd_g2d.h"
 #include "gtest/gtest.h"
 #include "common.h"
 
@@ -69,3 +70,285 @@ TEST(BlendImage, BITMAP_FMT_BGR565_stride) {
   test_blend_image(2, BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888);
   test_blend_image(3, BITMAP_FMT_BGR888, BITMAP_FMT_BGR565);
 }
+
+static void fill_random(bitmap_t* b) {
+  uint32_t i = 0;
+  uint8_t* p = (uint8_t*)(b->data);
+  uint32_t bpp = bitmap_get_bpp(b);
+  uint32_t size = bitmap_get_line_length(b) * b->h;
+  static const uint8_t alphas[] = {0, 8, 9, 0x80, 0xf8, 0xf9, 0xff};
+
+  for (i = 0; i < size; i++) {
+    p[i] = rand() & 0xff;
+  }
+
+  /*让alpha经常落在阈值附近*/
+  if (bpp == 4) {
+    for (i = 3; i < size; i += 4) {
+      if (rand() % 2) {
+        p[i] = alphas[rand() % ARRAY_SIZE(alphas)];
+      }
+    }
+  }
+}
+
+static void test_blend_simd(bitmap_format_t dfmt, bitmap_format_t sfmt, uint8_t alpha) {
+  int type = 0;
+  uint32_t w = 37;
+  uint32_t h = 9;
+  rect_t r = rect_init(3, 1, 31, 7);
+  uint32_t dst_line_length = w * bitmap_get_bpp_of_format(dfmt);
+  uint32_t size = dst_line_length * h;
+  bitmap_t* src = bitmap_create_ex(w, h, w * bitmap_get_bpp_of_format(sfmt), sfmt);
+  bitmap_t* origin = bitmap_create_ex(w, h, dst_line_length, dfmt);
+  bitmap_t* expected = bitmap_create_ex(w, h, dst_line_length, dfmt);
+  bitmap_t* actual = bitmap_create_ex(w, h, dst_line_length, dfmt);
+
+  fill_random(src);
+  fill_random(origin);
+  memcpy((uint8_t*)(expected->data), origin->data, size);
+
+  ASSERT_EQ(simd_g2d_set_type(SIMD_NONE), RET_OK);
+  ASSERT_EQ(image_blend(expected, src, &r, &r, alpha), RET_OK);
+
+  for (type = SIMD_SSE2; type <= SIMD_NEON; type++) {
+    if (simd_g2d_set_type((simd_type_t)type) != RET_OK) {
+      continue;
+    }
+
+    memcpy((uint8_t*)(actual->data), origin->data, size);
+    ASSERT_EQ(image_blend(actual, src, &r, &r, alpha), RET_OK);
+    ASSERT_EQ(memcmp(actual->data, expected->data, size), 0);
+  }
+
+  simd_g2d_set_type(simd_g2d_detect());
+
+  bitmap_destroy(src);
+  bitmap_destroy(origin);
+  bitmap_destroy(expected);
+  bitmap_destroy(actual);
+}
+
+TEST(BlendImage, simd) {
+  uint32_t i = 0;
+  uint8_t alphas[] = {0xff, 0xf8, 0x80, 9};
+
+  for (i = 0; i < ARRAY_SIZE(alphas); i++) {
+    test_blend_simd(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888, alphas[i]);
+    test_blend_simd(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888, alphas[i]);
+    test_blend_simd(BITMAP_FMT_RGBA8888, BITMAP_FMT_RGBA8888, alphas[i]);
+    test_blend_simd(BITMAP_FMT_RGBA8888, BITMAP_FMT_BGRA8888, alphas[i]);
+    test_blend_simd(BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888, alphas[i]);
+    test_blend_simd(BITMAP_FMT_BGR565, BITMAP_FMT_BGRA8888, alphas[i]);
+  }
+
+  /*copy*/
+  test_blend_simd(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565, 0xff);
+}
+
+static void check_rect(bitmap_t* b, rect_t* r, rgba_t e) {
+  int32_t x = 0;
+  int32_t y = 0;
+  rgba_t rgba;
+
+  for (y = r->y; y < r->y + r->h; y++) {
+    for (x = r->x; x < r->x + r->w; x++) {
+      ASSERT_EQ(bitmap_get_pixel(b, x, y, &rgba), RET_OK);
+      ASSERT_EQ(rgba.r, e.r);
+      ASSERT_EQ(rgba.g, e.g);
+      ASSERT_EQ(rgba.b, e.b);
+    }
+  }
+}
+
+static void test_scale_nearest(bitmap_format_t dfmt, bitmap_format_t sfmt, uint32_t dw) {
+  uint32_t dh = 6;
+  rect_t s = rect_init(0, 0, 2, 2);
+  rect_t d = rect_init(0, 0, dw, dh);
+  rect_t r00 = rect_init(0, 0, 1, 1);
+  rect_t r01 = rect_init(1, 0, 1, 1);
+  rect_t r10 = rect_init(0, 1, 1, 1);
+  rect_t r11 = rect_init(1, 1, 1, 1);
+  color_t c00 = color_init(0xf8, 0, 0, 0xff);
+  color_t c01 = color_init(0, 0xfc, 0, 0xff);
+  color_t c10 = color_init(0, 0, 0xf8, 0xff);
+  color_t c11 = color_init(0xf8, 0xfc, 0xf8, 0xff);
+  bitmap_t* src = bitmap_create_ex(2, 2, 0, sfmt);
+  bitmap_t* dst = bitmap_create_ex(dw, dh, 0, dfmt);
+
+  ASSERT_EQ(image_clear(src, &r00, c00), RET_OK);
+  ASSERT_EQ(image_clear(src, &r01, c01), RET_OK);
+  ASSERT_EQ(image_clear(src, &r10, c10), RET_OK);
+  ASSERT_EQ(image_clear(src, &r11, c11), RET_OK);
+  ASSERT_EQ(image_blend(dst, src, &d, &s, 0xff), RET_OK);
+
+  r00 = rect_init(0, 0, dw / 2, dh / 2);
+  r01 = rect_init(dw / 2, 0, dw / 2, dh / 2);
+  r10 = rect_init(0, dh / 2, dw / 2, dh / 2);
+  r11 = rect_init(dw / 2, dh / 2, dw / 2, dh / 2);
+  check_rect(dst, &r00, c00.rgba);
+  check_rect(dst, &r01, c01.rgba);
+  check_rect(dst, &r10, c10.rgba);
+  check_rect(dst, &r11, c11.rgba);
+
+  bitmap_destroy(src);
+  bitmap_destroy(dst);
+}
+
+TEST(BlendImage, scale_nearest) {
+  test_scale_nearest(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888, 8);
+  test_scale_nearest(BITMAP_FMT_BGR565, BITMAP_FMT_BGRA8888, 10);
+  test_scale_nearest(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565, 12);
+  /*列表超过栈上的空间*/
+  test_scale_nearest(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565, 600);
+  test_scale_nearest(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888, 600);
+}
+
+static void test_scale_nearest_alpha(bitmap_format_t fmt, uint8_t alpha) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  rect_t s = rect_init(0, 0, 2, 2);
+  rect_t d = rect_init(0, 0, 4, 4);
+  uint32_t bpp = bitmap_get_bpp_of_format(fmt);
+  bitmap_t* src = bitmap_create_ex(2, 2, 0, fmt);
+  bitmap_t* big = bitmap_create_ex(4, 4, 0, fmt);
+  bitmap_t* origin = bitmap_create_ex(4, 4, 0, fmt);
+  bitmap_t* expected = bitmap_create_ex(4, 4, 0, fmt);
+  bitmap_t* actual = bitmap_create_ex(4, 4, 0, fmt);
+  uint32_t size = bitmap_get_line_length(origin) * 4;
+
+  fill_random(src);
+  fill_random(origin);
+  if (bpp == 4) {
+    for (x = 3; x < 2 * 2 * 4; x += 4) {
+      ((uint8_t*)(src->data))[x] = 0xff;
+    }
+  }
+  src->flags |= BITMAP_FLAG_OPAQUE;
+
+  /*放大两倍的源图，用不缩放的合成计算期望的结果*/
+  for (y = 0; y < 4; y++) {
+    for (x = 0; x < 4; x++) {
+      memcpy((uint8_t*)(big->data) + (y * 4 + x) * bpp,
+             (uint8_t*)(src->data) + ((y / 2) * 2 + x / 2) * bpp, bpp);
+    }
+  }
+  big->flags |= BITMAP_FLAG_OPAQUE;
+
+  ASSERT_EQ(simd_g2d_set_type(SIMD_NONE), RET_OK);
+  memcpy((uint8_t*)(expected->data), origin->data, size);
+  ASSERT_EQ(image_blend(expected, big, &d, &d, alpha), RET_OK);
+  memcpy((uint8_t*)(actual->data), origin->data, size);
+  ASSERT_EQ(image_blend(actual, src, &d, &s, alpha), RET_OK);
+  ASSERT_EQ(memcmp(actual->data, expected->data, size), 0);
+  simd_g2d_set_type(simd_g2d_detect());
+
+  bitmap_destroy(src);
+  bitmap_destroy(big);
+  bitmap_destroy(origin);
+  bitmap_destroy(expected);
+  bitmap_destroy(actual);
+}
+
+TEST(BlendImage, scale_nearest_alpha) {
+  uint32_t a = 0;
+
+  for (a = 0xf6; a <= 0xff; a++) {
+    test_scale_nearest_alpha(BITMAP_FMT_BGR565, a);
+    test_scale_nearest_alpha(BITMAP_FMT_BGRA8888, a);
+  }
+}
+
+TEST(BlendImage, scale_down) {
+  uint32_t i = 0;
+  rect_t s = rect_init(0, 0, 40, 4);
+  rect_t d = rect_init(0, 0, 4, 2);
+  color_t c = color_init(0x40, 0x60, 0x80, 0xff);
+  bitmap_t* src = bitmap_create_ex(40, 4, 0, BITMAP_FMT_RGBA8888);
+  bitmap_t* dst = bitmap_create_ex(4, 2, 0, BITMAP_FMT_BGRA8888);
+
+  /*只有每10列中间的那一列是有颜色的，按像素中心采样应该正好取到它*/
+  for (i = 0; i < 4; i++) {
+    rect_t r = rect_init(i * 10 + 5, 0, 1, 4);
+    ASSERT_EQ(image_clear(src, &r, c), RET_OK);
+  }
+
+  ASSERT_EQ(image_blend(dst, src, &d, &s, 0xff), RET_OK);
+  check_rect(dst, &d, c.rgba);
+
+  bitmap_destroy(src);
+  bitmap_destroy(dst);
+}
+
+static void test_scale_bilinear(bitmap_format_t dfmt, bitmap_format_t sfmt, bool_t smooth_dst) {
+  uint32_t i = 0;
+  rgba_t last;
+  rgba_t rgba;
+  rect_t s = rect_init(0, 0, 2, 1);
+  rect_t d = rect_init(0, 0, 16, 4);
+  rect_t r0 = rect_init(0, 0, 1, 1);
+  rect_t r1 = rect_init(1, 0, 1, 1);
+  color_t black = color_init(0, 0, 0, 0xff);
+  color_t white = color_init(0xff, 0xff, 0xff, 0xff);
+  bitmap_t* src = bitmap_create_ex(2, 1, 0, sfmt);
+  bitmap_t* dst = bitmap_create_ex(16, 4, 0, dfmt);
+
+  ASSERT_EQ(image_clear(src, &r0, black), RET_OK);
+  ASSERT_EQ(image_clear(src, &r1, white), RET_OK);
+  if (smooth_dst) {
+    dst->flags |= BITMAP_FLAG_SMOOTH;
+  } else {
+    src->flags |= BITMAP_FLAG_SMOOTH;
+  }
+  ASSERT_EQ(image_blend(dst, src, &d, &s, 0xff), RET_OK);
+
+  /*两端与源图一致，中间是渐变的*/
+  ASSERT_EQ(bitmap_get_pixel(dst, 0, 0, &last), RET_OK);
+  ASSERT_EQ(last.r, 0);
+  for (i = 1; i < d.w; i++) {
+    ASSERT_EQ(bitmap_get_pixel(dst, i, 3, &rgba), RET_OK);
+    ASSERT_GE(rgba.g, last.g);
+    last = rgba;
+  }
+  ASSERT_GE(last.g, 0xf8);
+  ASSERT_EQ(bitmap_get_pixel(dst, 8, 0, &rgba), RET_OK);
+  ASSERT_GT(rgba.g, 0x60);
+  ASSERT_LT(rgba.g, 0xa0);
+
+  bitmap_destroy(src);
+  bitmap_destroy(dst);
+}
+
+TEST(BlendImage, scale_bilinear) {
+  test_scale_bilinear(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888, TRUE);
+  test_scale_bilinear(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888, FALSE);
+  test_scale_bilinear(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565, TRUE);
+  test_scale_bilinear(BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888, FALSE);
+}
+
+TEST(BlendImage, scale_bilinear_transparent) {
+  rgba_t rgba;
+  rect_t s = rect_init(0, 0, 2, 1);
+  rect_t d = rect_init(0, 0, 8, 1);
+  rect_t r1 = rect_init(1, 0, 1, 1);
+  color_t c = color_init(0xff, 0, 0, 0xff);
+  color_t trans = color_init(0, 0, 0, 0);
+  color_t white = color_init(0xff, 0xff, 0xff, 0xff);
+  bitmap_t* src = bitmap_create_ex(2, 1, 0, BITMAP_FMT_RGBA8888);
+  bitmap_t* dst = bitmap_create_ex(8, 1, 0, BITMAP_FMT_BGRA8888);
+
+  ASSERT_EQ(image_clear(src, &s, trans), RET_OK);
+  ASSERT_EQ(image_clear(src, &r1, c), RET_OK);
+  ASSERT_EQ(image_clear(dst, &d, white), RET_OK);
+  src->flags |= BITMAP_FLAG_SMOOTH;
+  ASSERT_EQ(image_blend(dst, src, &d, &s, 0xff), RET_OK);
+
+  /*透明像素(黑色)不会让边缘变暗*/
+  ASSERT_EQ(bitmap_get_pixel(dst, 4, 0, &rgba), RET_OK);
+  ASSERT_GE(rgba.r, 0xf0);
+  ASSERT_GT(rgba.g, 0x40);
+  ASSERT_LT(rgba.g, 0xf0);
+
+  bitmap_destroy(src);
+  bitmap_destroy(dst);
+}
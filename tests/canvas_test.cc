@@ -1,4 +1,5 @@
-﻿#include "base/canvas.h"
+﻿#include "tkc/utils.h"
+#include "base/canvas.h"
 #include "base/font_manager.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
@@ -206,6 +207,71 @@ TEST(Canvas, draw_glyph) {
   canvas_reset(&c);
 }
 
+static uint32_t s_glyph_lookups = 0;
+static std::string s_glyph_runs;
+
+static ret_t font_run_get_glyph(font_t* f, wchar_t chr, uint16_t font_size, glyph_t* g) {
+  memset(g, 0x00, sizeof(glyph_t));
+  g->y = -10;
+  g->w = 10;
+  g->h = 10;
+  g->advance = 10;
+  s_glyph_lookups++;
+
+  return RET_OK;
+}
+
+static bool_t font_run_match(font_t* f, const char* name, uint16_t font_size) {
+  return TRUE;
+}
+
+static ret_t lcd_run_draw_glyphs(lcd_t* lcd, draw_glyph_info_t* glyphs, uint32_t nr) {
+  char str[32];
+
+  tk_snprintf(str, sizeof(str), "%u,", nr);
+  s_glyph_runs += str;
+
+  return RET_OK;
+}
+
+TEST(Canvas, draw_text_run) {
+  rect_t r;
+  canvas_t c;
+  font_t font;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(800, 600);
+  wchar_t str[32];
+  uint32_t i = 0;
+
+  memset(&font, 0x00, sizeof(font));
+  font.match = font_run_match;
+  font.get_glyph = font_run_get_glyph;
+  tk_strncpy(font.name, "run", TK_NAME_LEN);
+  lcd->draw_glyphs = lcd_run_draw_glyphs;
+
+  /*第一行22个字符，超出裁剪区，第二行3个字符*/
+  for (i = 0; i < 26; i++) {
+    str[i] = i == 22 ? '\r' : 'a';
+  }
+
+  font_manager_init(&font_manager, NULL);
+  font_manager_add_font(&font_manager, &font);
+  canvas_init(&c, lcd, &font_manager);
+  r = rect_init(100, 100, 200, 200);
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+  canvas_set_font(&c, "run", 10);
+
+  /*被裁剪掉的字符也要查找字模，查找可能淘汰run中的字模，所以要先把run画出来*/
+  canvas_draw_text(&c, str, 26, 100, 150);
+  ASSERT_EQ(s_glyph_runs, "8,8,3,3,");
+  /*完全在裁剪区右边的字符不再查找字模*/
+  ASSERT_EQ(s_glyph_lookups, 23u);
+
+  canvas_end_frame(&c);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
 TEST(Canvas, draw_image) {
   rect_t r;
   rect_t s;
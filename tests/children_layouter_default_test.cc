@@ -1,7 +1,10 @@
 ﻿#include <string>
 #include "gtest/gtest.h"
 #include "widgets/button.h"
+#include "widgets/view.h"
 #include "widgets/window.h"
+#include "base/layout.h"
+#include "tkc/utils.h"
 #include "layouters/children_layouter_default.h"
 #include "base/children_layouter_factory.h"
 
@@ -341,3 +344,69 @@ TEST(ChildrenLayoutDefault, self) {
   children_layouter_destroy(layouter);
   widget_destroy(w);
 }
+
+TEST(ChildrenLayoutDefault, incremental) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  layout_stats_t stats;
+  widget_t* groups[3];
+  widget_t* w = view_create(NULL, 0, 0, 320, 480);
+
+  for (i = 0; i < ARRAY_SIZE(groups); i++) {
+    char params[64];
+    widget_t* group = view_create(w, 0, 0, 0, 0);
+
+    tk_snprintf(params, sizeof(params), "default(x=0,y=%d,w=100%%,h=100)", i * 100);
+    widget_set_self_layout(group, params);
+    widget_set_children_layout(group, "default(r=1,c=4)");
+    for (j = 0; j < 4; j++) {
+      button_create(group, 0, 0, 0, 0);
+    }
+    groups[i] = group;
+  }
+
+  widget_layout_children(w);
+  ASSERT_EQ(widget_get_child(groups[1], 0)->w, 80);
+  ASSERT_EQ(groups[2]->y, 200);
+
+  /*只有groups[1]需要重新layout*/
+  widget_layout_reset_stats();
+  widget_set_visible(widget_get_child(groups[1], 3), FALSE, FALSE);
+  ASSERT_EQ(widget_layout_children_if_needed(w), RET_OK);
+  ASSERT_EQ(widget_layout_get_stats(&stats), RET_OK);
+  ASSERT_EQ(stats.children_layout_nr, 1);
+  ASSERT_EQ(w->need_relayout_descendants, FALSE);
+  ASSERT_EQ(groups[1]->need_relayout_children, FALSE);
+
+  /*子控件的大小没有变化，不用layout它们的子控件*/
+  widget_layout_reset_stats();
+  widget_resize(w, 320, 400);
+  ASSERT_EQ(widget_layout_children_if_needed(w), RET_OK);
+  ASSERT_EQ(widget_layout_get_stats(&stats), RET_OK);
+  ASSERT_EQ(stats.children_layout_nr, 1);
+  ASSERT_EQ(stats.self_layout_nr, 3);
+
+  widget_layout_reset_stats();
+  widget_resize(w, 240, 400);
+  ASSERT_EQ(widget_layout_children_if_needed(w), RET_OK);
+  ASSERT_EQ(widget_layout_get_stats(&stats), RET_OK);
+  ASSERT_EQ(stats.children_layout_nr, 4);
+  ASSERT_EQ(widget_get_child(groups[0], 0)->w, 60);
+
+  /*没有需要layout的控件*/
+  widget_layout_reset_stats();
+  ASSERT_EQ(widget_layout_children_if_needed(w), RET_OK);
+  ASSERT_EQ(widget_layout_get_stats(&stats), RET_OK);
+  ASSERT_EQ(stats.children_layout_nr, 0);
+
+  /*布局器跳过的子树会残留标识，它不能阻止再次标识祖先控件*/
+  groups[0]->need_relayout_descendants = TRUE;
+  ASSERT_EQ(w->need_relayout_descendants, FALSE);
+  widget_set_need_relayout_children(widget_get_child(groups[0], 1));
+  ASSERT_EQ(w->need_relayout_descendants, TRUE);
+  ASSERT_EQ(widget_layout_children_if_needed(w), RET_OK);
+  ASSERT_EQ(groups[0]->need_relayout_descendants, FALSE);
+  ASSERT_EQ(widget_get_child(groups[0], 1)->need_relayout_children, FALSE);
+
+  widget_destroy(w);
+}
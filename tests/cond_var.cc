@@ -1,6 +1,7 @@
 ﻿#include "tkc/thread.h"
 #include "tkc/cond_var.h"
 #include "tkc/platform.h"
+#include "tkc/time_now.h"
 
 #include "gtest/gtest.h"
 #include <stdlib.h>
@@ -48,3 +49,22 @@ TEST(CondVar, basic) {
   ASSERT_EQ(s_producer, s_max);
   ASSERT_EQ(s_consumer, s_max);
 }
+
+TEST(CondVar, timeout) {
+  uint32_t start = 0;
+  tk_cond_var_t* cond = tk_cond_var_create();
+
+  /*超时返回RET_FAIL*/
+  start = time_now_ms();
+  ASSERT_EQ(tk_cond_var_wait(cond, 20), RET_FAIL);
+  ASSERT_GE(time_now_ms() - start, 15u);
+  ASSERT_LT(time_now_ms() - start, 1000u);
+
+  /*等待之前已经唤醒时立即返回*/
+  ASSERT_EQ(tk_cond_var_awake(cond), RET_OK);
+  start = time_now_ms();
+  ASSERT_EQ(tk_cond_var_wait(cond, 10000), RET_OK);
+  ASSERT_LT(time_now_ms() - start, 1000u);
+
+  tk_cond_var_destroy(cond);
+}
@@ -0,0 +1,152 @@
+﻿#include "base/dirty_rects.h"
+#include "gtest/gtest.h"
+
+TEST(DirtyRects, basic) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(0, 0, 10, 10);
+  rect_t r2 = rect_init(700, 400, 100, 80);
+
+  ASSERT_EQ(dirty_rects_init(&dr), RET_OK);
+  ASSERT_EQ(dr.nr, 0);
+
+  ASSERT_EQ(dirty_rects_add(&dr, &r1), RET_OK);
+  ASSERT_EQ(dirty_rects_add(&dr, &r2), RET_OK);
+  ASSERT_EQ(dr.nr, 2);
+  ASSERT_EQ(dr.max.x, 0);
+  ASSERT_EQ(dr.max.y, 0);
+  ASSERT_EQ(dr.max.w, 800);
+  ASSERT_EQ(dr.max.h, 480);
+
+  ASSERT_EQ(dirty_rects_reset(&dr), RET_OK);
+  ASSERT_EQ(dr.nr, 0);
+  ASSERT_EQ(dr.max.w, 0);
+  ASSERT_EQ(dr.max.h, 0);
+}
+
+TEST(DirtyRects, empty) {
+  dirty_rects_t dr;
+  rect_t r = rect_init(10, 10, 0, 10);
+
+  dirty_rects_init(&dr);
+  ASSERT_EQ(dirty_rects_add(&dr, &r), RET_OK);
+  ASSERT_EQ(dr.nr, 0);
+}
+
+TEST(DirtyRects, intersect) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(0, 0, 100, 100);
+  rect_t r2 = rect_init(50, 50, 100, 100);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&dr, &r2);
+
+  ASSERT_EQ(dr.nr, 1);
+  ASSERT_EQ(dr.rects[0].x, 0);
+  ASSERT_EQ(dr.rects[0].y, 0);
+  ASSERT_EQ(dr.rects[0].w, 150);
+  ASSERT_EQ(dr.rects[0].h, 150);
+}
+
+TEST(DirtyRects, contains) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(0, 0, 100, 100);
+  rect_t r2 = rect_init(10, 10, 10, 10);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&dr, &r2);
+
+  ASSERT_EQ(dr.nr, 1);
+  ASSERT_EQ(dr.rects[0].w, 100);
+  ASSERT_EQ(dr.rects[0].h, 100);
+}
+
+TEST(DirtyRects, cheap_merge) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(0, 0, 100, 20);
+  rect_t r2 = rect_init(0, 20, 100, 20);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&dr, &r2);
+
+  ASSERT_EQ(dr.nr, 1);
+  ASSERT_EQ(dr.rects[0].h, 40);
+}
+
+TEST(DirtyRects, chain_merge) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(0, 0, 100, 100);
+  rect_t r2 = rect_init(300, 0, 100, 100);
+  rect_t r3 = rect_init(50, 0, 300, 100);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&dr, &r2);
+  ASSERT_EQ(dr.nr, 2);
+
+  dirty_rects_add(&dr, &r3);
+  ASSERT_EQ(dr.nr, 1);
+  ASSERT_EQ(dr.rects[0].x, 0);
+  ASSERT_EQ(dr.rects[0].w, 400);
+}
+
+TEST(DirtyRects, full) {
+  uint32_t i = 0;
+  dirty_rects_t dr;
+
+  dirty_rects_init(&dr);
+  for (i = 0; i < TK_MAX_DIRTY_RECT_NR + 4; i++) {
+    rect_t r = rect_init(i * 100, i * 100, 10, 10);
+    dirty_rects_add(&dr, &r);
+  }
+
+  ASSERT_EQ(dr.nr <= TK_MAX_DIRTY_RECT_NR, TRUE);
+  ASSERT_EQ(dr.max.x, 0);
+  ASSERT_EQ(dr.max.y, 0);
+  ASSERT_EQ(dr.max.w, (TK_MAX_DIRTY_RECT_NR + 3) * 100 + 10);
+
+  for (i = 0; i < dr.nr; i++) {
+    uint32_t j = 0;
+    for (j = i + 1; j < dr.nr; j++) {
+      rect_t r = rect_intersect(dr.rects + i, dr.rects + j);
+      ASSERT_EQ(r.w == 0 || r.h == 0, TRUE);
+    }
+  }
+}
+
+TEST(DirtyRects, add_rects) {
+  dirty_rects_t dr;
+  dirty_rects_t last;
+  rect_t r1 = rect_init(0, 0, 10, 10);
+  rect_t r2 = rect_init(700, 400, 100, 80);
+
+  dirty_rects_init(&dr);
+  dirty_rects_init(&last);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&last, &r2);
+
+  ASSERT_EQ(dirty_rects_add_rects(&dr, &last), RET_OK);
+  ASSERT_EQ(dr.nr, 2);
+}
+
+TEST(DirtyRects, fix) {
+  dirty_rects_t dr;
+  rect_t r1 = rect_init(10, 10, 20, 20);
+  rect_t r2 = rect_init(900, 400, 100, 80);
+
+  dirty_rects_init(&dr);
+  dirty_rects_add(&dr, &r1);
+  dirty_rects_add(&dr, &r2);
+  ASSERT_EQ(dr.nr, 2);
+
+  ASSERT_EQ(dirty_rects_fix(&dr, 800, 480), RET_OK);
+  ASSERT_EQ(dr.nr, 1);
+  ASSERT_EQ(dr.rects[0].x, 10);
+  ASSERT_EQ(dr.rects[0].y, 10);
+  ASSERT_EQ(dr.rects[0].w, 20);
+  ASSERT_EQ(dr.rects[0].h, 20);
+  ASSERT_EQ(dr.max.x, 10);
+  ASSERT_EQ(dr.max.w, 20);
+}
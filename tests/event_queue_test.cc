@@ -1,4 +1,5 @@
 ﻿#include "gtest/gtest.h"
+#include "tkc/thread.h"
 #include "base/event_queue.h"
 
 #define NR 10
@@ -54,3 +55,120 @@ TEST(EventQueue, basic) {
 
   event_queue_destroy(q);
 }
+
+static uint32_t s_wakeups = 0;
+static ret_t on_wakeup(void* ctx) {
+  s_wakeups++;
+
+  return RET_OK;
+}
+
+TEST(EventQueueMPSC, basic) {
+  uint32_t i = 0;
+  event_queue_req_t r;
+  event_queue_req_t w;
+  event_queue_mpsc_t* q = event_queue_mpsc_create(NR);
+
+  memset(&r, 0x00, sizeof(r));
+  memset(&w, 0x00, sizeof(w));
+
+  ASSERT_EQ(q != NULL, true);
+  ASSERT_EQ(q->capacity, 16);
+  ASSERT_EQ(event_queue_mpsc_set_wakeup(q, on_wakeup, NULL), RET_OK);
+
+  s_wakeups = 0;
+  ASSERT_EQ(event_queue_mpsc_recv(q, &r), RET_FAIL);
+  for (i = 0; i < 3; i++) {
+    for (uint32_t k = 0; k < q->capacity; k++) {
+      w.pointer_event.e.type = EVT_POINTER_MOVE;
+      w.pointer_event.x = k;
+      ASSERT_EQ(event_queue_mpsc_send(q, &w), RET_OK);
+    }
+
+    w.key_event.e.type = EVT_KEY_DOWN;
+    ASSERT_EQ(event_queue_mpsc_send(q, &w), RET_FAIL);
+    w.add_idle.e.type = REQ_ADD_IDLE;
+    ASSERT_EQ(event_queue_mpsc_send(q, &w), RET_FAIL);
+
+    for (uint32_t k = 0; k < q->capacity; k++) {
+      ASSERT_EQ(event_queue_mpsc_peek(q, &r), RET_OK);
+      ASSERT_EQ(r.pointer_event.x, k);
+      ASSERT_EQ(event_queue_mpsc_recv(q, &r), RET_OK);
+      ASSERT_EQ(r.event.type, EVT_POINTER_MOVE);
+      ASSERT_EQ(r.pointer_event.x, k);
+    }
+    ASSERT_EQ(event_queue_mpsc_peek(q, &r), RET_FAIL);
+    ASSERT_EQ(event_queue_mpsc_recv(q, &r), RET_FAIL);
+  }
+
+  ASSERT_EQ(s_wakeups, 3 * q->capacity);
+  ASSERT_EQ(event_queue_mpsc_get_dropped(q, EVENT_QUEUE_DROP_KEY), 3);
+  ASSERT_EQ(event_queue_mpsc_get_dropped(q, EVENT_QUEUE_DROP_IDLE), 3);
+  ASSERT_EQ(event_queue_mpsc_get_dropped(q, EVENT_QUEUE_DROP_POINTER), 0);
+  ASSERT_EQ(event_queue_mpsc_get_dropped(q, EVENT_QUEUE_DROP_TIMER), 0);
+
+  event_queue_mpsc_destroy(q);
+}
+
+#define PRODUCER_NR 4
+#define EVENTS_PER_PRODUCER 20000
+
+typedef struct _producer_args_t {
+  event_queue_mpsc_t* q;
+  uint32_t id;
+} producer_args_t;
+
+static void* mpsc_producer_entry(void* args) {
+  event_queue_req_t w;
+  producer_args_t* info = (producer_args_t*)args;
+
+  memset(&w, 0x00, sizeof(w));
+  for (uint32_t i = 0; i < EVENTS_PER_PRODUCER; i++) {
+    w.pointer_event.e.type = EVT_POINTER_MOVE;
+    w.pointer_event.x = info->id;
+    w.pointer_event.y = i;
+    while (event_queue_mpsc_send_timeout(info->q, &w, 1000) != RET_OK) {
+    }
+  }
+
+  return NULL;
+}
+
+TEST(EventQueueMPSC, threads) {
+  uint32_t i = 0;
+  uint32_t total = 0;
+  event_queue_req_t r;
+  int32_t next[PRODUCER_NR];
+  tk_thread_t* threads[PRODUCER_NR];
+  producer_args_t args[PRODUCER_NR];
+  event_queue_mpsc_t* q = event_queue_mpsc_create(64);
+
+  for (i = 0; i < PRODUCER_NR; i++) {
+    next[i] = 0;
+    args[i].q = q;
+    args[i].id = i;
+    threads[i] = tk_thread_create(mpsc_producer_entry, args + i);
+    tk_thread_start(threads[i]);
+  }
+
+  while (total < PRODUCER_NR * EVENTS_PER_PRODUCER) {
+    if (event_queue_mpsc_recv(q, &r) == RET_OK) {
+      uint32_t id = r.pointer_event.x;
+      ASSERT_EQ(id < PRODUCER_NR, true);
+      /*同一个生产者的事件保持顺序*/
+      ASSERT_EQ(r.pointer_event.y, next[id]);
+      next[id]++;
+      total++;
+    }
+  }
+
+  for (i = 0; i < PRODUCER_NR; i++) {
+    tk_thread_join(threads[i]);
+    tk_thread_destroy(threads[i]);
+    ASSERT_EQ(next[i], EVENTS_PER_PRODUCER);
+  }
+
+  ASSERT_EQ(event_queue_mpsc_recv(q, &r), RET_FAIL);
+  ASSERT_EQ(event_queue_mpsc_get_dropped(q, EVENT_QUEUE_DROP_POINTER), 0);
+  event_queue_mpsc_destroy(q);
+}
@@ -2,6 +2,7 @@
 #include "tkc/color.h"
 #include "base/bitmap.h"
 #include "blend/image_g2d.h"
+#include "blend/simd_g2d.h"
 #include "gtest/gtest.h"
 #include "common.h"
 
@@ -68,3 +69,61 @@ TEST(FillImage, BITMAP_FMT_BGR565_stride) {
 TEST(FillImage, BITMAP_FMT_RGB565_stride) {
   test_fill_image(2, BITMAP_FMT_RGB565);
 }
+
+static void test_fill_simd(bitmap_format_t fmt, color_t c, bool_t clear) {
+  int type = 0;
+  uint32_t i = 0;
+  uint32_t w = 37;
+  uint32_t h = 9;
+  rect_t r = rect_init(3, 1, 31, 7);
+  uint32_t line_length = w * bitmap_get_bpp_of_format(fmt);
+  uint32_t size = line_length * h;
+  bitmap_t* origin = bitmap_create_ex(w, h, line_length, fmt);
+  bitmap_t* expected = bitmap_create_ex(w, h, line_length, fmt);
+  bitmap_t* actual = bitmap_create_ex(w, h, line_length, fmt);
+
+  for (i = 0; i < size; i++) {
+    ((uint8_t*)(origin->data))[i] = rand() & 0xff;
+  }
+  memcpy((uint8_t*)(expected->data), origin->data, size);
+
+  ASSERT_EQ(simd_g2d_set_type(SIMD_NONE), RET_OK);
+  if (clear) {
+    ASSERT_EQ(image_clear(expected, &r, c), RET_OK);
+  } else {
+    ASSERT_EQ(image_fill(expected, &r, c), RET_OK);
+  }
+
+  for (type = SIMD_SSE2; type <= SIMD_NEON; type++) {
+    if (simd_g2d_set_type((simd_type_t)type) != RET_OK) {
+      continue;
+    }
+
+    memcpy((uint8_t*)(actual->data), origin->data, size);
+    if (clear) {
+      ASSERT_EQ(image_clear(actual, &r, c), RET_OK);
+    } else {
+      ASSERT_EQ(image_fill(actual, &r, c), RET_OK);
+    }
+    ASSERT_EQ(memcmp(actual->data, expected->data, size), 0);
+  }
+
+  simd_g2d_set_type(simd_g2d_detect());
+
+  bitmap_destroy(origin);
+  bitmap_destroy(expected);
+  bitmap_destroy(actual);
+}
+
+TEST(FillImage, simd) {
+  uint32_t i = 0;
+  bitmap_format_t formats[] = {BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888, BITMAP_FMT_BGR565,
+                               BITMAP_FMT_RGB565};
+
+  for (i = 0; i < ARRAY_SIZE(formats); i++) {
+    test_fill_simd(formats[i], color_init(0x20, 0x30, 0x40, 0x20), FALSE);
+    test_fill_simd(formats[i], color_init(0xff, 0x80, 0x01, 0xf0), FALSE);
+    test_fill_simd(formats[i], color_init(0, 0, 0, 0x80), FALSE);
+    test_fill_simd(formats[i], color_init(0x40, 0x60, 0x80, 0xff), TRUE);
+  }
+}
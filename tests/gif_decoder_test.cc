@@ -0,0 +1,240 @@
+﻿#include "tkc/mem.h"
+#include "gtest/gtest.h"
+#include "tools/common/utils.h"
+#include "image_loader/gif_decoder.h"
+#include "image_loader/image_loader_stb.h"
+
+#include <string>
+
+#define BEE_GIF TK_ROOT "/demos/assets/raw/images/x1/bee.gif"
+
+#ifdef WITH_BITMAP_BGRA
+#define REQUIRE_BGRA TRUE
+#else
+#define REQUIRE_BGRA FALSE
+#endif /*WITH_BITMAP_BGRA*/
+
+/*生成不压缩的LZW数据：每个像素前面都加一个CLEAR，码长保持为3*/
+static void gif_put_pixels(std::string& gif, const uint8_t* pixels, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t buff = 0;
+  uint32_t nbits = 0;
+  std::string codes;
+
+  for (i = 0; i <= nr; i++) {
+    uint32_t c1 = i < nr ? 4 : 5;
+    uint32_t c2 = i < nr ? pixels[i] : 0;
+    uint32_t n = i < nr ? 6 : 3;
+
+    buff |= (c1 | (c2 << 3)) << nbits;
+    nbits += n;
+    while (nbits >= 8) {
+      codes += (char)(buff & 0xff);
+      buff >>= 8;
+      nbits -= 8;
+    }
+  }
+  if (nbits > 0) {
+    codes += (char)(buff & 0xff);
+  }
+
+  gif += (char)2;
+  for (i = 0; i < codes.size(); i += 255) {
+    std::string block = codes.substr(i, 255);
+    gif += (char)block.size();
+    gif += block;
+  }
+  gif += (char)0;
+}
+
+static void gif_put16(std::string& gif, uint16_t v) {
+  gif += (char)(v & 0xff);
+  gif += (char)(v >> 8);
+}
+
+static void gif_add_frame(std::string& gif, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                          uint8_t disposal, int transparent, const uint8_t* pixels) {
+  gif += "\x21\xF9\x04";
+  gif += (char)((disposal << 2) | (transparent >= 0 ? 1 : 0));
+  gif_put16(gif, 10);
+  gif += (char)(transparent >= 0 ? transparent : 0);
+  gif += (char)0;
+
+  gif += (char)0x2C;
+  gif_put16(gif, x);
+  gif_put16(gif, y);
+  gif_put16(gif, w);
+  gif_put16(gif, h);
+  gif += (char)0;
+  gif_put_pixels(gif, pixels, w * h);
+}
+
+/*
+ * 4x4，调色板为红、绿、蓝和白色：
+ * 0: 全部为红色，保留。
+ * 1: (1,1,2,2)为绿色，恢复为上一帧。
+ * 2: (0,0)为蓝色，恢复为背景。
+ * 3: (2,2,2,2)中只有(3,3)为绿色，其余为透明色。
+ */
+static std::string gif_gen(void) {
+  std::string gif("GIF89a", 6);
+  uint8_t red[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  uint8_t green[4] = {1, 1, 1, 1};
+  uint8_t blue[1] = {2};
+  uint8_t last[4] = {3, 3, 3, 1};
+
+  gif_put16(gif, 4);
+  gif_put16(gif, 4);
+  gif += (char)0x81;
+  gif += (char)0;
+  gif += (char)0;
+  gif += std::string("\xff\x00\x00\x00\xff\x00\x00\x00\xff\xff\xff\xff", 12);
+
+  gif_add_frame(gif, 0, 0, 4, 4, 1, -1, red);
+  gif_add_frame(gif, 1, 1, 2, 2, 3, -1, green);
+  gif_add_frame(gif, 0, 0, 1, 1, 2, -1, blue);
+  gif_add_frame(gif, 2, 2, 2, 2, 1, 3, last);
+  gif += (char)0x3B;
+
+  return gif;
+}
+
+static uint32_t pixel_of(bitmap_t* image, uint32_t x, uint32_t y) {
+  rgba_t rgba;
+
+  bitmap_get_pixel(image, x, y, &rgba);
+  if (rgba.a == 0) {
+    return 0;
+  }
+
+  return (rgba.r << 24) | (rgba.g << 16) | (rgba.b << 8) | rgba.a;
+}
+
+#define RED 0xff0000ffu
+#define GREEN 0x00ff00ffu
+#define BLUE 0x0000ffffu
+
+static void check_frames(gif_decoder_t* decoder) {
+  bitmap_t* image = gif_decoder_get_frame(decoder, 0);
+  ASSERT_TRUE(image != NULL);
+  ASSERT_EQ(pixel_of(image, 0, 0), RED);
+  ASSERT_EQ(pixel_of(image, 3, 3), RED);
+
+  image = gif_decoder_get_frame(decoder, 1);
+  ASSERT_EQ(pixel_of(image, 0, 0), RED);
+  ASSERT_EQ(pixel_of(image, 1, 1), GREEN);
+  ASSERT_EQ(pixel_of(image, 2, 2), GREEN);
+  ASSERT_EQ(pixel_of(image, 3, 3), RED);
+
+  image = gif_decoder_get_frame(decoder, 2);
+  ASSERT_EQ(pixel_of(image, 0, 0), BLUE);
+  ASSERT_EQ(pixel_of(image, 1, 1), RED);
+  ASSERT_EQ(pixel_of(image, 2, 2), RED);
+
+  image = gif_decoder_get_frame(decoder, 3);
+  ASSERT_EQ(pixel_of(image, 0, 0), 0u);
+  ASSERT_EQ(pixel_of(image, 1, 1), RED);
+  ASSERT_EQ(pixel_of(image, 2, 2), RED);
+  ASSERT_EQ(pixel_of(image, 3, 2), RED);
+  ASSERT_EQ(pixel_of(image, 3, 3), GREEN);
+}
+
+TEST(GifDecoder, disposal) {
+  std::string gif = gif_gen();
+  gif_decoder_t* decoder = gif_decoder_create((const uint8_t*)gif.c_str(), gif.size());
+
+  ASSERT_TRUE(decoder != NULL);
+  ASSERT_EQ(decoder->w, 4u);
+  ASSERT_EQ(decoder->h, 4u);
+  ASSERT_EQ(decoder->frames_nr, 4u);
+  ASSERT_EQ(decoder->delays[0], 100);
+
+  check_frames(decoder);
+  /*往回取时从第一帧重新解码*/
+  check_frames(decoder);
+  ASSERT_EQ(pixel_of(gif_decoder_get_frame(decoder, 1), 1, 1), GREEN);
+
+  gif_decoder_destroy(decoder);
+}
+
+TEST(GifDecoder, prefetch) {
+  uint32_t i = 0;
+  std::string gif = gif_gen();
+  gif_decoder_t* decoder = gif_decoder_create((const uint8_t*)gif.c_str(), gif.size());
+  gif_decoder_t* expected = gif_decoder_create((const uint8_t*)gif.c_str(), gif.size());
+
+  ASSERT_TRUE(decoder != NULL && expected != NULL);
+  ASSERT_TRUE(gif_decoder_get_frame(decoder, 0) != NULL);
+
+  for (i = 1; i < 2 * decoder->frames_nr; i++) {
+    uint32_t index = i % decoder->frames_nr;
+    bitmap_t* e = gif_decoder_get_frame(expected, index);
+    bitmap_t* image = NULL;
+
+    ASSERT_EQ(gif_decoder_prefetch(decoder), RET_OK);
+    ASSERT_EQ(decoder->back_index, (int32_t)index);
+    image = gif_decoder_get_frame(decoder, index);
+    ASSERT_EQ(decoder->front_index, (int32_t)index);
+    ASSERT_EQ(memcmp(image->data, e->data, e->line_length * e->h), 0);
+  }
+
+  gif_decoder_destroy(decoder);
+  gif_decoder_destroy(expected);
+}
+
+TEST(GifDecoder, bee) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  bitmap_t expected;
+  uint8_t* buff = (uint8_t*)read_file(BEE_GIF, &size);
+  gif_decoder_t* decoder = gif_decoder_create(buff, size);
+
+  ASSERT_TRUE(decoder != NULL);
+  ASSERT_EQ(stb_load_image(ASSET_TYPE_IMAGE_GIF, buff, size, &expected, REQUIRE_BGRA, FALSE),
+            RET_OK);
+  ASSERT_EQ(decoder->w, expected.w);
+  ASSERT_EQ(decoder->h, (uint32_t)(expected.gif_frame_h));
+  ASSERT_EQ(decoder->frames_nr, (uint32_t)(expected.gif_frames_nr));
+
+  for (i = 0; i < decoder->frames_nr; i++) {
+    uint32_t y = 0;
+    bitmap_t* image = NULL;
+
+    if (i % 2) {
+      ASSERT_EQ(gif_decoder_prefetch(decoder), RET_OK);
+    }
+
+    image = gif_decoder_get_frame(decoder, i);
+    ASSERT_TRUE(image != NULL);
+    ASSERT_EQ(image->format, expected.format);
+    ASSERT_EQ(decoder->delays[i], expected.gif_delays[i]);
+
+    for (y = 0; y < image->h; y++) {
+      uint32_t x = 0;
+      const uint8_t* s = expected.data + (i * decoder->h + y) * expected.line_length;
+      const uint8_t* d = image->data + y * image->line_length;
+
+      for (x = 0; x < image->w; x++, s += 4, d += 4) {
+        if (s[3] == 0) {
+          ASSERT_EQ(d[3], 0);
+        } else {
+          ASSERT_EQ(memcmp(s, d, 4), 0);
+        }
+      }
+    }
+  }
+
+  bitmap_destroy(&expected);
+  gif_decoder_destroy(decoder);
+  TKMEM_FREE(buff);
+}
+
+TEST(GifDecoder, invalid) {
+  std::string gif = gif_gen();
+
+  ASSERT_TRUE(gif_decoder_create(NULL, 0) == NULL);
+  ASSERT_TRUE(gif_decoder_create((const uint8_t*)"GIF89a", 6) == NULL);
+  /*只有头部和调色板，没有帧*/
+  ASSERT_TRUE(gif_decoder_create((const uint8_t*)gif.c_str(), 13 + 12) == NULL);
+  ASSERT_EQ(gif_decoder_prefetch(NULL), RET_BAD_PARAMS);
+}
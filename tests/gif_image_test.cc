@@ -1,4 +1,7 @@
-﻿#include "widgets/window.h"
+﻿#include "base/idle.h"
+#include "base/canvas.h"
+#include "widgets/window.h"
+#include "lcd/lcd_mem_rgba8888.h"
 #include "gif_image/gif_image.h"
 #include "gtest/gtest.h"
 
@@ -26,3 +29,40 @@ TEST(GifImage, cast) {
 
   widget_destroy(w);
 }
+
+TEST(GifImage, decoder) {
+  canvas_t c;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_mem_rgba8888_create(100, 100, TRUE);
+  widget_t* img = gif_image_create(NULL, 0, 0, 100, 100);
+  gif_image_t* gif_image = GIF_IMAGE(img);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  image_base_set_image(img, "bee");
+
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(img, &c);
+  canvas_end_frame(&c);
+
+  ASSERT_TRUE(gif_image->decoder != NULL);
+  ASSERT_EQ(gif_image->frames_nr, 11u);
+  ASSERT_EQ(gif_image->decoder->front_index, 0);
+  ASSERT_NE(gif_image->idle_id, (uint32_t)TK_INVALID_ID);
+
+  /*在idle中预先解码下一帧*/
+  idle_dispatch();
+  ASSERT_EQ(gif_image->idle_id, (uint32_t)TK_INVALID_ID);
+  ASSERT_EQ(gif_image->decoder->back_index, 1);
+
+  gif_image->index = 1;
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(img, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(gif_image->decoder->front_index, 1);
+  ASSERT_EQ(gif_image->decoder->back_index, -1);
+
+  widget_destroy(img);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
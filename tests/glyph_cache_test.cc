@@ -17,3 +17,175 @@ TEST(GlyphCache, basic) {
 
   glyph_cache_deinit(c);
 }
+
+TEST(GlyphCache, lru) {
+  uint16_t i = 0;
+  glyph_t g;
+  glyph_cache_t cache;
+  glyph_cache_t* c = glyph_cache_init(&cache, 16, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  for (i = 0; i < 16; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, 10, glyph_clone(&g)), RET_OK);
+  }
+
+  /*0最近被访问，淘汰的应该是1*/
+  ASSERT_EQ(glyph_cache_lookup(c, 0, 10, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_add(c, 100, 10, glyph_clone(&g)), RET_OK);
+
+  ASSERT_EQ(c->evictions, 1);
+  ASSERT_EQ(glyph_cache_lookup(c, 0, 10, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, 10, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, 2, 10, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 100, 10, &g), RET_OK);
+
+  ASSERT_EQ(c->hits, 4);
+  ASSERT_EQ(c->misses, 1);
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, size) {
+  glyph_t g;
+  glyph_cache_t cache;
+  glyph_cache_t* c = glyph_cache_init(&cache, 16, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  ASSERT_EQ(glyph_cache_add(c, 'a', 10, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(glyph_cache_add(c, 'a', 12, glyph_clone(&g)), RET_OK);
+
+  ASSERT_EQ(glyph_cache_lookup(c, 'a', 10, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 'a', 12, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 'a', 14, &g), RET_NOT_FOUND);
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, max_mem_size) {
+  uint16_t i = 0;
+  glyph_t g;
+  glyph_cache_t cache;
+  uint32_t item_size = 10 * 10 + sizeof(glyph_t);
+  glyph_cache_t* c = glyph_cache_init(&cache, 64, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  g.w = 10;
+  g.h = 10;
+  ASSERT_EQ(glyph_cache_set_max_mem_size(c, item_size * 12), RET_OK);
+
+  for (i = 0; i < 20; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, 10, glyph_clone(&g)), RET_OK);
+    ASSERT_EQ(c->mem_size <= item_size * 12, true);
+  }
+
+  ASSERT_EQ(c->evictions, 8);
+  ASSERT_EQ(c->mem_size, item_size * 12);
+  for (i = 0; i < 8; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, 10, &g), RET_NOT_FOUND);
+  }
+
+  for (i = 8; i < 20; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, 10, &g), RET_OK);
+  }
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, keep_recent) {
+  uint16_t i = 0;
+  glyph_t g;
+  glyph_cache_t cache;
+  uint32_t item_size = 10 * 10 + sizeof(glyph_t);
+  glyph_cache_t* c = glyph_cache_init(&cache, 64, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  g.w = 10;
+  g.h = 10;
+  ASSERT_EQ(glyph_cache_set_max_mem_size(c, item_size * 2), RET_OK);
+
+  /*同一批绘制的TK_GLYPH_RUN_NR个glyph，不会因为内存的原因被淘汰*/
+  for (i = 0; i < TK_GLYPH_RUN_NR; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, 10, glyph_clone(&g)), RET_OK);
+  }
+  ASSERT_EQ(c->evictions, 0);
+  ASSERT_EQ(c->mem_size, item_size * TK_GLYPH_RUN_NR);
+
+  ASSERT_EQ(glyph_cache_add(c, 100, 10, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(c->evictions, 1);
+  ASSERT_EQ(glyph_cache_lookup(c, 0, 10, &g), RET_NOT_FOUND);
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, atlas) {
+  uint16_t i = 0;
+  glyph_t g;
+  glyph_t* gg = NULL;
+  glyph_cache_t cache;
+  glyph_cache_t* c = glyph_cache_init(&cache, 64, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  g.w = 10;
+  g.h = 10;
+  g.advance = 12;
+
+  ASSERT_EQ(glyph_cache_alloc(c, 1, 10, &g) == NULL, true);
+  ASSERT_EQ(glyph_cache_enable_atlas(c, 1000, 2), RET_OK);
+
+  for (i = 0; i < 10; i++) {
+    gg = glyph_cache_alloc(c, i, 10, &g);
+    ASSERT_EQ(gg != NULL, true);
+    ASSERT_EQ(gg->advance, 12);
+    memset((uint8_t*)(gg->data), i, gg->w * gg->h);
+  }
+
+  /*同一页中连续存放*/
+  ASSERT_EQ(c->pages[0].used, 1000);
+  ASSERT_EQ(c->pages[0].glyphs_nr, 10);
+  ASSERT_EQ(c->pages[1].data == NULL, true);
+  ASSERT_EQ(c->mem_size, 1000);
+
+  for (i = 0; i < 10; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, 10, &g), RET_OK);
+    ASSERT_EQ(g.data[0], i);
+    ASSERT_EQ(g.data[99], i);
+  }
+
+  for (i = 10; i < 20; i++) {
+    ASSERT_EQ(glyph_cache_alloc(c, i, 10, &g) != NULL, true);
+  }
+  ASSERT_EQ(c->pages[1].glyphs_nr, 10);
+  ASSERT_EQ(c->mem_size, 2000);
+
+  /*页用完后，回收最久没有使用的页*/
+  ASSERT_EQ(glyph_cache_alloc(c, 100, 10, &g) != NULL, true);
+  ASSERT_EQ(c->pages[0].glyphs_nr, 1);
+  ASSERT_EQ(c->evictions, 10);
+  ASSERT_EQ(glyph_cache_lookup(c, 0, 10, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, 19, 10, &g), RET_OK);
+
+  /*太大的不放到atlas中*/
+  g.w = 100;
+  g.h = 100;
+  ASSERT_EQ(glyph_cache_alloc(c, 200, 10, &g) == NULL, true);
+
+  glyph_cache_deinit(c);
+}
+
+TEST(GlyphCache, random) {
+  uint32_t i = 0;
+  glyph_t g;
+  glyph_cache_t cache;
+  glyph_cache_t* c = glyph_cache_init(&cache, 100, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  for (i = 0; i < 20000; i++) {
+    wchar_t code = (i * 7919) % 500;
+    if (glyph_cache_lookup(c, code, 16, &g) != RET_OK) {
+      ASSERT_EQ(glyph_cache_add(c, code, 16, glyph_clone(&g)), RET_OK);
+    }
+    ASSERT_EQ(glyph_cache_lookup(c, code, 16, &g), RET_OK);
+  }
+
+  glyph_cache_deinit(c);
+}
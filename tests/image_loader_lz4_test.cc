@@ -0,0 +1,77 @@
+﻿#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "gtest/gtest.h"
+#include "tools/common/utils.h"
+#include "base/image_manager.h"
+#include "base/assets_manager.h"
+#include "tools/image_gen/image_gen.h"
+#include "image_loader/image_loader_stb.h"
+#include "image_loader/image_loader_lz4.h"
+
+#define PNG_NAME TK_ROOT "/tests/testdata/test.png"
+
+static ret_t load_png(const char* filename, bitmap_t* image) {
+  uint32_t size = 0;
+  ret_t ret = RET_OK;
+  uint8_t* buff = (uint8_t*)read_file(filename, &size);
+
+  ret = stb_load_image(0, buff, size, image, FALSE, FALSE);
+  TKMEM_FREE(buff);
+
+  return ret;
+}
+
+TEST(ImageLoaderLz4, basic) {
+  bitmap_t png;
+  bitmap_t image;
+  uint32_t size = 0;
+  uint32_t raw_size = 0;
+  static uint8_t buff[64 * 1024];
+
+  ASSERT_EQ(load_png(PNG_NAME, &png), RET_OK);
+  raw_size = bitmap_get_line_length(&png) * png.h;
+
+  size = image_gen_lz4_buff(&png, buff, sizeof(buff));
+  ASSERT_GT(size, 0u);
+  ASSERT_LT(size, raw_size);
+
+  ASSERT_EQ(lz4_load_image(buff, size, &image), RET_OK);
+  ASSERT_EQ(image.w, png.w);
+  ASSERT_EQ(image.h, png.h);
+  ASSERT_EQ(image.format, png.format);
+  ASSERT_EQ(image.flags, png.flags);
+  ASSERT_EQ(memcmp(image.data, png.data, raw_size), 0);
+  bitmap_destroy(&image);
+
+  /*数据不完整时失败*/
+  ASSERT_NE(lz4_load_image(buff, size - 8, &image), RET_OK);
+
+  bitmap_destroy(&png);
+}
+
+TEST(ImageLoaderLz4, image_manager) {
+  bitmap_t png;
+  bitmap_t image;
+  uint32_t raw_size = 0;
+  static uint8_t buff[64 * 1024];
+  asset_info_t* r = (asset_info_t*)buff;
+
+  ASSERT_EQ(load_png(PNG_NAME, &png), RET_OK);
+  raw_size = bitmap_get_line_length(&png) * png.h;
+
+  memset(r, 0x00, sizeof(asset_info_t));
+  strcpy(r->name, "test_lz4");
+  r->is_in_rom = TRUE;
+  r->type = ASSET_TYPE_IMAGE;
+  r->subtype = ASSET_TYPE_IMAGE_LZ4;
+  r->size = image_gen_lz4_buff(&png, r->data, sizeof(buff) - sizeof(asset_info_t));
+  ASSERT_EQ(assets_manager_add(assets_manager(), buff), RET_OK);
+
+  ASSERT_EQ(image_manager_get_bitmap(image_manager(), "test_lz4", &image), RET_OK);
+  ASSERT_EQ(image.w, png.w);
+  ASSERT_EQ(image.h, png.h);
+  ASSERT_EQ(memcmp(image.data, png.data, raw_size), 0);
+
+  image_manager_unload_unused(image_manager(), 0);
+  bitmap_destroy(&png);
+}
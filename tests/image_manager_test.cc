@@ -1,5 +1,6 @@
 ﻿#include <stdlib.h>
 #include "gtest/gtest.h"
+#include "tkc/mem.h"
 #include "base/image_manager.h"
 #include "image_loader/image_loader_stb.h"
 #include <string>
@@ -90,3 +91,176 @@ TEST(ImageManager, fs) {
   ASSERT_EQ(image_manager_unload_bitmap(image_manager(), &bmp), RET_OK);
 }
 #endif /*WITH_FS_RES*/
+
+TEST(ImageManager, many) {
+  bitmap_t bmp;
+  char name[32];
+  uint32_t i = 0;
+  const uint32_t nr = 100;
+  image_manager_t* imm = image_manager_create();
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  for (i = 0; i < nr; i++) {
+    bmp.w = i + 1;
+    snprintf(name, sizeof(name), "image%u", i);
+    ASSERT_EQ(image_manager_add(imm, name, &bmp), RET_OK);
+    ASSERT_EQ(image_manager_lookup(imm, name, &bmp), RET_OK);
+    ASSERT_EQ(bmp.w, i + 1);
+  }
+
+  bmp.w = 1000;
+  ASSERT_EQ(image_manager_add(imm, "image1", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "image1", &bmp), RET_OK);
+  ASSERT_EQ(bmp.w, 2);
+
+  for (i = 0; i < nr; i++) {
+    snprintf(name, sizeof(name), "image%u", i);
+    ASSERT_EQ(image_manager_lookup(imm, name, &bmp), RET_OK);
+    ASSERT_EQ(bmp.w, i + 1);
+  }
+  ASSERT_EQ(image_manager_lookup(imm, "image100", &bmp), RET_NOT_FOUND);
+
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "image1", &bmp), RET_NOT_FOUND);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, handle) {
+  bitmap_t bmp;
+  bitmap_t bmp1;
+  image_handle_t handle;
+  uint32_t generation = 0;
+  image_manager_t* imm = image_manager();
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  memset(&handle, 0x00, sizeof(handle));
+
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "checked", &handle, &bmp), RET_OK);
+  ASSERT_EQ(string(handle.name), string("checked"));
+  ASSERT_EQ(handle.generation != 0, true);
+
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "checked", &handle, &bmp1), RET_OK);
+  ASSERT_EQ(bmp1.data, bmp.data);
+  ASSERT_EQ(bmp1.w, bmp.w);
+
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "unchecked", &handle, &bmp1), RET_OK);
+  ASSERT_EQ(string(handle.name), string("unchecked"));
+
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "not found", &handle, &bmp1),
+            RET_NOT_FOUND);
+  ASSERT_EQ(handle.generation, 0);
+
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "checked", &handle, &bmp), RET_OK);
+
+  /*没有删除图片时，已有的handle仍然有效*/
+  generation = imm->generation;
+  ASSERT_EQ(image_manager_unload_unused(imm, 3600), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "checked", &bmp1), RET_OK);
+  memset(&bmp1, 0x00, sizeof(bmp1));
+  ASSERT_EQ(image_manager_unload_bitmap(imm, &bmp1), RET_OK);
+  ASSERT_EQ(imm->generation, generation);
+
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+  ASSERT_NE(imm->generation, generation);
+  ASSERT_EQ(image_manager_lookup(imm, "checked", &bmp1), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_get_bitmap_with_handle(imm, "checked", &handle, &bmp1), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "checked", &bmp1), RET_OK);
+
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+}
+
+static ret_t add_test_image(image_manager_t* imm, const char* name) {
+  ret_t ret = RET_OK;
+  bitmap_t* b = bitmap_create_ex(10, 10, 0, BITMAP_FMT_RGBA8888);
+
+  ret = image_manager_add(imm, name, b);
+  TKMEM_FREE(b);
+
+  return ret;
+}
+
+TEST(ImageManager, budget) {
+  bitmap_t bmp;
+  image_manager_stats_t stats;
+  image_manager_t* imm = image_manager_create();
+
+  ASSERT_EQ(image_manager_set_max_mem_size(imm, 1200), RET_OK);
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "a"), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "b"), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "c"), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 3);
+  ASSERT_EQ(stats.mem_size, 1200);
+  ASSERT_EQ(stats.evictions, 0);
+
+  /*b是最久没有使用的*/
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "a", &bmp), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "d"), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "b", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 3);
+  ASSERT_EQ(stats.mem_size, 1200);
+  ASSERT_EQ(stats.evictions, 1);
+
+  /*当前帧用到的图片不淘汰，暂时超过上限*/
+  ASSERT_EQ(image_manager_lookup(imm, "c", &bmp), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "e"), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 4);
+  ASSERT_EQ(stats.mem_size, 1600);
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.hits, 2);
+
+  /*新的一帧，降低上限时立即淘汰*/
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "e", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_set_max_mem_size(imm, 400), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 1);
+  ASSERT_EQ(stats.mem_size, 400);
+  ASSERT_EQ(stats.evictions, 4);
+  ASSERT_EQ(image_manager_lookup(imm, "e", &bmp), RET_OK);
+
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 0);
+  ASSERT_EQ(stats.mem_size, 0);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, budgetNoFrame) {
+  image_manager_stats_t stats;
+  image_manager_t* imm = image_manager_create();
+
+  ASSERT_EQ(image_manager_set_max_mem_size(imm, 800), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "a"), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "b"), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "c"), RET_OK);
+  ASSERT_EQ(add_test_image(imm, "d"), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 2);
+  ASSERT_EQ(stats.mem_size, 800);
+  ASSERT_EQ(stats.evictions, 2);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, stats) {
+  bitmap_t bmp;
+  image_manager_stats_t stats;
+  image_manager_t* imm = image_manager_create();
+
+  ASSERT_EQ(image_manager_get_bitmap(imm, "checked", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_get_bitmap(imm, "checked", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_get_stats(imm, &stats), RET_OK);
+  ASSERT_EQ(stats.nr, 1);
+  ASSERT_EQ(stats.misses, 1);
+  ASSERT_EQ(stats.hits, 1);
+  ASSERT_EQ(stats.mem_size, bitmap_get_line_length(&bmp) * bmp.h);
+
+  image_manager_destroy(imm);
+}
@@ -3,6 +3,7 @@
 #include "base/layout.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
+#include "base/font_manager.h"
 #include "gtest/gtest.h"
 #include "image_value/image_value.h"
 
@@ -35,3 +36,35 @@ TEST(ImageValue, cast) {
 
   widget_destroy(w);
 }
+
+TEST(ImageValue, handles) {
+  canvas_t c;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(800, 600);
+  widget_t* w = image_value_create(NULL, 0, 0, 200, 100);
+  image_value_t* image_value = IMAGE_VALUE(w);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  image_value_set_image(w, "num_");
+  ASSERT_EQ(image_value->handles_nr, 0u);
+
+  /*句柄按用到的字符分配*/
+  image_value_set_value(w, 1101);
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(image_value->handles_nr, 2u);
+
+  image_value_set_value(w, 12);
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(image_value->handles_nr, 3u);
+  ASSERT_EQ(image_value->handles[2].chr, '2');
+  ASSERT_STREQ(image_value->handles[2].handle.name, "num_2");
+
+  widget_destroy(w);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
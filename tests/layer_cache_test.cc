@@ -0,0 +1,180 @@
+﻿#include "base/canvas.h"
+#include "widgets/view.h"
+#include "base/layer_cache.h"
+#include "lcd/lcd_mem_rgba8888.h"
+#include "gtest/gtest.h"
+
+static ret_t paint_frame(canvas_t* c, widget_t* widget) {
+  canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(widget, c);
+  return canvas_end_frame(c);
+}
+
+TEST(LayerCache, basic) {
+  canvas_t c;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_mem_rgba8888_create(100, 100, TRUE);
+  widget_t* root = view_create(NULL, 0, 0, 100, 100);
+  widget_t* layer = view_create(root, 10, 10, 50, 50);
+  widget_t* child = view_create(layer, 10, 10, 20, 20);
+  uint32_t hits = layer_cache_get_hits();
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  widget_set_style_color(layer, "normal:bg_color", 0xff0000ff);
+  widget_set_style_color(child, "normal:bg_color", 0xff00ff00);
+
+  ASSERT_EQ(widget_set_prop_bool(layer, WIDGET_PROP_CACHE_LAYER, TRUE), RET_OK);
+  ASSERT_EQ(widget_get_prop_bool(layer, WIDGET_PROP_CACHE_LAYER, FALSE), TRUE);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  /*第一次绘制后生成缓存*/
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), TRUE);
+  ASSERT_EQ(layer_cache_count(), 1u);
+  ASSERT_EQ(layer_cache_get_mem_size(), 50u * 50u * 4u);
+  ASSERT_EQ(layer_cache_get_hits(), hits);
+  ASSERT_EQ(lcd_get_point_color(lcd, 15, 15).rgba.r, 0xff);
+  ASSERT_EQ(lcd_get_point_color(lcd, 25, 25).rgba.g, 0xff);
+
+  /*以后用缓存绘制*/
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_get_hits(), hits + 1);
+  ASSERT_EQ(lcd_get_point_color(lcd, 15, 15).rgba.r, 0xff);
+  ASSERT_EQ(lcd_get_point_color(lcd, 25, 25).rgba.g, 0xff);
+
+  /*子控件改变后缓存失效*/
+  widget_set_style_color(child, "normal:bg_color", 0xffff0000);
+  widget_invalidate(child, NULL);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_get_hits(), hits + 1);
+  ASSERT_EQ(layer_cache_is_valid(layer), TRUE);
+  ASSERT_EQ(lcd_get_point_color(lcd, 25, 25).rgba.b, 0xff);
+
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_get_hits(), hits + 2);
+  ASSERT_EQ(lcd_get_point_color(lcd, 25, 25).rgba.b, 0xff);
+
+  widget_destroy(root);
+  ASSERT_EQ(layer_cache_count(), 0u);
+  ASSERT_EQ(layer_cache_get_mem_size(), 0u);
+
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
+TEST(LayerCache, partial) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 30, 30);
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_mem_rgba8888_create(100, 100, TRUE);
+  widget_t* root = view_create(NULL, 0, 0, 100, 100);
+  widget_t* layer = view_create(root, 10, 10, 50, 50);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  widget_set_style_color(layer, "normal:bg_color", 0xff0000ff);
+  widget_set_cache_layer(layer, TRUE);
+
+  /*控件没有完整的在绘制区域内时，不生成缓存*/
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+  widget_paint(root, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), TRUE);
+
+  widget_set_cache_layer(layer, FALSE);
+  ASSERT_EQ(layer_cache_count(), 0u);
+
+  widget_destroy(root);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
+TEST(LayerCache, max_mem_size) {
+  canvas_t c;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_mem_rgba8888_create(100, 100, TRUE);
+  widget_t* root = view_create(NULL, 0, 0, 100, 100);
+  widget_t* a = view_create(root, 0, 0, 50, 50);
+  widget_t* b = view_create(root, 50, 50, 50, 50);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  widget_set_style_color(a, "normal:bg_color", 0xff0000ff);
+  widget_set_style_color(b, "normal:bg_color", 0xff00ff00);
+  widget_set_cache_layer(a, TRUE);
+  widget_set_cache_layer(b, TRUE);
+  layer_cache_set_max_mem_size(50 * 50 * 4);
+
+  /*超过上限时淘汰最久没有使用的缓存*/
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(a), FALSE);
+  ASSERT_EQ(layer_cache_is_valid(b), TRUE);
+  ASSERT_EQ(layer_cache_get_mem_size(), 50u * 50u * 4u);
+
+  /*超过上限的层不缓存*/
+  layer_cache_set_max_mem_size(100);
+  ASSERT_EQ(layer_cache_get_mem_size(), 0u);
+  widget_invalidate(root, NULL);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(a), FALSE);
+  ASSERT_EQ(layer_cache_is_valid(b), FALSE);
+
+  layer_cache_set_max_mem_size(TK_LAYER_CACHE_MEM_SIZE);
+  widget_destroy(root);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
+TEST(LayerCache, opaque) {
+  canvas_t c;
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_mem_rgba8888_create(100, 100, TRUE);
+  widget_t* root = view_create(NULL, 0, 0, 100, 100);
+  widget_t* layer = view_create(root, 10, 10, 50, 50);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  widget_set_style_color(root, "normal:bg_color", 0xff0000ff);
+  widget_set_cache_layer(layer, TRUE);
+
+  /*没有背景色时会把下面的内容一起保存，不缓存*/
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  /*背景色半透明*/
+  widget_set_style_color(layer, "normal:bg_color", 0x8000ff00);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  /*控件半透明*/
+  widget_set_style_color(layer, "normal:bg_color", 0xff00ff00);
+  widget_set_opacity(layer, 0x80);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  /*有圆角*/
+  widget_set_opacity(layer, 0xff);
+  widget_set_style_int(layer, "normal:round_radius", 5);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), FALSE);
+
+  widget_set_style_int(layer, "normal:round_radius", 0);
+  paint_frame(&c, root);
+  ASSERT_EQ(layer_cache_is_valid(layer), TRUE);
+
+  /*下面的内容改变后，缓存的内容仍然正确*/
+  widget_set_style_color(root, "normal:bg_color", 0xffff0000);
+  widget_invalidate(root, NULL);
+  paint_frame(&c, root);
+  ASSERT_EQ(lcd_get_point_color(lcd, 5, 5).rgba.b, 0xff);
+  ASSERT_EQ(lcd_get_point_color(lcd, 15, 15).rgba.g, 0xff);
+
+  widget_destroy(root);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
@@ -1,8 +1,12 @@
 ﻿#include "scroll_view/list_view.h"
+#include "scroll_view/list_item.h"
+#include "scroll_view/scroll_bar.h"
+#include "scroll_view/scroll_view.h"
 #include "base/canvas.h"
 #include "base/widget.h"
 #include "base/layout.h"
 #include "widgets/button.h"
+#include "widgets/window.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
 #include "gtest/gtest.h"
@@ -37,3 +41,91 @@ TEST(ListView, cast) {
 
   widget_destroy(w);
 }
+
+static uint32_t s_bind_times = 0;
+static ret_t on_bind_item(void* ctx, widget_t* item, uint32_t index) {
+  s_bind_times++;
+  widget_set_prop_int(item, "index", index);
+
+  return RET_OK;
+}
+
+static void check_virtual_items(widget_t* widget, int32_t yoffset) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  widget_t* view = list_view->scroll_view;
+
+  /*可见区域内的每一行都有绑定了正确数据的列表项*/
+  for (int32_t y = yoffset; y < yoffset + view->h; y += 10) {
+    bool_t found = FALSE;
+    int32_t row = y / 40;
+
+    WIDGET_FOR_EACH_CHILD_BEGIN(view, iter, i)
+    if (iter->visible && list_view_get_item_index(widget, iter) == row) {
+      ASSERT_EQ(iter->y, row * 40);
+      ASSERT_EQ(iter->h, 40);
+      ASSERT_EQ(widget_get_prop_int(iter, "index", -1), row);
+      found = TRUE;
+    }
+    WIDGET_FOR_EACH_CHILD_END();
+    ASSERT_EQ(found, TRUE);
+  }
+}
+
+TEST(ListView, virtual) {
+  widget_t* win = window_create(NULL, 0, 0, 0, 0);
+  widget_t* widget = list_view_create(win, 0, 0, 200, 400);
+  widget_t* view = scroll_view_create(widget, 0, 0, 200, 400);
+  widget_t* bar = scroll_bar_create_mobile(widget, 190, 0, 10, 400);
+
+  list_item_create(view, 0, 0, 0, 0);
+  list_view_set_item_height(widget, 40);
+
+  s_bind_times = 0;
+  ASSERT_EQ(list_view_set_virtual(widget, 10000, on_bind_item, NULL), RET_OK);
+  widget_layout(widget);
+
+  /*只创建可见的列表项和少量预留的列表项*/
+  ASSERT_EQ(widget_count_children(view) < 20, true);
+  ASSERT_EQ(SCROLL_VIEW(view)->virtual_h, 400000);
+  ASSERT_EQ(SCROLL_BAR(bar)->virtual_size, 400000);
+  check_virtual_items(widget, 0);
+
+  /*滚动一行只需要重新绑定一个列表项*/
+  s_bind_times = 0;
+  widget_set_prop_int(view, WIDGET_PROP_YOFFSET, 40 * 100);
+  check_virtual_items(widget, 40 * 100);
+  s_bind_times = 0;
+  widget_set_prop_int(view, WIDGET_PROP_YOFFSET, 40 * 101);
+  ASSERT_EQ(s_bind_times, 1);
+  check_virtual_items(widget, 40 * 101);
+
+  widget_set_prop_int(view, WIDGET_PROP_YOFFSET, 400000 - 400);
+  check_virtual_items(widget, 400000 - 400);
+
+  /*减少个数时保持在范围内*/
+  ASSERT_EQ(list_view_set_item_count(widget, 20), RET_OK);
+  ASSERT_EQ(SCROLL_VIEW(view)->virtual_h, 800);
+  ASSERT_EQ(SCROLL_VIEW(view)->yoffset, 400);
+  check_virtual_items(widget, 400);
+
+  /*重新布局时保持滚动的位置*/
+  widget_layout(view);
+  ASSERT_EQ(SCROLL_VIEW(view)->yoffset, 400);
+  ASSERT_EQ(SCROLL_BAR(bar)->value, 800);
+  check_virtual_items(widget, 400);
+
+  ASSERT_EQ(list_view_set_item_count(widget, 3), RET_OK);
+  ASSERT_EQ(SCROLL_VIEW(view)->virtual_h, 400);
+  ASSERT_EQ(SCROLL_VIEW(view)->yoffset, 0);
+  WIDGET_FOR_EACH_CHILD_BEGIN(view, iter, i)
+  int32_t index = list_view_get_item_index(widget, iter);
+  ASSERT_EQ(iter->visible, index >= 0);
+  ASSERT_EQ(index < 3, true);
+  WIDGET_FOR_EACH_CHILD_END();
+
+  s_bind_times = 0;
+  ASSERT_EQ(list_view_reload(widget), RET_OK);
+  ASSERT_EQ(s_bind_times, 3);
+
+  widget_destroy(win);
+}
@@ -0,0 +1,83 @@
+﻿#include "tkc/lz4.h"
+#include "tkc/mem.h"
+#include "gtest/gtest.h"
+#include <stdlib.h>
+
+static void test_round_trip(const uint8_t* data, uint32_t size) {
+  uint32_t capacity = lz4_compress_bound(size);
+  uint8_t* compressed = (uint8_t*)TKMEM_ALLOC(capacity);
+  uint8_t* decompressed = (uint8_t*)TKMEM_ALLOC(size + 1);
+  int32_t compressed_size = lz4_compress(data, size, compressed, capacity);
+
+  ASSERT_GT(compressed_size, 0);
+  ASSERT_LE((uint32_t)compressed_size, capacity);
+  ASSERT_EQ(lz4_decompress(compressed, compressed_size, decompressed, size), (int32_t)size);
+  ASSERT_EQ(memcmp(data, decompressed, size), 0);
+
+  /*输出缓冲区不够时失败*/
+  if (size > 0) {
+    ASSERT_EQ(lz4_decompress(compressed, compressed_size, decompressed, size - 1), -1);
+  }
+
+  TKMEM_FREE(compressed);
+  TKMEM_FREE(decompressed);
+}
+
+TEST(Lz4, small) {
+  const char* str = "hello";
+
+  test_round_trip((const uint8_t*)"", 0);
+  test_round_trip((const uint8_t*)str, strlen(str));
+  test_round_trip((const uint8_t*)"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 50);
+}
+
+TEST(Lz4, repeat) {
+  uint32_t i = 0;
+  uint32_t size = 100 * 1024;
+  uint8_t* data = (uint8_t*)TKMEM_ALLOC(size);
+  uint8_t* compressed = (uint8_t*)TKMEM_ALLOC(lz4_compress_bound(size));
+
+  for (i = 0; i < size; i++) {
+    data[i] = (i / 64) % 7;
+  }
+  test_round_trip(data, size);
+
+  /*重复的数据压缩率很高*/
+  ASSERT_LT(lz4_compress(data, size, compressed, lz4_compress_bound(size)), (int32_t)(size / 20));
+
+  TKMEM_FREE(data);
+  TKMEM_FREE(compressed);
+}
+
+TEST(Lz4, random) {
+  uint32_t i = 0;
+  uint32_t size = 70 * 1024;
+  uint8_t* data = (uint8_t*)TKMEM_ALLOC(size);
+
+  srand(1234);
+  for (i = 0; i < size; i++) {
+    data[i] = rand() & 0xff;
+  }
+  test_round_trip(data, size);
+
+  /*随机数据夹杂重复的数据，匹配的距离超过64K时不能匹配*/
+  for (i = 0; i < size; i += 1000) {
+    memset(data + i, 0x55, 300);
+  }
+  test_round_trip(data, size);
+
+  TKMEM_FREE(data);
+}
+
+TEST(Lz4, corrupted) {
+  uint8_t out[64];
+  const uint8_t bad_offset[] = {0x14, 'a', 0x05, 0x00};
+  const uint8_t bad_literals[] = {0xf0, 0xff, 'a'};
+  const uint8_t truncated[] = {0x14, 'a', 0x01};
+
+  ASSERT_EQ(lz4_decompress(bad_offset, sizeof(bad_offset), out, sizeof(out)), -1);
+  ASSERT_EQ(lz4_decompress(bad_literals, sizeof(bad_literals), out, sizeof(out)), -1);
+  ASSERT_EQ(lz4_decompress(truncated, sizeof(truncated), out, sizeof(out)), -1);
+
+  ASSERT_EQ(lz4_compress((const uint8_t*)"0123456789abcdef", 16, out, 4), -1);
+}
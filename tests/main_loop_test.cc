@@ -0,0 +1,226 @@
+﻿#include "base/idle.h"
+#include "base/timer.h"
+#include "base/timer_manager.h"
+#include "tkc/thread.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
+#include "base/main_loop.h"
+#include "base/window_manager.h"
+#include "main_loop/main_loop_simple.h"
+#include "gtest/gtest.h"
+
+static void main_loop_test_init(main_loop_t* l) {
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+
+  memset(l, 0x00, sizeof(main_loop_t));
+  l->wm = window_manager();
+  l->wm->need_relayout_children = FALSE;
+  l->wm->need_relayout_descendants = FALSE;
+  wm->animating = FALSE;
+  wm->last_paint_cost = 0;
+  dirty_rects_reset(&(wm->dirty_rects));
+}
+
+TEST(MainLoop, fps) {
+  main_loop_t l;
+  main_loop_test_init(&l);
+
+  ASSERT_EQ(main_loop_set_fps(&l, 50), RET_OK);
+  ASSERT_EQ(l.frame_interval, 20u);
+
+  ASSERT_EQ(main_loop_begin_frame(&l, 1000), RET_OK);
+  ASSERT_EQ(l.frame_deadline, 1020u);
+  ASSERT_EQ(l.next_frame_time, 1020u);
+
+  /*帧内提前结束时按固定节拍前进*/
+  ASSERT_EQ(main_loop_begin_frame(&l, 1022), RET_OK);
+  ASSERT_EQ(l.next_frame_time, 1040u);
+
+  /*落后超过一帧时重新对齐*/
+  ASSERT_EQ(main_loop_begin_frame(&l, 2000), RET_OK);
+  ASSERT_EQ(l.next_frame_time, 2020u);
+
+  ASSERT_EQ(main_loop_set_fps(&l, 0), RET_OK);
+  ASSERT_EQ(l.frame_interval, 0u);
+}
+
+TEST(MainLoop, sleep_time) {
+  main_loop_t l;
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+  main_loop_test_init(&l);
+
+  main_loop_set_fps(&l, 50);
+  main_loop_set_idle_sleep_time(&l, 500);
+  main_loop_begin_frame(&l, 1000);
+
+  ASSERT_EQ(main_loop_need_paint(&l), FALSE);
+  ASSERT_LE(main_loop_calc_sleep_time(&l, time_now_ms()), 500u);
+
+  /*需要绘制时睡眠到下一帧开始*/
+  wm->animating = TRUE;
+  ASSERT_EQ(main_loop_need_paint(&l), TRUE);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, 1005), 15u);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, 1020), 0u);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, 1030), 0u);
+  wm->animating = FALSE;
+
+  l.wm->need_relayout_descendants = TRUE;
+  ASSERT_EQ(main_loop_need_paint(&l), TRUE);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, 1010), 10u);
+  l.wm->need_relayout_descendants = FALSE;
+}
+
+static ret_t on_timer_nothing(const timer_info_t* info) {
+  return RET_REMOVE;
+}
+
+static uint32_t s_timer_now = 1000;
+static uint32_t timer_get_time_fake(void) {
+  return s_timer_now;
+}
+
+static ret_t wait_nothing(main_loop_t* l, uint32_t timeout_ms) {
+  return RET_FAIL;
+}
+
+TEST(MainLoop, idle_sleep_time) {
+  main_loop_t l;
+  timer_manager_t* old_tm = timer_manager();
+  timer_manager_t* tm = timer_manager_create(timer_get_time_fake);
+  main_loop_test_init(&l);
+
+  timer_manager_set(tm);
+  timer_add(on_timer_nothing, NULL, 300);
+
+  /*不能被唤醒时，空闲时也要定时醒来*/
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, s_timer_now), (uint32_t)TK_MAX_IDLE_SLEEP_TIME);
+
+  /*能被唤醒时一直睡眠到下一个定时器*/
+  l.wait = wait_nothing;
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, s_timer_now), 300u);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, s_timer_now + 400), 0u);
+
+  main_loop_set_idle_sleep_time(&l, 50);
+  ASSERT_EQ(main_loop_calc_sleep_time(&l, s_timer_now), 50u);
+
+  timer_manager_set(old_tm);
+  timer_manager_destroy(tm);
+}
+
+TEST(MainLoop, idle_postpone) {
+  uint32_t i = 0;
+  main_loop_t l;
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+  main_loop_test_init(&l);
+
+  main_loop_set_fps(&l, 50);
+  main_loop_begin_frame(&l, 1000);
+  wm->last_paint_cost = 10;
+
+  /*不需要绘制时总是分发idle*/
+  ASSERT_EQ(main_loop_should_dispatch_idle(&l, 1015), TRUE);
+
+  wm->animating = TRUE;
+  ASSERT_EQ(main_loop_should_dispatch_idle(&l, 1005), TRUE);
+
+  for (i = 0; i < TK_MAX_IDLE_POSTPONE; i++) {
+    ASSERT_EQ(main_loop_should_dispatch_idle(&l, 1015), FALSE);
+  }
+  ASSERT_EQ(main_loop_should_dispatch_idle(&l, 1015), TRUE);
+  ASSERT_EQ(main_loop_should_dispatch_idle(&l, 1015), FALSE);
+
+  wm->animating = FALSE;
+  wm->last_paint_cost = 0;
+}
+
+TEST(MainLoop, vsync) {
+  main_loop_t l;
+  main_loop_test_init(&l);
+
+  ASSERT_EQ(main_loop_set_vsync(&l, TRUE), RET_OK);
+  ASSERT_EQ(l.vsync, TRUE);
+
+  ASSERT_EQ(main_loop_notify_vsync(&l), RET_OK);
+  ASSERT_EQ(main_loop_notify_vsync(&l), RET_OK);
+  ASSERT_EQ(l.vsync_count, 2u);
+  ASSERT_EQ(l.last_vsync_count, 0u);
+
+  ASSERT_EQ(main_loop_set_vsync(&l, FALSE), RET_OK);
+  ASSERT_EQ(l.last_vsync_count, 2u);
+}
+
+static void* post_key_entry(void* args) {
+  sleep_ms(20);
+  main_loop_post_key_event((main_loop_t*)args, TRUE, TK_KEY_a);
+
+  return NULL;
+}
+
+TEST(MainLoop, wakeup) {
+  uint32_t start = 0;
+  event_queue_req_t r;
+  main_loop_simple_t* loop = main_loop_simple_init(100, 100);
+  main_loop_t* l = (main_loop_t*)loop;
+  tk_thread_t* thread = tk_thread_create(post_key_entry, l);
+
+  ASSERT_TRUE(l->wait != NULL && l->wakeup != NULL);
+
+  /*其它线程发送事件时唤醒睡眠中的GUI线程*/
+  start = time_now_ms();
+  tk_thread_start(thread);
+  ASSERT_EQ(l->wait(l, 5000), RET_OK);
+  ASSERT_LT(time_now_ms() - start, 2000u);
+  tk_thread_join(thread);
+  tk_thread_destroy(thread);
+  ASSERT_EQ(event_queue_mpsc_recv(loop->queue, &r), RET_OK);
+  ASSERT_EQ(r.event.type, EVT_KEY_DOWN);
+
+  /*没有唤醒时等到超时*/
+  ASSERT_EQ(l->wait(l, 10), RET_FAIL);
+
+  /*GUI线程自己发送时，队列满了不等待*/
+  main_loop_simple_set_send_timeout(loop, 2000);
+  memset(&r, 0x00, sizeof(r));
+  r.event.type = EVT_KEY_DOWN;
+  while (main_loop_queue_event(l, &r) == RET_OK) {
+  }
+  start = time_now_ms();
+  ASSERT_EQ(main_loop_queue_event(l, &r), RET_FAIL);
+  ASSERT_LT(time_now_ms() - start, 1000u);
+
+  main_loop_simple_reset(loop);
+  main_loop_set(NULL);
+}
+
+static void* notify_vsync_entry(void* args) {
+  sleep_ms(20);
+  main_loop_notify_vsync((main_loop_t*)args);
+
+  return NULL;
+}
+
+TEST(MainLoop, wait_vsync) {
+  uint32_t start = 0;
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+  main_loop_simple_t* loop = main_loop_simple_init(100, 100);
+  main_loop_t* l = (main_loop_t*)loop;
+  tk_thread_t* thread = tk_thread_create(notify_vsync_entry, l);
+
+  /*每帧1秒，收到垂直同步信号时立即醒来，而不是等到超时*/
+  main_loop_set_fps(l, 1);
+  main_loop_set_vsync(l, TRUE);
+  wm->animating = TRUE;
+  start = time_now_ms();
+  l->next_frame_time = start;
+
+  tk_thread_start(thread);
+  ASSERT_EQ(main_loop_sleep(l), RET_OK);
+  ASSERT_LT(time_now_ms() - start, 1000u);
+  ASSERT_EQ(l->last_vsync_count, 1u);
+  tk_thread_join(thread);
+  tk_thread_destroy(thread);
+
+  wm->animating = FALSE;
+  main_loop_simple_reset(loop);
+  main_loop_set(NULL);
+}
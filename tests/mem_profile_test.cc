@@ -0,0 +1,97 @@
+﻿#include "tkc/mem.h"
+#include "gtest/gtest.h"
+
+static const mem_site_stat_t* find_site(const mem_site_stat_t* sites, uint32_t nr,
+                                        uint32_t line) {
+  for (uint32_t i = 0; i < nr; i++) {
+    if (sites[i].line == line && strcmp(sites[i].func, "alloc_at") == 0) {
+      return sites + i;
+    }
+  }
+
+  return NULL;
+}
+
+static uint32_t s_line1 = 0;
+static uint32_t s_line2 = 0;
+
+static void* alloc_at(uint32_t which, uint32_t size) {
+  if (which == 1) {
+    s_line1 = __LINE__ + 1;
+    return TKMEM_ALLOC(size);
+  } else {
+    s_line2 = __LINE__ + 1;
+    return TKMEM_CALLOC(1, size);
+  }
+}
+
+TEST(MemProfile, basic) {
+  void* p[10];
+  uint32_t nr = 0;
+  mem_site_stat_t sites[256];
+  const mem_site_stat_t* s1 = NULL;
+  const mem_site_stat_t* s2 = NULL;
+
+  /*开始之前分配的内存不参与统计*/
+  void* before = TKMEM_ALLOC(10);
+  ASSERT_EQ(tk_mem_profile_start(), RET_OK);
+  TKMEM_FREE(before);
+
+  for (uint32_t i = 0; i < 10; i++) {
+    p[i] = alloc_at(i < 8 ? 1 : 2, 100);
+  }
+
+  nr = tk_mem_profile_get_sites(sites, ARRAY_SIZE(sites));
+  s1 = find_site(sites, nr, s_line1);
+  s2 = find_site(sites, nr, s_line2);
+  ASSERT_EQ(s1 != NULL && s2 != NULL, true);
+  ASSERT_EQ(s1->live_bytes, 800);
+  ASSERT_EQ(s1->live_nr, 8);
+  ASSERT_EQ(s1->calls, 8);
+  ASSERT_EQ(s2->live_bytes, 200);
+  /*按live_bytes排序*/
+  ASSERT_EQ(s1 < s2, true);
+
+  for (uint32_t i = 0; i < 5; i++) {
+    TKMEM_FREE(p[i]);
+  }
+  p[5] = TKMEM_REALLOC(p[5], 300);
+
+  nr = tk_mem_profile_get_sites(sites, ARRAY_SIZE(sites));
+  s1 = find_site(sites, nr, s_line1);
+  ASSERT_EQ(s1->live_bytes, 200);
+  ASSERT_EQ(s1->live_nr, 2);
+  ASSERT_EQ(s1->peak_bytes, 800);
+  ASSERT_EQ(tk_mem_profile_dump(10), RET_OK);
+
+  /*快照比较：全部释放后，两个分配位置和realloc的位置都发生了变化*/
+  for (uint32_t i = 5; i < 10; i++) {
+    TKMEM_FREE(p[i]);
+  }
+  ASSERT_EQ(tk_mem_profile_dump_diff(sites, nr), 3);
+  ASSERT_EQ(tk_mem_profile_get_sites(sites, ARRAY_SIZE(sites)), nr);
+  ASSERT_EQ(tk_mem_profile_dump_diff(sites, nr), 0);
+
+  ASSERT_EQ(tk_mem_profile_stop(), RET_OK);
+}
+
+TEST(MemProfile, frame) {
+  void* p[100];
+
+  ASSERT_EQ(tk_mem_profile_start(), RET_OK);
+  tk_mem_profile_begin_frame();
+  for (uint32_t i = 0; i < 100; i++) {
+    p[i] = alloc_at(1, i + 1);
+  }
+  ASSERT_EQ(tk_mem_profile_get_frame_alloc_nr(), 0);
+
+  tk_mem_profile_begin_frame();
+  ASSERT_EQ(tk_mem_profile_get_frame_alloc_nr(), 100);
+  for (uint32_t i = 0; i < 100; i++) {
+    TKMEM_FREE(p[i]);
+  }
+
+  tk_mem_profile_begin_frame();
+  ASSERT_EQ(tk_mem_profile_get_frame_alloc_nr(), 0);
+  ASSERT_EQ(tk_mem_profile_stop(), RET_OK);
+}
@@ -50,26 +50,33 @@ void check_zero(void* ptr, uint32_t size) {
 int main() {
   mem_stack_t s;
   uint32_t i = 0;
+  mem_stat_t st;
+  mem_stat_t base;
   uint32_t nr = 10000 * 10000;
 
   srand(time(0));
   mem_stack_init(&s);
   tk_mem_init(s_heap_mem, sizeof(s_heap_mem));
 
+  /*stdio的缓冲区也从这里分配，先打印一次，以此时的状态为基准*/
+  tk_mem_dump();
+  base = tk_mem_stat();
+
   tk_free(TKMEM_ALLOC(100));
 
   for (i = 0; i < nr; i++) {
-    uint32_t size = rand() % 100;
+    uint32_t size = (i % 8) ? rand() % 300 : rand() % 4096;
     void* ptr = TKMEM_CALLOC(size, 1);
 
-    check_zero(ptr, size);
     if (ptr != NULL) {
+      check_zero(ptr, size);
       if (mem_stack_has_space(&s)) {
         mem_stack_push(&s, ptr);
       } else {
         TKMEM_FREE(ptr);
       }
     } else {
+      /*内存不足是预期的，释放一半后继续*/
       mem_stack_free_n(&s, s.top >> 1);
     }
   }
@@ -77,5 +84,13 @@ int main() {
   mem_stack_free_n(&s, s.top);
   tk_mem_dump();
 
+  /*全部释放后，空闲内存应该合并成一块*/
+  st = tk_mem_stat();
+  assert(st.used_bytes == base.used_bytes);
+  assert(st.used_block_nr == base.used_block_nr);
+  assert(st.slab_bytes == base.slab_bytes);
+  assert(st.free_block_nr == base.free_block_nr);
+  assert(st.max_free_block == base.max_free_block);
+
   return 0;
 }
@@ -18,6 +18,47 @@ TEST(StyleConst, basic) {
   widget_destroy(w);
 }
 
+TEST(StyleConst, prop_id) {
+  uint32_t i = 0;
+
+  for (i = 0; i < STYLE_PROP_NR; i++) {
+    const char* name = style_prop_name((style_prop_id_t)i);
+    ASSERT_EQ(name != NULL, true);
+    ASSERT_EQ(style_prop_id(name), (style_prop_id_t)i);
+  }
+
+  ASSERT_EQ(style_prop_id(STYLE_ID_BG_COLOR), STYLE_PROP_BG_COLOR);
+  ASSERT_EQ(style_prop_id(STYLE_ID_ROUND_RADIUS), STYLE_PROP_ROUND_RADIUS);
+  ASSERT_EQ(style_prop_id("not_a_style"), STYLE_PROP_NR);
+  ASSERT_EQ(style_prop_id(""), STYLE_PROP_NR);
+  ASSERT_EQ(style_prop_name(STYLE_PROP_NR) == NULL, true);
+}
+
+TEST(StyleConst, by_id) {
+  uint32_t i = 0;
+  color_t trans = color_init(0, 0, 0, 0);
+  widget_t* w = window_create(NULL, 10, 20, 30, 40);
+  widget_t* b = button_create(w, 0, 0, 10, 10);
+  style_t* s = style_const_create(b);
+
+  style_notify_widget_state_changed(s, b);
+  for (i = 0; i < STYLE_PROP_NR; i++) {
+    style_prop_id_t id = (style_prop_id_t)i;
+    const char* name = style_prop_name(id);
+    const char* str = style_get_str(s, name, NULL);
+    const char* str_by_id = style_get_str_by_id(s, id, NULL);
+
+    ASSERT_EQ(style_get_int_by_id(s, id, -1), style_get_int(s, name, -1));
+    ASSERT_EQ(style_get_color_by_id(s, id, trans).color, style_get_color(s, name, trans).color);
+    ASSERT_EQ(string(str_by_id != NULL ? str_by_id : ""), string(str != NULL ? str : ""));
+  }
+
+  ASSERT_EQ(style_get_int(s, "not_a_style", 123), 123);
+
+  style_destroy(s);
+  widget_destroy(w);
+}
+
 TEST(StyleConst, combo_box_item) {
   const char* icon = NULL;
   widget_t* w = window_create(NULL, 10, 20, 30, 40);
@@ -1,4 +1,8 @@
-﻿#include "widgets/window.h"
+﻿#include "base/canvas.h"
+#include "widgets/view.h"
+#include "widgets/window.h"
+#include "base/image_manager.h"
+#include "lcd/lcd_mem_rgba8888.h"
 #include "svg_image/svg_image.h"
 #include "gtest/gtest.h"
 
@@ -26,3 +30,79 @@ TEST(SvgImage, cast) {
 
   widget_destroy(w);
 }
+
+#ifdef WITH_NANOVG_SOFT
+static ret_t paint_svg(canvas_t* c, widget_t* widget) {
+  rect_t r = rect_init(0, 0, widget->w, widget->h);
+
+  canvas_begin_frame(c, &r, LCD_DRAW_NORMAL);
+  canvas_set_fill_color(c, color_init(0, 0, 0xff, 0xff));
+  canvas_fill_rect(c, 0, 0, widget->w, widget->h);
+  widget_paint(widget, c);
+
+  return canvas_end_frame(c);
+}
+
+TEST(SvgImage, cache) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  canvas_t c;
+  uint8_t* direct = NULL;
+  image_manager_stats_t stats;
+  font_manager_t font_manager;
+  image_manager_t* imm = image_manager();
+  lcd_t* lcd = lcd_mem_rgba8888_create(200, 200, TRUE);
+  widget_t* root = view_create(NULL, 0, 0, 200, 200);
+  widget_t* img1 = svg_image_create(root, 0, 0, 200, 200);
+  widget_t* img2 = svg_image_create(NULL, 0, 0, 200, 200);
+  uint32_t size = 200 * 200 * 4;
+  uint32_t nr = 0;
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  image_base_set_image(img1, "ball");
+  image_base_set_image(img2, "ball");
+  image_manager_unload_unused(imm, 0);
+  nr = imm->stats.nr;
+
+  /*第一次绘制时光栅化，同一图片的控件共享*/
+  paint_svg(&c, img1);
+  ASSERT_EQ(imm->stats.nr, nr + 1);
+  image_manager_get_stats(imm, &stats);
+  paint_svg(&c, img2);
+  ASSERT_EQ(imm->stats.nr, nr + 1);
+  ASSERT_EQ(imm->stats.hits, stats.hits + 1);
+
+  /*变换参数在变化时直接用矢量绘制*/
+  image_base_set_scale(img2, 0.5f, 0.5f);
+  image_base_set_rotation(img2, 0.1f);
+  paint_svg(&c, img2);
+  ASSERT_EQ(imm->stats.nr, nr + 1);
+  paint_svg(&c, img2);
+  ASSERT_EQ(imm->stats.nr, nr + 2);
+
+  /*与矢量绘制的结果一致(只有边缘的抗锯齿有舍入误差)*/
+  direct = (uint8_t*)TKMEM_ALLOC(size);
+  image_manager_unload_unused(imm, 0);
+  SVG_IMAGE(img1)->cache_key = 1;
+  paint_svg(&c, img1);
+  ASSERT_EQ(imm->stats.nr, nr);
+  memcpy(direct, ((lcd_mem_t*)lcd)->offline_fb, size);
+
+  paint_svg(&c, img1);
+  ASSERT_EQ(imm->stats.nr, nr + 1);
+  for (y = 0; y < 200; y++) {
+    for (x = 0; x < 200 * 4; x++) {
+      uint32_t i = y * 200 * 4 + x;
+      ASSERT_LE(tk_abs(direct[i] - ((lcd_mem_t*)lcd)->offline_fb[i]), 8);
+    }
+  }
+
+  TKMEM_FREE(direct);
+  image_manager_unload_unused(imm, 0);
+  widget_destroy(root);
+  widget_destroy(img2);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+#endif /*WITH_NANOVG_SOFT*/
@@ -33,6 +33,79 @@ TEST(ThemeGen, basic) {
   ASSERT_EQ(style_data_get_int(style_data, STYLE_ID_FG_COLOR, 0), 0x7f00ffff);
 }
 
+TEST(ThemeGen, index) {
+  uint8_t buff[1024];
+  theme_t theme;
+  uint8_t index[STYLE_PROP_NR];
+  uint8_t index_by_name[STYLE_PROP_NR];
+  const uint8_t* style_data = NULL;
+  const char* str =
+      "<button><style><normal bg_color=\"yellow\" my_size=\"3\" font_name=\"sans\" font_size=\"12\" icon=\"ok\" /></style></button>";
+
+  xml_gen_buff(str, buff, sizeof(buff));
+  theme.data = buff;
+  ASSERT_EQ(((const theme_header_t*)buff)->version, THEME_VERSION);
+
+  style_data = theme_find_style(&theme, WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  ASSERT_EQ(style_data != NULL, true);
+  ASSERT_EQ(style_data_build_index(style_data, TRUE, index, STYLE_PROP_NR), RET_OK);
+  ASSERT_EQ(style_data_build_index(style_data, FALSE, index_by_name, STYLE_PROP_NR), RET_OK);
+  ASSERT_EQ(memcmp(index, index_by_name, sizeof(index)), 0);
+
+  ASSERT_EQ(index[STYLE_PROP_BORDER], 0);
+  ASSERT_EQ(index[STYLE_PROP_FONT_NAME] & STYLE_DATA_INDEX_STR, STYLE_DATA_INDEX_STR);
+  ASSERT_EQ(index[STYLE_PROP_FONT_SIZE] & STYLE_DATA_INDEX_STR, 0);
+  ASSERT_EQ(style_data_get_int_at(style_data, index[STYLE_PROP_FONT_SIZE] - 1, 0), 12);
+  ASSERT_EQ(style_data_get_int_at(style_data, index[STYLE_PROP_BG_COLOR] - 1, 0), 0xff00ffff);
+  ASSERT_EQ(string(style_data_get_str_at(
+                style_data, (index[STYLE_PROP_ICON] & ~STYLE_DATA_INDEX_STR) - 1, "")),
+            string("ok"));
+  ASSERT_EQ(style_data_get_int(style_data, "my_size", 0), 3);
+}
+
+TEST(ThemeGen, custom_prop_id) {
+  uint32_t i = 0;
+  uint32_t int_nr = 0;
+  uint32_t str_nr = 0;
+  uint8_t buff[1024];
+  theme_t theme;
+  uint8_t index[0x100];
+  const uint8_t* p = NULL;
+  const uint8_t* ids = NULL;
+  const style_int_data_t* ints = NULL;
+  const char* str =
+      "<button><style><normal bg_color=\"yellow\" my_size=\"3\" my_icon=\"ok\" /></style></button>";
+
+  xml_gen_buff(str, buff, sizeof(buff));
+  theme.data = buff;
+  p = theme_find_style(&theme, WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  ASSERT_EQ(p != NULL, true);
+
+  int_nr = *(const uint32_t*)p;
+  ints = (const style_int_data_t*)(p + sizeof(uint32_t));
+  str_nr = *(const uint32_t*)(ints + int_nr);
+  ids = (const uint8_t*)(ints + int_nr) + sizeof(uint32_t) + str_nr * sizeof(style_str_data_t);
+  ASSERT_EQ(int_nr, 2u);
+  ASSERT_EQ(str_nr, 1u);
+
+  /*自定义属性保存为STYLE_PROP_ID_UNKNOWN*/
+  for (i = 0; i < int_nr; i++) {
+    if (string(ints[i].name) == "my_size") {
+      ASSERT_EQ(ids[i], STYLE_PROP_ID_UNKNOWN);
+    } else {
+      ASSERT_EQ(ids[i], STYLE_PROP_BG_COLOR);
+    }
+  }
+  ASSERT_EQ(ids[int_nr], STYLE_PROP_ID_UNKNOWN);
+
+  /*以后追加的ID不会指向自定义属性*/
+  ASSERT_EQ(style_data_build_index(p, TRUE, index, sizeof(index)), RET_OK);
+  for (i = STYLE_PROP_NR; i < sizeof(index); i++) {
+    ASSERT_EQ(index[i], 0);
+  }
+  ASSERT_EQ(style_data_get_int_at(p, index[STYLE_PROP_BG_COLOR] - 1, 0), 0xff00ffff);
+}
+
 TEST(ThemeGen, state) {
   uint8_t buff[1024];
   theme_t theme;
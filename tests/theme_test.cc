@@ -124,3 +124,71 @@ TEST(Theme, basic) {
     }
   }
 }
+
+TEST(Theme, sorted) {
+  uint8_t buff[40 * 10240];
+  theme_t t;
+  theme_t linear;
+  const uint8_t* style_data;
+  theme_header_t* header = (theme_header_t*)buff;
+  uint8_t* linear_buff = (uint8_t*)malloc(sizeof(buff));
+
+  GenThemeData(buff, sizeof(buff), 5, 2);
+  ASSERT_EQ(header->version, THEME_VERSION);
+  memcpy(linear_buff, buff, sizeof(buff));
+  ((theme_header_t*)linear_buff)->version = 0;
+
+  t.data = buff;
+  linear.data = linear_buff;
+
+  const theme_item_t* items = (const theme_item_t*)(buff + sizeof(theme_header_t));
+  for (uint32_t i = 1; i < header->nr; i++) {
+    const theme_item_t* iter = items + i;
+    ASSERT_EQ(theme_item_cmp(iter - 1, iter->widget_type, iter->name, iter->state) <= 0, true);
+  }
+
+  for (int32_t i = 0; widget_types[i]; i++) {
+    const char* type = widget_types[i];
+    for (uint32_t state = 0; state_names[state]; state++) {
+      style_data = theme_find_style(&t, type, TK_DEFAULT_STYLE, state_names[state]);
+      ASSERT_EQ(style_data != NULL, true);
+      ASSERT_EQ(style_data - buff,
+                theme_find_style(&linear, type, TK_DEFAULT_STYLE, state_names[state]) -
+                    linear_buff);
+    }
+    ASSERT_EQ(theme_find_style(&t, type, "none", WIDGET_STATE_NORMAL) == NULL, true);
+    ASSERT_EQ(theme_find_style(&t, type, TK_DEFAULT_STYLE, "none") == NULL, true);
+  }
+
+  ASSERT_EQ(theme_find_style(&t, "aaa", TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL) == NULL, true);
+  ASSERT_EQ(theme_find_style(&t, "zzz", TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL) == NULL, true);
+
+  free(linear_buff);
+}
+
+TEST(Theme, sortedFirst) {
+  uint8_t buff[10240];
+  theme_t t;
+  ThemeGen g;
+  Style s1(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  Style s2(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  Style s3(WIDGET_TYPE_LABEL, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+
+  s1.AddInt("value", 1);
+  s2.AddInt("value", 2);
+  s3.AddInt("value", 3);
+  g.AddStyle(s3);
+  g.AddStyle(s1);
+  g.AddStyle(s2);
+  g.Output(buff, sizeof(buff));
+  t.data = buff;
+
+  ASSERT_EQ(style_data_get_int(
+                theme_find_style(&t, WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL),
+                "value", 0),
+            1);
+  ASSERT_EQ(style_data_get_int(
+                theme_find_style(&t, WIDGET_TYPE_LABEL, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL),
+                "value", 0),
+            3);
+}
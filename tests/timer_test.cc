@@ -223,3 +223,114 @@ TEST(Timer, UserChangedTime) {
 
   timer_manager_destroy(tm);
 }
+
+static ret_t timer_log_ctx(const timer_info_t* timer) {
+  char buff[32];
+  tk_snprintf(buff, sizeof(buff), "%d:", (int)((char*)(timer->ctx) - (char*)NULL));
+  s_log += buff;
+
+  return RET_OK;
+}
+
+TEST(Timer, order) {
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  timer_manager_add(tm, timer_log_ctx, (char*)NULL + 3, 30);
+  timer_manager_add(tm, timer_log_ctx, (char*)NULL + 1, 10);
+  timer_manager_add(tm, timer_log_ctx, (char*)NULL + 4, 30);
+  timer_manager_add(tm, timer_log_ctx, (char*)NULL + 2, 20);
+  ASSERT_EQ(timer_manager_next_time(tm), 10);
+
+  timer_clear_log();
+  timer_set_time(100);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "1:2:3:4:");
+  ASSERT_EQ(timer_manager_count(tm), 0);
+
+  timer_manager_destroy(tm);
+}
+
+TEST(Timer, removeRandom) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  uint32_t ids[1000];
+  uint32_t durations[1000];
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  for (i = 0; i < ARRAY_SIZE(ids); i++) {
+    durations[i] = 1 + rand() % 10000;
+    ids[i] = timer_manager_add(tm, timer_once, NULL, durations[i]);
+  }
+
+  for (i = 0; i < ARRAY_SIZE(ids); i += 2) {
+    ASSERT_EQ(timer_manager_remove(tm, ids[i]), RET_OK);
+    ASSERT_EQ(timer_manager_remove(tm, ids[i]), RET_NOT_FOUND);
+    ASSERT_EQ(timer_manager_find(tm, ids[i]) == NULL, true);
+  }
+  ASSERT_EQ(timer_manager_count(tm), ARRAY_SIZE(ids) / 2);
+
+  while (timer_manager_count(tm) > 0) {
+    uint32_t min = 0xffffffff;
+    for (i = 1; i < ARRAY_SIZE(ids); i += 2) {
+      if (timer_manager_find(tm, ids[i]) != NULL && durations[i] < min) {
+        min = durations[i];
+      }
+    }
+
+    ASSERT_EQ(timer_manager_next_time(tm), min);
+    timer_set_time(min);
+    ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+    n++;
+  }
+  ASSERT_EQ(n > 0, true);
+
+  timer_manager_destroy(tm);
+}
+
+TEST(Timer, repeatZero) {
+  timer_set_time(10);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  timer_manager_add(tm, timer_repeat, NULL, 0);
+  timer_manager_add(tm, timer_once, NULL, 0);
+
+  timer_clear_log();
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "r:o:");
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "r:o:");
+  ASSERT_EQ(timer_manager_next_time(tm), 11);
+
+  timer_set_time(11);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "r:o:r:");
+
+  timer_manager_destroy(tm);
+}
+
+static ret_t timer_nested_dispatch(const timer_info_t* timer) {
+  s_log += "n:";
+  timer_set_time(timer->now + 50);
+  timer_manager_dispatch(timer->timer_manager);
+
+  return RET_OK;
+}
+
+TEST(Timer, nestedDispatch) {
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  timer_manager_add(tm, timer_nested_dispatch, NULL, 10);
+  timer_manager_add(tm, timer_once, NULL, 20);
+  timer_manager_add(tm, timer_once, NULL, 200);
+
+  timer_clear_log();
+  timer_set_time(20);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "n:o:");
+  ASSERT_EQ(timer_manager_count(tm), 1);
+
+  timer_manager_destroy(tm);
+}
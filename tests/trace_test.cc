@@ -0,0 +1,147 @@
+﻿#include "tkc/trace.h"
+#include "base/canvas.h"
+#include "base/font_manager.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using std::string;
+
+TEST(Trace, basic) {
+  trace_event_t events[4];
+
+  ASSERT_EQ(tk_trace_is_started(), FALSE);
+  ASSERT_EQ(tk_trace_begin("phase", "frame"), RET_OK);
+  ASSERT_EQ(tk_trace_end(), RET_OK);
+  ASSERT_EQ(tk_trace_get_events(events, 4), 0u);
+
+  ASSERT_EQ(tk_trace_start(0), RET_OK);
+  ASSERT_EQ(tk_trace_is_started(), TRUE);
+
+  tk_trace_begin("phase", "frame");
+  tk_trace_begin("phase", "timer");
+  tk_trace_end();
+  tk_trace_begin("phase", "paint");
+  tk_trace_end();
+  tk_trace_end();
+
+  /*作用域结束时记录，所以外层的作用域在后面*/
+  ASSERT_EQ(tk_trace_get_events(events, 4), 3u);
+  ASSERT_STREQ(events[0].name, "timer");
+  ASSERT_EQ(events[0].depth, 1u);
+  ASSERT_STREQ(events[1].name, "paint");
+  ASSERT_STREQ(events[2].name, "frame");
+  ASSERT_STREQ(events[2].cat, "phase");
+  ASSERT_EQ(events[2].depth, 0u);
+  ASSERT_LE(events[2].ts, events[0].ts);
+  ASSERT_GE(events[2].ts + events[2].dur, events[1].ts + events[1].dur);
+
+  ASSERT_EQ(tk_trace_clear(), RET_OK);
+  ASSERT_EQ(tk_trace_get_events(events, 4), 0u);
+
+  ASSERT_EQ(tk_trace_stop(), RET_OK);
+  ASSERT_EQ(tk_trace_is_started(), FALSE);
+}
+
+TEST(Trace, ring) {
+  uint32_t i = 0;
+  trace_event_t events[8];
+  const char* names[] = {"a", "b", "c", "d", "e", "f"};
+
+  ASSERT_EQ(tk_trace_start(4), RET_OK);
+  for (i = 0; i < ARRAY_SIZE(names); i++) {
+    tk_trace_begin("test", names[i]);
+    tk_trace_end();
+  }
+
+  /*缓冲区满时覆盖最早的事件*/
+  ASSERT_EQ(tk_trace_get_events(events, 8), 4u);
+  ASSERT_STREQ(events[0].name, "c");
+  ASSERT_STREQ(events[3].name, "f");
+
+  tk_trace_stop();
+}
+
+TEST(Trace, depth) {
+  uint32_t i = 0;
+  trace_event_t events[TK_TRACE_MAX_DEPTH + 8];
+
+  ASSERT_EQ(tk_trace_start(0), RET_OK);
+  for (i = 0; i < TK_TRACE_MAX_DEPTH + 4; i++) {
+    tk_trace_begin("test", "nested");
+  }
+  for (i = 0; i < TK_TRACE_MAX_DEPTH + 4; i++) {
+    tk_trace_end();
+  }
+  tk_trace_end();
+
+  ASSERT_EQ(tk_trace_get_events(events, ARRAY_SIZE(events)), (uint32_t)TK_TRACE_MAX_DEPTH);
+  ASSERT_EQ(events[TK_TRACE_MAX_DEPTH - 1].depth, 0u);
+
+  tk_trace_stop();
+}
+
+TEST(Trace, export) {
+  str_t str;
+  string json;
+
+  str_init(&str, 0);
+  ASSERT_EQ(tk_trace_start(0), RET_OK);
+  tk_trace_begin("phase", "layout");
+  tk_trace_begin("widget", "a\"b");
+  tk_trace_end();
+  tk_trace_end();
+
+  ASSERT_EQ(tk_trace_export(&str), RET_OK);
+  json = str.str;
+  ASSERT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  ASSERT_NE(json.find("{\"name\":\"layout\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":"), string::npos);
+  ASSERT_NE(json.find("{\"name\":\"a\\\"b\",\"cat\":\"widget\""), string::npos);
+  ASSERT_NE(json.find("\n]}"), string::npos);
+
+  tk_trace_stop();
+  str_reset(&str);
+}
+
+TEST(Trace, widget_paint) {
+  rect_t r;
+  canvas_t c;
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  trace_event_t events[16];
+  font_manager_t font_manager;
+  lcd_t* lcd = lcd_log_init(800, 600);
+  widget_t* view = view_create(NULL, 0, 0, 400, 300);
+
+  button_create(view, 10, 10, 100, 30);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+
+  ASSERT_EQ(tk_trace_start(0), RET_OK);
+  r = rect_init(0, 0, 400, 300);
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+  widget_paint(view, &c);
+  canvas_end_frame(&c);
+
+  nr = tk_trace_get_events(events, ARRAY_SIZE(events));
+  ASSERT_GE(nr, 3u);
+  for (i = 0; i < nr; i++) {
+    if (tk_str_eq(events[i].name, WIDGET_TYPE_BUTTON)) {
+      ASSERT_STREQ(events[i].cat, "widget");
+      ASSERT_EQ(events[i].depth, 1u);
+      ASSERT_STREQ(events[i + 1].name, WIDGET_TYPE_VIEW);
+      break;
+    }
+  }
+  ASSERT_LT(i, nr);
+  ASSERT_STREQ(events[nr - 1].name, "end_frame");
+  ASSERT_STREQ(events[nr - 1].cat, "lcd");
+
+  tk_trace_stop();
+  widget_destroy(view);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
@@ -1,4 +1,6 @@
 ﻿#include "widgets/dialog.h"
+#include "widgets/button.h"
+#include "widgets/slider.h"
 #include "ui_loader/ui_builder_default.h"
 #include "ui_loader/ui_binary_writer.h"
 #include "ui_loader/ui_loader_default.h"
@@ -138,3 +140,84 @@ TEST(UILoader, ext) {
 
   widget_destroy(builder->root);
 }
+
+static void ui_loader_write_v2_test_data(ui_builder_t* writer) {
+  widget_desc_t desc;
+
+  memset(&desc, 0x00, sizeof(desc));
+  INIT_DESC("group_box", 0, 0, 100, 200);
+  ui_builder_on_widget_start(writer, &desc);
+  ui_builder_on_widget_prop_end(writer);
+
+  INIT_DESC("button", 10, 20, 30, 40);
+  ui_builder_on_widget_start(writer, &desc);
+  ui_builder_on_widget_prop(writer, "name", "ok");
+  ui_builder_on_widget_prop(writer, "text", "ok");
+  ui_builder_on_widget_prop(writer, "visible", "false");
+  ui_builder_on_widget_prop(writer, "enable", "false");
+  ui_builder_on_widget_prop(writer, "opacity", "128");
+  ui_builder_on_widget_prop(writer, "repeat", "300");
+  ui_builder_on_widget_prop(writer, "foo", "bar");
+  ui_builder_on_widget_prop_end(writer);
+  ui_builder_on_widget_end(writer);
+
+  INIT_DESC("slider", 1, 2, 30, 40);
+  ui_builder_on_widget_start(writer, &desc);
+  ui_builder_on_widget_prop(writer, "style:normal:bg_color", "#ff0000");
+  ui_builder_on_widget_prop(writer, "name", "slider");
+  ui_builder_on_widget_prop(writer, "min", "10");
+  ui_builder_on_widget_prop(writer, "max", "200");
+  ui_builder_on_widget_prop(writer, "step", "2.5");
+  ui_builder_on_widget_prop(writer, "value", "30");
+  ui_builder_on_widget_prop(writer, "vertical", "true");
+  ui_builder_on_widget_prop_end(writer);
+  ui_builder_on_widget_end(writer);
+
+  ui_builder_on_widget_end(writer);
+}
+
+TEST(UILoader, v2) {
+  value_t v;
+  uint8_t data[1024];
+  uint8_t data_v1[1024];
+  wbuffer_t wbuffer;
+  wbuffer_t wbuffer_v1;
+  widget_t* ok = NULL;
+  widget_t* slider = NULL;
+  ui_binary_writer_t ui_binary_writer;
+  ui_loader_t* loader = default_ui_loader();
+  ui_builder_t* builder = ui_builder_default("");
+
+  ui_loader_write_v2_test_data(
+      ui_binary_writer_init(&ui_binary_writer, wbuffer_init(&wbuffer_v1, data_v1, sizeof(data_v1))));
+  ui_loader_write_v2_test_data(
+      ui_binary_writer_init_v2(&ui_binary_writer, wbuffer_init(&wbuffer, data, sizeof(data))));
+  ASSERT_LT(wbuffer.cursor, wbuffer_v1.cursor);
+
+  ASSERT_EQ(ui_loader_load(loader, wbuffer.data, wbuffer.cursor, builder), RET_OK);
+  ASSERT_EQ(tk_str_eq(widget_get_type(builder->root), WIDGET_TYPE_GROUP_BOX), TRUE);
+  ASSERT_EQ(widget_count_children(builder->root), 2);
+
+  ok = widget_lookup(builder->root, "ok", TRUE);
+  ASSERT_EQ(ok != NULL, true);
+  ASSERT_EQ(ok->x, 10);
+  ASSERT_EQ(ok->h, 40);
+  ASSERT_EQ(ok->visible, FALSE);
+  ASSERT_EQ(ok->enable, FALSE);
+  ASSERT_EQ(ok->opacity, 128);
+  ASSERT_EQ(BUTTON(ok)->repeat, 300);
+  ASSERT_STREQ(ok->text.str, L"ok");
+  ASSERT_EQ(widget_get_prop(ok, "foo", &v), RET_OK);
+  ASSERT_STREQ(value_str(&v), "bar");
+
+  slider = widget_lookup(builder->root, "slider", TRUE);
+  ASSERT_EQ(slider != NULL, true);
+  ASSERT_EQ(SLIDER(slider)->min, 10);
+  ASSERT_EQ(SLIDER(slider)->max, 200);
+  ASSERT_EQ(SLIDER(slider)->value, 30);
+  ASSERT_EQ(SLIDER(slider)->vertical, TRUE);
+  ASSERT_EQ(style_get_color(slider->astyle, STYLE_ID_BG_COLOR, color_init(0, 0, 0, 0)).color,
+            color_init(0xff, 0, 0, 0xff).color);
+
+  widget_destroy(builder->root);
+}
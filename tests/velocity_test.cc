@@ -13,3 +13,34 @@ TEST(Velocity, basic) {
   ASSERT_EQ(round(v->xv), 1000);
   ASSERT_EQ(round(v->yv), 2000);
 }
+
+TEST(Velocity, history) {
+  velocity_t velocity1;
+  velocity_t velocity2;
+  velocity_t* v1 = velocity_reset(&velocity1);
+  velocity_t* v2 = velocity_reset(&velocity2);
+
+  velocity_history_reset();
+  velocity_update(v1, 100, 0, 0);
+  velocity_update(v1, 110, 10, 20);
+  velocity_update(v1, 120, 20, 40);
+  velocity_update(v1, 130, 30, 60);
+
+  /*合并后的事件：只收到最后一个，中间的在历史中*/
+  velocity_update(v2, 100, 0, 0);
+  velocity_history_add(110, 10, 20);
+  velocity_history_add(120, 20, 40);
+  velocity_update(v2, 130, 30, 60);
+  velocity_history_reset();
+
+  ASSERT_EQ(round(v1->xv), round(v2->xv));
+  ASSERT_EQ(round(v1->yv), round(v2->yv));
+
+  /*过时的历史记录不会被使用*/
+  velocity_history_add(50, 1000, 1000);
+  velocity_update(v2, 140, 40, 80);
+  velocity_update(v1, 140, 40, 80);
+  velocity_history_reset();
+  ASSERT_EQ(round(v1->xv), round(v2->xv));
+  ASSERT_EQ(round(v1->yv), round(v2->yv));
+}
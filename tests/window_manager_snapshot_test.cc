@@ -0,0 +1,59 @@
+﻿#include "base/canvas.h"
+#include "widgets/view.h"
+#include "base/window_manager.h"
+#include "lcd/lcd_mem_rgba8888.h"
+#include "gtest/gtest.h"
+
+#if TK_SNAPSHOT_POOL_SIZE > 1
+TEST(WindowManagerSnapshot, pool) {
+  uint32_t i = 0;
+  canvas_t canvas;
+  framebuffer_object_t fbo;
+  font_manager_t font_manager;
+  bitmap_t imgs[TK_SNAPSHOT_POOL_SIZE + 1];
+  widget_t* wm = window_manager();
+  canvas_t* old_canvas = WINDOW_MANAGER(wm)->canvas;
+  lcd_t* lcd = lcd_mem_rgba8888_create(200, 100, TRUE);
+  widget_t* win = view_create(NULL, 0, 0, 200, 100);
+  const uint8_t* data = NULL;
+
+  font_manager_init(&font_manager, NULL);
+  WINDOW_MANAGER(wm)->canvas = canvas_init(&canvas, lcd, &font_manager);
+  memset(&fbo, 0x00, sizeof(fbo));
+  memset(imgs, 0x00, sizeof(imgs));
+  window_manager_free_unused_snapshots(wm);
+
+  for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+    ASSERT_EQ(window_manager_snap_curr_window(wm, win, imgs + i, &fbo, FALSE), RET_OK);
+    ASSERT_EQ(imgs[i].w, 200);
+    ASSERT_EQ(imgs[i].h, 100);
+    ASSERT_TRUE(imgs[i].data != NULL);
+    ASSERT_EQ(imgs[i].should_free_data, FALSE);
+    ASSERT_EQ(WINDOW_MANAGER(wm)->snapshots[i].used, TRUE);
+  }
+
+  /*保留的缓冲区用完时临时分配*/
+  ASSERT_EQ(window_manager_snap_curr_window(wm, win, imgs + i, &fbo, FALSE), RET_OK);
+  ASSERT_EQ(imgs[i].should_free_data, TRUE);
+  ASSERT_EQ(window_manager_release_snapshot(wm, imgs + i), RET_OK);
+
+  /*释放后再次使用同一个缓冲区*/
+  data = imgs[0].data;
+  ASSERT_EQ(window_manager_release_snapshot(wm, imgs), RET_OK);
+  ASSERT_TRUE(imgs[0].data == NULL);
+  ASSERT_EQ(WINDOW_MANAGER(wm)->snapshots[0].used, FALSE);
+  ASSERT_EQ(window_manager_snap_prev_window(wm, win, imgs, &fbo, FALSE), RET_OK);
+  ASSERT_TRUE(imgs[0].data == data);
+
+  for (i = 0; i < TK_SNAPSHOT_POOL_SIZE; i++) {
+    ASSERT_EQ(window_manager_release_snapshot(wm, imgs + i), RET_OK);
+  }
+  ASSERT_EQ(window_manager_free_unused_snapshots(wm), 200u * 100u * 4u * TK_SNAPSHOT_POOL_SIZE);
+  ASSERT_EQ(window_manager_free_unused_snapshots(wm), 0u);
+
+  WINDOW_MANAGER(wm)->canvas = old_canvas;
+  widget_destroy(win);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+#endif /*TK_SNAPSHOT_POOL_SIZE > 1*/
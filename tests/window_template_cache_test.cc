@@ -0,0 +1,94 @@
+﻿#include "widgets/dialog.h"
+#include "base/ui_loader.h"
+#include "base/window_manager.h"
+#include "ui_loader/ui_builder_default.h"
+#include "ui_loader/window_template_cache.h"
+#include "gtest/gtest.h"
+
+static bool_t widget_tree_equal(widget_t* a, widget_t* b) {
+  uint32_t i = 0;
+
+  if (!widget_equal(a, b) || widget_count_children(a) != widget_count_children(b)) {
+    return FALSE;
+  }
+
+  for (i = 0; i < widget_count_children(a); i++) {
+    if (!widget_tree_equal(widget_get_child(a, i), widget_get_child(b, i))) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+TEST(WindowTemplateCache, basic) {
+  widget_t* win1 = NULL;
+  widget_t* win2 = NULL;
+  widget_t* win3 = NULL;
+  widget_t* button = NULL;
+
+  ASSERT_EQ(window_template_cache_is_enabled("dialog1"), FALSE);
+  ASSERT_EQ(window_template_cache_open("dialog1") == NULL, TRUE);
+  win1 = ui_loader_load_widget("dialog1");
+  ASSERT_EQ(win1 != NULL, TRUE);
+
+  ASSERT_EQ(window_template_cache_enable("dialog1"), RET_OK);
+  ASSERT_EQ(window_template_cache_is_enabled("dialog1"), TRUE);
+  ASSERT_EQ(window_template_cache_get_mem_size(), 0);
+
+  win2 = window_open("dialog1");
+  ASSERT_EQ(win2 != NULL, TRUE);
+  ASSERT_GT(window_template_cache_get_mem_size(), 0);
+  win3 = window_open("dialog1");
+  ASSERT_EQ(win3 != NULL, TRUE);
+
+  ASSERT_STREQ(win2->name, "dialog1");
+  ASSERT_STREQ(widget_get_type(win3), WIDGET_TYPE_DIALOG);
+  ASSERT_EQ(DIALOG(win3)->title != NULL, TRUE);
+  ASSERT_EQ(DIALOG(win3)->client != NULL, TRUE);
+  ASSERT_EQ(widget_tree_equal(win1, win2), TRUE);
+  ASSERT_EQ(widget_tree_equal(win2, win3), TRUE);
+
+  button = widget_lookup(win3, "back_to_home", TRUE);
+  ASSERT_EQ(button != NULL, TRUE);
+  ASSERT_STREQ(button->text.str, L"确定");
+  ASSERT_EQ(button->parent, DIALOG(win3)->client);
+
+  widget_destroy(win1);
+  widget_destroy(win2);
+  widget_destroy(win3);
+
+  ASSERT_EQ(window_template_cache_clear(), RET_OK);
+  ASSERT_EQ(window_template_cache_get_mem_size(), 0);
+  ASSERT_EQ(window_template_cache_disable("dialog1"), RET_OK);
+  ASSERT_EQ(window_template_cache_is_enabled("dialog1"), FALSE);
+  ASSERT_EQ(window_template_cache_deinit(), RET_OK);
+}
+
+TEST(WindowTemplateCache, mem_limit) {
+  widget_t* win = NULL;
+  uint32_t mem_size = 0;
+
+  ASSERT_EQ(window_template_cache_enable("dialog1"), RET_OK);
+  ASSERT_EQ(window_template_cache_enable("dialog2"), RET_OK);
+
+  win = window_open("dialog1");
+  widget_destroy(win);
+  mem_size = window_template_cache_get_mem_size();
+  ASSERT_GT(mem_size, 0);
+
+  ASSERT_EQ(window_template_cache_set_max_mem_size(mem_size), RET_OK);
+  win = window_open("dialog2");
+  ASSERT_EQ(win != NULL, TRUE);
+  widget_destroy(win);
+  ASSERT_LE(window_template_cache_get_mem_size(), mem_size);
+
+  ASSERT_EQ(window_template_cache_set_max_mem_size(1), RET_OK);
+  ASSERT_EQ(window_template_cache_get_mem_size(), 0);
+  win = window_open("dialog1");
+  ASSERT_EQ(win != NULL, TRUE);
+  ASSERT_EQ(window_template_cache_get_mem_size(), 0);
+  widget_destroy(win);
+
+  ASSERT_EQ(window_template_cache_deinit(), RET_OK);
+}
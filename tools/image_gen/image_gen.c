@@ -19,6 +19,7 @@
  *
  */
 
+#include "tkc/lz4.h"
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "common/utils.h"
@@ -26,6 +27,7 @@
 #include "base/image_manager.h"
 #include "base/assets_manager.h"
 #include "image_loader/image_loader_stb.h"
+#include "image_loader/image_loader_lz4.h"
 
 #define MAX_BUFF_SIZE 2 * 1024 * 1024
 
@@ -59,3 +61,37 @@ uint32_t image_gen_buff(bitmap_t* image, uint8_t* output_buff, uint32_t buff_siz
 
   return size + sizeof(bitmap_header_t);
 }
+
+ret_t image_gen_lz4(bitmap_t* image, const char* output_filename) {
+  uint32_t size = 0;
+  uint8_t* buff = (uint8_t*)TKMEM_ALLOC(MAX_BUFF_SIZE);
+  return_value_if_fail(buff != NULL, RET_FAIL);
+
+  size = image_gen_lz4_buff(image, buff, MAX_BUFF_SIZE);
+  if (size > 0) {
+    output_res_c_source(output_filename, ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_LZ4, buff, size);
+  }
+  TKMEM_FREE(buff);
+
+  return size > 0 ? RET_OK : RET_FAIL;
+}
+
+uint32_t image_gen_lz4_buff(bitmap_t* image, uint8_t* output_buff, uint32_t buff_size) {
+  int32_t size = 0;
+  uint32_t header_size = sizeof(bitmap_lz4_header_t) - 4;
+  bitmap_lz4_header_t* header = (bitmap_lz4_header_t*)output_buff;
+  return_value_if_fail(image != NULL && output_buff != NULL, 0);
+  return_value_if_fail(buff_size > header_size, 0);
+
+  size = lz4_compress(image->data, bitmap_get_bpp(image) * image->w * image->h, header->data,
+                      buff_size - header_size);
+  return_value_if_fail(size >= 0, 0);
+
+  header->w = image->w;
+  header->h = image->h;
+  header->flags = image->flags;
+  header->format = image->format;
+  header->size = size;
+
+  return size + header_size;
+}
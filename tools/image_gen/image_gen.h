@@ -29,6 +29,9 @@ BEGIN_C_DECLS
 ret_t image_gen(bitmap_t* image, const char* output_filename);
 uint32_t image_gen_buff(bitmap_t* image, uint8_t* output_buff, uint32_t buff_size);
 
+ret_t image_gen_lz4(bitmap_t* image, const char* output_filename);
+uint32_t image_gen_lz4_buff(bitmap_t* image, uint8_t* output_buff, uint32_t buff_size);
+
 END_C_DECLS
 
 #endif /*IMAGE_GEN_H*/
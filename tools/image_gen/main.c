@@ -27,17 +27,19 @@
 
 int main(int argc, char** argv) {
   bitmap_t image;
+  ret_t ret = RET_OK;
   uint32_t size = 0;
   uint8_t* buff = NULL;
   bool_t require_bgra = FALSE;
   bool_t enable_bgr565 = FALSE;
+  bool_t enable_lz4 = FALSE;
   const char* in_filename = NULL;
   const char* out_filename = NULL;
 
   TKMEM_INIT(4 * 1024 * 1024);
 
   if (argc < 3) {
-    printf("Usage: %s in_filename out_filename (bgra|bgr565)\n", argv[0]);
+    printf("Usage: %s in_filename out_filename (bgra|bgr565|lz4)\n", argv[0]);
 
     return 0;
   }
@@ -52,6 +54,10 @@ int main(int argc, char** argv) {
     if (strstr(options, "bgr565") != NULL) {
       enable_bgr565 = TRUE;
     }
+
+    if (strstr(options, "lz4") != NULL) {
+      enable_lz4 = TRUE;
+    }
   }
 
   in_filename = argv[1];
@@ -62,7 +68,13 @@ int main(int argc, char** argv) {
   buff = (uint8_t*)read_file(in_filename, &size);
   if (buff != NULL) {
     if (stb_load_image(0, buff, size, &image, require_bgra, enable_bgr565) == RET_OK) {
-      if (image_gen(&image, out_filename) == RET_OK) {
+      if (enable_lz4) {
+        ret = image_gen_lz4(&image, out_filename);
+      } else {
+        ret = image_gen(&image, out_filename);
+      }
+
+      if (ret == RET_OK) {
         printf("done\n");
       } else {
         printf("gen %s failed\n", out_filename);
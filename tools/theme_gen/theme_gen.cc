@@ -23,8 +23,14 @@
 #include "tkc/utils.h"
 #include "base/enums.h"
 #include "base/theme.h"
+#include "base/style.h"
 #include "tkc/buffer.h"
 #include "tkc/types_def.h"
+#include <algorithm>
+
+static bool theme_item_less(const theme_item_t& a, const theme_item_t& b) {
+  return theme_item_cmp(&a, b.widget_type, b.name, b.state) < 0;
+}
 
 Style::Style() {
 }
@@ -87,6 +93,13 @@ bool Style::Merge(Style& other) {
   return true;
 }
 
+/*自定义属性写入STYLE_PROP_ID_UNKNOWN，以后追加的ID不会把它当成新的属性*/
+static uint8_t style_prop_id_to_data(const char* name) {
+  style_prop_id_t id = style_prop_id(name);
+
+  return id < STYLE_PROP_NR ? (uint8_t)id : STYLE_PROP_ID_UNKNOWN;
+}
+
 uint8_t* Style::Output(uint8_t* buff, uint32_t max_size) {
   uint32_t size = 0;
   uint8_t* p = buff;
@@ -133,6 +146,24 @@ uint8_t* Style::Output(uint8_t* buff, uint32_t max_size) {
     printf("    %s=%s\n", data.name, data.value);
   }
 
+  /*THEME_VERSION 1: 每个值的属性ID，按4字节对齐*/
+  size = this->int_values.size() + this->str_values.size();
+  return_value_if_fail((end - p) > (size + 4), NULL);
+  for (vector<NameIntValue>::iterator i = this->int_values.begin(); i != this->int_values.end();
+       i++) {
+    *p++ = style_prop_id_to_data(i->name.c_str());
+  }
+
+  for (vector<NameStringValue>::iterator i = this->str_values.begin(); i != this->str_values.end();
+       i++) {
+    *p++ = style_prop_id_to_data(i->name.c_str());
+  }
+
+  while (size % 4) {
+    *p++ = 0xff;
+    size++;
+  }
+
   return p;
 }
 
@@ -155,7 +186,7 @@ uint8_t* ThemeGen::Output(uint8_t* buff, uint32_t max_size) {
   memset(buff, 0x00, max_size);
 
   header->magic = THEME_MAGIC;
-  header->version = 0;
+  header->version = THEME_VERSION;
   header->nr = nr;
 
   for (vector<Style>::iterator iter = this->styles.begin(); iter != this->styles.end(); iter++) {
@@ -168,5 +199,9 @@ uint8_t* ThemeGen::Output(uint8_t* buff, uint32_t max_size) {
     item++;
   }
 
+  /*THEME_VERSION_SORTED: 运行时二分查找，相同的项保持原来的顺序*/
+  item = (theme_item_t*)(buff + sizeof(theme_header_t));
+  std::stable_sort(item, item + nr, theme_item_less);
+
   return p;
 }
@@ -97,6 +97,8 @@ static void xml_gen_style(xml_builder_t* b, Style& s, const char** attrs) {
     } else if (strcmp(name, "bg_image_draw_type") == 0 || strcmp(name, "fg_image_draw_type") == 0) {
       const key_type_value_t* dt = image_draw_type_find(value);
       s.AddInt(name, dt->value);
+    } else if (strcmp(name, "bg_image_smooth") == 0 || strcmp(name, "fg_image_smooth") == 0) {
+      s.AddInt(name, tk_atob(value));
     } else if (strcmp(name, "text_align_h") == 0) {
       const key_type_value_t* dt = align_h_type_find(value);
       s.AddInt(name, dt->value);
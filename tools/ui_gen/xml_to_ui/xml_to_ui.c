@@ -37,7 +37,7 @@ int main(int argc, char** argv) {
   ui_binary_writer_t ui_binary_writer;
   ui_loader_t* loader = xml_ui_loader();
   ui_builder_t* builder =
-      ui_binary_writer_init(&ui_binary_writer, wbuffer_init(&wbuffer, data, sizeof(data)));
+      ui_binary_writer_init_v2(&ui_binary_writer, wbuffer_init(&wbuffer, data, sizeof(data)));
 
   TKMEM_INIT(4 * 1024 * 1024);
 